@@ -0,0 +1,164 @@
+/**
+ * @file AssetArchive.h
+ * @brief Declara la API de AssetArchive dentro del subsistema Core.
+ * @ingroup core
+ */
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @brief Vista de solo lectura a un blob dentro del archivo montado.
+ */
+struct AssetBlob {
+	const unsigned char* data = nullptr;  ///< Inicio del blob (memoria mapeada).
+	size_t size = 0;                      ///< Tamano en bytes.
+	uint64_t sourceWriteTime = 0;         ///< Tiempo de escritura del fuente al empaquetar (0 si no habia fuente).
+};
+
+/**
+ * @brief Lector secuencial sobre un bloque de memoria, comun a los parsers de caches.
+ */
+struct MemoryReader {
+	const unsigned char* cursor = nullptr;
+	const unsigned char* end = nullptr;
+
+	MemoryReader(const unsigned char* data, size_t size) : cursor(data), end(data + size) {}
+
+	/// Bytes sin leer; permite validar un conteo antes de reservar memoria para el.
+	size_t
+	remaining() const { return static_cast<size_t>(end - cursor); }
+
+	bool
+	read(void* out, size_t size) {
+		if (remaining() < size) {
+			return false;
+		}
+		memcpy(out, cursor, size);
+		cursor += size;
+		return true;
+	}
+
+	template<typename T>
+	bool
+	read(T& out) { return read(&out, sizeof(T)); }
+
+	bool
+	readString(std::string& out) {
+		uint32_t length = 0;
+		if (!read(length) || remaining() < length) {
+			return false;
+		}
+		out.assign(reinterpret_cast<const char*>(cursor), length);
+		cursor += length;
+		return true;
+	}
+};
+
+/**
+ * @class AssetArchive
+ * @brief Archivo `.wvpak` que agrupa los caches cocinados (`.wvmesh`, `.wvtx`) en un solo fichero.
+ *
+ * El archivo se mapea en memoria al arrancar. Su tabla de contenidos esta ordenada por
+ * hash FNV-1a de la ruta normalizada, de modo que localizar un asset es una busqueda
+ * binaria sin abrir archivos. Los blobs quedan alineados a `kBlobAlignment` bytes.
+ *
+ * Formato:
+ * - Header (32 bytes): magic, version, entryCount, stringTableSize, tocOffset, stringTableOffset.
+ * - TOC: `entryCount` entradas de 40 bytes ordenadas por hash.
+ * - Tabla de nombres (para resolver colisiones de hash).
+ * - Blobs alineados.
+ */
+class
+AssetArchive {
+public:
+	static constexpr uint32_t kBlobAlignment = 64;
+
+	AssetArchive() = default;
+	~AssetArchive() { unmount(); }
+
+	AssetArchive(const AssetArchive&) = delete;
+	AssetArchive& operator=(const AssetArchive&) = delete;
+
+	/// Archivo montado globalmente y consultado por Model3D y Texture.
+	static AssetArchive& getInstance() {
+		static AssetArchive instance;
+		return instance;
+	}
+
+	/**
+	 * @brief Mapea un `.wvpak` en memoria y valida su cabecera y su tabla de contenidos.
+	 *
+	 * Rechaza el archivo si alguna entrada sale de la tabla de nombres o del
+	 * archivo, o si la tabla no esta ordenada por hash.
+	 * @param archivePath Ruta del archivo.
+	 * @return `true` si el archivo quedo montado.
+	 */
+	bool
+	mount(const std::string& archivePath);
+
+	/**
+	 * @brief Libera la vista mapeada y los handles del archivo.
+	 */
+	void
+	unmount();
+
+	bool
+	isMounted() const { return m_view != nullptr; }
+
+	/**
+	 * @brief Busca un asset por su ruta de archivo suelto (p. ej. `CyberGun.fbx.wvmesh`).
+	 * @param path Ruta; se normaliza a minusculas y separadores `/`.
+	 * @param outBlob Vista al contenido si se encuentra.
+	 */
+	bool
+	find(const std::string& path, AssetBlob& outBlob) const;
+
+	/**
+	 * @brief Empaqueta archivos sueltos en un `.wvpak` nuevo.
+	 *
+	 * Cada archivo se guarda bajo su propia ruta. Si existe el fuente del cache
+	 * (la ruta sin su ultima extension) se registra su tiempo de escritura para
+	 * que los loaders puedan descartar entradas obsoletas.
+	 * @param archivePath Ruta de salida.
+	 * @param files Archivos a empaquetar; los que no existan se omiten.
+	 */
+	static bool
+	build(const std::string& archivePath, const std::vector<std::string>& files);
+
+	/// Hash FNV-1a de 64 bits sobre la ruta normalizada.
+	static uint64_t
+	hashPath(const std::string& path);
+
+	size_t
+	getEntryCount() const { return m_entryCount; }
+
+private:
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t stringTableSize;
+		uint64_t tocOffset;
+		uint64_t stringTableOffset;
+	};
+
+	struct TocEntry {
+		uint64_t pathHash;
+		uint64_t offset;
+		uint64_t size;
+		uint64_t sourceWriteTime;
+		uint32_t nameOffset;
+		uint32_t nameLength;
+	};
+
+	static std::string
+	normalizePath(const std::string& path);
+
+	HANDLE m_file = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = nullptr;
+	const unsigned char* m_view = nullptr;
+	size_t m_viewSize = 0;
+	const TocEntry* m_toc = nullptr;
+	const char* m_strings = nullptr;
+	size_t m_entryCount = 0;
+};
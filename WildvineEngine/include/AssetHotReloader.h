@@ -0,0 +1,149 @@
+/**
+ * @file AssetHotReloader.h
+ * @brief Declara la API de AssetHotReloader dentro del subsistema Core.
+ * @ingroup core
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "FileWatcher.h"
+#include "Model3D.h"
+#include "Texture.h"
+#include "ShaderProgram.h"
+#include "EngineUtilities\Utilities\LayoutBuilder.h"
+#include <functional>
+#include <future>
+
+class Device;
+
+/**
+ * @brief Metricas de la recarga en caliente, expuestas para depuracion.
+ */
+struct HotReloadStats {
+	unsigned int reloads = 0;           ///< Recargas aplicadas con exito.
+	unsigned int failures = 0;          ///< Reimportaciones que fallaron (se conserva la version previa).
+	double lastImportMs = 0.0;          ///< Tiempo de reimportacion en el hilo de fondo.
+	double lastLatencyMs = 0.0;         ///< Desde la deteccion del cambio hasta el swap.
+	double lastSwapMs = 0.0;            ///< Costo del swap en el hilo principal (impacto en el frame).
+};
+
+/**
+ * @class AssetHotReloader
+ * @brief Reimporta modelos, texturas y shaders modificados sin reiniciar la aplicacion.
+ *
+ * Un FileWatcher detecta cambios en los archivos fuente. Cada asset modificado se
+ * reimporta en un hilo de fondo reutilizando el camino normal de carga (y por lo tanto
+ * los caches `.wvmesh`/`.wvtx`). El resultado se publica en el hilo principal desde
+ * update(): los modelos se sustituyen en su entrada del ResourceManager (los handles
+ * siguen siendo validos) y texturas y shaders se intercambian en su objeto original.
+ */
+class
+AssetHotReloader {
+public:
+	using ModelReloadedCallback = std::function<void(Model3D&)>;
+
+	AssetHotReloader() = default;
+	~AssetHotReloader() { destroy(); }
+
+	/**
+	 * @brief Arranca el vigilante de archivos.
+	 * @param device Dispositivo usado para crear los recursos GPU reimportados.
+	 * @param pollIntervalMs Periodo de sondeo del FileWatcher.
+	 */
+	void
+	init(Device& device, unsigned int pollIntervalMs = 250);
+
+	/**
+	 * @brief Detiene el vigilante y espera a las reimportaciones en curso.
+	 */
+	void
+	destroy();
+
+	/**
+	 * @brief Vigila un modelo registrado en el ResourceManager.
+	 * @param key Clave del recurso en el ResourceManager.
+	 * @param path Archivo fuente del modelo.
+	 * @param modelType Formato del archivo.
+	 * @param onReloaded Se invoca en el hilo principal tras el swap (p. ej. para rehacer buffers GPU).
+	 */
+	void
+	watchModel(const std::string& key,
+	           const std::string& path,
+	           ModelType modelType,
+	           ModelReloadedCallback onReloaded = nullptr);
+
+	/**
+	 * @brief Vigila una textura ya inicializada.
+	 * @param texture Textura viva; debe sobrevivir al reloader.
+	 * @param textureName Nombre usado en Texture::init (sin extension).
+	 * @param extensionType Extension usada en Texture::init.
+	 */
+	void
+	watchTexture(Texture& texture, const std::string& textureName, ExtensionType extensionType);
+
+	/**
+	 * @brief Vigila un programa de shaders ya inicializado.
+	 * @param shader Programa vivo; debe sobrevivir al reloader.
+	 * @param fileName Archivo HLSL usado en ShaderProgram::init.
+	 * @param layoutBuilder Layout de entrada usado en ShaderProgram::init.
+	 */
+	void
+	watchShader(ShaderProgram& shader, const std::string& fileName, const LayoutBuilder& layoutBuilder);
+
+	/**
+	 * @brief Lanza reimportaciones para los cambios detectados y aplica las terminadas.
+	 * Debe llamarse una vez por frame desde el hilo principal.
+	 */
+	void
+	update();
+
+	const HotReloadStats&
+	getStats() const { return m_stats; }
+
+private:
+	enum class AssetKind {
+		Model,
+		Texture,
+		Shader
+	};
+
+	struct WatchedAsset {
+		AssetKind kind = AssetKind::Model;
+		std::string path;
+		std::string key;
+		ModelType modelType = ModelType::OBJ;
+		ModelReloadedCallback onReloaded;
+		Texture* texture = nullptr;
+		ExtensionType extensionType = PNG;
+		ShaderProgram* shader = nullptr;
+		LayoutBuilder layoutBuilder;
+		bool inFlight = false;      ///< Hay una reimportacion en curso.
+		bool changedAgain = false;  ///< Llego otro cambio mientras se reimportaba.
+	};
+
+	struct CompletedReload {
+		size_t assetIndex = 0;
+		bool success = false;
+		std::shared_ptr<Model3D> model;
+		std::unique_ptr<Texture> texture;
+		std::unique_ptr<ShaderProgram> shader;
+		std::chrono::high_resolution_clock::time_point detectedAt;
+		double importMs = 0.0;
+	};
+
+	void
+	launchReload(size_t assetIndex, std::chrono::high_resolution_clock::time_point detectedAt);
+
+	void
+	applyReload(CompletedReload& reload);
+
+	Device* m_device = nullptr;
+	FileWatcher m_watcher;
+	std::vector<WatchedAsset> m_assets;
+	std::vector<FileChange> m_changes;
+
+	std::vector<std::future<void>> m_jobs;
+	std::vector<CompletedReload> m_completed;
+	std::mutex m_completedMutex;
+
+	HotReloadStats m_stats;
+};
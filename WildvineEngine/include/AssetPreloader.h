@@ -0,0 +1,91 @@
+/**
+ * @file AssetPreloader.h
+ * @brief Declara la API de AssetPreloader dentro del subsistema Core.
+ * @ingroup core
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "ResourceManager.h"
+#include <mutex>
+
+/**
+ * @class AssetPreloader
+ * @brief Emite por adelantado las lecturas listadas en el manifiesto de precarga de una escena.
+ *
+ * El manifiesto se genera a partir del grafo de dependencias del ResourceManager y
+ * guarda, por archivo, su nivel de dependencia (0 = hoja). Al arrancar, begin() abre
+ * todos los archivos y lanza lecturas solapadas (overlapped I/O) en orden de nivel,
+ * de modo que el sistema operativo las atiende en paralelo mientras BaseApp inicializa
+ * el resto. Los loaders (caches de Model3D y Texture) toman los bytes con consume()
+ * en lugar de abrir el archivo otra vez.
+ */
+class
+AssetPreloader {
+public:
+	AssetPreloader() = default;
+	~AssetPreloader() { end(); }
+
+	AssetPreloader(const AssetPreloader&) = delete;
+	AssetPreloader& operator=(const AssetPreloader&) = delete;
+
+	static AssetPreloader& getInstance() {
+		static AssetPreloader instance;
+		return instance;
+	}
+
+	/**
+	 * @brief Escribe el manifiesto de precarga a partir del grafo de dependencias.
+	 *
+	 * Cada nodo se traduce al archivo que su loader leera realmente (el cache
+	 * `.wvmesh`/`.wvtx` si existe). Los nodos sin archivo consumible se omiten.
+	 * @param manifestPath Ruta del manifiesto.
+	 * @param graph Grafo registrado durante la carga.
+	 */
+	static bool
+	writeManifest(const std::string& manifestPath, const ResourceManager::DependencyGraph& graph);
+
+	/**
+	 * @brief Lee un manifiesto y lanza todas sus lecturas sin bloquear.
+	 * @return `false` si el manifiesto no existe o es invalido.
+	 */
+	bool
+	begin(const std::string& manifestPath);
+
+	/**
+	 * @brief Entrega los bytes precargados de un archivo, esperando si aun se estan leyendo.
+	 * @param path Ruta del archivo tal como la usa el loader.
+	 * @param outData Contenido completo del archivo.
+	 * @return `false` si el archivo no estaba en el manifiesto (el loader lee de disco).
+	 */
+	bool
+	consume(const std::string& path, std::vector<unsigned char>& outData);
+
+	/**
+	 * @brief Cancela lo no consumido, libera buffers y registra las metricas.
+	 */
+	void
+	end();
+
+	bool
+	isActive() const { return m_active; }
+
+private:
+	struct PendingRead {
+		HANDLE file = INVALID_HANDLE_VALUE;
+		OVERLAPPED overlapped{};
+		std::vector<unsigned char> data;
+	};
+
+	static std::string
+	normalizePath(const std::string& path);
+
+	static void
+	closeRead(PendingRead& read);
+
+	std::unordered_map<std::string, std::unique_ptr<PendingRead>> m_reads;
+	std::mutex m_mutex;
+	bool m_active = false;
+	size_t m_issued = 0;
+	size_t m_consumed = 0;
+	uint64_t m_bytesIssued = 0;
+};
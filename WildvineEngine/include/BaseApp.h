@@ -18,6 +18,8 @@
 #include "Buffer.h"
 #include "SamplerState.h"
 #include "Model3D.h"
+#include "ResourceHandle.h"
+#include "AssetHotReloader.h"
 #include "ECS/Actor.h"
 #include "EngineUtilities\GUI/GUI.h"
 #include "SceneGraph\SceneGraph.h"
@@ -123,10 +125,41 @@ public:
 	 * @brief Devuelve la ruta por defecto usada por el editor para persistencia rapida.
 	 */
 	std::string getDefaultScenePath() const;
+
+	/**
+	 * @brief Devuelve la ruta del manifiesto de precarga asociado a una escena.
+	 * @param scenePath Ruta del archivo `.wvscene`.
+	 */
+	std::string getPreloadManifestPath(const std::string& scenePath) const;
+
+	/**
+	 * @brief Devuelve la ruta del archivo `.wvpak` con los caches cocinados.
+	 */
+	std::string getAssetArchivePath() const;
+
+	/**
+	 * @brief Empaqueta los caches `.wvmesh`/`.wvtx` de los assets cargados en el `.wvpak`.
+	 * @return `true` si el archivo se escribio correctamente.
+	 */
+	bool buildAssetArchive();
 private:
 	static LRESULT CALLBACK 
 	WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
 
+	/**
+	 * @brief Crea los buffers GPU de un Mesh de render a partir de un modelo importado.
+	 * @param renderMesh Mesh destino; su contenido previo se libera solo si la construccion termina bien.
+	 * @param model Modelo con las mallas de CPU.
+	 */
+	HRESULT
+	buildRenderMesh(Mesh& renderMesh, const Model3D& model);
+
+	/**
+	 * @brief Callback del hot reload: reconstruye `renderMesh` o, si falla, conserva la anterior.
+	 */
+	void
+	reloadRenderMesh(Mesh& renderMesh, const Model3D& model);
+
 
 private:
 	Window                              m_window;
@@ -167,8 +200,8 @@ private:
 	EU::TSharedPointer<Actor> m_directionalLightActor;
 
 	
-	Model3D*														m_model;
-	Model3D*														m_drakefireModel = nullptr;
+	TResourceHandle<Model3D>						m_cyberGunModel;
+	TResourceHandle<Model3D>						m_drakefireModel;
 
 	//CBChangeOnResize										cbChangesOnResize;
 	//CBNeverChanges											cbNeverChanges;
@@ -190,6 +223,8 @@ private:
 
 	EditorViewportPass m_editorViewportPass;
 	ForwardRenderer m_forwardRenderer;
+	AssetHotReloader m_hotReloader;
+	bool m_preloadManifestUsed = false;
 	RenderScene m_renderScene;
 	bool m_editorViewportResizePending = false;
 	unsigned int m_pendingViewportWidth = 1;
@@ -29,7 +29,7 @@ class MeshComponent;
  * adems de soportar renderizado de sombras.
  */
 class 
-Actor : public Entity {
+Actor : public Entity, public EU::TPooledObject<Actor> {
 public:
   /**
    * @brief Constructor por defecto.
@@ -159,6 +159,7 @@ private:
   SamplerState m_sampler;                ///< Estado de muestreo de texturas.
   CBChangesEveryFrame m_model;           ///< Constante de buffer para transformaciones por frame.
   Buffer m_modelBuffer;                  ///< Constant buffer que contiene @c m_model.
+  uint32_t m_uploadedTransformVersion = UINT32_MAX; ///< Version del Transform subida a @c m_modelBuffer.
 
   // Recursos para sombras
   ShaderProgram m_shaderShadow;          ///< Shader program usado para renderizar sombras.
@@ -0,0 +1,237 @@
+/**
+ * @file ArchetypeStorage.h
+ * @brief Declara la API de ArchetypeStorage dentro del subsistema ECS.
+ * @ingroup ecs
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "ECS/Entity.h"
+#include "ECS/Transform.h"
+#include "ECS/MeshRendererComponent.h"
+
+/**
+ * @brief Bloque de memoria de tamano fijo con las filas de un arquetipo.
+ */
+struct ArchetypeChunk {
+	unsigned char* memory = nullptr; ///< kChunkSize bytes alineados a 64.
+	uint32_t count = 0;              ///< Filas ocupadas; solo el ultimo chunk puede no estar lleno.
+};
+
+/**
+ * @class Archetype
+ * @brief Conjunto de entidades con la misma mascara de componentes.
+ *
+ * Cada chunk guarda sus columnas una tras otra (SoA): primero los `Entity*`,
+ * luego los TransformData y los MeshRendererData si el arquetipo los incluye.
+ * El resto de componentes forma parte de la mascara pero sigue viviendo en el heap.
+ */
+class
+Archetype {
+public:
+	static constexpr size_t kChunkSize = 16 * 1024;
+	static constexpr size_t kNoColumn = static_cast<size_t>(-1);
+
+	explicit Archetype(uint32_t mask);
+
+	uint32_t
+	getMask() const { return m_mask; }
+
+	/// Indica si el arquetipo contiene todos los bits de `requiredMask`.
+	bool
+	matches(uint32_t requiredMask) const { return (m_mask & requiredMask) == requiredMask; }
+
+	uint32_t
+	getChunkCapacity() const { return m_capacity; }
+
+	std::vector<ArchetypeChunk>&
+	getChunks() { return m_chunks; }
+
+	const std::vector<ArchetypeChunk>&
+	getChunks() const { return m_chunks; }
+
+	Entity**
+	entities(const ArchetypeChunk& chunk) const {
+		return reinterpret_cast<Entity**>(chunk.memory);
+	}
+
+	/// Columna de TransformData, o nullptr si el arquetipo no tiene Transform.
+	TransformData*
+	transforms(const ArchetypeChunk& chunk) const {
+		return m_transformOffset == kNoColumn ? nullptr
+			: reinterpret_cast<TransformData*>(chunk.memory + m_transformOffset);
+	}
+
+	/// Columna de MeshRendererData, o nullptr si el arquetipo no tiene MeshRenderer.
+	MeshRendererData*
+	meshRenderers(const ArchetypeChunk& chunk) const {
+		return m_meshRendererOffset == kNoColumn ? nullptr
+			: reinterpret_cast<MeshRendererData*>(chunk.memory + m_meshRendererOffset);
+	}
+
+private:
+	friend class ArchetypeStorage;
+
+	uint32_t m_mask = 0;
+	uint32_t m_capacity = 0;
+	size_t m_transformOffset = kNoColumn;
+	size_t m_meshRendererOffset = kNoColumn;
+	std::vector<ArchetypeChunk> m_chunks;
+};
+
+/**
+ * @class EntityQuery
+ * @brief Vista cacheada de los arquetipos que contienen una mascara de componentes.
+ *
+ * ArchetypeStorage mantiene la lista al dia: cuando se crea un arquetipo nuevo se
+ * agrega a las consultas que coinciden, y las altas y bajas de entidades no la
+ * tocan porque solo cambian el contenido de los chunks. Recorrer una consulta
+ * visita unicamente filas que coinciden, sin probar componentes por entidad.
+ */
+class
+EntityQuery {
+public:
+	explicit EntityQuery(uint32_t mask) : m_mask(mask) {}
+
+	uint32_t
+	getMask() const { return m_mask; }
+
+	/**
+	 * @brief Recorre los chunks que coinciden.
+	 * @param fn Invocado como `fn(const Archetype&, const ArchetypeChunk&)`.
+	 */
+	template<typename Fn>
+	void
+	forEachChunk(Fn&& fn) const {
+		for (const Archetype* archetype : m_archetypes) {
+			for (const ArchetypeChunk& chunk : archetype->getChunks()) {
+				fn(*archetype, chunk);
+			}
+		}
+	}
+
+	/**
+	 * @brief Recorre las entidades que coinciden.
+	 * @param fn Invocado como `fn(Entity*)`.
+	 */
+	template<typename Fn>
+	void
+	forEachEntity(Fn&& fn) const {
+		forEachChunk([&fn](const Archetype& archetype, const ArchetypeChunk& chunk) {
+			Entity* const* entities = archetype.entities(chunk);
+			for (uint32_t row = 0; row < chunk.count; ++row) {
+				fn(entities[row]);
+			}
+		});
+	}
+
+	/// Numero de entidades que coinciden (suma de filas de sus chunks).
+	size_t
+	getEntityCount() const;
+
+	size_t
+	getArchetypeCount() const { return m_archetypes.size(); }
+
+private:
+	friend class ArchetypeStorage;
+
+	uint32_t m_mask = 0;
+	std::vector<const Archetype*> m_archetypes;
+};
+
+/**
+ * @class ArchetypeStorage
+ * @brief Almacenamiento por arquetipos de las entidades de un SceneGraph.
+ *
+ * Al registrar una entidad se busca (o crea) el arquetipo de su mascara, se le
+ * asigna una fila y sus componentes Transform y MeshRendererComponent pasan a
+ * apuntar a esa fila. Cuando la mascara cambia la entidad migra de arquetipo;
+ * al quitarla, la ultima fila ocupa su hueco para mantener las columnas densas.
+ */
+class
+ArchetypeStorage {
+public:
+	ArchetypeStorage() = default;
+	~ArchetypeStorage() { clear(); }
+
+	ArchetypeStorage(const ArchetypeStorage&) = delete;
+	ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+	/**
+	 * @brief Almacena una entidad en el arquetipo de su mascara actual.
+	 */
+	void
+	add(Entity* entity);
+
+	/**
+	 * @brief Devuelve el estado a los componentes de la entidad y libera su fila.
+	 */
+	void
+	remove(Entity* entity);
+
+	/**
+	 * @brief Mueve una entidad ya almacenada al arquetipo de su nueva mascara.
+	 */
+	void
+	migrate(Entity* entity);
+
+	/**
+	 * @brief Desliga todas las entidades y libera todos los chunks.
+	 */
+	void
+	clear();
+
+	/**
+	 * @brief Consulta cacheada de las entidades con todos los componentes `Ts`.
+	 *
+	 * `query<Transform, MeshRendererComponent>()`. La referencia sigue siendo
+	 * valida (y al dia) mientras viva el almacenamiento, incluso tras clear().
+	 */
+	template<typename... Ts>
+	EntityQuery&
+	query() {
+		return getQuery((Entity::componentBit(Ts::kType) | ... | 0u));
+	}
+
+	/**
+	 * @brief Consulta cacheada por mascara; la crea la primera vez.
+	 *
+	 * Crear consultas modifica el almacenamiento: los sistemas que corren en
+	 * paralelo deben recibir consultas creadas de antemano.
+	 */
+	EntityQuery&
+	getQuery(uint32_t requiredMask);
+
+	/**
+	 * @brief Recorre los chunks de los arquetipos que contienen `requiredMask`.
+	 * @param fn Invocado como `fn(const Archetype&, const ArchetypeChunk&)`.
+	 */
+	template<typename Fn>
+	void
+	forEachChunk(uint32_t requiredMask, Fn&& fn) {
+		getQuery(requiredMask).forEachChunk(std::forward<Fn>(fn));
+	}
+
+	const std::vector<std::unique_ptr<Archetype>>&
+	getArchetypes() const { return m_archetypes; }
+
+	size_t
+	getEntityCount() const { return m_entityCount; }
+
+	size_t
+	getChunkCount() const;
+
+private:
+	uint32_t
+	getOrCreateArchetype(uint32_t mask);
+
+	void
+	insertRow(uint32_t archetypeIndex, Entity* entity);
+
+	void
+	removeRow(const EntityStorageSlot& slot);
+
+	std::vector<std::unique_ptr<Archetype>> m_archetypes;
+	std::unordered_map<uint32_t, uint32_t> m_archetypeByMask;
+	std::unordered_map<uint32_t, std::unique_ptr<EntityQuery>> m_queries;
+	size_t m_entityCount = 0;
+};
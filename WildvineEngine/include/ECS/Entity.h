@@ -8,6 +8,18 @@
 #include "Component.h"
 
 class DeviceContext;
+class ArchetypeStorage;
+class SceneGraph;
+
+/**
+ * @brief Fila que ocupa una entidad dentro de ArchetypeStorage.
+ */
+struct EntityStorageSlot {
+  ArchetypeStorage* storage = nullptr; ///< nullptr si la entidad no esta registrada.
+  uint32_t archetype = 0;
+  uint32_t chunk = 0;
+  uint32_t row = 0;
+};
 
 class 
 Entity {
@@ -15,10 +27,10 @@ public:
 	Entity() = default;
 	
 	/**
-   * @brief Destructor virtual.
+   * @brief Destructor virtual. Libera la fila de la entidad si sigue almacenada.
    */
   virtual
-  ~Entity() = default;
+  ~Entity();
 
   virtual void
   awake() = 0;
@@ -60,30 +72,82 @@ public:
   template <typename T> void 
   addComponent(EU::TSharedPointer<T> component) {
     static_assert(std::is_base_of<Component, T>::value, "T must be derived from Component");
-    m_components.push_back(component.template dynamic_pointer_cast<Component>());
+    if (!component) {
+      return;
+    }
+    // Upcast sin RTTI: comparte el mismo contador de referencias.
+    m_components.push_back(EU::TSharedPointer<Component>(component.get(), component.refCount));
+
+    // Como antes, si hay duplicados gana el primero agregado.
+    Component*& slot = m_componentTable[T::kType];
+    if (!slot) {
+      slot = component.get();
+      m_componentMask |= componentBit(T::kType);
+      onComponentMaskChanged();
+    }
   }
 
   /**
    * @brief Obtiene un componente de la entidad por su tipo.
+   *
+   * El tipo se resuelve en compilacion (`T::kType`), asi que la busqueda es un
+   * acceso a la tabla de la entidad: sin RTTI ni copias del puntero compartido.
    * @tparam T Tipo del componente a obtener.
-   * @return Puntero compartido al componente si se encuentra, nullptr en caso contrario.
+   * @return Puntero al componente (propiedad de la entidad) o nullptr si no existe.
 	 */
   template<typename T>
-  EU::TSharedPointer<T>
-  getComponent() {
-    for (auto& component : m_components) {
-      EU::TSharedPointer<T> specificComponent = component.template dynamic_pointer_cast<T>();
-      if (specificComponent) {
-        return specificComponent;
-      }
-    }
-    return EU::TSharedPointer<T>();
+  T*
+  getComponent() const {
+    static_assert(std::is_base_of<Component, T>::value, "T must be derived from Component");
+    return static_cast<T*>(m_componentTable[T::kType]);
+  }
+
+  /**
+   * @brief Indica si la entidad tiene un componente del tipo indicado.
+   */
+  template<typename T>
+  bool
+  hasComponent() const {
+    return (m_componentMask & componentBit(T::kType)) != 0;
   }
+
+  /**
+   * @brief Mascara con un bit por cada ComponentType presente en la entidad.
+   */
+  uint32_t
+  getComponentMask() const { return m_componentMask; }
+
+  static constexpr uint32_t
+  componentBit(ComponentType type) { return 1u << static_cast<uint32_t>(type); }
+
+  const EntityStorageSlot&
+  getStorageSlot() const { return m_storageSlot; }
+
+  /**
+   * @brief SceneGraph en el que esta registrada la entidad, o nullptr.
+   */
+  const SceneGraph*
+  getSceneGraph() const { return m_sceneGraph; }
+
 private:
+  friend class ArchetypeStorage;
+  friend class SceneGraph;
+
+  /**
+   * @brief Mueve la entidad al arquetipo de su nueva mascara si esta almacenada.
+   */
+  void
+  onComponentMaskChanged();
+
 protected:
   bool m_isActive;
   int m_id;
   std::vector<EU::TSharedPointer<Component>> m_components;
+  std::array<Component*, COMPONENT_TYPE_COUNT> m_componentTable{}; ///< Acceso O(1) por tipo.
+  uint32_t m_componentMask = 0;                                   ///< Bits de los tipos presentes.
+  EntityStorageSlot m_storageSlot;                                 ///< Fila en ArchetypeStorage.
+  SceneGraph* m_sceneGraph = nullptr;                              ///< Grafo que la registra.
+  uint32_t m_sceneIndex = 0;                                       ///< Posicion en SceneGraph::m_entities.
 };
 
 
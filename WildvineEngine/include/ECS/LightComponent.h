@@ -11,10 +11,12 @@
 class DeviceContext;
 
 class
-LightComponent : public Component {
+LightComponent : public Component, public EU::TPooledObject<LightComponent> {
 public:
+	static constexpr ComponentType kType = ComponentType::LIGHT; ///< Indice en la tabla de componentes.
+
 	LightComponent()
-		: Component(ComponentType::NONE) {}
+		: Component(ComponentType::LIGHT) {}
 
 	void init() override {}
 	void update(float deltaTime) override {}
@@ -11,58 +11,101 @@ class Mesh;
 class MaterialInstance;
 class DeviceContext;
 
+/**
+ * @brief Datos de MeshRendererComponent que lee el gather de render, guardados en columna.
+ */
+struct MeshRendererData {
+	Mesh* mesh = nullptr;
+	MaterialInstance* materialInstance = nullptr;
+	const std::vector<MaterialInstance*>* materialInstances = nullptr; ///< Vive en el componente.
+	bool visible = true;
+	bool castShadow = true;
+	bool isStatic = false; ///< No se mueve: el renderer cachea su sombra.
+	bool occluder = false; ///< Se rasteriza en el buffer de oclusion de CPU (necesita el BVH de la malla).
+
+	// Estado del indice espacial del SceneGraph (DynamicAABBTree)
+	int32_t spatialProxy = -1;            ///< Proxy en el indice espacial; -1 si no tiene.
+	uint32_t spatialVersion = UINT32_MAX; ///< Version del Transform con la que se actualizo la hoja.
+	const Mesh* spatialMesh = nullptr;    ///< Malla cuya caja se inserto (en su proxy o en la caja de su rama).
+	uint32_t spatialMeshRevision = 0;     ///< Mesh::getRevision() de spatialMesh al insertarla.
+};
+
+/**
+ * @class MeshRendererComponent
+ * @brief Fachada sobre un MeshRendererData; ver Transform para el esquema de binding.
+ */
 class
-MeshRendererComponent : public Component {
+MeshRendererComponent : public Component, public EU::TPooledObject<MeshRendererComponent> {
 public:
+	static constexpr ComponentType kType = ComponentType::MESH_RENDERER; ///< Indice en la tabla de componentes.
+
 	MeshRendererComponent()
-		: Component(ComponentType::MESH) {}
+		: Component(ComponentType::MESH_RENDERER), m_data(&m_localData) {
+		m_localData.materialInstances = &m_materialInstances;
+	}
+
+	MeshRendererComponent(const MeshRendererComponent&) = delete;
+	MeshRendererComponent& operator=(const MeshRendererComponent&) = delete;
 
 	void init() override {}
 	void update(float deltaTime) override {}
 	void render(DeviceContext& deviceContext) override {}
 	void destroy() override {}
 
-	void setMesh(Mesh* mesh) { m_mesh = mesh; }
-	Mesh* getMesh() const { return m_mesh; }
+	void setMesh(Mesh* mesh) { m_data->mesh = mesh; }
+	Mesh* getMesh() const { return m_data->mesh; }
 
 	void setMaterialInstance(MaterialInstance* materialInstance) {
-		m_materialInstance = materialInstance;
+		m_data->materialInstance = materialInstance;
 		m_materialInstances.clear();
 		if (materialInstance) {
 			m_materialInstances.push_back(materialInstance);
 		}
 	}
-	MaterialInstance* getMaterialInstance() const { return m_materialInstance; }
+	MaterialInstance* getMaterialInstance() const { return m_data->materialInstance; }
 
 	void setMaterialInstances(const std::vector<MaterialInstance*>& materialInstances) {
 		m_materialInstances = materialInstances;
-		m_materialInstance = m_materialInstances.empty() ? nullptr : m_materialInstances.front();
+		m_data->materialInstance = m_materialInstances.empty() ? nullptr : m_materialInstances.front();
 	}
 
 	void addMaterialInstance(MaterialInstance* materialInstance) {
 		if (!materialInstance) {
 			return;
 		}
-		if (!m_materialInstance) {
-			m_materialInstance = materialInstance;
+		if (!m_data->materialInstance) {
+			m_data->materialInstance = materialInstance;
 		}
 		m_materialInstances.push_back(materialInstance);
 	}
 
 	const std::vector<MaterialInstance*>& getMaterialInstances() const { return m_materialInstances; }
 
-	bool isVisible() const { return m_visible; }
-	void setVisible(bool visible) { m_visible = visible; }
+	bool isVisible() const { return m_data->visible; }
+	void setVisible(bool visible) { m_data->visible = visible; }
+
+	bool canCastShadow() const { return m_data->castShadow; }
+	void setCastShadow(bool value) { m_data->castShadow = value; }
+
+	bool isStatic() const { return m_data->isStatic; }
+	void setStatic(bool value) { m_data->isStatic = value; }
+
+	bool isOccluder() const { return m_data->occluder; }
+	void setOccluder(bool value) { m_data->occluder = value; }
 
-	bool canCastShadow() const { return m_castShadow; }
-	void setCastShadow(bool value) { m_castShadow = value; }
+	const MeshRendererData& getData() const { return *m_data; }
+	MeshRendererData& getData() { return *m_data; }
+	bool isStored() const { return m_data != &m_localData; }
+	void bindData(MeshRendererData* data) { m_data = data ? data : &m_localData; }
+	void unbindData() {
+		if (isStored()) {
+			m_localData = *m_data;
+			m_data = &m_localData;
+		}
+	}
 
 private:
-	Mesh* m_mesh = nullptr;
-	MaterialInstance* m_materialInstance = nullptr;
+	MeshRendererData m_localData;
+	MeshRendererData* m_data;
 	std::vector<MaterialInstance*> m_materialInstances;
-	bool m_visible = true;
-	bool m_castShadow = true;
 };
-
-
@@ -0,0 +1,116 @@
+/**
+ * @file SystemScheduler.h
+ * @brief Declara la API de SystemScheduler dentro del subsistema ECS.
+ * @ingroup ecs
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "ECS/ArchetypeStorage.h"
+#include "EngineUtilities/Utilities/JobSystem.h"
+
+/// Chunk de una consulta tal como lo reparte SystemContext::forEachChunkParallel.
+using ChunkRef = std::pair<const Archetype*, const ArchetypeChunk*>;
+
+/**
+ * @brief Datos que recibe cada sistema al ejecutarse.
+ */
+struct SystemContext {
+	float deltaTime = 0.0f;
+	ArchetypeStorage* storage = nullptr;
+	JobSystem* jobs = nullptr;
+	/// Lista de chunks del sistema en ejecucion; el scheduler la fija para reutilizarla entre frames.
+	std::vector<ChunkRef>* chunkScratch = nullptr;
+
+	/**
+	 * @brief Reparte entre los workers los chunks que coinciden con `query`.
+	 *
+	 * Cada chunk lo procesa un solo hilo, por lo que escribir en sus filas es seguro.
+	 * La lista de chunks se toma prestada de `chunkScratch` (sin reservar memoria
+	 * tras el primer frame); una llamada anidada o sin scheduler usa una propia.
+	 * @param fn Invocado como `fn(const Archetype&, const ArchetypeChunk&)`.
+	 */
+	template<typename Fn>
+	void
+	forEachChunkParallel(const EntityQuery& query, Fn&& fn) const {
+		std::vector<ChunkRef> chunks = chunkScratch ? std::move(*chunkScratch) : std::vector<ChunkRef>();
+		chunks.clear();
+		query.forEachChunk([&chunks](const Archetype& archetype, const ArchetypeChunk& chunk) {
+			chunks.emplace_back(&archetype, &chunk);
+		});
+		jobs->parallelFor(chunks.size(), 1, [&chunks, &fn](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				fn(*chunks[i].first, *chunks[i].second);
+			}
+		});
+		if (chunkScratch) {
+			*chunkScratch = std::move(chunks);
+		}
+	}
+};
+
+/**
+ * @class SystemScheduler
+ * @brief Ejecuta sistemas de actualizacion en paralelo segun los componentes que leen y escriben.
+ *
+ * Cada sistema declara una mascara de lectura y otra de escritura (bits de
+ * ComponentType). Al registrar un sistema se reconstruye el grafo de
+ * dependencias: un sistema depende de todo sistema registrado antes que escriba
+ * algo que el lee o escribe, o que lea algo que el escribe. Los sistemas sin
+ * conflicto corren a la vez en el JobSystem; run() solo reinicia los contadores.
+ *
+ * Orden determinista: dos sistemas en conflicto siempre se ejecutan en orden de
+ * registro, de modo que el resultado no depende del numero de hilos.
+ */
+class
+SystemScheduler {
+public:
+	using SystemFn = std::function<void(const SystemContext&)>;
+
+	SystemScheduler() = default;
+	~SystemScheduler() = default;
+
+	/**
+	 * @brief Registra un sistema al final del orden de ejecucion.
+	 * @param name Nombre para diagnostico.
+	 * @param readMask Componentes que el sistema lee.
+	 * @param writeMask Componentes que el sistema modifica.
+	 * @param fn Cuerpo del sistema.
+	 */
+	void
+	addSystem(const std::string& name, uint32_t readMask, uint32_t writeMask, SystemFn fn);
+
+	/**
+	 * @brief Ejecuta todos los sistemas respetando sus dependencias y espera a que terminen.
+	 */
+	void
+	run(const SystemContext& context);
+
+	void
+	clear() {
+		m_systems.clear();
+		m_remaining.reset();
+	}
+
+	size_t
+	getSystemCount() const { return m_systems.size(); }
+
+private:
+	struct System {
+		std::string name;
+		uint32_t readMask = 0;
+		uint32_t writeMask = 0;
+		SystemFn fn;
+		std::vector<uint32_t> dependents;
+		uint32_t dependencyCount = 0;
+		std::vector<ChunkRef> chunks; ///< SystemContext::chunkScratch mientras corre el sistema.
+	};
+
+	void
+	buildGraph();
+
+	void
+	launch(uint32_t index, const SystemContext& context, JobCounter& counter);
+
+	std::vector<System> m_systems;
+	std::unique_ptr<std::atomic<uint32_t>[]> m_remaining; ///< Dependencias pendientes por sistema.
+};
@@ -8,40 +8,85 @@
 #include "EngineUtilities/Vectors/Vector3.h"
 #include "Component.h"
 
+/**
+ * @brief Estado de un Transform tal como se guarda en las columnas de ArchetypeStorage.
+ */
+struct TransformData {
+  static constexpr uint32_t kLocalDirty = 1u << 0; ///< position/rotation/scale cambiaron: recalcular `matrix`.
+  static constexpr uint32_t kWorldDirty = 1u << 1; ///< Recalcular `worldMatrix` (y la de los hijos).
+
+  XMMATRIX matrix;      ///< Matriz de transformacion local (S*R*T).
+  XMMATRIX worldMatrix; ///< Matriz de transformacion world.
+  EU::Vector3 position; ///< Posicion del objeto.
+  EU::Vector3 rotation; ///< Rotacion del objeto.
+  EU::Vector3 scale;    ///< Escala del objeto.
+  uint32_t flags;       ///< kLocalDirty | kWorldDirty.
+  uint32_t version;     ///< Se incrementa cada vez que cambia `worldMatrix`.
+};
+
+/**
+ * @class Transform
+ * @brief Fachada sobre un TransformData.
+ *
+ * Mientras la entidad no esta registrada en un SceneGraph los datos viven dentro
+ * del propio componente. Al registrarse, ArchetypeStorage copia el estado a una
+ * fila de su chunk y redirige el componente hacia ella con bindData(), de modo
+ * que los sistemas recorren columnas contiguas y la API publica no cambia.
+ */
 class 
-Transform : public Component {
+Transform : public Component, public EU::TPooledObject<Transform> {
 public:
+  static constexpr ComponentType kType = ComponentType::TRANSFORM; ///< Indice en la tabla de componentes.
+
   // Constructor que inicializa posicin, rotacin y escala por defecto
-  Transform() : position(), 
-                rotation(), 
-                scale(), 
-                matrix(), 
-                worldMatrix(),
-                Component(ComponentType::TRANSFORM) {}
+  Transform() : Component(ComponentType::TRANSFORM), m_data(&m_localData) {
+    m_localData.matrix = XMMatrixIdentity();
+    m_localData.worldMatrix = XMMatrixIdentity();
+    m_localData.flags = TransformData::kLocalDirty | TransformData::kWorldDirty;
+  }
+
+  // La fachada apunta a sus propios datos: no se copia.
+  Transform(const Transform&) = delete;
+  Transform& operator=(const Transform&) = delete;
 
   // Mtodos para inicializacin, actualizacin, renderizado y destruccin
   // Inicializa el objeto Transform
   void 
   init() {
-    scale.one();
-    matrix = XMMatrixIdentity();
-    worldMatrix = XMMatrixIdentity();
+    m_data->scale.one();
+    m_data->matrix = XMMatrixIdentity();
+    m_data->worldMatrix = XMMatrixIdentity();
+    markLocalDirty();
   }
 
   // Actualiza el estado del objeto Transform basado en el tiempo transcurrido
   // @param deltaTime: Tiempo transcurrido desde la ltima actualizacin
   void 
   update(float deltaTime) override {
+    // Con almacenamiento por arquetipos el SceneGraph actualiza la columna completa.
+    if (isStored() || !(m_data->flags & TransformData::kLocalDirty)) {
+      return;
+    }
+    updateMatrices(*m_data);
+    // Sin SceneGraph no hay propagacion: world = local.
+    m_data->worldMatrix = m_data->matrix;
+    m_data->flags &= ~TransformData::kWorldDirty;
+    ++m_data->version;
+  }
+
+  // Recalcula la matriz local (scale -> rotation -> translation) y deja la world pendiente.
+  static void
+  updateMatrices(TransformData& data) {
     // Aplicar escala
-    XMMATRIX scaleMatrix = XMMatrixScaling(scale.x, scale.y, scale.z);
+    XMMATRIX scaleMatrix = XMMatrixScaling(data.scale.x, data.scale.y, data.scale.z);
     // Aplicar rotacion
-    XMMATRIX rotationMatrix = XMMatrixRotationRollPitchYaw(rotation.x, rotation.y, rotation.z);
+    XMMATRIX rotationMatrix = XMMatrixRotationRollPitchYaw(data.rotation.x, data.rotation.y, data.rotation.z);
     // Aplicar traslacion
-    XMMATRIX translationMatrix = XMMatrixTranslation(position.x, position.y, position.z);
+    XMMATRIX translationMatrix = XMMatrixTranslation(data.position.x, data.position.y, data.position.z);
 
     // Componer la matriz final en el orden: scale -> rotation -> translation
-    matrix = scaleMatrix * rotationMatrix * translationMatrix;
-    worldMatrix = matrix;
+    data.matrix = scaleMatrix * rotationMatrix * translationMatrix;
+    data.flags = (data.flags & ~TransformData::kLocalDirty) | TransformData::kWorldDirty;
   }
 
   // Renderiza el objeto Transform
@@ -56,37 +101,38 @@ public:
   // Mtodos de acceso a los datos de posicin
   // Retorna la posicin actual
   const EU::Vector3&
-  getPosition() const { return position; }
+  getPosition() const { return m_data->position; }
 
   // Establece una nueva posicin
   void 
-  setPosition(const EU::Vector3& newPos) { position = newPos; }
+  setPosition(const EU::Vector3& newPos) { m_data->position = newPos; markLocalDirty(); }
 
   // Mtodos de acceso a los datos de rotacin
   // Retorna la rotacin actual
   const EU::Vector3&
-  getRotation() const { return rotation; }
+  getRotation() const { return m_data->rotation; }
 
   // Establece una nueva rotacin
   void 
-  setRotation(const EU::Vector3& newRot) { rotation = newRot; }
+  setRotation(const EU::Vector3& newRot) { m_data->rotation = newRot; markLocalDirty(); }
 
   // Mtodos de acceso a los datos de escala
   // Retorna la escala actual
   const EU::Vector3&
-  getScale() const { return scale; }
+  getScale() const { return m_data->scale; }
 
   // Establece una nueva escala
   void 
-  setScale(const EU::Vector3& newScale) { scale = newScale; }
+  setScale(const EU::Vector3& newScale) { m_data->scale = newScale; markLocalDirty(); }
 
   void
   setTransform(const EU::Vector3& newPos, 
                const EU::Vector3& newRot,
                const EU::Vector3& newSca) {
-    position = newPos;
-    rotation = newRot;
-    scale = newSca;
+    m_data->position = newPos;
+    m_data->rotation = newRot;
+    m_data->scale = newSca;
+    markLocalDirty();
   }
 
   // Mtodo para trasladar la posicin del objeto
@@ -94,14 +140,61 @@ public:
   void 
   translate(const EU::Vector3& translation);
 
-private:
-  EU::Vector3 position;  // Posicin del objeto
-  EU::Vector3 rotation;  // Rotacin del objeto
-  EU::Vector3 scale;     // Escala del objeto
+  // Matriz de transformacin local
+  const XMMATRIX&
+  getLocalMatrix() const { return m_data->matrix; }
 
-public:
-  XMMATRIX matrix;    // Matriz de transformacin local
-  XMMATRIX worldMatrix; // Matriz de transformacin world
-};
+  // Matriz de transformacin world
+  const XMMATRIX&
+  getWorldMatrix() const { return m_data->worldMatrix; }
+
+  void
+  setWorldMatrix(const XMMATRIX& world) {
+    m_data->worldMatrix = world;
+    m_data->flags &= ~TransformData::kWorldDirty;
+    ++m_data->version;
+  }
+
+  // Marca la matriz local (y por tanto la world) para recalcular en el proximo update.
+  void
+  markLocalDirty() { m_data->flags |= TransformData::kLocalDirty | TransformData::kWorldDirty; }
+
+  // Marca solo la world, p. ej. al cambiar de padre.
+  void
+  markWorldDirty() { m_data->flags |= TransformData::kWorldDirty; }
+
+  bool
+  isWorldDirty() const { return (m_data->flags & TransformData::kWorldDirty) != 0; }
+
+  // Version de la world; quien la cachea puede saltarse el objeto si no cambio.
+  uint32_t
+  getVersion() const { return m_data->version; }
+
+  // Datos actuales (locales o fila del chunk).
+  TransformData&
+  getData() { return *m_data; }
 
+  const TransformData&
+  getData() const { return *m_data; }
 
+  // Indica si los datos viven en una columna de ArchetypeStorage.
+  bool
+  isStored() const { return m_data != &m_localData; }
+
+  // Redirige la fachada a una fila externa; el llamador ya copio el estado.
+  void
+  bindData(TransformData* data) { m_data = data ? data : &m_localData; }
+
+  // Copia el estado de la fila de vuelta al componente y se desliga del chunk.
+  void
+  unbindData() {
+    if (isStored()) {
+      m_localData = *m_data;
+      m_data = &m_localData;
+    }
+  }
+
+private:
+  TransformData m_localData{}; ///< Datos propios mientras no hay almacenamiento externo.
+  TransformData* m_data;       ///< Datos activos: m_localData o una fila de chunk.
+};
@@ -122,6 +122,30 @@ public:
     return requested;
   }
 
+  /**
+   * @brief Consume la solicitud de empaquetar los caches en el `.wvpak`.
+   * @return `true` una sola vez por peticion.
+   */
+  bool
+  consumeBuildAssetArchiveRequest() {
+    const bool requested = m_requestBuildAssetArchive;
+    m_requestBuildAssetArchive = false;
+    return requested;
+  }
+
+  /**
+   * @brief Consume el clic de seleccion sobre el viewport (fuera del gizmo).
+   * @param outPosition Pixel del clic relativo a la esquina superior izquierda del viewport.
+   * @return `true` una sola vez por clic.
+   */
+  bool
+  consumeViewportPick(ImVec2& outPosition) {
+    const bool requested = m_requestViewportPick;
+    m_requestViewportPick = false;
+    outPosition = m_viewportPickPosition;
+    return requested;
+  }
+
 private:
 
   bool checkboxValue = true;
@@ -131,6 +155,9 @@ private:
 
   bool show_exit_popup = false; // Variable de estado para el popup
   bool m_requestSaveScene = false;
+  bool m_requestBuildAssetArchive = false;
+  bool m_requestViewportPick = false;
+  ImVec2 m_viewportPickPosition = ImVec2(0.0f, 0.0f);
   ImDrawList* m_viewportDrawList = nullptr;
   bool m_viewportActive = false;
 
@@ -141,6 +168,8 @@ public:
   ImVec2 m_viewportSize = ImVec2(0.0f, 0.0f);///< Tamano actual del viewport del editor.
   bool m_viewportHovered = false;            ///< Indica si el cursor esta sobre el viewport.
   bool m_viewportFocused = false;            ///< Indica si el viewport tiene foco de entrada.
+  int64_t m_lastPickUs = -1;                 ///< Duracion del ultimo pick del viewport en microsegundos (-1 sin pick).
+  uint32_t m_lastPickCandidates = 0;         ///< Mallas recorridas por el ultimo pick.
 };
 
 
@@ -0,0 +1,349 @@
+/**
+ * @file TFrameArena.h
+ * @brief Declara la API de TFrameArena dentro del subsistema Memory.
+ * @ingroup memory
+ */
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace EU {
+	/**
+	 * @brief Estadisticas de un LinearArena o de un TFrameArena.
+	 */
+	struct ArenaStats {
+		size_t usedBytes = 0;         ///< Bytes entregados desde el ultimo reset().
+		size_t peakBytes = 0;         ///< Maximo de usedBytes alcanzado en un frame.
+		size_t capacity = 0;          ///< Bytes reservados en los bloques.
+		size_t blockCount = 0;        ///< Bloques vivos.
+		uint64_t heapAllocations = 0; ///< Bloques pedidos al sistema, acumulados: no crece en estado estable.
+	};
+
+	/**
+	 * @brief Vista no propietaria de `size` elementos contiguos.
+	 */
+	template<typename T>
+	class TSpan
+	{
+	public:
+		TSpan() = default;
+		TSpan(T* data, size_t size) : m_data(data), m_size(size) {}
+
+		T* begin() const { return m_data; }
+		T* end() const { return m_data + m_size; }
+		T* data() const { return m_data; }
+		size_t size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+		T& front() const { return m_data[0]; }
+		T& operator[](size_t index) const { return m_data[index]; }
+
+	private:
+		T* m_data = nullptr;
+		size_t m_size = 0;
+	};
+
+	/**
+	 * @brief Asignador lineal: entrega memoria avanzando un puntero y la libera toda en reset().
+	 *
+	 * Al crecer pide un bloque de al menos `blockSize` bytes y de la capacidad que
+	 * ya tiene, asi la capacidad se duplica. Si un frame necesito mas de un bloque,
+	 * reset() los reemplaza por uno solo con la capacidad total y desde el frame
+	 * siguiente no vuelve a tocar el heap mientras la carga no crezca. No llama
+	 * destructores ni es seguro entre hilos.
+	 */
+	class LinearArena
+	{
+	public:
+		static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+		explicit LinearArena(size_t blockSize = kDefaultBlockSize) : m_blockSize(blockSize) {}
+
+		~LinearArena()
+		{
+			releaseBlocks();
+		}
+
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+
+		/**
+		 * @brief Devuelve `size` bytes sin inicializar alineados a `alignment` (potencia de dos).
+		 */
+		void* allocate(size_t size, size_t alignment)
+		{
+			uintptr_t address = alignUp(m_cursor, alignment);
+			if (!m_blocks || address + size > m_limit)
+			{
+				addBlock(size + alignment);
+				address = alignUp(m_cursor, alignment);
+			}
+			m_cursor = address + size;
+			m_stats.usedBytes += size;
+			if (m_stats.usedBytes > m_stats.peakBytes)
+			{
+				m_stats.peakBytes = m_stats.usedBytes;
+			}
+			return reinterpret_cast<void*>(address);
+		}
+
+		/**
+		 * @brief Memoria sin construir para `count` objetos T.
+		 */
+		template<typename T>
+		T* allocateArray(size_t count)
+		{
+			return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		/**
+		 * @brief Copia `count` elementos en el arena y devuelve la vista de la copia.
+		 */
+		template<typename T>
+		TSpan<T> copy(const T* source, size_t count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "El arena no llama destructores");
+			if (count == 0)
+			{
+				return TSpan<T>();
+			}
+			T* data = allocateArray<T>(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				new (data + i) T(source[i]);
+			}
+			return TSpan<T>(data, count);
+		}
+
+		/**
+		 * @brief Invalida todo lo entregado y junta los bloques en uno si hubo mas de uno.
+		 */
+		void reset()
+		{
+			if (m_blocks && m_blocks->next)
+			{
+				const size_t capacity = m_stats.capacity;
+				releaseBlocks();
+				addBlock(capacity);
+			}
+			else if (m_blocks)
+			{
+				m_cursor = m_blocks->begin();
+			}
+			m_stats.usedBytes = 0;
+		}
+
+		const ArenaStats& getStats() const { return m_stats; }
+
+	private:
+		/// Cabecera al inicio de cada bloque; los datos van detras.
+		struct Block
+		{
+			Block* next;
+			size_t size;
+
+			uintptr_t begin() const { return reinterpret_cast<uintptr_t>(this + 1); }
+		};
+
+		static uintptr_t alignUp(uintptr_t address, size_t alignment)
+		{
+			return (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+		}
+
+		void addBlock(size_t minimumSize)
+		{
+			// Crece al menos al doble: pocos bloques por frame y margen tras juntarlos
+			size_t size = m_stats.capacity > m_blockSize ? m_stats.capacity : m_blockSize;
+			size = minimumSize > size ? minimumSize : size;
+			Block* block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+			block->next = m_blocks;
+			block->size = size;
+			m_blocks = block;
+			m_cursor = block->begin();
+			m_limit = m_cursor + size;
+
+			m_stats.capacity += size;
+			++m_stats.blockCount;
+			++m_stats.heapAllocations;
+		}
+
+		void releaseBlocks()
+		{
+			while (m_blocks)
+			{
+				Block* next = m_blocks->next;
+				::operator delete(m_blocks);
+				m_blocks = next;
+			}
+			m_cursor = 0;
+			m_limit = 0;
+			m_stats.capacity = 0;
+			m_stats.blockCount = 0;
+		}
+
+		size_t m_blockSize;
+		Block* m_blocks = nullptr; ///< Bloque actual primero; los anteriores ya estan llenos.
+		uintptr_t m_cursor = 0;
+		uintptr_t m_limit = 0;
+		ArenaStats m_stats;
+	};
+
+	/**
+	 * @brief Arreglo que crece dentro de un LinearArena.
+	 *
+	 * Al quedarse sin capacidad copia sus elementos a un tramo del doble de tamano;
+	 * el tramo anterior se recupera en el reset() del arena. Pensado para colas
+	 * que se rehacen cada frame: reset() con el tamano del frame anterior evita
+	 * crecer a mitad de frame.
+	 */
+	template<typename T>
+	class TArenaArray
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "El arena no llama destructores");
+
+	public:
+		/**
+		 * @brief Vacia el arreglo y lo asocia a `arena`, reservando `reserveCount` elementos.
+		 */
+		void reset(LinearArena* arena, size_t reserveCount = 0)
+		{
+			m_arena = arena;
+			m_data = nullptr;
+			m_size = 0;
+			m_capacity = 0;
+			if (reserveCount > 0)
+			{
+				grow(reserveCount);
+			}
+		}
+
+		void push_back(const T& value)
+		{
+			if (m_size == m_capacity)
+			{
+				grow(m_capacity > 0 ? m_capacity * 2 : 16);
+			}
+			new (m_data + m_size) T(value);
+			++m_size;
+		}
+
+		/// Conserva el tramo actual y su capacidad.
+		void clear() { m_size = 0; }
+
+		T* begin() { return m_data; }
+		T* end() { return m_data + m_size; }
+		const T* begin() const { return m_data; }
+		const T* end() const { return m_data + m_size; }
+		T* data() { return m_data; }
+		const T* data() const { return m_data; }
+		size_t size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+		T& front() { return m_data[0]; }
+		const T& front() const { return m_data[0]; }
+		T& operator[](size_t index) { return m_data[index]; }
+		const T& operator[](size_t index) const { return m_data[index]; }
+
+		operator TSpan<const T>() const { return TSpan<const T>(m_data, m_size); }
+
+	private:
+		void grow(size_t capacity)
+		{
+			T* data = m_arena->allocateArray<T>(capacity);
+			for (size_t i = 0; i < m_size; ++i)
+			{
+				new (data + i) T(m_data[i]);
+			}
+			m_data = data;
+			m_capacity = capacity;
+		}
+
+		LinearArena* m_arena = nullptr;
+		T* m_data = nullptr;
+		size_t m_size = 0;
+		size_t m_capacity = 0;
+	};
+
+	/**
+	 * @brief Anillo de `FrameCount` LinearArena: uno por frame en vuelo.
+	 *
+	 * beginFrame() pasa al siguiente arena y lo reinicia, de modo que lo asignado
+	 * en los `FrameCount - 1` frames anteriores sigue siendo valido mientras se
+	 * prepara el actual.
+	 */
+	template<size_t FrameCount = 2>
+	class TFrameArena
+	{
+		static_assert(FrameCount >= 1, "Se necesita al menos un arena");
+
+	public:
+		TFrameArena() = default;
+		TFrameArena(const TFrameArena&) = delete;
+		TFrameArena& operator=(const TFrameArena&) = delete;
+
+		/**
+		 * @brief Avanza al arena del siguiente frame y lo reinicia.
+		 */
+		LinearArena& beginFrame()
+		{
+			m_frame = (m_frame + 1) % FrameCount;
+			m_arenas[m_frame].reset();
+			return m_arenas[m_frame];
+		}
+
+		LinearArena& current() { return m_arenas[m_frame]; }
+		const LinearArena& current() const { return m_arenas[m_frame]; }
+
+		/**
+		 * @brief Uso del frame actual; capacidad, bloques y peticiones al heap de todo el anillo.
+		 */
+		ArenaStats getStats() const
+		{
+			ArenaStats stats = current().getStats();
+			stats.capacity = 0;
+			stats.blockCount = 0;
+			stats.heapAllocations = 0;
+			for (size_t i = 0; i < FrameCount; ++i)
+			{
+				const ArenaStats& frameStats = m_arenas[i].getStats();
+				stats.peakBytes = frameStats.peakBytes > stats.peakBytes ? frameStats.peakBytes : stats.peakBytes;
+				stats.capacity += frameStats.capacity;
+				stats.blockCount += frameStats.blockCount;
+				stats.heapAllocations += frameStats.heapAllocations;
+			}
+			return stats;
+		}
+
+	private:
+		LinearArena m_arenas[FrameCount];
+		size_t m_frame = 0;
+	};
+}
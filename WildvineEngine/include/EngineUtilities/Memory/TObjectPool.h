@@ -0,0 +1,330 @@
+/**
+ * @file TObjectPool.h
+ * @brief Declara la API de TObjectPool dentro del subsistema Memory.
+ * @ingroup memory
+ */
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace EU {
+	/**
+	 * @brief Estadisticas de un TObjectPool.
+	 */
+	struct PoolStats {
+		size_t liveCount = 0;       ///< Objetos vivos.
+		size_t peakCount = 0;       ///< Maximo de objetos vivos a la vez.
+		size_t capacity = 0;        ///< Slots reservados (vivos + libres).
+		size_t blockCount = 0;      ///< Bloques pedidos al sistema.
+		uint64_t allocations = 0;   ///< Llamadas a allocate() acumuladas.
+		uint64_t deallocations = 0; ///< Llamadas a deallocate() acumuladas.
+	};
+
+	/**
+	 * @brief Pool de memoria para objetos de un solo tipo.
+	 *
+	 * Reserva bloques de `SlotsPerBlock` slots del tamano y alineacion de T y
+	 * reutiliza los slots libres mediante una lista enlazada intrusiva, de modo
+	 * que crear y destruir objetos no toca el heap global salvo al crecer.
+	 * Los bloques se conservan hasta shrink(); el pool global no se destruye.
+	 *
+	 * Cada hilo guarda su propia lista de slots libres: allocate() y deallocate()
+	 * no toman ningun lock mientras esa lista tenga slots o no crezca demasiado.
+	 * Solo al vaciarse o llenarse se mueven kCacheBatch slots con la lista
+	 * compartida bajo el mutex, asi los workers del JobSystem no se serializan.
+	 *
+	 * Hay una sola instancia por tipo (getInstance()): las listas por hilo son
+	 * estaticas del tipo. El pool solo gestiona memoria: el llamador construye
+	 * y destruye el objeto.
+	 */
+	template<typename T, size_t SlotsPerBlock = 256>
+	class TObjectPool
+	{
+	public:
+		static constexpr size_t kCacheBatch = 32; ///< Slots que un hilo toma o devuelve por lote.
+
+		TObjectPool(const TObjectPool&) = delete;
+		TObjectPool& operator=(const TObjectPool&) = delete;
+
+		/**
+		 * @brief Pool global del tipo T.
+		 *
+		 * No se destruye nunca: asi los objetos liberados por otros estaticos al
+		 * cerrar el programa, y las listas de los hilos que terminan, no dependen
+		 * del orden de destruccion.
+		 */
+		static TObjectPool& getInstance()
+		{
+			static TObjectPool* instance = new TObjectPool();
+			return *instance;
+		}
+
+		/**
+		 * @brief Devuelve memoria sin construir para un objeto T.
+		 */
+		void* allocate()
+		{
+			ThreadCache& cache = threadCache();
+			if (!cache.head)
+			{
+				refill(cache);
+			}
+			Slot* slot = cache.head;
+			cache.head = slot->next;
+			--cache.count;
+
+			const uint64_t allocations = m_allocations.fetch_add(1, std::memory_order_relaxed) + 1;
+			const uint64_t deallocations = m_deallocations.load(std::memory_order_relaxed);
+			const uint64_t live = allocations > deallocations ? allocations - deallocations : 0;
+			uint64_t peak = m_peakCount.load(std::memory_order_relaxed);
+			while (live > peak && !m_peakCount.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+			{
+			}
+			return slot;
+		}
+
+		/**
+		 * @brief Devuelve un slot al pool. El objeto ya debe estar destruido.
+		 */
+		void deallocate(void* memory)
+		{
+			if (!memory)
+			{
+				return;
+			}
+			ThreadCache& cache = threadCache();
+			Slot* slot = static_cast<Slot*>(memory);
+			slot->next = cache.head;
+			cache.head = slot;
+			++cache.count;
+			m_deallocations.fetch_add(1, std::memory_order_relaxed);
+
+			// Un hilo que solo libera (p. ej. destruye lo que otro creo) devuelve lotes
+			if (cache.count >= 2 * kCacheBatch)
+			{
+				flush(cache, kCacheBatch);
+			}
+		}
+
+		/**
+		 * @brief Garantiza al menos `count` slots libres (creacion masiva sin crecer a mitad).
+		 */
+		void reserve(size_t count)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			while (m_freeCount < count)
+			{
+				addBlock();
+			}
+		}
+
+		/**
+		 * @brief Libera todos los bloques si no queda ningun objeto vivo.
+		 *
+		 * Devuelve antes los slots de la lista del hilo que llama; si otro hilo
+		 * aun guarda slots en la suya, la memoria no se puede liberar.
+		 * @return `true` si la memoria se devolvio al sistema.
+		 */
+		bool shrink()
+		{
+			flush(threadCache(), 0);
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_freeCount != m_capacity)
+			{
+				return false;
+			}
+			releaseBlocks();
+			return true;
+		}
+
+		PoolStats getStats() const
+		{
+			PoolStats stats;
+			stats.allocations = m_allocations.load(std::memory_order_relaxed);
+			stats.deallocations = m_deallocations.load(std::memory_order_relaxed);
+			stats.liveCount = stats.allocations > stats.deallocations ?
+				static_cast<size_t>(stats.allocations - stats.deallocations) : 0;
+			stats.peakCount = static_cast<size_t>(m_peakCount.load(std::memory_order_relaxed));
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			stats.capacity = m_capacity;
+			stats.blockCount = m_blocks.size();
+			return stats;
+		}
+
+	private:
+		union Slot
+		{
+			Slot* next;
+			alignas(T) unsigned char storage[sizeof(T)];
+		};
+
+		/// Slots libres de un hilo; al terminar el hilo vuelven a la lista compartida.
+		struct ThreadCache
+		{
+			Slot* head = nullptr;
+			size_t count = 0;
+
+			~ThreadCache()
+			{
+				getInstance().flush(*this, 0);
+			}
+		};
+
+		TObjectPool() = default;
+
+		static ThreadCache& threadCache()
+		{
+			static thread_local ThreadCache cache;
+			return cache;
+		}
+
+		/// Pasa un lote de la lista compartida a la del hilo, creciendo si hace falta.
+		void refill(ThreadCache& cache)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_freeList)
+			{
+				addBlock();
+			}
+			for (size_t i = 0; i < kCacheBatch && m_freeList; ++i)
+			{
+				Slot* slot = m_freeList;
+				m_freeList = slot->next;
+				slot->next = cache.head;
+				cache.head = slot;
+				++cache.count;
+				--m_freeCount;
+			}
+		}
+
+		/// Devuelve a la lista compartida los slots del hilo que excedan `keep`.
+		void flush(ThreadCache& cache, size_t keep)
+		{
+			if (cache.count <= keep)
+			{
+				return;
+			}
+			std::lock_guard<std::mutex> lock(m_mutex);
+			while (cache.count > keep)
+			{
+				Slot* slot = cache.head;
+				cache.head = slot->next;
+				--cache.count;
+				slot->next = m_freeList;
+				m_freeList = slot;
+				++m_freeCount;
+			}
+		}
+
+		void addBlock()
+		{
+			Slot* block = static_cast<Slot*>(
+				::operator new(sizeof(Slot) * SlotsPerBlock, std::align_val_t(alignof(Slot))));
+			// Encadenar en orden para que los objetos consecutivos queden contiguos.
+			for (size_t i = 0; i < SlotsPerBlock; ++i)
+			{
+				block[i].next = (i + 1 < SlotsPerBlock) ? &block[i + 1] : m_freeList;
+			}
+			m_freeList = block;
+			m_blocks.push_back(block);
+			m_capacity += SlotsPerBlock;
+			m_freeCount += SlotsPerBlock;
+		}
+
+		void releaseBlocks()
+		{
+			for (Slot* block : m_blocks)
+			{
+				::operator delete(block, std::align_val_t(alignof(Slot)));
+			}
+			m_blocks.clear();
+			m_freeList = nullptr;
+			m_capacity = 0;
+			m_freeCount = 0;
+		}
+
+		// Lista compartida y bloques, protegidos por m_mutex
+		std::vector<Slot*> m_blocks;
+		Slot* m_freeList = nullptr;
+		size_t m_capacity = 0;  ///< Slots reservados en los bloques.
+		size_t m_freeCount = 0; ///< Slots en m_freeList (no cuenta los de las listas de los hilos).
+		mutable std::mutex m_mutex;
+
+		// Contadores sin lock
+		std::atomic<uint64_t> m_allocations{ 0 };
+		std::atomic<uint64_t> m_deallocations{ 0 };
+		std::atomic<uint64_t> m_peakCount{ 0 };
+	};
+
+	/**
+	 * @brief Hace que `new`/`delete` de T (exactamente T) usen TObjectPool<T>.
+	 *
+	 * Se hereda como base vacia: `class Transform : public Component, public EU::TPooledObject<Transform>`.
+	 * Las clases derivadas de T, con otro tamano, vuelven al heap global.
+	 */
+	template<typename T>
+	class TPooledObject
+	{
+	public:
+		static void* operator new(size_t size)
+		{
+			if (size != sizeof(T))
+			{
+				return ::operator new(size);
+			}
+			return TObjectPool<T>::getInstance().allocate();
+		}
+
+		static void operator delete(void* memory, size_t size)
+		{
+			if (size != sizeof(T))
+			{
+				::operator delete(memory);
+				return;
+			}
+			TObjectPool<T>::getInstance().deallocate(memory);
+		}
+
+		static PoolStats getPoolStats()
+		{
+			return TObjectPool<T>::getInstance().getStats();
+		}
+
+	protected:
+		TPooledObject() = default;
+		~TPooledObject() = default;
+	};
+}
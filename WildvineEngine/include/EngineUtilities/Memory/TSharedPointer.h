@@ -32,8 +32,29 @@
  * SOFTWARE.
 */
 #pragma once
+#include <type_traits>
+#include "TObjectPool.h"
 
 namespace EU {
+	/// Pool compartido por los contadores de referencias de todos los TSharedPointer.
+	using RefCountPool = TObjectPool<int, 1024>;
+
+	/**
+	 * @brief Crea un contador de referencias (valor 1) desde RefCountPool.
+	 */
+	inline int* AllocateRefCount()
+	{
+		return new (RefCountPool::getInstance().allocate()) int(1);
+	}
+
+	/**
+	 * @brief Devuelve un contador de referencias a RefCountPool.
+	 */
+	inline void ReleaseRefCount(int* refCount)
+	{
+		RefCountPool::getInstance().deallocate(refCount);
+	}
+
 	/**
 	 * @brief Clase TSharedPointer para manejar la gestin de memoria compartida.
 	 *
@@ -57,7 +78,7 @@ namespace EU {
 		 *
 		 * @param rawPtr Puntero crudo al objeto que se va a gestionar.
 		 */
-		explicit TSharedPointer(T* rawPtr) : ptr(rawPtr), refCount(new int(1)) {}
+		explicit TSharedPointer(T* rawPtr) : ptr(rawPtr), refCount(AllocateRefCount()) {}
 
 		/**
 		 * @brief Constructor desde un puntero crudo y un recuento de referencias.
@@ -120,7 +141,7 @@ namespace EU {
 				if (refCount && --(*refCount) == 0)
 				{
 					delete ptr;
-					delete refCount;
+					ReleaseRefCount(refCount);
 				}
 				// Copiar datos del otro puntero compartido
 				ptr = other.ptr;
@@ -150,7 +171,7 @@ namespace EU {
 				if (refCount && --(*refCount) == 0)
 				{
 					delete ptr;
-					delete refCount;
+					ReleaseRefCount(refCount);
 				}
 				// Transferir los datos del otro puntero compartido
 				ptr = other.ptr;
@@ -172,7 +193,7 @@ namespace EU {
 			if (refCount && --(*refCount) == 0)
 			{
 				delete ptr;
-				delete refCount;
+				ReleaseRefCount(refCount);
 			}
 		}
 
@@ -244,7 +265,7 @@ namespace EU {
 			if (refCount && --(*refCount) == 0)
 			{
 				delete ptr;
-				delete refCount;
+				ReleaseRefCount(refCount);
 			}
 
 			// Si newPtr es nullptr, asignar nullptr al puntero y recuento de referencias
@@ -257,7 +278,7 @@ namespace EU {
 			{
 				// Asignar nuevo objeto y manejar el recuento de referencias
 				ptr = newPtr;
-				refCount = new int(1);
+				refCount = AllocateRefCount();
 			}
 		}
 
@@ -291,6 +312,32 @@ namespace EU {
 	{
 		return TSharedPointer<T>(new T(args...));
 	}
+
+	/**
+	 * @brief Crea `count` objetos de tipo T de una sola vez.
+	 *
+	 * Reserva antes el pool del tipo (si T usa TPooledObject) y el de contadores,
+	 * de modo que la creacion masiva no crece bloque a bloque. Para destruirlos
+	 * en bloque basta con vaciar el vector.
+	 *
+	 * @param count Numero de objetos.
+	 * @param out Vector al que se agregan los punteros.
+	 * @param args Argumentos del constructor, iguales para todos.
+	 */
+	template<typename T, typename... Args>
+	void MakeSharedBulk(size_t count, std::vector<TSharedPointer<T>>& out, Args... args)
+	{
+		if constexpr (std::is_base_of<TPooledObject<T>, T>::value)
+		{
+			TObjectPool<T>::getInstance().reserve(count);
+		}
+		RefCountPool::getInstance().reserve(count);
+		out.reserve(out.size() + count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			out.push_back(MakeShared<T>(args...));
+		}
+	}
 }
 
 
@@ -118,6 +118,21 @@ public:
 	XMMATRIX 
 	getProj() const { return XMLoadFloat4x4(&m_proj); }
 
+	/**
+	 * @brief Rayo en mundo que pasa por un pixel del viewport.
+	 *
+	 * **Pasos**
+	 * - Convierte el pixel (origen arriba a la izquierda) a NDC.
+	 * - Escala por tan(fovY / 2) y el aspect para obtener la direccion en vista.
+	 * - La lleva a mundo con la inversa de View.
+	 *
+	 * **Aplicacion practica**
+	 * - Picking del editor: el origen es la posicion de la camara.
+	 */
+	void
+	screenPointToRay(float x, float y, float width, float height,
+	                 XMFLOAT3& outOrigin, XMFLOAT3& outDirection) const;
+
 	/**
 	 * @brief View sin traslacin (solo rotacin). Ideal para Skybox.
 	 *
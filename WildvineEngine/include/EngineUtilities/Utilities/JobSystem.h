@@ -0,0 +1,125 @@
+/**
+ * @file JobSystem.h
+ * @brief Declara la API de JobSystem dentro del subsistema Utilities.
+ * @ingroup utilities
+ */
+#pragma once
+#include "Prerequisites.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+/**
+ * @brief Contador de trabajos pendientes; JobSystem::wait() espera a que llegue a cero.
+ */
+struct JobCounter {
+	std::atomic<int> pending{ 0 };
+};
+
+/**
+ * @class JobSystem
+ * @brief Pool de hilos con colas por hilo y robo de trabajo (work stealing).
+ *
+ * Cada worker toma trabajo de su propia cola por el final (LIFO, datos calientes)
+ * y, si esta vacia, roba del principio de las colas de los demas. Los hilos que no
+ * son workers (el hilo principal) comparten la cola 0. wait() no bloquea: el hilo
+ * que espera ejecuta trabajos pendientes, de modo que un trabajo puede lanzar y
+ * esperar otros sin interbloqueos.
+ *
+ * Sin workers (init(0) en una maquina de un nucleo, o antes de init) todo se ejecuta
+ * en el hilo que llama a wait(), con el mismo resultado.
+ */
+class
+JobSystem {
+public:
+	using Job = std::function<void()>;
+
+	JobSystem() = default;
+	~JobSystem() { destroy(); }
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	static JobSystem& getInstance() {
+		static JobSystem instance;
+		return instance;
+	}
+
+	/**
+	 * @brief Arranca los workers.
+	 * @param workerCount Numero de hilos; 0 usa `hardware_concurrency() - 1`.
+	 */
+	void
+	init(uint32_t workerCount = 0);
+
+	/**
+	 * @brief Ejecuta lo que quede en las colas y detiene los workers.
+	 */
+	void
+	destroy();
+
+	uint32_t
+	getWorkerCount() const { return static_cast<uint32_t>(m_threads.size()); }
+
+	/**
+	 * @brief Encola un trabajo e incrementa `counter`; se decrementa al terminar.
+	 */
+	void
+	schedule(Job job, JobCounter& counter);
+
+	/**
+	 * @brief Ejecuta trabajos pendientes hasta que `counter` llegue a cero.
+	 */
+	void
+	wait(JobCounter& counter);
+
+	/**
+	 * @brief Divide `[0, count)` en rangos de `grain` elementos y los reparte.
+	 * @param fn Invocado como `fn(begin, end)`; los rangos no se solapan.
+	 */
+	template<typename Fn>
+	void
+	parallelFor(size_t count, size_t grain, Fn&& fn) {
+		grain = (std::max)(grain, static_cast<size_t>(1));
+		if (m_threads.empty() || count <= grain) {
+			if (count > 0) {
+				fn(static_cast<size_t>(0), count);
+			}
+			return;
+		}
+
+		JobCounter counter;
+		for (size_t begin = 0; begin < count; begin += grain) {
+			const size_t end = (std::min)(begin + grain, count);
+			schedule([&fn, begin, end]() { fn(begin, end); }, counter);
+		}
+		wait(counter);
+	}
+
+private:
+	struct QueuedJob {
+		Job job;
+		JobCounter* counter = nullptr;
+	};
+
+	struct WorkerQueue {
+		std::mutex mutex;
+		std::deque<QueuedJob> jobs;
+	};
+
+	bool
+	tryRunJob(uint32_t queueIndex);
+
+	void
+	workerLoop(uint32_t queueIndex);
+
+	std::vector<std::unique_ptr<WorkerQueue>> m_queues; ///< 0 = hilos externos, 1..N = workers.
+	std::vector<std::thread> m_threads;
+	std::atomic<bool> m_running{ false };
+	std::atomic<int> m_queuedJobs{ 0 };
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wake;
+};
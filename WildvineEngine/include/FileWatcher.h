@@ -0,0 +1,91 @@
+/**
+ * @file FileWatcher.h
+ * @brief Declara la API de FileWatcher dentro del subsistema Core.
+ * @ingroup core
+ */
+#pragma once
+#include "Prerequisites.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+/**
+ * @brief Cambio detectado sobre un archivo vigilado.
+ */
+struct FileChange {
+	std::string path;                                             ///< Ruta tal como se registro en watch().
+	std::chrono::high_resolution_clock::time_point detectedAt;    ///< Momento en que el hilo vigilante lo detecto.
+};
+
+/**
+ * @class FileWatcher
+ * @brief Vigila archivos en un hilo de fondo y encola los que cambian.
+ *
+ * Usa las notificaciones de cambio de directorio de Win32 para despertar en cuanto
+ * algo se escribe y, como respaldo, sondea los tiempos de escritura cada
+ * `pollIntervalMs`. Un archivo solo se reporta cuando su tiempo de escritura se
+ * mantiene estable durante un ciclo, para no leer archivos a medio guardar.
+ */
+class
+FileWatcher {
+public:
+	FileWatcher() = default;
+	~FileWatcher() { stop(); }
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	/**
+	 * @brief Arranca el hilo vigilante.
+	 * @param pollIntervalMs Periodo maximo entre escaneos de tiempos de escritura.
+	 */
+	void
+	start(unsigned int pollIntervalMs = 250);
+
+	/**
+	 * @brief Detiene y une el hilo vigilante.
+	 */
+	void
+	stop();
+
+	/**
+	 * @brief Agrega un archivo a la lista vigilada. Puede llamarse con el hilo activo.
+	 * @param path Ruta del archivo.
+	 */
+	void
+	watch(const std::string& path);
+
+	/**
+	 * @brief Mueve los cambios pendientes a `outChanges` (pensado para el hilo principal).
+	 */
+	void
+	consumeChanges(std::vector<FileChange>& outChanges);
+
+private:
+	struct WatchedFile {
+		std::string path;
+		ULONGLONG knownWriteTime = 0;    ///< Ultimo tiempo ya reportado.
+		ULONGLONG pendingWriteTime = 0;  ///< Tiempo visto en el escaneo anterior, aun sin reportar.
+	};
+
+	void
+	run();
+
+	void
+	scanFiles();
+
+	void
+	rebuildNotifications(std::vector<HANDLE>& handles);
+
+	std::vector<WatchedFile> m_files;
+	std::vector<std::string> m_directories;
+	bool m_directoriesDirty = false;
+	std::mutex m_filesMutex;
+
+	std::vector<FileChange> m_changes;
+	std::mutex m_changesMutex;
+
+	std::thread m_thread;
+	std::atomic<bool> m_running{ false };
+	unsigned int m_pollIntervalMs = 250;
+};
@@ -20,8 +20,10 @@ class DeviceContext;
  * - Contadores de vrtices e ndices.
  */
 class 
-MeshComponent : public Component {
+MeshComponent : public Component, public EU::TPooledObject<MeshComponent> {
 public:
+  static constexpr ComponentType kType = ComponentType::MESH; ///< Indice en la tabla de componentes.
+
   /**
    * @brief Constructor por defecto.
    *
@@ -7,6 +7,7 @@
 #include "Prerequisites.h"
 #include "IResource.h"
 #include "MeshComponent.h"
+#include "Rendering/TriangleBVH.h"
 #include "fbxsdk.h"
 
 enum 
@@ -51,6 +52,10 @@ public:
 	const std::vector<MeshComponent>& 
 	GetMeshes() const { return m_meshes; }
 
+	/// BVH de triangulos de todas las mallas (una submalla por MeshComponent); se guarda en el .wvmesh.
+	const std::shared_ptr<const TriangleBVH>&
+	GetTriangleBVH() const { return m_triangleBVH; }
+
 	/* FBX MODEL LOADER*/
 	bool
 	InitializeFBXManager();
@@ -73,16 +78,25 @@ public:
 	std::vector<std::string> 
   GetTextureFileNames() const { return textureFileNames; }
 
+	/// Olvida la copia en memoria de un modelo para que el siguiente load() relea
+	/// el archivo fuente (o su .wvmesh si sigue vigente). Lo usa la recarga en caliente.
+	static void
+	EvictFromMemoryCache(const std::string& path);
+
 private:
+	bool ImportModel();
 	std::string GetBinaryCachePath() const;
 	bool IsBinaryCacheUpToDate(const std::string& sourcePath, const std::string& cachePath) const;
 	bool LoadBinaryCache(const std::string& cachePath);
+	bool ParseBinaryCache(const unsigned char* data, size_t size);
 	bool SaveBinaryCache(const std::string& cachePath) const;
+	void BuildTriangleBVH();
 
 private:
 	FbxManager* lSdkManager;
 	FbxScene* lScene;
 	std::vector<std::string> textureFileNames;
+	std::shared_ptr<const TriangleBVH> m_triangleBVH;
 public:
 	ModelType m_modelType;
 	std::vector<MeshComponent> m_meshes;
@@ -128,7 +128,10 @@ ComponentType {
   TRANSFORM = 1,///< Componente de transformacin.
   MESH = 2,     ///< Componente de malla.
   MATERIAL = 3,  ///< Componente de material.
-	HIERARCHY = 4 ///< Componente de jerarqua.
+	HIERARCHY = 4, ///< Componente de jerarqua.
+	MESH_RENDERER = 5, ///< Componente de render de malla.
+	LIGHT = 6,    ///< Componente de luz.
+	COMPONENT_TYPE_COUNT ///< Numero de tipos; tamano de la tabla de componentes por entidad.
 };
 
 
@@ -0,0 +1,139 @@
+/**
+ * @file Bounds.h
+ * @brief Declara la API de Bounds dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#pragma once
+#include "Prerequisites.h"
+#include <algorithm>
+#include <cfloat>
+
+/**
+ * @struct Bounds
+ * @brief Caja alineada a ejes expresada como centro y semiextension.
+ *
+ * Una caja con extension negativa es "vacia": no se ha calculado, y quien la
+ * consulte debe tratarla como visible.
+ */
+struct
+Bounds {
+	XMFLOAT3 center = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	XMFLOAT3 extents = XMFLOAT3(-1.0f, -1.0f, -1.0f); ///< Semiextension por eje.
+
+	bool
+	isValid() const { return extents.x >= 0.0f; }
+
+	static Bounds
+	fromMinMax(const XMFLOAT3& minPoint, const XMFLOAT3& maxPoint) {
+		Bounds bounds;
+		bounds.center = XMFLOAT3((minPoint.x + maxPoint.x) * 0.5f,
+		                         (minPoint.y + maxPoint.y) * 0.5f,
+		                         (minPoint.z + maxPoint.z) * 0.5f);
+		bounds.extents = XMFLOAT3((maxPoint.x - minPoint.x) * 0.5f,
+		                          (maxPoint.y - minPoint.y) * 0.5f,
+		                          (maxPoint.z - minPoint.z) * 0.5f);
+		return bounds;
+	}
+
+	XMFLOAT3
+	getMin() const {
+		return XMFLOAT3(center.x - extents.x, center.y - extents.y, center.z - extents.z);
+	}
+
+	XMFLOAT3
+	getMax() const {
+		return XMFLOAT3(center.x + extents.x, center.y + extents.y, center.z + extents.z);
+	}
+
+	/// Radio de la esfera que envuelve la caja.
+	float
+	getRadius() const {
+		return sqrtf(extents.x * extents.x + extents.y * extents.y + extents.z * extents.z);
+	}
+
+	/// Extiende la caja para contener `other`.
+	void
+	merge(const Bounds& other) {
+		if (!other.isValid()) {
+			return;
+		}
+		if (!isValid()) {
+			*this = other;
+			return;
+		}
+		const XMFLOAT3 aMin = getMin();
+		const XMFLOAT3 aMax = getMax();
+		const XMFLOAT3 bMin = other.getMin();
+		const XMFLOAT3 bMax = other.getMax();
+		*this = fromMinMax(
+			XMFLOAT3((std::min)(aMin.x, bMin.x), (std::min)(aMin.y, bMin.y), (std::min)(aMin.z, bMin.z)),
+			XMFLOAT3((std::max)(aMax.x, bMax.x), (std::max)(aMax.y, bMax.y), (std::max)(aMax.z, bMax.z)));
+	}
+
+	/**
+	 * @brief Caja en espacio world que contiene esta caja transformada por `world`.
+	 *
+	 * Convencion de fila (p * M): la extension resultante en cada eje es la suma
+	 * de las extensiones locales escaladas por el valor absoluto de cada fila.
+	 */
+	Bounds
+	transformed(const XMMATRIX& world) const {
+		if (!isValid()) {
+			return *this;
+		}
+		const XMVECTOR c = XMVector3TransformCoord(XMLoadFloat3(&center), world);
+		XMVECTOR e = XMVectorScale(XMVectorAbs(world.r[0]), extents.x);
+		e = XMVectorMultiplyAdd(XMVectorAbs(world.r[1]), XMVectorReplicate(extents.y), e);
+		e = XMVectorMultiplyAdd(XMVectorAbs(world.r[2]), XMVectorReplicate(extents.z), e);
+
+		Bounds result;
+		XMStoreFloat3(&result.center, c);
+		XMStoreFloat3(&result.extents, e);
+		return result;
+	}
+
+	/**
+	 * @brief Prueba de slabs del rayo `origin + t * direction` contra la caja [lower, upper].
+	 *
+	 * Recibe la inversa de la direccion; los ejes paralelos quedan en +-inf y la
+	 * prueba los resuelve sin ramas extra.
+	 * @param outEnter Recibe el `t` de entrada, acotado a 0 si el origen esta dentro.
+	 * @return `true` si el rayo toca la caja con `t` en [0, maxDistance].
+	 */
+	static bool
+	rayIntersects(const XMFLOAT3& lower, const XMFLOAT3& upper,
+	              const XMFLOAT3& origin, const XMFLOAT3& inverseDirection,
+	              float maxDistance, float& outEnter) {
+		float t0 = (lower.x - origin.x) * inverseDirection.x;
+		float t1 = (upper.x - origin.x) * inverseDirection.x;
+		float tMin = (std::min)(t0, t1);
+		float tMax = (std::max)(t0, t1);
+		t0 = (lower.y - origin.y) * inverseDirection.y;
+		t1 = (upper.y - origin.y) * inverseDirection.y;
+		tMin = (std::max)(tMin, (std::min)(t0, t1));
+		tMax = (std::min)(tMax, (std::max)(t0, t1));
+		t0 = (lower.z - origin.z) * inverseDirection.z;
+		t1 = (upper.z - origin.z) * inverseDirection.z;
+		tMin = (std::max)(tMin, (std::min)(t0, t1));
+		tMax = (std::min)(tMax, (std::max)(t0, t1));
+		outEnter = (std::max)(tMin, 0.0f);
+		return tMax >= outEnter && outEnter <= maxDistance;
+	}
+
+	/// Caja minima de una lista de posiciones; vacia si `count` es 0.
+	template<typename Vertex>
+	static Bounds
+	fromVertices(const Vertex* vertices, size_t count) {
+		if (count == 0) {
+			return Bounds{};
+		}
+		XMFLOAT3 minPoint(FLT_MAX, FLT_MAX, FLT_MAX);
+		XMFLOAT3 maxPoint(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		for (size_t i = 0; i < count; ++i) {
+			const EU::Vector3& p = vertices[i].Position;
+			minPoint = XMFLOAT3((std::min)(minPoint.x, p.x), (std::min)(minPoint.y, p.y), (std::min)(minPoint.z, p.z));
+			maxPoint = XMFLOAT3((std::max)(maxPoint.x, p.x), (std::max)(maxPoint.y, p.y), (std::max)(maxPoint.z, p.z));
+		}
+		return fromMinMax(minPoint, maxPoint);
+	}
+};
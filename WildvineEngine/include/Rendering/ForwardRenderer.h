@@ -9,8 +9,12 @@
 #include "DepthStencilState.h"
 #include "DepthStencilView.h"
 #include "RasterizerState.h"
+#include "Rendering/LightClusters.h"
+#include "Rendering/RenderQueues.h"
 #include "Rendering/RenderScene.h"
 #include "Rendering/RenderTypes.h"
+#include "Rendering/ShadowCacheTracker.h"
+#include "Rendering/ShadowCascades.h"
 #include "ShaderProgram.h"
 #include "Texture.h"
 #include "EngineUtilities/Utilities/EditorViewportPass.h"
@@ -20,6 +24,21 @@ class DeviceContext;
 class Camera;
 class Material;
 
+/**
+ * @brief Contadores del pase de sombras del ultimo frame.
+ */
+struct
+ShadowStats {
+	size_t castersTested = 0; ///< Casters con caja probados contra cada cascada.
+	size_t castersDrawn = 0;  ///< Dibujos emitidos este frame en el pase de sombras, sumando cascadas.
+	size_t staticDrawn = 0;   ///< Dibujos de casters estaticos; 0 si se reutilizo la cache.
+	size_t dynamicDrawn = 0;  ///< Dibujos de casters dinamicos sobre la copia del frame.
+	size_t staticCached = 0;  ///< Dibujos estaticos que la cache evito este frame.
+	uint32_t cascadeCount = 0;
+	size_t cascadeCasters[ShadowCascades::kMaxCascades] = {}; ///< Casters (estaticos y dinamicos) de cada cascada.
+	ShadowCacheInvalidation cacheInvalidation = ShadowCacheInvalidation::None; ///< Motivo del redibujado de la cache.
+};
+
 /**
  * @class ForwardRenderer
  * @brief Ejecuta el pipeline de render forward del motor.
@@ -45,6 +64,16 @@ public:
 	 */
 	void updatePerFrame(const Camera& camera, const RenderScene& scene, DeviceContext& deviceContext);
 
+	/**
+	 * @brief Ajusta las cascadas a la camara y deja sus volumenes de casters en la escena.
+	 *
+	 * Va entre SceneGraph::gatherLights() y SceneGraph::gatherRenderScene(): el
+	 * gather busca los casters fuera de camara en RenderScene::shadowCasterVolumes.
+	 * La huella y el plano lejano de una cascada no dependen de los casters, asi
+	 * que los volumenes coinciden con los del ajuste final en render().
+	 */
+	void prepareShadowVolumes(const Camera& camera, RenderScene& scene);
+
 	/**
 	 * @brief Renderiza la escena completa sobre el `EditorViewportPass`.
 	 */
@@ -57,11 +86,63 @@ public:
 	 * @brief Libera los recursos internos del renderer.
 	 */
 	void destroy();
-	ID3D11ShaderResourceView* getShadowMapSRV() const { return m_shadowDepthSRV.m_textureFromImg; }
+	ID3D11ShaderResourceView* getShadowMapSRV() const { return m_activeShadowSRV; }
 	ID3D11ShaderResourceView* getPreShadowSRV() const { return m_preShadowDebugPass.getSRV(); }
 
+	/**
+	 * @brief Asignacion de RenderScene::localLights a las celdas del frustum del ultimo frame.
+	 *
+	 * Vacia si el clustering esta apagado o no hubo luces locales.
+	 */
+	const LightClusters& getLightClusters() const { return m_lightClusters; }
+
+	/**
+	 * @brief Activa el reparto de luces locales en celdas en cada render().
+	 *
+	 * Apagado por defecto: ningun shader lee aun las listas por celda, asi que
+	 * construirlas solo tiene sentido para inspeccionarlas o medirlas.
+	 */
+	void setLightClustering(bool enabled) { m_lightClustering = enabled; }
+	bool isLightClustering() const { return m_lightClustering; }
+
+	const ShadowStats& getShadowStats() const { return m_shadowStats; }
+
+	/**
+	 * @brief Numero de cascadas, reparto de los cortes y alcance de las sombras.
+	 *
+	 * Mas de una cascada requiere un shader que lea CascadeViewProjection.
+	 */
+	void setShadowCascadeSettings(const ShadowCascadeSettings& settings) { m_shadowCascades.setSettings(settings); }
+
+	/**
+	 * @brief Cascadas ajustadas en el ultimo frame; comparten el atlas de getShadowMapSRV().
+	 */
+	const ShadowCascades& getShadowCascades() const { return m_shadowCascades; }
+
+	/**
+	 * @brief Cachea la profundidad de los casters estaticos entre frames.
+	 *
+	 * Con la cache activa la profundidad de las cascadas se ajusta solo a los
+	 * casters estaticos; los dinamicos que queden delante del plano cercano se
+	 * aplastan contra el.
+	 */
+	void setStaticShadowCaching(bool enabled) { m_cacheStaticShadows = enabled; m_shadowCacheTracker.invalidate(); }
+
+	/**
+	 * @brief Obliga a redibujar la cache de sombras estaticas el siguiente frame.
+	 */
+	void invalidateShadowCache() { m_shadowCacheTracker.invalidate(); }
+
 private:
+	using RenderQueue = EU::TArenaArray<const RenderObject*>;
+
 	void buildQueues(RenderScene& scene, const Camera& camera);
+	void cullShadowCasters();
+	void cullCascadeCasters(const Frustum& frustum,
+		EU::TSpan<const RenderObject* const> casters,
+		const BoundsBatch& batch,
+		RenderQueue& outQueue);
+	size_t drawShadowCascades(DeviceContext& deviceContext, const RenderQueue* cascadeQueues);
 	void renderPreShadowDebugPass(DeviceContext& deviceContext, RenderScene& scene);
 	void renderShadowPass(DeviceContext& deviceContext);
 	void renderOpaquePass(DeviceContext& deviceContext);
@@ -71,6 +152,8 @@ private:
 	void renderShadowObject(DeviceContext& deviceContext, const RenderObject& object);
 	HRESULT createShadowResources(Device& device);
 	void updateLightMatrices(const Camera& camera, const RenderScene& scene);
+	void fitShadowCascades(const Camera& camera, const RenderScene& scene, const BoundsBatch& casters);
+	uint32_t shadowAtlasColumns() const;
 	HRESULT createBlendStates(Device& device);
 	ID3D11BlendState* resolveBlendState(const Material* material) const;
 
@@ -84,12 +167,16 @@ private:
 	ID3D11BlendState* m_additiveBlendState = nullptr;
 	ID3D11BlendState* m_premultipliedBlendState = nullptr;
 	float m_blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-	Texture m_shadowDepthTexture;
+	Texture m_shadowDepthTexture; ///< Atlas del frame: la cache estatica mas los casters dinamicos.
 	Texture m_shadowDepthSRV;
 	DepthStencilView m_shadowDSV;
+	Texture m_staticShadowTexture; ///< Atlas con solo los casters estaticos; se conserva entre frames.
+	Texture m_staticShadowSRV;
+	DepthStencilView m_staticShadowDSV;
+	ID3D11ShaderResourceView* m_activeShadowSRV = nullptr; ///< Atlas que muestrean los pases de este frame.
 	ShaderProgram m_shadowShader;
 	RasterizerState m_shadowRasterizer;
-	unsigned int m_shadowMapSize = 2048;
+	unsigned int m_shadowMapSize = 2048; ///< Lado del atlas de cascadas.
 	EditorViewportPass m_preShadowDebugPass;
 	bool m_applyShadows = true;
 
@@ -97,8 +184,22 @@ private:
 	CBPerObject m_cbPerObject{};
 	CBPerMaterial m_cbPerMaterial{};
 
-	std::vector<const RenderObject*> m_opaqueQueue;
-	std::vector<const RenderObject*> m_transparentQueue;
+	// Colas en el arena del frame de RenderScene: buildQueues() las reasocia cada frame
+	RenderQueues m_queues;
+	LightClusters m_lightClusters; ///< Listas de luces locales por celda, listas para subir.
+	bool m_lightClustering = false;
+
+	ShadowCascades m_shadowCascades; ///< Cascadas en cuadrantes de m_shadowDepthTexture (atlas).
+	BoundsBatch m_shadowBatch;       ///< Cajas de los casters de m_queues.shadow que tienen una.
+	BoundsBatch m_staticShadowBatch; ///< Cajas de m_queues.staticShadow.
+	std::vector<uint8_t> m_shadowVisible;
+	RenderQueue m_cascadeQueues[ShadowCascades::kMaxCascades];       ///< Casters dinamicos de cada cascada.
+	RenderQueue m_staticCascadeQueues[ShadowCascades::kMaxCascades]; ///< Casters estaticos de cada cascada.
+	XMFLOAT3 m_shadowLightDirection = XMFLOAT3(0.0f, -1.0f, 0.0f);
+	ShadowCacheTracker m_shadowCacheTracker;
+	bool m_cacheStaticShadows = true;
+	bool m_staticShadowDirty = true; ///< El tracker pidio redibujar la cache este frame.
+	ShadowStats m_shadowStats;
 };
 
 
@@ -0,0 +1,127 @@
+/**
+ * @file Frustum.h
+ * @brief Declara la API de Frustum dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "Rendering/Bounds.h"
+
+/**
+ * @struct BoundsBatch
+ * @brief Cajas en columnas (SoA) para probarlas de cuatro en cuatro.
+ */
+struct
+BoundsBatch {
+	std::vector<float> centerX;
+	std::vector<float> centerY;
+	std::vector<float> centerZ;
+	std::vector<float> extentX;
+	std::vector<float> extentY;
+	std::vector<float> extentZ;
+
+	void
+	clear() {
+		centerX.clear(); centerY.clear(); centerZ.clear();
+		extentX.clear(); extentY.clear(); extentZ.clear();
+	}
+
+	void
+	push(const Bounds& bounds) {
+		centerX.push_back(bounds.center.x);
+		centerY.push_back(bounds.center.y);
+		centerZ.push_back(bounds.center.z);
+		extentX.push_back(bounds.extents.x);
+		extentY.push_back(bounds.extents.y);
+		extentZ.push_back(bounds.extents.z);
+	}
+
+	size_t
+	size() const { return centerX.size(); }
+};
+
+/**
+ * @class Frustum
+ * @brief Seis planos de recorte extraidos de una matriz view * projection.
+ *
+ * Los planos apuntan hacia dentro y estan normalizados: `dot(n, p) + d` es la
+ * distancia con signo de `p`. Para una caja basta el radio proyectado
+ * `|n| . extents`: si `distancia + radio < 0` la caja esta fuera de un plano.
+ */
+class
+Frustum {
+public:
+	enum Plane {
+		Left = 0,
+		Right,
+		Bottom,
+		Top,
+		Near,
+		Far,
+		PlaneCount
+	};
+
+	/// Resultado de clasificar un volumen contra el frustum.
+	enum class
+	Containment {
+		Outside = 0,
+		Intersects,
+		Inside
+	};
+
+	Frustum() = default;
+
+	/**
+	 * @brief Extrae los planos (Gribb-Hartmann) de `viewProjection`.
+	 *
+	 * Convencion D3D: profundidad de clip en [0, w].
+	 */
+	void
+	setFromMatrix(const XMMATRIX& viewProjection);
+
+	/**
+	 * @brief Anula un plano para que nunca descarte nada.
+	 *
+	 * Sirve para extruir el volumen; p. ej. sin el plano cercano de la luz se
+	 * conservan los casters que estan entre la luz y su volumen ortografico.
+	 */
+	void
+	removePlane(Plane plane) { m_planes[plane] = XMFLOAT4(0.0f, 0.0f, 0.0f, FLT_MAX); }
+
+	/// `true` si la caja toca o esta dentro del frustum. Las cajas vacias siempre pasan.
+	bool
+	intersects(const Bounds& bounds) const;
+
+	bool
+	intersectsSphere(const XMFLOAT3& center, float radius) const;
+
+	/**
+	 * @brief Clasifica la caja: fuera, cortando algun plano o completamente dentro.
+	 */
+	Containment
+	classify(const Bounds& bounds) const;
+
+	/**
+	 * @brief Prueba todas las cajas del lote (validas); cuatro por iteracion con SIMD.
+	 * @param outVisible Recibe 1 por caja visible y 0 por caja descartada.
+	 * @return Numero de cajas visibles.
+	 */
+	size_t
+	cull(const BoundsBatch& batch, uint8_t* outVisible) const;
+
+	/**
+	 * @brief Caja world de las ocho esquinas del frustum.
+	 *
+	 * Cada esquina es la interseccion de tres planos (lateral, vertical y
+	 * cercano o lejano).
+	 * @return `false` si el volumen no esta acotado (un plano anulado con removePlane()).
+	 */
+	bool
+	computeBounds(XMFLOAT3& outLower, XMFLOAT3& outUpper) const;
+
+	const XMFLOAT4&
+	getPlane(Plane plane) const { return m_planes[plane]; }
+
+private:
+	XMFLOAT4 m_planes[PlaneCount]{};
+};
@@ -0,0 +1,154 @@
+/**
+ * @file LightClusters.h
+ * @brief Declara la API de LightClusters dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "Rendering/RenderTypes.h"
+
+class JobSystem;
+
+/**
+ * @struct LightCluster
+ * @brief Rango de una celda dentro de LightClusters::getLightIndices().
+ */
+struct
+LightCluster {
+	uint32_t offset = 0;
+	uint32_t count = 0;
+};
+
+/**
+ * @brief Resultado de la ultima asignacion de luces.
+ */
+struct
+LightClusterStats {
+	size_t lightCount = 0;      ///< Luces puntuales y focales recibidas.
+	size_t visibleLights = 0;   ///< Luces cuya esfera toca el frustum de la camara.
+	size_t indexCount = 0;      ///< Pares celda-luz: tamano de la lista compacta.
+	uint32_t maxPerCluster = 0; ///< Luces de la celda mas cargada.
+	size_t clusterTests = 0;    ///< Celdas probadas contra una luz (cuatro por prueba SIMD).
+	int64_t buildUs = 0;        ///< Duracion de build() en microsegundos.
+};
+
+/**
+ * @class LightClusters
+ * @brief Asigna luces puntuales y focales a las celdas (froxels) del frustum de la camara.
+ *
+ * El frustum se divide en kTilesX x kTilesY teselas de pantalla y kSlices
+ * rebanadas de profundidad exponencial, asi las celdas lejanas crecen igual que
+ * su huella en pantalla. Cada luz se lleva a espacio de vista y su esfera
+ * acota el rango de celdas; dentro de ese rango se prueban cuatro celdas de una
+ * fila a la vez con SIMD: esfera contra caja y, en las focales, cono contra la
+ * esfera que envuelve a la celda.
+ *
+ * Las rebanadas se reparten entre los workers del JobSystem. El resultado son
+ * dos arreglos listos para subir a la GPU: un LightCluster por celda (indice
+ * `clusterIndex(x, y, slice)`) y la lista compacta de indices de luz, ordenada
+ * por celda. Los indices apuntan al vector de luces recibido en build().
+ *
+ * La tesela `y = 0` es la inferior (y de NDC hacia arriba).
+ */
+class
+LightClusters {
+public:
+	static constexpr uint32_t kTilesX = 16; ///< Multiplo de 4: cada fila son grupos SIMD completos.
+	static constexpr uint32_t kTilesY = 9;
+	static constexpr uint32_t kSlices = 24;
+	static constexpr uint32_t kClustersPerSlice = kTilesX * kTilesY;
+	static constexpr uint32_t kClusterCount = kClustersPerSlice * kSlices;
+	static constexpr size_t kLightGrain = 256; ///< Luces por trabajo al prepararlas.
+
+	/**
+	 * @brief Reparte `lights` en las celdas del frustum descrito por `view` y `projection`.
+	 *
+	 * Ignora las luces direccionales. `projection` debe ser una perspectiva LH
+	 * simetrica (XMMatrixPerspectiveFovLH); las cajas de las celdas solo se
+	 * recalculan si cambian la proyeccion o los planos.
+	 */
+	void
+	build(const XMMATRIX& view, const XMMATRIX& projection, float nearZ, float farZ,
+	      EU::TSpan<const LightData> lights, JobSystem* jobs = nullptr);
+
+	void
+	clear();
+
+	static uint32_t
+	clusterIndex(uint32_t x, uint32_t y, uint32_t slice) {
+		return x + kTilesX * (y + kTilesY * slice);
+	}
+
+	/// Rebanada que contiene la profundidad de vista `viewDepth`.
+	uint32_t
+	sliceOf(float viewDepth) const;
+
+	const std::vector<LightCluster>&
+	getClusters() const { return m_clusters; }
+
+	const std::vector<uint32_t>&
+	getLightIndices() const { return m_lightIndices; }
+
+	const LightClusterStats&
+	getStats() const { return m_stats; }
+
+private:
+	/// Luz en espacio de vista con el rango de celdas que puede tocar.
+	struct ViewLight {
+		XMFLOAT3 center;
+		float radius = 0.0f;
+		XMFLOAT3 direction;           ///< Eje del cono (solo focales).
+		float cosAngle = 0.0f;
+		float sinAngle = 0.0f;
+		uint32_t index = 0;           ///< Posicion en el vector de build().
+		bool spot = false;
+		bool visible = false;
+		uint8_t minX = 0, maxX = 0;
+		uint8_t minY = 0, maxY = 0;
+		uint8_t minSlice = 0, maxSlice = 0;
+	};
+
+	/// Par celda-luz producido por una rebanada antes de compactarlo.
+	struct ClusterLight {
+		uint32_t cluster = 0; ///< Celda dentro de la rebanada.
+		uint32_t light = 0;
+	};
+
+	/// Salida de una rebanada; se reutiliza entre frames.
+	struct SliceScratch {
+		std::vector<ClusterLight> pairs;
+		std::vector<uint32_t> indices;    ///< Indices de luz ordenados por celda.
+		size_t tests = 0;
+	};
+
+	/// Cajas y esferas envolventes de las celdas en espacio de vista.
+	void
+	rebuildClusterBounds(float scaleX, float scaleY, float nearZ, float farZ);
+
+	/// Transforma la luz y calcula su rango de celdas.
+	void
+	setupLight(const XMMATRIX& view, const LightData& light, uint32_t index, ViewLight& outLight) const;
+
+	/// Prueba las luces de la rebanada contra sus celdas y compacta el resultado.
+	void
+	assignSlice(uint32_t slice);
+
+	// Columnas por celda (SoA); se cargan de cuatro en cuatro a lo largo de x.
+	std::vector<float> m_minX, m_maxX, m_minY, m_maxY, m_minZ, m_maxZ;
+	std::vector<float> m_sphereX, m_sphereY, m_sphereZ, m_sphereRadius;
+
+	float m_scaleX = 0.0f;     ///< projection._11 con el que se calcularon las celdas.
+	float m_scaleY = 0.0f;     ///< projection._22.
+	float m_nearZ = 0.0f;
+	float m_farZ = 0.0f;
+	float m_sliceScale = 0.0f; ///< kSlices / log(far / near).
+
+	std::vector<ViewLight> m_viewLights;
+	std::vector<uint32_t> m_sliceLightOffsets; ///< Inicio de cada rebanada en m_sliceLights (+ final).
+	std::vector<uint32_t> m_sliceLights;       ///< Luces visibles agrupadas por rebanada.
+	std::vector<SliceScratch> m_slices;
+
+	std::vector<LightCluster> m_clusters;
+	std::vector<uint32_t> m_lightIndices;
+	LightClusterStats m_stats;
+};
@@ -6,6 +6,8 @@
 #pragma once
 #include "Prerequisites.h"
 #include "Buffer.h"
+#include "Rendering/Bounds.h"
+#include "Rendering/TriangleBVH.h"
 
 /**
  * @struct Submesh
@@ -18,6 +20,7 @@ Submesh {
 	unsigned int indexCount = 0;  ///< Numero de indices a dibujar.
 	unsigned int startIndex = 0;  ///< Offset inicial dentro del index buffer.
 	unsigned int materialSlot = 0;///< Slot de material esperado por el renderer.
+	Bounds bounds;                ///< Caja local calculada al importar.
 };
 
 /**
@@ -30,6 +33,56 @@ public:
 	std::vector<Submesh>& getSubmeshes() { return m_submeshes; }
 	const std::vector<Submesh>& getSubmeshes() const { return m_submeshes; }
 
+	/**
+	 * @brief Caja local que envuelve todas las submallas.
+	 */
+	const Bounds& getBounds() const { return m_bounds; }
+
+	/**
+	 * @brief Recalcula la caja de la malla a partir de las de sus submallas y avanza la revision.
+	 */
+	void
+	updateBounds() {
+		m_bounds = Bounds{};
+		for (const Submesh& submesh : m_submeshes) {
+			m_bounds.merge(submesh.bounds);
+		}
+		++m_revision;
+	}
+
+	/**
+	 * @brief Cambia cada vez que la geometria se reconstruye en el mismo objeto (hot reload).
+	 *
+	 * Quien cachea algo derivado de la malla (indice espacial, cache de sombras)
+	 * compara puntero y revision.
+	 */
+	uint32_t
+	getRevision() const { return m_revision; }
+
+	/**
+	 * @brief Libera la geometria actual y toma la de `other`, que queda vacia.
+	 */
+	void
+	replaceWith(Mesh& other) {
+		destroy();
+		m_submeshes = std::move(other.m_submeshes);
+		m_triangleBVH = std::move(other.m_triangleBVH);
+		other.m_submeshes.clear();
+		other.m_bounds = Bounds{};
+		updateBounds();
+	}
+
+	/**
+	 * @brief BVH de triangulos en espacio local para picking; nulo si no hay geometria en CPU.
+	 *
+	 * Compartido con el Model3D del que salio la malla: no se copia al reconstruirla.
+	 */
+	const std::shared_ptr<const TriangleBVH>&
+	getTriangleBVH() const { return m_triangleBVH; }
+
+	void
+	setTriangleBVH(std::shared_ptr<const TriangleBVH> triangleBVH) { m_triangleBVH = std::move(triangleBVH); }
+
 	/**
 	 * @brief Libera todos los buffers asociados a las submallas.
 	 */
@@ -40,10 +93,16 @@ public:
 			submesh.indexBuffer.destroy();
 		}
 		m_submeshes.clear();
+		m_bounds = Bounds{};
+		m_triangleBVH.reset();
+		++m_revision;
 	}
 
 private:
 	std::vector<Submesh> m_submeshes;
+	Bounds m_bounds;
+	std::shared_ptr<const TriangleBVH> m_triangleBVH;
+	uint32_t m_revision = 0;
 };
 
 
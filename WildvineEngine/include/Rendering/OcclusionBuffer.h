@@ -0,0 +1,117 @@
+/**
+ * @file OcclusionBuffer.h
+ * @brief Declara la API de OcclusionBuffer dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "Rendering/Bounds.h"
+
+class JobSystem;
+class TriangleBVH;
+
+/**
+ * @brief Contadores del ultimo frame del buffer de oclusion.
+ */
+struct
+OcclusionStats {
+	size_t occluders = 0;        ///< Mallas agregadas con addOccluder().
+	size_t triangles = 0;        ///< Triangulos que cubren algun centro de pixel en pantalla.
+	size_t trianglesSkipped = 0; ///< Degenerados, fuera de pantalla o cruzando el plano cercano.
+	size_t binnedTriangles = 0;  ///< Pares tesela-triangulo tras el binning.
+	int64_t rasterUs = 0;        ///< Duracion de rasterize() en microsegundos.
+};
+
+/**
+ * @class OcclusionBuffer
+ * @brief Buffer de profundidad de baja resolucion para descartar objetos ocultos en CPU.
+ *
+ * Por frame: begin() con la viewProjection de la camara, addOccluder() por cada
+ * malla oclusora y rasterize(). Los triangulos se reparten en teselas de
+ * kTileSize x kTileSize pixeles y cada tesela se rasteriza en un worker del
+ * JobSystem, cuatro pixeles por iteracion con SIMD; ninguna tesela comparte
+ * pixeles, asi no hay escrituras concurrentes. Despues se construye una
+ * piramide con la profundidad maxima (la mas lejana) de cada bloque de 2x2.
+ *
+ * isVisible() proyecta la caja, toma su profundidad mas cercana y la compara
+ * con el nivel de la piramide donde el rectangulo ocupa a lo sumo 4x4 texels:
+ * si queda detras de todos, la caja esta oculta. La prueba es conservadora
+ * (ante la duda devuelve visible) y es segura entre hilos despues de rasterize().
+ *
+ * Profundidad D3D: z / w en [0, 1], 0 en el plano cercano. Los triangulos que
+ * cruzan el plano cercano se descartan: solo se pierde oclusion, nunca se
+ * oculta algo visible. Se rasterizan ambas caras.
+ */
+class
+OcclusionBuffer {
+public:
+	static constexpr uint32_t kWidth = 256;
+	static constexpr uint32_t kHeight = 128;
+	static constexpr uint32_t kTileSize = 32; ///< Multiplo de 4: cada fila de tesela son grupos SIMD completos.
+	static constexpr uint32_t kTilesX = kWidth / kTileSize;
+	static constexpr uint32_t kTilesY = kHeight / kTileSize;
+
+	/// Limpia la profundidad (1 = lejos) y fija la camara de este frame.
+	void
+	begin(const XMMATRIX& viewProjection);
+
+	/// Agrega los triangulos del BVH de una malla (en espacio local) con su matriz world.
+	void
+	addOccluder(const TriangleBVH& triangles, const XMMATRIX& world);
+
+	/// Agrega triangulos sueltos en espacio local: `indices` de tres en tres sobre `positions`.
+	void
+	addOccluder(const XMFLOAT3* positions, size_t positionCount,
+	            const uint32_t* indices, size_t indexCount, const XMMATRIX& world);
+
+	/// Rasteriza los oclusores agregados y construye la piramide.
+	void
+	rasterize(JobSystem* jobs = nullptr);
+
+	/**
+	 * @brief `false` si la caja world queda completamente detras de los oclusores.
+	 */
+	bool
+	isVisible(const Bounds& worldBounds) const;
+
+	/// Profundidad del pixel (x, y); y = 0 es la fila superior.
+	float
+	getDepth(uint32_t x, uint32_t y) const { return m_levels[0][y * kWidth + x]; }
+
+	/// Texel (x, y) del nivel `level` de la piramide: maximo de los pixeles de su bloque.
+	float
+	getDepth(uint32_t level, uint32_t x, uint32_t y) const { return m_levels[level][y * (kWidth >> level) + x]; }
+
+	/// Niveles de la piramide, incluido el nivel 0; 0 antes del primer begin().
+	uint32_t
+	getLevelCount() const { return static_cast<uint32_t>(m_levels.size()); }
+
+	const OcclusionStats&
+	getStats() const { return m_stats; }
+
+private:
+	/// Triangulo en pixeles con z / w y su rectangulo de pixeles cubiertos.
+	struct ScreenTriangle {
+		XMFLOAT3 v[3];
+		int32_t minX = 0, minY = 0;
+		int32_t maxX = 0, maxY = 0;
+	};
+
+	/// Proyecta un triangulo en clip y lo agrega si cubre algun centro de pixel.
+	void
+	addClipTriangle(const XMVECTOR& c0, const XMVECTOR& c1, const XMVECTOR& c2);
+
+	void
+	rasterizeTile(uint32_t tile);
+
+	void
+	buildHierarchy();
+
+	XMMATRIX m_viewProjection = XMMatrixIdentity();
+	/// Nivel 0: profundidad de kWidth x kHeight, fila superior primero. Cada nivel
+	/// siguiente guarda el maximo de 2x2 texels del anterior.
+	std::vector<std::vector<float>> m_levels;
+	std::vector<ScreenTriangle> m_triangles;
+	std::vector<std::vector<uint32_t>> m_tileTriangles; ///< Triangulos que tocan cada tesela.
+	OcclusionStats m_stats;
+};
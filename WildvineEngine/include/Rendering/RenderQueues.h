@@ -0,0 +1,39 @@
+/**
+ * @file RenderQueues.h
+ * @brief Declara la API de RenderQueues dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "Rendering/RenderScene.h"
+
+/**
+ * @struct RenderQueues
+ * @brief Colas de dibujo de un frame armadas a partir de una RenderScene.
+ *
+ * Las colas viven en el arena del frame de la escena: build() las reasocia cada
+ * frame reservando lo que ocuparon en el anterior, asi en estado estable no
+ * tocan el heap. No depende del dispositivo; ForwardRenderer las usa para sus
+ * pases.
+ */
+struct
+RenderQueues {
+	using Queue = EU::TArenaArray<const RenderObject*>;
+
+	/**
+	 * @brief Reparte los objetos de `scene` en las colas y las ordena.
+	 *
+	 * Opacos por material y luego de cerca a lejos; transparentes de lejos a
+	 * cerca. Con `cacheStaticShadows` los casters estaticos van a staticShadow.
+	 */
+	void
+	build(RenderScene& scene, bool cacheStaticShadows);
+
+	void
+	clear();
+
+	Queue opaque;       ///< Opacos visibles desde la camara.
+	Queue transparent;  ///< Transparentes visibles, ordenados para mezclar.
+	Queue shadow;       ///< Casters dinamicos (todos si la cache esta apagada), visibles o no.
+	Queue staticShadow; ///< Casters estaticos, solo con la cache activa.
+};
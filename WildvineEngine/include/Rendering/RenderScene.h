@@ -6,6 +6,7 @@
 #pragma once
 #include "Prerequisites.h"
 #include "Rendering/RenderTypes.h"
+#include "Rendering/Frustum.h"
 
 class Skybox;
 
@@ -14,21 +15,46 @@ class Skybox;
  * @brief Contenedor temporal con los elementos visibles de un frame.
  *
  * `RenderScene` funciona como estructura intermedia entre el `SceneGraph` y el
- * renderer. Agrupa objetos por tipo de cola, luces direccionales y skybox activo.
+ * renderer. Agrupa objetos por tipo de cola, luces por tipo y skybox activo.
+ *
+ * Las colecciones y todo lo que cuelga de ellas (materiales de cada
+ * RenderObject, colas del renderer) viven en un arena lineal por frame. Con
+ * kFramesInFlight arenas, lo preparado en el frame anterior sigue siendo valido
+ * mientras se arma el actual, y en estado estable un frame no toca el heap.
  */
 class
 RenderScene {
 public:
+	static constexpr size_t kFramesInFlight = 2;
+
+	RenderScene() { clear(); }
+
 	/**
-	 * @brief Limpia todas las colecciones para preparar un nuevo frame.
+	 * @brief Pasa al arena del siguiente frame y vacia las colecciones para un frame nuevo.
+	 *
+	 * Cada coleccion reserva lo que ocupo en el frame anterior.
 	 */
 	void clear();
 
+	/// Arena del frame actual; se reinicia en el clear() de dentro de kFramesInFlight frames.
+	EU::LinearArena&
+	getFrameArena() { return m_frameArena.current(); }
+
+	/// Uso del arena; `heapAllocations` debe quedarse fijo cuando la escena no crece.
+	EU::ArenaStats
+	getArenaStats() const { return m_frameArena.getStats(); }
+
 public:
-	std::vector<RenderObject> opaqueObjects;       ///< Objetos opacos listos para renderizar.
-	std::vector<RenderObject> transparentObjects;  ///< Objetos transparentes ordenables por distancia.
-	std::vector<LightData> directionalLights;      ///< Luces direccionales activas en la escena.
-	Skybox* skybox = nullptr;                      ///< Skybox activo para el frame actual.
+	EU::TArenaArray<RenderObject> opaqueObjects;       ///< Objetos opacos visibles y sombreadores fuera de camara.
+	EU::TArenaArray<RenderObject> transparentObjects;  ///< Objetos transparentes ordenables por distancia.
+	EU::TArenaArray<LightData> directionalLights;      ///< Luces direccionales activas en la escena.
+	EU::TArenaArray<LightData> localLights;            ///< Luces puntuales y focales, con posicion world.
+	EU::TArenaArray<Frustum> shadowCasterVolumes;      ///< Volumenes de casters de las cascadas; fuera de camara solo se conservan los casters que los tocan.
+	Skybox* skybox = nullptr;                          ///< Skybox activo para el frame actual.
+	Frustum cameraFrustum;                             ///< Frustum de la camara usado en el gather.
+
+private:
+	EU::TFrameArena<kFramesInFlight> m_frameArena;
 };
 
 
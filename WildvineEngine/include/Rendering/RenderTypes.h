@@ -5,6 +5,8 @@
  */
 #pragma once
 #include "Prerequisites.h"
+#include "Rendering/Bounds.h"
+#include "EngineUtilities/Memory/TFrameArena.h"
 
 class Mesh;
 class MaterialInstance;
@@ -47,10 +49,10 @@ LightData {
 	float intensity = 1.0f;
 
 	EU::Vector3 direction = EU::Vector3(0.0f, -1.0f, 0.0f);
-	float range = 0.0f;
+	float range = 0.0f;       ///< Radio de influencia de las luces puntuales y focales.
 
-	EU::Vector3 position = EU::Vector3(0.0f, 0.0f, 0.0f);
-	float spotAngle = 0.0f;
+	EU::Vector3 position = EU::Vector3(0.0f, 0.0f, 0.0f); ///< En world; el gather la toma del Transform.
+	float spotAngle = 0.0f;   ///< Semiangulo del cono de las focales, en radianes.
 };
 
 struct
@@ -75,6 +77,10 @@ CBPerFrame {
 	float pad1 = 0.0f;
 	EU::Vector3 LightColor = EU::Vector3(1.0f, 1.0f, 1.0f);
 	float pad2 = 0.0f;
+	// Cascadas de sombra; al final para no mover los campos que ya leen los shaders
+	XMFLOAT4X4 CascadeViewProjection[4]{}; ///< Ya escaladas al cuadrante de cada cascada en el atlas.
+	XMFLOAT4 CascadeSplits{};              ///< Profundidad de vista donde termina cada cascada.
+	XMFLOAT4 ShadowParams{};               ///< x: cascadas activas, y: tamano de un texel del atlas en UV.
 };
 
 struct
@@ -103,10 +109,13 @@ struct
 RenderObject {
 	Mesh* mesh = nullptr;
 	MaterialInstance* materialInstance = nullptr;
-	std::vector<MaterialInstance*> materialInstances;
+	EU::TSpan<MaterialInstance*> materialInstances; ///< Copia por slot en el arena del frame de RenderScene.
 	XMMATRIX world = XMMatrixIdentity();
+	Bounds worldBounds;           ///< Caja de la malla en espacio world (vacia si no se conoce).
 	bool castShadow = true;
+	bool staticShadow = false;    ///< Caster que no se mueve: su profundidad se cachea entre frames.
 	bool transparent = false;
+	bool cameraVisible = true;    ///< false: fuera de la camara, solo se conserva para sombras.
 	float distanceToCamera = 0.0f;
 };
 
@@ -0,0 +1,71 @@
+/**
+ * @file ShadowCacheTracker.h
+ * @brief Declara la API de ShadowCacheTracker dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "Rendering/RenderTypes.h"
+#include "Rendering/ShadowCascades.h"
+
+/**
+ * @brief Motivo por el que la cache de sombras estaticas se redibujo.
+ */
+enum class
+ShadowCacheInvalidation {
+	None = 0,        ///< La cache sigue valida.
+	Empty,           ///< Primer frame o invalidate().
+	LightDirection,
+	Cascades,        ///< Alguna cascada cambio de volumen (camara, ajuste o configuracion).
+	StaticCasters    ///< Un caster estatico se movio, aparecio o desaparecio.
+};
+
+/**
+ * @class ShadowCacheTracker
+ * @brief Decide en CPU si la profundidad cacheada de los casters estaticos sigue valida.
+ *
+ * Guarda lo que determina el contenido de la cache: la direccion de la luz, la
+ * viewProjection de cada cascada y una firma de los casters estaticos de cada
+ * cascada (malla, su revision y matriz world). La firma suma el hash de cada
+ * caster, asi no depende del orden en que los entrega el gather; la revision
+ * detecta una malla reconstruida en el mismo objeto por el hot reload. Solo
+ * cuentan los casters de las cascadas: los que entran o salen de la camara sin
+ * tocar ningun volumen no invalidan la cache.
+ */
+class
+ShadowCacheTracker {
+public:
+	/**
+	 * @brief Compara el frame con el estado de la cache y lo adopta si difiere.
+	 * @param cascadeCasters Casters estaticos de cada cascada, una cola por cascada.
+	 * @return Motivo de la invalidacion; None si la cache puede reutilizarse.
+	 */
+	ShadowCacheInvalidation
+	update(const XMFLOAT3& lightDirection, const ShadowCascades& cascades,
+	       const EU::TArenaArray<const RenderObject*>* cascadeCasters);
+
+	/// Obliga a redibujar la cache en el siguiente update().
+	void
+	invalidate() { m_valid = false; }
+
+	uint64_t
+	getRebuildCount() const { return m_rebuildCount; }
+
+	uint64_t
+	getReuseCount() const { return m_reuseCount; }
+
+	ShadowCacheInvalidation
+	getLastRebuildReason() const { return m_lastRebuildReason; }
+
+private:
+	bool m_valid = false;
+	XMFLOAT3 m_lightDirection = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	uint32_t m_cascadeCount = 0;
+	XMFLOAT4X4 m_cascadeViewProjection[ShadowCascades::kMaxCascades]{};
+	uint64_t m_casterSignature = 0;
+	size_t m_casterCount = 0;
+
+	uint64_t m_rebuildCount = 0;
+	uint64_t m_reuseCount = 0;
+	ShadowCacheInvalidation m_lastRebuildReason = ShadowCacheInvalidation::None;
+};
@@ -0,0 +1,107 @@
+/**
+ * @file ShadowCascades.h
+ * @brief Declara la API de ShadowCascades dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "Rendering/Frustum.h"
+
+/**
+ * @brief Parametros de reparto de las cascadas de sombra.
+ *
+ * Por defecto hay una sola cascada: los shaders actuales solo leen
+ * LightViewProjection, que es la ultima cascada. Con mas cascadas los demas
+ * cuadrantes del atlas se dibujan pero nadie los muestrea, y la ultima queda
+ * en un cuadrante de la mitad de resolucion. Subir `cascadeCount` solo tiene
+ * sentido con un shader que elija la cascada con CascadeSplits y
+ * CascadeViewProjection.
+ */
+struct
+ShadowCascadeSettings {
+	uint32_t cascadeCount = 1;   ///< Entre 1 y ShadowCascades::kMaxCascades.
+	float splitLambda = 0.75f;   ///< Mezcla de cortes: 0 lineal, 1 logaritmico.
+	float maxDistance = 120.0f;  ///< Profundidad de vista donde termina la ultima cascada (se limita al far).
+};
+
+/**
+ * @brief Volumen ortografico de una cascada ajustado en ShadowCascades::fit().
+ */
+struct
+ShadowCascade {
+	XMMATRIX view = XMMatrixIdentity();           ///< Solo rotacion: comun a todas las cascadas.
+	XMMATRIX projection = XMMatrixIdentity();
+	XMMATRIX viewProjection = XMMatrixIdentity();
+	Frustum casterFrustum;       ///< Volumen sin plano cercano para cullear casters.
+	float splitNear = 0.0f;      ///< Rebanada de la camara que cubre (profundidad de vista).
+	float splitFar = 0.0f;
+	XMFLOAT3 center = XMFLOAT3(0.0f, 0.0f, 0.0f); ///< Centro de la rebanada en espacio de luz, ajustado al texel.
+	float radius = 0.0f;         ///< Semiancho del volumen ortografico.
+	float texelSize = 0.0f;      ///< Tamano world de un texel del shadow map.
+	float nearZ = 0.0f;          ///< Rango de profundidad en espacio de luz (ajustado en pasos).
+	float farZ = 0.0f;
+	uint32_t fittedCasters = 0;  ///< Casters de la huella que adelantaron nearZ.
+};
+
+/**
+ * @class ShadowCascades
+ * @brief Ajusta las cascadas de una luz direccional a las rebanadas del frustum de la camara.
+ *
+ * Los cortes mezclan el reparto lineal y el logaritmico con `splitLambda`.
+ * Cada rebanada se envuelve con una esfera (su tamano no cambia al girar la
+ * camara) y el volumen ortografico de la cascada la rodea. Su centro se
+ * redondea al texel del shadow map y su profundidad a pasos de una fraccion del
+ * radio: las sombras no tiemblan al mover la camara y la matriz no cambia con
+ * movimientos pequenos. El rango de profundidad se ajusta a la rebanada y a los
+ * casters cuya caja corta la huella de la cascada, asi ninguno queda delante
+ * del plano cercano y la precision no se gasta en espacio vacio.
+ *
+ * No toca la GPU: el renderer dibuja cada cascada con su `viewProjection`.
+ */
+class
+ShadowCascades {
+public:
+	static constexpr uint32_t kMaxCascades = 4;
+	static constexpr float kDepthSnapFraction = 0.125f; ///< Paso de ajuste de la profundidad, relativo al radio.
+
+	/**
+	 * @brief Profundidades de vista de los cortes: `count + 1` valores de `nearZ` a `farZ`.
+	 */
+	static void
+	computeSplits(float nearZ, float farZ, uint32_t count, float lambda, float* outSplits);
+
+	/**
+	 * @brief Ajusta las cascadas para la camara y la luz dadas.
+	 * @param cameraProjection Perspectiva LH simetrica (XMMatrixPerspectiveFovLH).
+	 * @param lightDirection Direccion en la que viaja la luz (no necesita estar normalizada).
+	 * @param casters Cajas world de los casters que deben caber en el rango de
+	 *        profundidad; los que queden delante del plano cercano se aplastan contra
+	 *        el si el rasterizador no recorta la profundidad.
+	 * @param resolution Texels por lado del shadow map de cada cascada.
+	 */
+	void
+	fit(const XMMATRIX& cameraView, const XMMATRIX& cameraProjection, float nearZ, float farZ,
+	    const XMFLOAT3& lightDirection, const BoundsBatch& casters, uint32_t resolution);
+
+	void
+	setSettings(const ShadowCascadeSettings& settings);
+
+	const ShadowCascadeSettings&
+	getSettings() const { return m_settings; }
+
+	/// Cascadas ajustadas en el ultimo fit(); 0 si la camara no era valida.
+	uint32_t
+	getCascadeCount() const { return m_cascadeCount; }
+
+	const ShadowCascade&
+	getCascade(uint32_t index) const { return m_cascades[index]; }
+
+private:
+	ShadowCascadeSettings m_settings;
+	ShadowCascade m_cascades[kMaxCascades];
+	uint32_t m_cascadeCount = 0;
+
+	// Cajas de los casters en espacio de luz, reutilizadas entre frames.
+	std::vector<XMFLOAT3> m_casterMin;
+	std::vector<XMFLOAT3> m_casterMax;
+};
@@ -0,0 +1,162 @@
+/**
+ * @file TriangleBVH.h
+ * @brief Declara la API de TriangleBVH dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "Rendering/Bounds.h"
+#include <cfloat>
+
+/**
+ * @struct TriangleHit
+ * @brief Impacto mas cercano de un rayo contra la geometria de una malla.
+ */
+struct
+TriangleHit {
+	float distance = FLT_MAX;       ///< Parametro `t` del rayo en el impacto.
+	uint32_t submesh = UINT32_MAX;  ///< Submalla del triangulo.
+	uint32_t triangle = UINT32_MAX; ///< Triangulo dentro de la submalla (indice / 3).
+	float u = 0.0f;                 ///< Coordenadas baricentricas del impacto.
+	float v = 0.0f;
+
+	bool
+	isValid() const { return triangle != UINT32_MAX; }
+};
+
+/**
+ * @class TriangleBVH
+ * @brief BVH estatico de los triangulos de una malla, construido con SAH por bins.
+ *
+ * Se construye una vez al importar y se guarda junto al `.wvmesh`. Cada hoja
+ * tiene hasta cuatro triangulos empaquetados en columnas (vertice 0 y dos
+ * aristas por eje), de modo que un rayo se prueba contra la hoja completa con
+ * una sola pasada SIMD de Moller-Trumbore. Los huecos del paquete son
+ * triangulos degenerados que nunca impactan.
+ *
+ * Los nodos estan aplanados: los dos hijos de un nodo interior son contiguos,
+ * asi que cada nodo ocupa 32 bytes y el recorrido no sigue punteros.
+ */
+class
+TriangleBVH {
+public:
+	static constexpr uint32_t kLeafSize = 4;  ///< Triangulos por hoja (ancho SIMD).
+	static constexpr uint32_t kBinCount = 12; ///< Bins por eje para evaluar el SAH.
+
+	struct Node {
+		XMFLOAT3 lower;
+		uint32_t first = 0;  ///< Hijo izquierdo (el derecho es first + 1) o paquete de la hoja.
+		XMFLOAT3 upper;
+		uint32_t count = 0;  ///< Triangulos de la hoja; 0 en nodos interiores.
+	};
+
+	/// Cuatro triangulos en columnas: v0 y las aristas e1 = v1 - v0, e2 = v2 - v0.
+	struct TrianglePacket {
+		XMFLOAT4 v0x, v0y, v0z;
+		XMFLOAT4 e1x, e1y, e1z;
+		XMFLOAT4 e2x, e2y, e2z;
+		uint32_t submesh[kLeafSize];
+		uint32_t triangle[kLeafSize];
+	};
+
+	/**
+	 * @brief Agrega los triangulos de una submalla; se indexa en el orden de llamada.
+	 *
+	 * `Vertex` debe exponer `Position` (como SimpleVertex).
+	 */
+	template<typename Vertex>
+	void
+	addSubmesh(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount);
+
+	/// Construye el arbol con los triangulos agregados y libera los datos de entrada.
+	void
+	build();
+
+	/**
+	 * @brief Impacto mas cercano del rayo `origin + t * direction` con `t` en (0, maxDistance).
+	 *
+	 * Recorre los hijos de cerca a lejos y poda los nodos que empiezan detras del
+	 * mejor impacto. Se prueban ambas caras de los triangulos.
+	 * @return `true` si hubo impacto; `outHit` solo se escribe en ese caso.
+	 */
+	bool
+	intersect(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, TriangleHit& outHit) const;
+
+	/// Reemplaza el arbol por uno ya construido (p. ej. leido del cache).
+	void
+	assign(std::vector<Node>&& nodes, std::vector<TrianglePacket>&& packets);
+
+	void
+	clear();
+
+	bool
+	isEmpty() const { return m_nodes.empty(); }
+
+	const std::vector<Node>&
+	getNodes() const { return m_nodes; }
+
+	const std::vector<TrianglePacket>&
+	getPackets() const { return m_packets; }
+
+	size_t
+	getTriangleCount() const { return m_triangleCount; }
+
+private:
+	/// Triangulo de entrada mientras se construye el arbol.
+	struct BuildTriangle {
+		XMFLOAT3 v0;
+		XMFLOAT3 v1;
+		XMFLOAT3 v2;
+		XMFLOAT3 lower;
+		XMFLOAT3 upper;
+		XMFLOAT3 centroid;
+		uint32_t submesh = 0;
+		uint32_t triangle = 0;
+	};
+
+	/// Cierra la hoja `node` con los triangulos [begin, end) de m_build.
+	void
+	makeLeaf(Node& node, size_t begin, size_t end);
+
+	/// Prueba el rayo contra los cuatro triangulos del paquete.
+	bool
+	intersectPacket(const TrianglePacket& packet, uint32_t count,
+	                FXMVECTOR origin, FXMVECTOR direction, TriangleHit& hit) const;
+
+	std::vector<Node> m_nodes;
+	std::vector<TrianglePacket> m_packets;
+	std::vector<BuildTriangle> m_build;   ///< Solo entre addSubmesh() y build().
+	uint32_t m_submeshCount = 0;
+	size_t m_triangleCount = 0;
+};
+
+template<typename Vertex>
+void
+TriangleBVH::addSubmesh(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount) {
+	const uint32_t submesh = m_submeshCount++;
+	for (size_t i = 0; i + 2 < indexCount; i += 3) {
+		if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount) {
+			continue;
+		}
+
+		BuildTriangle triangle;
+		const EU::Vector3& p0 = vertices[indices[i]].Position;
+		const EU::Vector3& p1 = vertices[indices[i + 1]].Position;
+		const EU::Vector3& p2 = vertices[indices[i + 2]].Position;
+		triangle.v0 = XMFLOAT3(p0.x, p0.y, p0.z);
+		triangle.v1 = XMFLOAT3(p1.x, p1.y, p1.z);
+		triangle.v2 = XMFLOAT3(p2.x, p2.y, p2.z);
+		triangle.lower = XMFLOAT3((std::min)((std::min)(p0.x, p1.x), p2.x),
+		                          (std::min)((std::min)(p0.y, p1.y), p2.y),
+		                          (std::min)((std::min)(p0.z, p1.z), p2.z));
+		triangle.upper = XMFLOAT3((std::max)((std::max)(p0.x, p1.x), p2.x),
+		                          (std::max)((std::max)(p0.y, p1.y), p2.y),
+		                          (std::max)((std::max)(p0.z, p1.z), p2.z));
+		triangle.centroid = XMFLOAT3((p0.x + p1.x + p2.x) / 3.0f,
+		                             (p0.y + p1.y + p2.y) / 3.0f,
+		                             (p0.z + p1.z + p2.z) / 3.0f);
+		triangle.submesh = submesh;
+		triangle.triangle = static_cast<uint32_t>(i / 3);
+		m_build.push_back(triangle);
+	}
+}
@@ -0,0 +1,158 @@
+/**
+ * @file ResourceHandle.h
+ * @brief Declara la API de ResourceHandle dentro del subsistema Core.
+ * @ingroup core
+ */
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @brief Handle tipado a un recurso registrado en el ResourceManager.
+ *
+ * Combina un indice de 32 bits dentro del arreglo de slots del tipo T con la
+ * generacion del slot al momento de registrarse. Resolverlo es un acceso por
+ * indice mas una comparacion de generacion: sin hash, sin RTTI y sin trafico
+ * de conteo de referencias.
+ */
+template<typename T>
+struct TResourceHandle {
+	static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+	uint32_t index = kInvalidIndex;  ///< Posicion del slot en el arreglo del tipo.
+	uint32_t generation = 0;         ///< Generacion esperada del slot (0 nunca es valida).
+
+	bool
+	isValid() const { return index != kInvalidIndex && generation != 0; }
+
+	bool
+	operator==(const TResourceHandle& other) const {
+		return index == other.index && generation == other.generation;
+	}
+
+	bool
+	operator!=(const TResourceHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Base no tipada para que el ResourceManager pueda invalidar todos los arreglos.
+ */
+class
+IResourceSlotArray {
+public:
+	virtual ~IResourceSlotArray() = default;
+
+	/// Libera el slot indicado sin conocer el tipo concreto.
+	virtual void
+	releaseIndex(uint32_t index) = 0;
+
+	/// Invalida todos los slots ocupados incrementando su generacion.
+	virtual void
+	releaseAll() = 0;
+};
+
+/**
+ * @brief Arreglo de slots por tipo con lista libre y contador de generacion.
+ *
+ * Los slots no poseen el recurso: el ResourceManager conserva la propiedad y el
+ * arreglo solo guarda el puntero crudo para la resolucion rapida. Al liberar un
+ * slot su generacion avanza, por lo que cualquier handle previo deja de resolver.
+ */
+template<typename T>
+class
+TResourceSlotArray : public IResourceSlotArray {
+public:
+	TResourceHandle<T>
+	allocate(T* resource) {
+		uint32_t index;
+		if (m_freeHead != TResourceHandle<T>::kInvalidIndex) {
+			index = m_freeHead;
+			m_freeHead = m_slots[index].nextFree;
+		}
+		else {
+			index = static_cast<uint32_t>(m_slots.size());
+			m_slots.push_back(Slot{});
+		}
+
+		Slot& slot = m_slots[index];
+		slot.resource = resource;
+		slot.nextFree = TResourceHandle<T>::kInvalidIndex;
+		return TResourceHandle<T>{ index, slot.generation };
+	}
+
+	T*
+	resolve(TResourceHandle<T> handle) const {
+		if (handle.index >= m_slots.size()) {
+			return nullptr;
+		}
+		const Slot& slot = m_slots[handle.index];
+		return slot.generation == handle.generation ? slot.resource : nullptr;
+	}
+
+	/// Reemplaza el recurso de un slot vivo conservando su generacion.
+	bool
+	replace(TResourceHandle<T> handle, T* resource) {
+		if (!resolve(handle)) {
+			return false;
+		}
+		m_slots[handle.index].resource = resource;
+		return true;
+	}
+
+	void
+	release(TResourceHandle<T> handle) {
+		if (!resolve(handle)) {
+			return;
+		}
+		releaseSlot(handle.index);
+	}
+
+	void
+	releaseIndex(uint32_t index) override {
+		if (index < m_slots.size() && m_slots[index].resource) {
+			releaseSlot(index);
+		}
+	}
+
+	uint32_t
+	generationOf(uint32_t index) const {
+		return index < m_slots.size() ? m_slots[index].generation : 0;
+	}
+
+	void
+	releaseAll() override {
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_slots.size()); ++i) {
+			if (m_slots[i].resource) {
+				releaseSlot(i);
+			}
+		}
+	}
+
+	size_t
+	liveCount() const {
+		size_t count = 0;
+		for (const Slot& slot : m_slots) {
+			count += slot.resource ? 1 : 0;
+		}
+		return count;
+	}
+
+private:
+	struct Slot {
+		T* resource = nullptr;
+		uint32_t generation = 1;
+		uint32_t nextFree = TResourceHandle<T>::kInvalidIndex;
+	};
+
+	void
+	releaseSlot(uint32_t index) {
+		Slot& slot = m_slots[index];
+		slot.resource = nullptr;
+		// La generacion 0 queda reservada para handles nulos.
+		slot.generation = (slot.generation + 1 == 0) ? 1 : slot.generation + 1;
+		slot.nextFree = m_freeHead;
+		m_freeHead = index;
+	}
+
+	std::vector<Slot> m_slots;
+	uint32_t m_freeHead = TResourceHandle<T>::kInvalidIndex;
+};
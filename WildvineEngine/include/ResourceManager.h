@@ -6,6 +6,8 @@
 #pragma once
 #include "Prerequisites.h"
 #include "IResource.h"
+#include "ResourceHandle.h"
+#include <algorithm>
 
 class 
 ResourceManager {
@@ -33,7 +35,7 @@ public:
 		auto it = m_resources.find(key);
 		if (it != m_resources.end()) {
 			// Intentar castear al tipo correcto
-			auto existing = std::dynamic_pointer_cast<T>(it->second);
+			auto existing = std::dynamic_pointer_cast<T>(it->second.resource);
 			if (existing && existing->GetState() == ResourceState::Loaded) {
 				return existing; // Flyweight: reutilizamos la instancia
 			}
@@ -52,10 +54,79 @@ public:
 		}
 
 		// 3. Guardar en el cach y devolver
-		m_resources[key] = resource;
+		Register<T>(key, resource);
+		RecordAsset(filename, resource->GetType());
 		return resource;
 	}
 
+	/// Carga (o reutiliza) un recurso y devuelve su handle generacional.
+	/// La clave string solo se usa aqui; el acceso posterior es via Resolve().
+	template<typename T, typename... Args>
+	TResourceHandle<T> LoadHandle(const std::string& key,
+	                              const std::string& filename,
+	                              Args&&... args) {
+		if (!GetOrLoad<T>(key, filename, std::forward<Args>(args)...)) {
+			return TResourceHandle<T>{};
+		}
+		return FindHandle<T>(key);
+	}
+
+	/// Registra un recurso ya creado bajo una clave y le asigna un slot.
+	/// Si la clave existia, el slot anterior se invalida.
+	template<typename T>
+	TResourceHandle<T> Register(const std::string& key, std::shared_ptr<T> resource) {
+		static_assert(std::is_base_of<IResource, T>::value,
+                      "T debe heredar de IResource");
+		Unload(key);
+
+		ResourceEntry entry;
+		entry.resource = resource;
+		entry.typeIndex = GetTypeIndex<T>();
+		TResourceHandle<T> handle = GetSlotArray<T>().allocate(resource.get());
+		entry.slotIndex = handle.index;
+		m_resources[key] = std::move(entry);
+		return handle;
+	}
+
+	/// Sustituye el recurso de una clave ya registrada conservando su slot y su
+	/// generacion, de modo que los handles existentes resuelven al nuevo recurso.
+	/// Debe llamarse desde el hilo principal (recarga en caliente).
+	template<typename T>
+	bool Replace(const std::string& key, std::shared_ptr<T> resource) {
+		auto it = m_resources.find(key);
+		if (!resource || it == m_resources.end() || it->second.typeIndex != GetTypeIndex<T>()) {
+			return false;
+		}
+		TResourceHandle<T> handle = FindHandle<T>(key);
+		if (!GetSlotArray<T>().replace(handle, resource.get())) {
+			return false;
+		}
+		std::shared_ptr<IResource> previous = it->second.resource;
+		it->second.resource = resource;
+		if (previous) {
+			previous->unload();
+		}
+		return true;
+	}
+
+	/// Devuelve el handle vivo asociado a una clave, o un handle nulo.
+	template<typename T>
+	TResourceHandle<T> FindHandle(const std::string& key) {
+		auto it = m_resources.find(key);
+		if (it == m_resources.end() || it->second.typeIndex != GetTypeIndex<T>()) {
+			return TResourceHandle<T>{};
+		}
+		TResourceSlotArray<T>& slots = GetSlotArray<T>();
+		return TResourceHandle<T>{ it->second.slotIndex, slots.generationOf(it->second.slotIndex) };
+	}
+
+	/// Resuelve un handle: indice en el arreglo del tipo y chequeo de generacion.
+	/// Devuelve nullptr si el recurso fue descargado (handle obsoleto).
+	template<typename T>
+	T* Resolve(TResourceHandle<T> handle) {
+		return GetSlotArray<T>().resolve(handle);
+	}
+
 	/// Obtener un recurso ya cargado, sin cargarlo si no existe.
 	template<typename T>
 	std::shared_ptr<T> Get(const std::string& key) const
@@ -63,15 +134,48 @@ public:
 		auto it = m_resources.find(key);
 		if (it == m_resources.end()) return nullptr;
 
-		return std::dynamic_pointer_cast<T>(it->second);
+		return std::dynamic_pointer_cast<T>(it->second.resource);
 	}
 
+	/// Nodo del grafo de dependencias: un archivo de asset y los archivos que necesita.
+	struct DependencyNode {
+		ResourceType type = ResourceType::Unknown;
+		std::vector<std::string> dependencies;
+	};
+
+	using DependencyGraph = std::unordered_map<std::string, DependencyNode>;
+
+	/// Registra un archivo cargado como nodo del grafo de dependencias.
+	void RecordAsset(const std::string& path, ResourceType type)
+	{
+		DependencyNode& node = m_dependencyGraph[path];
+		if (node.type == ResourceType::Unknown) {
+			node.type = type;
+		}
+	}
+
+	/// Registra que `owner` necesita `dependency` (p. ej. escena -> modelo -> textura).
+	void RecordDependency(const std::string& owner, const std::string& dependency)
+	{
+		std::vector<std::string>& dependencies = m_dependencyGraph[owner].dependencies;
+		if (std::find(dependencies.begin(), dependencies.end(), dependency) == dependencies.end()) {
+			dependencies.push_back(dependency);
+		}
+		m_dependencyGraph[dependency];
+	}
+
+	const DependencyGraph& GetDependencyGraph() const { return m_dependencyGraph; }
+
 	/// Liberar un recurso especfico
 	void Unload(const std::string& key)
 	{
 		auto it = m_resources.find(key);
 		if (it != m_resources.end()) {
-			it->second->unload();
+			ResourceEntry& entry = it->second;
+			if (entry.typeIndex < m_slotArrays.size() && m_slotArrays[entry.typeIndex]) {
+				m_slotArrays[entry.typeIndex]->releaseIndex(entry.slotIndex);
+			}
+			entry.resource->unload();
 			m_resources.erase(it);
 		}
 	}
@@ -79,15 +183,52 @@ public:
 	/// Liberar todos los recursos
 	void UnloadAll()
 	{
-		for (auto& [key, res] : m_resources) {
-			if (res) {
-				res->unload();
+		for (auto& [key, entry] : m_resources) {
+			if (entry.resource) {
+				entry.resource->unload();
+			}
+		}
+		for (auto& slots : m_slotArrays) {
+			if (slots) {
+				slots->releaseAll();
 			}
 		}
 		m_resources.clear();
 	}
 
 private:
-	std::unordered_map<std::string, std::shared_ptr<IResource>> m_resources;
+	struct ResourceEntry {
+		std::shared_ptr<IResource> resource;
+		uint32_t typeIndex = 0;
+		uint32_t slotIndex = 0;
+	};
+
+	/// Indice compacto por tipo, asignado la primera vez que se usa T.
+	template<typename T>
+	static uint32_t GetTypeIndex() {
+		static const uint32_t index = s_nextTypeIndex()++;
+		return index;
+	}
+
+	static uint32_t& s_nextTypeIndex() {
+		static uint32_t next = 0;
+		return next;
+	}
+
+	template<typename T>
+	TResourceSlotArray<T>& GetSlotArray() {
+		const uint32_t typeIndex = GetTypeIndex<T>();
+		if (typeIndex >= m_slotArrays.size()) {
+			m_slotArrays.resize(typeIndex + 1);
+		}
+		if (!m_slotArrays[typeIndex]) {
+			m_slotArrays[typeIndex] = std::make_unique<TResourceSlotArray<T>>();
+		}
+		return static_cast<TResourceSlotArray<T>&>(*m_slotArrays[typeIndex]);
+	}
+
+	std::unordered_map<std::string, ResourceEntry> m_resources;
+	std::vector<std::unique_ptr<IResourceSlotArray>> m_slotArrays;
+	DependencyGraph m_dependencyGraph;
 };
 
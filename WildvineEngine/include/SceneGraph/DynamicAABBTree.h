@@ -0,0 +1,390 @@
+/**
+ * @file DynamicAABBTree.h
+ * @brief Declara la API de DynamicAABBTree dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "SceneGraph/SpatialIndex.h"
+#include <atomic>
+
+/**
+ * @class DynamicAABBTree
+ * @brief BVH dinamico de cajas alineadas a ejes con hojas por proxy.
+ *
+ * Cada proxy (un renderable) es una hoja con una caja "gorda": la caja real
+ * ampliada por un margen. Mientras la caja real siga dentro de la gorda, mover
+ * el proxy no toca el arbol. Al salirse, la hoja se quita y se reinserta
+ * eligiendo el hermano de menor coste de area (SAH), y los ancestros se
+ * reajustan (refit) y rebalancean con rotaciones tipo AVL en el camino de
+ * vuelta a la raiz.
+ *
+ * Los nodos viven en un arreglo con lista libre; los indices de proxy son
+ * estables hasta destroyProxy(). No es thread-safe para escritura; las
+ * consultas son const y pueden correr en paralelo entre si. Reutilizan la pila
+ * de recorrido del arbol para no reservar memoria por llamada (ver StackLease).
+ *
+ * Ademas de la interfaz SpatialIndex expone consultas con plantilla, sin
+ * vector intermedio, para quien conoce el tipo concreto.
+ */
+class
+DynamicAABBTree : public SpatialIndex {
+public:
+	static constexpr int32_t kNullNode = -1;
+
+	DynamicAABBTree() = default;
+	~DynamicAABBTree() override = default;
+
+	/**
+	 * @brief Crea una hoja para `bounds` y devuelve su indice de proxy.
+	 */
+	int32_t
+	createProxy(const Bounds& bounds, void* userData) override;
+
+	void
+	destroyProxy(int32_t proxy) override;
+
+	/**
+	 * @brief Actualiza la caja de un proxy.
+	 * @return `true` si la hoja se reinserto; `false` si la caja gorda aun la contenia.
+	 */
+	bool
+	moveProxy(int32_t proxy, const Bounds& bounds) override;
+
+	void*
+	getUserData(int32_t proxy) const override { return m_nodes[proxy].userData; }
+
+	/// Caja gorda almacenada en la hoja.
+	Bounds
+	getFatBounds(int32_t proxy) const {
+		return Bounds::fromMinMax(m_nodes[proxy].lower, m_nodes[proxy].upper);
+	}
+
+	void
+	clear() override;
+
+	/// Margen con el que se engordan las cajas de las hojas (unidades world).
+	void
+	setMargin(float margin) { m_margin = margin; }
+
+	size_t
+	getProxyCount() const override { return m_proxyCount; }
+
+	size_t
+	getProxyCapacity() const override { return m_nodes.size(); }
+
+	/// Las hojas son los proxies: un arbol binario completo tiene 2n - 1 nodos.
+	size_t
+	getNodeCount() const override { return m_proxyCount == 0 ? 0 : 2 * m_proxyCount - 1; }
+
+	/// Altura del arbol (0 con una sola hoja, -1 vacio).
+	int32_t
+	getHeight() const { return m_root == kNullNode ? -1 : m_nodes[m_root].height; }
+
+	/// Reinserciones acumuladas desde el ultimo resetCounters().
+	uint32_t
+	getReinsertCount() const override { return m_reinsertCount; }
+
+	void
+	resetCounters() override { m_reinsertCount = 0; }
+
+	uint32_t
+	collectFrustum(const Frustum& frustum, std::vector<SpatialHit>& outHits) const override;
+
+	void
+	collectSphere(const XMFLOAT3& center, float radius, std::vector<int32_t>& outProxies) const override;
+
+	void
+	collectAABB(const Bounds& bounds, std::vector<int32_t>& outProxies) const override;
+
+	void
+	collectRay(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance,
+	           std::vector<SpatialRayHit>& outHits) const override;
+
+	/**
+	 * @brief Hojas cuya caja gorda toca el frustum.
+	 *
+	 * Un subarbol completamente dentro se reporta sin mas pruebas de planos.
+	 * @param fn Invocado como `fn(int32_t proxy, bool fullyInside)`.
+	 * @return Nodos probados contra el frustum.
+	 */
+	template<typename Fn>
+	uint32_t
+	queryFrustum(const Frustum& frustum, Fn&& fn) const;
+
+	/**
+	 * @brief Hojas cuya caja gorda se solapa con `bounds`.
+	 * @param fn Invocado como `fn(int32_t proxy)`; devolver `false` detiene la consulta.
+	 */
+	template<typename Fn>
+	void
+	queryAABB(const Bounds& bounds, Fn&& fn) const;
+
+	/**
+	 * @brief Hojas cuya caja gorda toca la esfera.
+	 * @param fn Invocado como `fn(int32_t proxy)`; devolver `false` detiene la consulta.
+	 */
+	template<typename Fn>
+	void
+	querySphere(const XMFLOAT3& center, float radius, Fn&& fn) const;
+
+	/**
+	 * @brief Hojas atravesadas por el rayo `origin + t * direction`, `t` en [0, maxDistance].
+	 *
+	 * @param fn Invocado como `fn(int32_t proxy, float tEnter)` y devuelve la nueva
+	 *           distancia maxima: la misma para seguir, el `t` de un impacto para
+	 *           recortar el rayo, o 0 para terminar.
+	 */
+	template<typename Fn>
+	void
+	queryRay(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, Fn&& fn) const;
+
+private:
+	struct Node {
+		XMFLOAT3 lower;
+		XMFLOAT3 upper;
+		int32_t parent = kNullNode;    ///< Siguiente libre cuando el nodo no esta en uso.
+		int32_t child1 = kNullNode;
+		int32_t child2 = kNullNode;
+		int32_t height = -1;           ///< 0 en hojas, -1 en nodos libres.
+		void* userData = nullptr;
+
+		bool
+		isLeaf() const { return child1 == kNullNode; }
+	};
+
+	int32_t
+	allocateNode();
+
+	void
+	freeNode(int32_t node);
+
+	void
+	insertLeaf(int32_t leaf);
+
+	void
+	removeLeaf(int32_t leaf);
+
+	/// Rota el nodo si sus hijos difieren en mas de un nivel; devuelve la nueva raiz del subarbol.
+	int32_t
+	balance(int32_t node);
+
+	/// Recalcula caja y altura desde `node` hasta la raiz, balanceando en el camino.
+	void
+	refitAncestors(int32_t node);
+
+	void
+	setUnion(Node& node, const Node& a, const Node& b);
+
+	static float
+	surfaceArea(const XMFLOAT3& lower, const XMFLOAT3& upper);
+
+	static bool
+	overlaps(const Node& node, const XMFLOAT3& lower, const XMFLOAT3& upper);
+
+	/**
+	 * @brief Presta m_stack a una consulta mientras dure.
+	 *
+	 * Si otra consulta ya la tiene (otro hilo, o una consulta anidada desde `fn`)
+	 * se usa una pila propia: la reserva vuelve, pero nunca comparten pila.
+	 */
+	class StackLease {
+	public:
+		explicit StackLease(const DynamicAABBTree& tree)
+			: m_tree(tree), m_owner(!tree.m_stackInUse.exchange(true, std::memory_order_acquire)) {
+			if (m_owner) {
+				m_tree.m_stack.clear();
+			}
+			else {
+				m_local.reserve(64);
+			}
+		}
+
+		~StackLease() {
+			if (m_owner) {
+				m_tree.m_stackInUse.store(false, std::memory_order_release);
+			}
+		}
+
+		StackLease(const StackLease&) = delete;
+		StackLease& operator=(const StackLease&) = delete;
+
+		std::vector<int32_t>&
+		get() { return m_owner ? m_tree.m_stack : m_local; }
+
+	private:
+		const DynamicAABBTree& m_tree;
+		std::vector<int32_t> m_local;
+		bool m_owner;
+	};
+
+	/// Recorre las hojas del subarbol de `node` sin pruebas.
+	template<typename Fn>
+	void
+	forEachLeaf(int32_t node, std::vector<int32_t>& stack, Fn&& fn) const;
+
+	std::vector<Node> m_nodes;
+	int32_t m_root = kNullNode;
+	int32_t m_freeList = kNullNode;
+	size_t m_proxyCount = 0;
+	float m_margin = 0.1f;
+	uint32_t m_reinsertCount = 0;
+	mutable std::vector<int32_t> m_stack;           ///< Pila de recorrido de las consultas.
+	mutable std::atomic<bool> m_stackInUse{ false }; ///< Una consulta tiene prestada m_stack.
+};
+
+template<typename Fn>
+void
+DynamicAABBTree::forEachLeaf(int32_t node, std::vector<int32_t>& stack, Fn&& fn) const {
+	const size_t base = stack.size();
+	stack.push_back(node);
+	while (stack.size() > base) {
+		const int32_t index = stack.back();
+		stack.pop_back();
+		const Node& current = m_nodes[index];
+		if (current.isLeaf()) {
+			fn(index);
+		}
+		else {
+			stack.push_back(current.child1);
+			stack.push_back(current.child2);
+		}
+	}
+}
+
+template<typename Fn>
+uint32_t
+DynamicAABBTree::queryFrustum(const Frustum& frustum, Fn&& fn) const {
+	uint32_t tested = 0;
+	if (m_root == kNullNode) {
+		return tested;
+	}
+
+	StackLease lease(*this);
+	std::vector<int32_t>& stack = lease.get();
+	stack.push_back(m_root);
+	while (!stack.empty()) {
+		const int32_t index = stack.back();
+		stack.pop_back();
+		const Node& node = m_nodes[index];
+
+		++tested;
+		const Frustum::Containment containment =
+			frustum.classify(Bounds::fromMinMax(node.lower, node.upper));
+		if (containment == Frustum::Containment::Outside) {
+			continue;
+		}
+		if (containment == Frustum::Containment::Inside) {
+			forEachLeaf(index, stack, [&fn](int32_t leaf) { fn(leaf, true); });
+			continue;
+		}
+		if (node.isLeaf()) {
+			fn(index, false);
+		}
+		else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+	return tested;
+}
+
+template<typename Fn>
+void
+DynamicAABBTree::queryAABB(const Bounds& bounds, Fn&& fn) const {
+	if (m_root == kNullNode || !bounds.isValid()) {
+		return;
+	}
+
+	const XMFLOAT3 lower = bounds.getMin();
+	const XMFLOAT3 upper = bounds.getMax();
+	StackLease lease(*this);
+	std::vector<int32_t>& stack = lease.get();
+	stack.push_back(m_root);
+	while (!stack.empty()) {
+		const int32_t index = stack.back();
+		stack.pop_back();
+		const Node& node = m_nodes[index];
+		if (!overlaps(node, lower, upper)) {
+			continue;
+		}
+		if (node.isLeaf()) {
+			if (!fn(index)) {
+				return;
+			}
+		}
+		else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
+
+template<typename Fn>
+void
+DynamicAABBTree::querySphere(const XMFLOAT3& center, float radius, Fn&& fn) const {
+	if (m_root == kNullNode) {
+		return;
+	}
+
+	const float radiusSq = radius * radius;
+	StackLease lease(*this);
+	std::vector<int32_t>& stack = lease.get();
+	stack.push_back(m_root);
+	while (!stack.empty()) {
+		const int32_t index = stack.back();
+		stack.pop_back();
+		const Node& node = m_nodes[index];
+
+		// Distancia del centro al punto mas cercano de la caja.
+		const float dx = (std::max)((std::max)(node.lower.x - center.x, 0.0f), center.x - node.upper.x);
+		const float dy = (std::max)((std::max)(node.lower.y - center.y, 0.0f), center.y - node.upper.y);
+		const float dz = (std::max)((std::max)(node.lower.z - center.z, 0.0f), center.z - node.upper.z);
+		if (dx * dx + dy * dy + dz * dz > radiusSq) {
+			continue;
+		}
+		if (node.isLeaf()) {
+			if (!fn(index)) {
+				return;
+			}
+		}
+		else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
+
+template<typename Fn>
+void
+DynamicAABBTree::queryRay(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, Fn&& fn) const {
+	if (m_root == kNullNode) {
+		return;
+	}
+
+	const XMFLOAT3 inverse(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+	StackLease lease(*this);
+	std::vector<int32_t>& stack = lease.get();
+	stack.push_back(m_root);
+	while (!stack.empty()) {
+		const int32_t index = stack.back();
+		stack.pop_back();
+		const Node& node = m_nodes[index];
+
+		float tEnter = 0.0f;
+		if (!Bounds::rayIntersects(node.lower, node.upper, origin, inverse, maxDistance, tEnter)) {
+			continue;
+		}
+		if (node.isLeaf()) {
+			maxDistance = fn(index, tEnter);
+			if (maxDistance <= 0.0f) {
+				return;
+			}
+		}
+		else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
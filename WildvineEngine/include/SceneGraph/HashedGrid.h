@@ -0,0 +1,176 @@
+/**
+ * @file HashedGrid.h
+ * @brief Declara la API de HashedGrid dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ */
+#pragma once
+#include "SceneGraph/SpatialIndex.h"
+
+/**
+ * @class HashedGrid
+ * @brief Rejilla uniforme "suelta" guardada en una tabla hash de celdas ocupadas.
+ *
+ * Cada proxy vive en una sola celda: la que contiene el centro de su caja. La
+ * celda guarda la union de las cajas de sus proxies (su caja suelta), que es lo
+ * que se prueba en las consultas; un objeto grande no se replica en varias
+ * celdas. Solo existen las celdas ocupadas, asi que el mundo no tiene limites
+ * fijos y la memoria crece con los objetos, no con el volumen.
+ *
+ * Insertar, quitar y mover son O(1): una busqueda en la tabla y un push_back o
+ * un swap-remove dentro de la celda. Las celdas estan densas en un arreglo, y
+ * cada una guarda sus proxies contiguos, asi que las consultas recorren memoria
+ * secuencial en lugar de saltar por nodos.
+ *
+ * La caja de una celda solo crece mientras tenga proxies (se reinicia al
+ * vaciarse). Es conservadora: en mundos casi estaticos coincide con la union
+ * exacta.
+ */
+class
+HashedGrid : public SpatialIndex {
+public:
+	static constexpr float kDefaultCellSize = 16.0f;
+
+	explicit HashedGrid(float cellSize = kDefaultCellSize) : m_cellSize(cellSize) {}
+	~HashedGrid() override = default;
+
+	int32_t
+	createProxy(const Bounds& bounds, void* userData) override;
+
+	void
+	destroyProxy(int32_t proxy) override;
+
+	bool
+	moveProxy(int32_t proxy, const Bounds& bounds) override;
+
+	void*
+	getUserData(int32_t proxy) const override { return m_proxies[proxy].userData; }
+
+	void
+	clear() override;
+
+	size_t
+	getProxyCount() const override { return m_proxyCount; }
+
+	size_t
+	getProxyCapacity() const override { return m_proxies.size(); }
+
+	size_t
+	getNodeCount() const override { return m_cells.size(); }
+
+	uint32_t
+	getReinsertCount() const override { return m_reinsertCount; }
+
+	void
+	resetCounters() override { m_reinsertCount = 0; }
+
+	uint32_t
+	collectFrustum(const Frustum& frustum, std::vector<SpatialHit>& outHits) const override;
+
+	void
+	collectSphere(const XMFLOAT3& center, float radius, std::vector<int32_t>& outProxies) const override;
+
+	void
+	collectAABB(const Bounds& bounds, std::vector<int32_t>& outProxies) const override;
+
+	void
+	collectRay(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance,
+	           std::vector<SpatialRayHit>& outHits) const override;
+
+	/**
+	 * @brief Cambia el tamano de celda y redistribuye los proxies existentes.
+	 *
+	 * Conviene del orden del objeto tipico: celdas mucho menores que los objetos
+	 * inflan las cajas sueltas; mucho mayores devuelven demasiados candidatos.
+	 */
+	void
+	setCellSize(float cellSize);
+
+	float
+	getCellSize() const { return m_cellSize; }
+
+private:
+	struct Cell {
+		int32_t x = 0;
+		int32_t y = 0;
+		int32_t z = 0;
+		XMFLOAT3 lower;                ///< Union de las cajas de sus proxies.
+		XMFLOAT3 upper;
+		std::vector<int32_t> proxies;  ///< Proxies cuyo centro cae en la celda.
+	};
+
+	struct Proxy {
+		Bounds bounds;
+		void* userData = nullptr;
+		uint32_t cell = UINT32_MAX;    ///< Indice en m_cells; UINT32_MAX si el proxy esta libre.
+		uint32_t slot = 0;             ///< Posicion en Cell::proxies.
+	};
+
+	/// Coordenada de celda de un valor world, acotada al rango que admite la llave.
+	int32_t
+	cellCoordinate(float value) const;
+
+	static uint64_t
+	cellKey(int32_t x, int32_t y, int32_t z);
+
+	/// Mete el proxy en la celda de su centro, creandola si no existe.
+	void
+	insertIntoCell(int32_t proxy);
+
+	/// Saca el proxy de su celda; la celda vacia se elimina.
+	void
+	removeFromCell(int32_t proxy);
+
+	/**
+	 * @brief Invoca `fn(const Cell&)` por cada celda que pueda tener proxies dentro de [lower, upper].
+	 *
+	 * Si el rango abarca menos celdas que las ocupadas, las busca en la tabla;
+	 * si no, recorre el arreglo de celdas.
+	 */
+	template<typename Fn>
+	void
+	forEachCellInRange(const XMFLOAT3& lower, const XMFLOAT3& upper, Fn&& fn) const;
+
+	float m_cellSize = kDefaultCellSize;
+	std::vector<Cell> m_cells;                         ///< Celdas ocupadas, densas.
+	std::unordered_map<uint64_t, uint32_t> m_lookup;   ///< Llave de celda -> indice en m_cells.
+	std::vector<Proxy> m_proxies;
+	std::vector<int32_t> m_freeProxies;
+	size_t m_proxyCount = 0;
+	float m_maxExtent = 0.0f;          ///< Semiextension maxima vista; amplia los rangos de busqueda.
+	uint32_t m_reinsertCount = 0;
+};
+
+template<typename Fn>
+void
+HashedGrid::forEachCellInRange(const XMFLOAT3& lower, const XMFLOAT3& upper, Fn&& fn) const {
+	if (m_cells.empty()) {
+		return;
+	}
+
+	// Un proxy puede sobresalir de su celda hasta m_maxExtent.
+	const int32_t x0 = cellCoordinate(lower.x - m_maxExtent);
+	const int32_t y0 = cellCoordinate(lower.y - m_maxExtent);
+	const int32_t z0 = cellCoordinate(lower.z - m_maxExtent);
+	const int32_t x1 = cellCoordinate(upper.x + m_maxExtent);
+	const int32_t y1 = cellCoordinate(upper.y + m_maxExtent);
+	const int32_t z1 = cellCoordinate(upper.z + m_maxExtent);
+	const double rangeCells = double(x1 - x0 + 1) * double(y1 - y0 + 1) * double(z1 - z0 + 1);
+
+	if (rangeCells > double(m_cells.size())) {
+		for (const Cell& cell : m_cells) {
+			fn(cell);
+		}
+		return;
+	}
+
+	for (int32_t z = z0; z <= z1; ++z) {
+		for (int32_t y = y0; y <= y1; ++y) {
+			for (int32_t x = x0; x <= x1; ++x) {
+				const auto found = m_lookup.find(cellKey(x, y, z));
+				if (found != m_lookup.end()) {
+					fn(m_cells[found->second]);
+				}
+			}
+		}
+	}
+}
@@ -6,13 +6,17 @@
 #pragma once
 #include "Prerequisites.h"
 #include "ECS/Component.h"
+#include "ECS/Entity.h"
+#include "Rendering/Bounds.h"
 
 class DeviceContext;
-class Entity;
 
 class 
-HierarchyComponent : public Component {
+HierarchyComponent : public Component, public EU::TPooledObject<HierarchyComponent> {
 public:
+	static constexpr ComponentType kType = ComponentType::HIERARCHY; ///< Indice en la tabla de componentes.
+	static constexpr uint32_t kNoChildIndex = static_cast<uint32_t>(-1);
+
 	HierarchyComponent() : Component(ComponentType::HIERARCHY) {}
 	~HierarchyComponent() = default;
 
@@ -29,6 +33,10 @@ public:
 	destroy() override { 
 		m_children.clear(); 
 		m_parent = nullptr; 
+		m_flatIndex = static_cast<uint32_t>(-1);
+		m_subtreeBounds = Bounds{};
+		m_spatialProxy = -1;
+		m_spatialVersion = UINT32_MAX;
 	}
 
 	// API SceneGraph
@@ -47,30 +55,54 @@ public:
 		return !m_children.empty();
 	}
 
+	/**
+	 * @brief Agrega un hijo en O(1); su posicion queda en su m_childIndex.
+	 */
 	void 
 	addChild(Entity* child) {
-		if(!child) {
+		HierarchyComponent* childHierarchy = child ? child->getComponent<HierarchyComponent>() : nullptr;
+		if (!childHierarchy || ownsChild(child, childHierarchy)) {
 			return;
 		}
 
-		if (std::find(m_children.begin(), m_children.end(), child) != m_children.end()) {
-			return;
-		}
+		childHierarchy->m_childIndex = static_cast<uint32_t>(m_children.size());
 		m_children.push_back(child);
 	}
 
+	/**
+	 * @brief Quita un hijo en O(1): el ultimo ocupa su hueco (el orden no se conserva).
+	 */
 	void
 	removeChild(Entity* child) {
-		if (!child) return;
+		HierarchyComponent* childHierarchy = child ? child->getComponent<HierarchyComponent>() : nullptr;
+		if (!childHierarchy || !ownsChild(child, childHierarchy)) {
+			return;
+		}
+
+		const uint32_t index = childHierarchy->m_childIndex;
+		Entity* last = m_children.back();
+		m_children[index] = last;
+		last->getComponent<HierarchyComponent>()->m_childIndex = index;
+		m_children.pop_back();
+		childHierarchy->m_childIndex = kNoChildIndex;
+	}
 
-		m_children.erase(
-			std::remove(m_children.begin(), m_children.end(), child),
-			m_children.end()
-		);
+private:
+	/// m_childIndex solo es valido si apunta a `child` dentro de esta lista.
+	bool
+	ownsChild(Entity* child, const HierarchyComponent* childHierarchy) const {
+		return childHierarchy->m_childIndex < m_children.size() &&
+		       m_children[childHierarchy->m_childIndex] == child;
 	}
 
 public:
 	Entity* m_parent = nullptr;
 	std::vector<Entity*> m_children;
+	uint32_t m_childIndex = kNoChildIndex; ///< Posicion en m_children del padre.
+	uint32_t m_flatIndex = static_cast<uint32_t>(-1); ///< Indice en TransformHierarchy; -1 si no esta registrada.
+	Bounds m_subtreeBounds; ///< Union world de las mallas del subarbol; la escribe TransformHierarchy::updateBounds().
+	uint32_t m_boundsVersion = 0; ///< Se incrementa cada vez que se recalcula m_subtreeBounds.
+	int32_t m_spatialProxy = -1; ///< Proxy de la rama en el indice espacial (solo raices con hijos).
+	uint32_t m_spatialVersion = UINT32_MAX; ///< m_boundsVersion con la que se actualizo el proxy.
 };
 
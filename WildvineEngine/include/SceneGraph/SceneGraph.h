@@ -5,12 +5,66 @@
  */
 #pragma once
 #include "Prerequisites.h"
+#include "ECS/ArchetypeStorage.h"
+#include "ECS/SystemScheduler.h"
+#include "SceneGraph/TransformHierarchy.h"
+#include "Rendering/Frustum.h"
+#include "Rendering/OcclusionBuffer.h"
+#include "SceneGraph/DynamicAABBTree.h"
+#include "SceneGraph/HashedGrid.h"
 
 class Entity;
 class DeviceContext;
 class Camera;
 class RenderScene;
 
+/**
+ * @brief Tiempos del ultimo frame y ocupacion del almacenamiento por arquetipos.
+ */
+struct SceneGraphStats {
+	int64_t updateUs = 0;      ///< Duracion de update() en microsegundos.
+	int64_t gatherUs = 0;      ///< Duracion de gatherRenderScene() en microsegundos (sin gatherLights()).
+	size_t entityCount = 0;
+	size_t archetypeCount = 0;
+	size_t chunkCount = 0;
+	size_t renderableCount = 0;   ///< Coincidencias de la consulta de render.
+	size_t lightCount = 0;        ///< Coincidencias de la consulta de luces.
+	size_t frustumTested = 0;     ///< Cajas ajustadas probadas contra el frustum (proxies que lo cortan).
+	size_t frustumCulled = 0;     ///< Renderables descartados por el frustum de la camara.
+	size_t shadowCasters = 0;     ///< Casters fuera de camara que aportaron los volumenes de sombra.
+	uint32_t spatialNodesTested = 0; ///< Nodos o celdas visitados por la consulta de frustum.
+	size_t spatialProxies = 0;       ///< Proxies en el indice espacial.
+	size_t spatialNodes = 0;         ///< Nodos del arbol o celdas ocupadas de la rejilla.
+	int32_t spatialHeight = -1;      ///< Altura del arbol espacial (-1 con la rejilla).
+	uint32_t spatialUpdates = 0;     ///< Proxies con Transform cambiado este frame.
+	uint32_t spatialReinserts = 0;   ///< Proxies que cambiaron de nodo o de celda.
+	size_t branchProxies = 0;   ///< Jerarquias indexadas como un solo proxy con la caja de su subarbol.
+	uint32_t boundsUpdates = 0; ///< Cajas de subarbol recalculadas este frame.
+	size_t branchNodes = 0;     ///< Nodos de las ramas que tocaron el frustum o un volumen de sombra: pruebas de un culling por entidad.
+	size_t branchTested = 0;    ///< Cajas probadas al recorrer esas ramas.
+	uint32_t workerCount = 0; ///< Hilos del JobSystem que ejecutaron los sistemas.
+	uint32_t localUpdates = 0; ///< Matrices locales recalculadas (transforms sucios).
+	uint32_t worldUpdates = 0; ///< Matrices world recalculadas (subarboles sucios).
+	int64_t worldUs = 0;       ///< Duracion de la propagacion world en microsegundos.
+	size_t hierarchyLevels = 0; ///< Niveles de profundidad que usa la propagacion paralela.
+	size_t occluders = 0;        ///< Oclusores rasterizados en el buffer de oclusion.
+	size_t occlusionTested = 0;  ///< Cajas dentro del frustum probadas contra el buffer.
+	size_t occlusionCulled = 0;  ///< Renderables ocultos tras los oclusores.
+	int64_t occlusionUs = 0;     ///< Rasterizado mas pruebas de oclusion en microsegundos.
+};
+
+/**
+ * @brief Impacto de SceneGraph::raycast() contra la geometria de un renderable.
+ */
+struct RaycastHit {
+	Entity* entity = nullptr;
+	uint32_t submesh = UINT32_MAX;  ///< Submalla del Mesh impactada.
+	uint32_t triangle = UINT32_MAX; ///< Triangulo dentro de la submalla.
+	float distance = 0.0f;          ///< Distancia world desde el origen del rayo.
+	XMFLOAT3 position = XMFLOAT3(0.0f, 0.0f, 0.0f); ///< Punto de impacto en world.
+	uint32_t candidatesTested = 0;  ///< Mallas cuyo BVH de triangulos se recorrio.
+};
+
 /**
  * @class SceneGraph
  * @brief Administra la jerarquia de entidades y su actualizacion espacial.
@@ -41,9 +95,20 @@ public:
 	void 
 	removeEntity(Entity* e);
 
+	/**
+	 * @brief Indica si `possibleAncestor` esta por encima de `node` en la jerarquia.
+	 *
+	 * O(1) para entidades registradas: compara sus intervalos de preorden.
+	 */
 	bool 
 	isAncestor(Entity* possibleAncestor, Entity* node) const;
 
+	/**
+	 * @brief Indica si `node` es `root` o uno de sus descendientes.
+	 */
+	bool
+	isInSubtree(Entity* root, Entity* node) const;
+
 	bool
 	attach(Entity* child, Entity* parent);
 
@@ -56,25 +121,170 @@ public:
 	void 
 	render(DeviceContext& deviceContext);
 
+	/**
+	 * @brief Agrega las luces de la escena; las direccionales orientan las cascadas.
+	 */
+	void
+	gatherLights(RenderScene& outScene);
+
+	/**
+	 * @brief Agrega los renderables visibles y los casters de sombra fuera de camara.
+	 *
+	 * Los casters fuera de camara salen de consultar el indice espacial con
+	 * RenderScene::shadowCasterVolumes (ForwardRenderer::prepareShadowVolumes());
+	 * sin volumenes solo se agrega lo que ve la camara.
+	 */
 	void
 	gatherRenderScene(RenderScene& outScene, const Camera& camera);
 
+	/**
+	 * @brief Impacto mas cercano del rayo con la geometria de los renderables visibles.
+	 *
+	 * El indice espacial devuelve las cajas que cruza el rayo; se ordenan por
+	 * distancia de entrada y se recorre el BVH de triangulos de cada malla (en
+	 * espacio local) hasta que la siguiente caja empieza detras del mejor impacto.
+	 * En las ramas se descienden solo los subarboles cuya caja cruza el rayo.
+	 * Las mallas sin BVH no se pueden seleccionar.
+	 * @param direction No necesita estar normalizada.
+	 */
+	bool
+	raycast(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, RaycastHit& outHit) const;
+
 	void
 	destroy();
+
+	const ArchetypeStorage&
+	getStorage() const { return m_storage; }
+
+	const SceneGraphStats&
+	getStats() const { return m_stats; }
+
+	const TransformHierarchy&
+	getHierarchy() const { return m_hierarchy; }
+
+	/**
+	 * @brief Elige la particion espacial de la escena.
+	 *
+	 * El arbol dinamico conviene con muchos objetos en movimiento; la rejilla,
+	 * en mundos grandes y casi estaticos. Cambiarla vacia el indice actual y el
+	 * siguiente update() vuelve a insertar todos los renderables.
+	 * @param gridCellSize Tamano de celda de la rejilla (ignorado con el arbol).
+	 */
+	void
+	setSpatialPartition(SpatialPartition partition, float gridCellSize = HashedGrid::kDefaultCellSize);
+
+	SpatialPartition
+	getSpatialPartition() const { return m_spatialPartition; }
+
+	/**
+	 * @brief Indice espacial de los renderables con caja; se actualiza en update().
+	 *
+	 * Los proxies guardan el `Entity*` como userData.
+	 */
+	const SpatialIndex&
+	getSpatialIndex() const;
+
+	/**
+	 * @brief Activa el culling por oclusion en CPU de gatherRenderScene().
+	 *
+	 * Las mallas marcadas como oclusor (MeshRendererComponent::setOccluder) que
+	 * pasan el frustum se rasterizan en un OcclusionBuffer; los renderables cuya
+	 * caja queda detras dejan de ser visibles para la camara y solo se conservan
+	 * como sombreadores.
+	 */
+	void
+	setOcclusionCulling(bool enabled) { m_occlusionCulling = enabled; }
+
+	bool
+	isOcclusionCulling() const { return m_occlusionCulling; }
+
+	/// Buffer de oclusion del ultimo gather (profundidad y contadores).
+	const OcclusionBuffer&
+	getOcclusionBuffer() const { return m_occlusionBuffer; }
 private:
-	void 
-	updateWorldRecursive(Entity* node, const XMMATRIX& parentWorld);
+	SpatialIndex&
+	spatialIndex();
+
+	/// Crea, mueve o quita los proxies de los renderables cuyo Transform o malla cambio.
+	void
+	syncSpatialIndex();
+
+	/// Vacia el indice espacial y desliga los proxies de todas las filas.
+	void
+	resetSpatialIndex();
+
+	/// Quita el proxy de un renderable, si tiene.
+	void
+	releaseSpatialProxy(MeshRendererData& meshRenderer);
+
+	/// Crea, mueve o quita el proxy de cada raiz con hijos segun la caja de su subarbol.
+	void
+	syncBranchProxies(SpatialIndex& index);
+
+	/// Quita el proxy de rama de la entidad, si tiene.
+	void
+	releaseBranchProxy(Entity* e);
+
+	/// Indice en m_hierarchy si la entidad tiene padre o hijos; UINT32_MAX si se cullea sola.
+	uint32_t
+	branchIndexOf(const Entity* e) const;
+
+	/**
+	 * @brief Recorre en preorden la rama con raiz en `root` y agrega sus renderables visibles.
+	 *
+	 * Un subarbol fuera del frustum se salta con una prueba; uno completamente
+	 * dentro se acepta sin probar a sus nodos. Los nodos ya agregados se omiten.
+	 * @param fullyInside El indice espacial ya garantizo que toda la rama esta dentro.
+	 * @param shadowCasters `frustum` es un volumen de sombra: solo se agregan
+	 *        casters, como no visibles para la camara.
+	 */
+	void
+	gatherBranch(uint32_t root, bool fullyInside, const Frustum& frustum, bool shadowCasters);
 
 	bool 
 	isRoot(Entity* e) const;
 
+	/// O(1): la entidad guarda el grafo que la registra.
 	bool
 	isRegistered(Entity* e) const;
 
+	/// Desliga todas las entidades registradas y vacia m_entities.
+	void
+	clearRegistry();
+
 private:
 	//std::vector<EU::TSharedPointer<Entity>> m_entities;
 public:
-	std::vector<Entity*> m_entities; ///< Entidades registradas en el grafo.
+	std::vector<Entity*> m_entities; ///< Entidades registradas (densas, con swap-remove; el orden no es estable).
+
+private:
+	ArchetypeStorage m_storage; ///< Columnas de Transform/MeshRenderer de las entidades registradas.
+	SystemScheduler m_scheduler; ///< Sistemas de update registrados en init().
+	EntityQuery* m_transformQuery = nullptr; ///< Entidades con Transform.
+	EntityQuery* m_lightQuery = nullptr;     ///< Entidades con LightComponent.
+	EntityQuery* m_renderQuery = nullptr;    ///< Entidades con Transform + MeshRendererComponent.
+	TransformHierarchy m_hierarchy; ///< Jerarquia aplanada (padres antes que hijos) para propagar la world.
+	DynamicAABBTree m_spatialTree;  ///< Indice con SpatialPartition::DynamicTree.
+	HashedGrid m_spatialGrid;       ///< Indice con SpatialPartition::HashedGrid.
+	SpatialPartition m_spatialPartition = SpatialPartition::DynamicTree;
+
+	/// Renderable que paso el filtro `visible` y espera el resultado del frustum.
+	struct GatherCandidate {
+		const TransformData* transform = nullptr;
+		const MeshRendererData* meshRenderer = nullptr;
+		Bounds worldBounds;
+		uint32_t batchIndex = UINT32_MAX; ///< Posicion en m_cullBatch; UINT32_MAX si no requiere prueba.
+		bool inFrustum = true;
+	};
+	std::vector<GatherCandidate> m_gatherCandidates; ///< Reutilizado entre frames.
+	BoundsBatch m_cullBatch;
+	std::vector<uint8_t> m_cullVisible;
+	std::vector<SpatialHit> m_spatialHits; ///< Resultado de la consulta de frustum, reutilizado.
+	std::vector<uint8_t> m_proxyReported; ///< Consulta que devolvio cada proxy: 1 la camara, 2 un volumen de sombra.
+	std::vector<uint8_t> m_branchEmitted; ///< Nodos de m_hierarchy agregados por gatherBranch(): 1 visibles, 2 solo casters.
+	OcclusionBuffer m_occlusionBuffer;
+	bool m_occlusionCulling = true;
+	SceneGraphStats m_stats;
 };
 
 
@@ -0,0 +1,117 @@
+/**
+ * @file SpatialIndex.h
+ * @brief Declara la API de SpatialIndex dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "Rendering/Bounds.h"
+#include "Rendering/Frustum.h"
+
+/**
+ * @brief Estructura de particion espacial que usa una escena para sus renderables.
+ */
+enum class
+SpatialPartition {
+	DynamicTree = 0, ///< BVH dinamico: escenas con muchos objetos en movimiento.
+	HashedGrid       ///< Rejilla uniforme dispersa: mundos grandes y casi estaticos.
+};
+
+/**
+ * @brief Proxy devuelto por una consulta de frustum.
+ */
+struct
+SpatialHit {
+	int32_t proxy = -1;
+	bool fullyInside = false; ///< Su volumen contenedor esta dentro del frustum: no requiere mas pruebas.
+};
+
+/**
+ * @brief Proxy cuya caja atraviesa un rayo.
+ */
+struct
+SpatialRayHit {
+	int32_t proxy = -1;
+	float distance = 0.0f; ///< `t` de entrada del rayo en la caja del proxy.
+};
+
+/**
+ * @class SpatialIndex
+ * @brief Interfaz comun de las particiones espaciales de la escena.
+ *
+ * Cada renderable con caja es un proxy con un indice estable hasta destroyProxy().
+ * Las consultas llenan un vector del llamador (que puede reutilizarlo entre
+ * frames) en lugar de invocar un callback por resultado: asi la llamada virtual
+ * se paga una vez por consulta y no una vez por proxy.
+ */
+class
+SpatialIndex {
+public:
+	static constexpr int32_t kNullProxy = -1;
+
+	virtual ~SpatialIndex() = default;
+
+	virtual int32_t
+	createProxy(const Bounds& bounds, void* userData) = 0;
+
+	virtual void
+	destroyProxy(int32_t proxy) = 0;
+
+	/**
+	 * @brief Actualiza la caja de un proxy.
+	 * @return `true` si el proxy cambio de nodo o de celda.
+	 */
+	virtual bool
+	moveProxy(int32_t proxy, const Bounds& bounds) = 0;
+
+	virtual void*
+	getUserData(int32_t proxy) const = 0;
+
+	virtual void
+	clear() = 0;
+
+	virtual size_t
+	getProxyCount() const = 0;
+
+	/// Cota superior de los indices de proxy: sirve para dimensionar arreglos por proxy.
+	virtual size_t
+	getProxyCapacity() const = 0;
+
+	/// Nodos del arbol o celdas ocupadas de la rejilla.
+	virtual size_t
+	getNodeCount() const = 0;
+
+	/// Proxies que cambiaron de nodo o de celda desde el ultimo resetCounters().
+	virtual uint32_t
+	getReinsertCount() const = 0;
+
+	virtual void
+	resetCounters() = 0;
+
+	/**
+	 * @brief Agrega a `outHits` los proxies que pueden tocar el frustum.
+	 *
+	 * Los que tienen `fullyInside == false` deben probarse con su caja ajustada.
+	 * @return Volumenes (nodos o celdas) probados contra el frustum.
+	 */
+	virtual uint32_t
+	collectFrustum(const Frustum& frustum, std::vector<SpatialHit>& outHits) const = 0;
+
+	/// Agrega a `outProxies` los proxies cuya caja puede tocar la esfera.
+	virtual void
+	collectSphere(const XMFLOAT3& center, float radius, std::vector<int32_t>& outProxies) const = 0;
+
+	/// Agrega a `outProxies` los proxies cuya caja puede solaparse con `bounds`.
+	virtual void
+	collectAABB(const Bounds& bounds, std::vector<int32_t>& outProxies) const = 0;
+
+	/**
+	 * @brief Agrega a `outHits` los proxies cuya caja puede cruzar el rayo `origin + t * direction`.
+	 *
+	 * El orden no esta definido; quien busque el impacto mas cercano los ordena
+	 * por `distance` y se detiene cuando supera el mejor impacto.
+	 */
+	virtual void
+	collectRay(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance,
+	           std::vector<SpatialRayHit>& outHits) const = 0;
+};
@@ -0,0 +1,242 @@
+/**
+ * @file TransformHierarchy.h
+ * @brief Declara la API de TransformHierarchy dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ */
+#pragma once
+#include "Prerequisites.h"
+#include "Rendering/Bounds.h"
+
+class Entity;
+class Transform;
+class JobSystem;
+
+/**
+ * @class TransformHierarchy
+ * @brief Jerarquia de transforms aplanada en orden topologico (preorden).
+ *
+ * Cada nodo ocupa un indice en columnas paralelas: entidad, Transform, indice del
+ * padre (-1 en raices), tamano de su subarbol y matriz world. El orden es un
+ * recorrido en preorden, asi que todo padre precede a sus hijos y cada subarbol
+ * ocupa un rango contiguo `[i, i + subtreeSize[i])`. Ese rango es el intervalo
+ * de entrada/salida del recorrido (Euler tour): las consultas de ancestro y de
+ * pertenencia a subarbol son dos comparaciones.
+ *
+ * Los cambios de estructura no desplazan el resto del arreglo: attach()/detach()
+ * copian el rango del subarbol al final y dejan lapidas (slots sin entidad, de
+ * tamano 1 y caja vacia) en su lugar, y remove() deja una lapida en el slot del
+ * nodo. Cuestan lo que mide el subarbol movido, no la jerarquia. Mientras haya
+ * lapidas, subtreeSize cuenta slots: los rangos de los ancestros siguen
+ * incluyendolas y las consultas de ancestro siguen siendo validas. compact()
+ * las elimina en una sola pasada lineal; updateWorld() la llama al empezar, asi
+ * que quien lea las columnas despues de la propagacion las ve densas.
+ *
+ * updateWorld() es una pasada lineal que lee la world del padre de un arreglo
+ * contiguo en lugar de recorrer punteros a hijos.
+ *
+ * El indice de cada entidad se guarda en HierarchyComponent::m_flatIndex.
+ *
+ * Cada nodo guarda tambien la caja world de su propia malla y la union de las
+ * cajas de su subarbol. updateWorld() marca los nodos cuya world cambio y
+ * updateBounds() recalcula solo esos nodos y sus ancestros en una pasada inversa
+ * (los hijos siguen al padre en preorden), de modo que el culling puede
+ * descartar o aceptar una rama completa con una sola prueba.
+ *
+ * Con un JobSystem, updateWorld() procesa la jerarquia por niveles de profundidad:
+ * los nodos de un nivel solo dependen del nivel anterior, asi que cada nivel se
+ * reparte entre los workers. Sirve igual para un subarbol enorme que para muchas
+ * raices pequenas, y los niveles estrechos (cadenas profundas) corren en linea.
+ */
+class
+TransformHierarchy {
+public:
+	static constexpr int32_t kNoParent = -1;
+	static constexpr size_t kParallelMinNodes = 4096; ///< Por debajo, la pasada lineal es mas rapida.
+	static constexpr size_t kParallelGrain = 512;     ///< Nodos por trabajo dentro de un nivel.
+
+	TransformHierarchy() = default;
+	~TransformHierarchy() = default;
+
+	/**
+	 * @brief Agrega la entidad como raiz al final del arreglo.
+	 */
+	void
+	add(Entity* entity);
+
+	/**
+	 * @brief Quita la entidad; sus hijos, si los hay, pasan a ser raices.
+	 *
+	 * El slot queda como lapida. Si el nodo era raiz sus hijos quedan en su
+	 * sitio; si no, sus subarboles se copian al final como en detach().
+	 */
+	void
+	remove(Entity* entity);
+
+	/**
+	 * @brief Cuelga el subarbol de `child` justo despues del subarbol de `parent`.
+	 *
+	 * Si `parent` esta en el borde derecho del ultimo arbol solo se copia el
+	 * subarbol de `child` (o nada, si ya le sigue), que es el caso de una carga
+	 * en preorden. Si no, el arbol de `parent` se copia al final con el subarbol
+	 * insertado. El llamador garantiza que `parent` no es descendiente de `child`.
+	 */
+	void
+	attach(Entity* child, Entity* parent);
+
+	/**
+	 * @brief Convierte `child` en raiz copiando su subarbol al final del arreglo.
+	 */
+	void
+	detach(Entity* child);
+
+	void
+	clear();
+
+	/**
+	 * @brief Elimina las lapidas conservando el orden y reasigna los indices.
+	 *
+	 * Pasada lineal; no hace nada si no hay lapidas.
+	 */
+	void
+	compact();
+
+	/**
+	 * @brief Propaga las matrices world.
+	 *
+	 * Un nodo se recalcula si su Transform tiene kWorldDirty o si la world de su
+	 * padre cambio en esta misma pasada. Sin `jobs` (o con pocos nodos) es una
+	 * pasada lineal; con `jobs` se reparte por niveles. Ambos caminos evaluan la
+	 * misma expresion con los mismos operandos, asi que el resultado es identico
+	 * bit a bit.
+	 * @return Numero de matrices world recalculadas.
+	 */
+	uint32_t
+	updateWorld(JobSystem* jobs = nullptr);
+
+	/**
+	 * @brief Recalcula las cajas de los nodos marcados y propaga la union a sus ancestros.
+	 *
+	 * Debe llamarse despues de updateWorld(). La caja propia es la de la malla del
+	 * MeshRendererComponent transformada por la world; es vacia si no hay malla o
+	 * su caja no es valida. Copia la caja del subarbol en HierarchyComponent.
+	 * @return Numero de cajas de subarbol recalculadas.
+	 */
+	uint32_t
+	updateBounds();
+
+	/// Fuerza a recalcular la caja propia de la entidad (p. ej. cambio de malla).
+	void
+	markBoundsDirty(Entity* entity);
+
+	/// `true` si el nodo tiene padre o hijos: se cullea por su rama y no por separado (tras compact()).
+	bool
+	isBranchMember(uint32_t index) const {
+		return m_parents[index] != kNoParent || m_subtreeSizes[index] > 1;
+	}
+
+	/**
+	 * @brief `true` si `ancestor` es ancestro estricto de `node`, en O(1).
+	 */
+	bool
+	isAncestor(Entity* ancestor, Entity* node) const;
+
+	/**
+	 * @brief `true` si `node` es `root` o descendiente suyo, en O(1).
+	 */
+	bool
+	isInSubtree(Entity* root, Entity* node) const;
+
+	/// Indica si la entidad tiene un nodo en la jerarquia.
+	bool
+	contains(Entity* entity) const;
+
+	size_t
+	size() const { return m_entities.size(); }
+
+	const std::vector<Entity*>&
+	getEntities() const { return m_entities; }
+
+	const std::vector<int32_t>&
+	getParents() const { return m_parents; }
+
+	const std::vector<uint32_t>&
+	getSubtreeSizes() const { return m_subtreeSizes; }
+
+	/// Profundidad de cada nodo, calculada al reagrupar los niveles.
+	const std::vector<uint32_t>&
+	getDepths() const { return m_depths; }
+
+	/// Caja world de la malla de cada nodo (vacia si no tiene).
+	const std::vector<Bounds>&
+	getOwnBounds() const { return m_ownBounds; }
+
+	/// Union de las cajas propias del subarbol de cada nodo.
+	const std::vector<Bounds>&
+	getSubtreeBounds() const { return m_subtreeBounds; }
+
+	/// Niveles de profundidad calculados en la ultima propagacion paralela.
+	size_t
+	getLevelCount() const { return m_levelOffsets.empty() ? 0 : m_levelOffsets.size() - 1; }
+
+private:
+	static constexpr uint8_t kOwnBoundsDirty = 1;   ///< La world o la malla del nodo cambiaron.
+	static constexpr uint8_t kChildBoundsDirty = 2; ///< Cambio la caja de un hijo o la lista de hijos.
+
+	/// Recalcula la world del nodo `index` si corresponde; su padre ya debe estar listo.
+	bool
+	updateNode(size_t index);
+
+	/// Calcula las profundidades y agrupa los indices por nivel (orden de conteo, estable por indice).
+	void
+	rebuildLevels();
+
+	/// Rango de slots `[first, first + count)`.
+	struct Segment {
+		uint32_t first;
+		uint32_t count;
+	};
+
+	/**
+	 * @brief Copia los rangos, en ese orden, al final del arreglo y deja lapidas en su lugar.
+	 *
+	 * Solo reasigna los padres que caen dentro de algun rango copiado; el padre
+	 * de la raiz de cada rango lo fija el llamador.
+	 * @return Nuevo indice del primer slot copiado.
+	 */
+	uint32_t
+	appendSegments(const Segment* segments, size_t segmentCount);
+
+	/// detach() de un nodo con padre, sin compactar: los indices del llamador siguen validos.
+	void
+	detachNode(uint32_t index);
+
+	/// Convierte el slot en lapida. No toca el m_flatIndex de la entidad.
+	void
+	clearSlot(uint32_t index);
+
+	/// Compacta si las lapidas superan a los nodos vivos: el coste queda amortizado.
+	void
+	compactIfSparse();
+
+	/// Suma `delta` al tamano de subarbol de `node` y todos sus ancestros.
+	void
+	adjustSubtreeSizes(int32_t node, int32_t delta);
+
+	std::vector<Entity*> m_entities;       ///< Entidad de cada nodo.
+	std::vector<Transform*> m_transforms;  ///< Transform de cada nodo (cacheado al agregar).
+	std::vector<int32_t> m_parents;        ///< Indice del padre o kNoParent.
+	std::vector<uint32_t> m_subtreeSizes;  ///< Slots del subarbol, incluido el propio (y lapidas).
+	std::vector<XMMATRIX> m_world;         ///< World de cada nodo; la leen los hijos.
+	std::vector<uint8_t> m_changed;        ///< World recalculada en la pasada actual.
+	std::vector<Bounds> m_ownBounds;       ///< Caja world de la malla del nodo.
+	std::vector<Bounds> m_subtreeBounds;   ///< Union de las cajas propias del subarbol.
+	std::vector<uint8_t> m_boundsDirty;    ///< kOwnBoundsDirty | kChildBoundsDirty.
+
+	size_t m_liveCount = 0;                ///< Slots con entidad; el resto son lapidas.
+	std::vector<uint32_t> m_remap;         ///< Indice nuevo de cada slot en compact().
+
+	std::vector<uint32_t> m_depths;        ///< 0 en raices; lo calcula rebuildLevels().
+	std::vector<uint32_t> m_levelNodes;    ///< Indices ordenados por profundidad.
+	std::vector<uint32_t> m_levelOffsets;  ///< Inicio de cada nivel en m_levelNodes (+ final).
+	bool m_levelsDirty = true;             ///< La estructura cambio desde rebuildLevels().
+};
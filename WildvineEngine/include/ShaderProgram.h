@@ -94,6 +94,15 @@ public:
   void 
   destroy();
 
+  /**
+   * @brief Intercambia shaders, blobs e input layout con otro programa.
+   *
+   * Permite compilar una version nueva en segundo plano y publicarla en el hilo
+   * principal sin invalidar los punteros que los materiales guardan a este objeto.
+   */
+  void 
+  swap(ShaderProgram& other);
+
   /**
    * @brief Crea un Input Layout asociado al Vertex Shader.
    *
@@ -127,6 +127,15 @@ public:
   void 
   destroy();
 
+  /**
+   * @brief Intercambia los recursos GPU con otra textura.
+   *
+   * Lo usa la recarga en caliente: la textura nueva se crea en un hilo de fondo y
+   * se intercambia en el hilo principal, asi los punteros a este objeto siguen validos.
+   */
+  void 
+  swap(Texture& other);
+
   HRESULT 
   CreateCubemap(Device& device,
                 DeviceContext& deviceContext,
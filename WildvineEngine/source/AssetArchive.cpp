@@ -0,0 +1,257 @@
+/**
+ * @file AssetArchive.cpp
+ * @brief Implementa la logica de AssetArchive dentro del subsistema Core.
+ * @ingroup core
+ */
+#include "AssetArchive.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+namespace {
+constexpr uint32_t kArchiveMagic = 0x4B505657; // WVPK
+constexpr uint32_t kArchiveVersion = 1;
+
+bool GetFileWriteTime(const std::string& path, ULONGLONG& outWriteTime) {
+	WIN32_FILE_ATTRIBUTE_DATA attributes{};
+	if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes)) {
+		return false;
+	}
+
+	ULARGE_INTEGER fileTime{};
+	fileTime.LowPart = attributes.ftLastWriteTime.dwLowDateTime;
+	fileTime.HighPart = attributes.ftLastWriteTime.dwHighDateTime;
+	outWriteTime = fileTime.QuadPart;
+	return true;
+}
+
+bool ReadWholeFile(const std::string& path, std::vector<char>& outData) {
+	std::ifstream stream(path, std::ios::binary | std::ios::ate);
+	if (!stream.is_open()) {
+		return false;
+	}
+	const std::streamsize size = stream.tellg();
+	stream.seekg(0, std::ios::beg);
+	outData.resize(static_cast<size_t>(size));
+	return size == 0 || stream.read(outData.data(), size).good();
+}
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/// `offset + size <= limit` sin desbordar uint64.
+bool RangeFits(uint64_t offset, uint64_t size, uint64_t limit) {
+	return offset <= limit && size <= limit - offset;
+}
+}
+
+std::string
+AssetArchive::normalizePath(const std::string& path) {
+	std::string normalized = path;
+	for (char& c : normalized) {
+		c = (c == '\\') ? '/' : static_cast<char>(tolower(static_cast<unsigned char>(c)));
+	}
+	return normalized;
+}
+
+uint64_t
+AssetArchive::hashPath(const std::string& path) {
+	uint64_t hash = 14695981039346656037ull;
+	for (char c : normalizePath(path)) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+bool
+AssetArchive::mount(const std::string& archivePath) {
+	unmount();
+
+	const auto begin = std::chrono::high_resolution_clock::now();
+	m_file = CreateFileA(archivePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(Header))) {
+		unmount();
+		return false;
+	}
+
+	m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_mapping) {
+		unmount();
+		return false;
+	}
+
+	m_view = static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!m_view) {
+		unmount();
+		return false;
+	}
+	m_viewSize = static_cast<size_t>(fileSize.QuadPart);
+
+	const Header* header = reinterpret_cast<const Header*>(m_view);
+	const uint64_t tocBytes = static_cast<uint64_t>(header->entryCount) * sizeof(TocEntry);
+	if (header->magic != kArchiveMagic ||
+	    header->version != kArchiveVersion ||
+	    !RangeFits(header->tocOffset, tocBytes, m_viewSize) ||
+	    !RangeFits(header->stringTableOffset, header->stringTableSize, m_viewSize)) {
+		ERROR("AssetArchive", "mount", "Invalid or outdated archive header.");
+		unmount();
+		return false;
+	}
+
+	m_toc = reinterpret_cast<const TocEntry*>(m_view + header->tocOffset);
+	m_strings = reinterpret_cast<const char*>(m_view + header->stringTableOffset);
+	m_entryCount = header->entryCount;
+
+	// Cada entrada se valida una vez: find() confia en sus rangos y en el orden por hash
+	for (size_t i = 0; i < m_entryCount; ++i) {
+		const TocEntry& entry = m_toc[i];
+		if (!RangeFits(entry.nameOffset, entry.nameLength, header->stringTableSize) ||
+		    !RangeFits(entry.offset, entry.size, m_viewSize) ||
+		    (i > 0 && m_toc[i - 1].pathHash > entry.pathHash)) {
+			ERROR("AssetArchive", "mount",
+				("Corrupt archive table of contents at entry " + std::to_string(i) + ".").c_str());
+			unmount();
+			return false;
+		}
+	}
+
+	const auto end = std::chrono::high_resolution_clock::now();
+	const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+	const std::wstring archivePathW(archivePath.begin(), archivePath.end());
+	MESSAGE("AssetArchive", "mount",
+		L"Mounted '" << archivePathW << L"' (" << m_entryCount << L" entries) in " << elapsedUs << L" us")
+	return true;
+}
+
+void
+AssetArchive::unmount() {
+	if (m_view) {
+		UnmapViewOfFile(m_view);
+		m_view = nullptr;
+	}
+	if (m_mapping) {
+		CloseHandle(m_mapping);
+		m_mapping = nullptr;
+	}
+	if (m_file != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_file);
+		m_file = INVALID_HANDLE_VALUE;
+	}
+	m_viewSize = 0;
+	m_toc = nullptr;
+	m_strings = nullptr;
+	m_entryCount = 0;
+}
+
+bool
+AssetArchive::find(const std::string& path, AssetBlob& outBlob) const {
+	if (!m_view) {
+		return false;
+	}
+
+	const std::string normalized = normalizePath(path);
+	const uint64_t hash = hashPath(normalized);
+	const TocEntry* first = m_toc;
+	const TocEntry* last = m_toc + m_entryCount;
+	const TocEntry* it = std::lower_bound(first, last, hash,
+		[](const TocEntry& entry, uint64_t value) { return entry.pathHash < value; });
+
+	for (; it != last && it->pathHash == hash; ++it) {
+		if (it->nameLength != normalized.size() ||
+		    normalized.compare(0, normalized.size(), m_strings + it->nameOffset, it->nameLength) != 0) {
+			continue;
+		}
+		outBlob.data = m_view + it->offset;
+		outBlob.size = static_cast<size_t>(it->size);
+		outBlob.sourceWriteTime = it->sourceWriteTime;
+		return true;
+	}
+	return false;
+}
+
+bool
+AssetArchive::build(const std::string& archivePath, const std::vector<std::string>& files) {
+	struct PendingEntry {
+		TocEntry toc;
+		std::vector<char> data;
+	};
+
+	const auto begin = std::chrono::high_resolution_clock::now();
+	std::vector<PendingEntry> entries;
+	std::string strings;
+	entries.reserve(files.size());
+
+	for (const std::string& file : files) {
+		PendingEntry entry{};
+		if (!ReadWholeFile(file, entry.data)) {
+			continue;
+		}
+
+		const std::string normalized = normalizePath(file);
+		entry.toc.pathHash = hashPath(normalized);
+		entry.toc.size = entry.data.size();
+		entry.toc.nameOffset = static_cast<uint32_t>(strings.size());
+		entry.toc.nameLength = static_cast<uint32_t>(normalized.size());
+		strings += normalized;
+
+		const size_t extension = file.find_last_of('.');
+		ULONGLONG sourceWriteTime = 0;
+		if (extension != std::string::npos && GetFileWriteTime(file.substr(0, extension), sourceWriteTime)) {
+			entry.toc.sourceWriteTime = sourceWriteTime;
+		}
+		entries.push_back(std::move(entry));
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const PendingEntry& a, const PendingEntry& b) {
+		return a.toc.pathHash < b.toc.pathHash;
+	});
+
+	Header header{};
+	header.magic = kArchiveMagic;
+	header.version = kArchiveVersion;
+	header.entryCount = static_cast<uint32_t>(entries.size());
+	header.stringTableSize = static_cast<uint32_t>(strings.size());
+	header.tocOffset = sizeof(Header);
+	header.stringTableOffset = header.tocOffset + entries.size() * sizeof(TocEntry);
+
+	uint64_t offset = AlignUp(header.stringTableOffset + strings.size(), kBlobAlignment);
+	for (PendingEntry& entry : entries) {
+		entry.toc.offset = offset;
+		offset = AlignUp(offset + entry.toc.size, kBlobAlignment);
+	}
+
+	std::ofstream stream(archivePath, std::ios::binary | std::ios::trunc);
+	if (!stream.is_open()) {
+		ERROR("AssetArchive", "build", "Unable to open archive for writing.");
+		return false;
+	}
+
+	stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	for (const PendingEntry& entry : entries) {
+		stream.write(reinterpret_cast<const char*>(&entry.toc), sizeof(TocEntry));
+	}
+	stream.write(strings.data(), strings.size());
+
+	const char padding[kBlobAlignment] = {};
+	uint64_t written = header.stringTableOffset + strings.size();
+	for (const PendingEntry& entry : entries) {
+		stream.write(padding, static_cast<std::streamsize>(entry.toc.offset - written));
+		stream.write(entry.data.data(), static_cast<std::streamsize>(entry.data.size()));
+		written = entry.toc.offset + entry.toc.size;
+	}
+
+	const auto end = std::chrono::high_resolution_clock::now();
+	const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+	const std::wstring archivePathW(archivePath.begin(), archivePath.end());
+	MESSAGE("AssetArchive", "build",
+		L"Packed " << entries.size() << L" files into '" << archivePathW << L"' in " << elapsedMs << L" ms")
+	return stream.good();
+}
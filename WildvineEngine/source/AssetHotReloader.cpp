@@ -0,0 +1,232 @@
+/**
+ * @file AssetHotReloader.cpp
+ * @brief Implementa la logica de AssetHotReloader dentro del subsistema Core.
+ * @ingroup core
+ */
+#include "AssetHotReloader.h"
+#include "Device.h"
+#include "ResourceManager.h"
+#include <algorithm>
+
+namespace {
+double ElapsedMs(std::chrono::high_resolution_clock::time_point begin,
+                 std::chrono::high_resolution_clock::time_point end) {
+	return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+std::wstring ToWide(const std::string& value) {
+	return std::wstring(value.begin(), value.end());
+}
+}
+
+void
+AssetHotReloader::init(Device& device, unsigned int pollIntervalMs) {
+	m_device = &device;
+	m_watcher.start(pollIntervalMs);
+}
+
+void
+AssetHotReloader::destroy() {
+	m_watcher.stop();
+	for (std::future<void>& job : m_jobs) {
+		if (job.valid()) {
+			job.wait();
+		}
+	}
+	m_jobs.clear();
+
+	std::lock_guard<std::mutex> lock(m_completedMutex);
+	for (CompletedReload& reload : m_completed) {
+		if (reload.texture) {
+			reload.texture->destroy();
+		}
+		if (reload.shader) {
+			reload.shader->destroy();
+		}
+	}
+	m_completed.clear();
+	m_assets.clear();
+	m_device = nullptr;
+}
+
+void
+AssetHotReloader::watchModel(const std::string& key,
+                             const std::string& path,
+                             ModelType modelType,
+                             ModelReloadedCallback onReloaded) {
+	WatchedAsset asset;
+	asset.kind = AssetKind::Model;
+	asset.key = key;
+	asset.path = path;
+	asset.modelType = modelType;
+	asset.onReloaded = onReloaded;
+	m_assets.push_back(asset);
+	m_watcher.watch(path);
+}
+
+void
+AssetHotReloader::watchTexture(Texture& texture,
+                               const std::string& textureName,
+                               ExtensionType extensionType) {
+	WatchedAsset asset;
+	asset.kind = AssetKind::Texture;
+	asset.key = textureName;
+	asset.path = texture.m_textureName;
+	asset.texture = &texture;
+	asset.extensionType = extensionType;
+	m_assets.push_back(asset);
+	m_watcher.watch(asset.path);
+}
+
+void
+AssetHotReloader::watchShader(ShaderProgram& shader,
+                              const std::string& fileName,
+                              const LayoutBuilder& layoutBuilder) {
+	WatchedAsset asset;
+	asset.kind = AssetKind::Shader;
+	asset.key = fileName;
+	asset.path = fileName;
+	asset.shader = &shader;
+	asset.layoutBuilder = layoutBuilder;
+	m_assets.push_back(asset);
+	m_watcher.watch(fileName);
+}
+
+void
+AssetHotReloader::update() {
+	if (!m_device) {
+		return;
+	}
+
+	m_changes.clear();
+	m_watcher.consumeChanges(m_changes);
+	for (const FileChange& change : m_changes) {
+		for (size_t i = 0; i < m_assets.size(); ++i) {
+			if (m_assets[i].path != change.path) {
+				continue;
+			}
+			if (m_assets[i].inFlight) {
+				m_assets[i].changedAgain = true;
+			}
+			else {
+				launchReload(i, change.detectedAt);
+			}
+		}
+	}
+
+	std::vector<CompletedReload> completed;
+	{
+		std::lock_guard<std::mutex> lock(m_completedMutex);
+		completed.swap(m_completed);
+	}
+	for (CompletedReload& reload : completed) {
+		applyReload(reload);
+	}
+
+	m_jobs.erase(std::remove_if(m_jobs.begin(), m_jobs.end(), [](std::future<void>& job) {
+		return job.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}), m_jobs.end());
+}
+
+void
+AssetHotReloader::launchReload(size_t assetIndex,
+                               std::chrono::high_resolution_clock::time_point detectedAt) {
+	WatchedAsset& asset = m_assets[assetIndex];
+	asset.inFlight = true;
+	asset.changedAgain = false;
+
+	// El hilo de fondo trabaja con copias: m_assets puede crecer mientras tanto.
+	const AssetKind kind = asset.kind;
+	const std::string key = asset.key;
+	const std::string path = asset.path;
+	const ModelType modelType = asset.modelType;
+	const ExtensionType extensionType = asset.extensionType;
+	const LayoutBuilder layoutBuilder = asset.layoutBuilder;
+	Device* device = m_device;
+
+	m_jobs.push_back(std::async(std::launch::async,
+		[this, assetIndex, detectedAt, kind, key, path, modelType, extensionType, layoutBuilder, device]() {
+		CompletedReload reload;
+		reload.assetIndex = assetIndex;
+		reload.detectedAt = detectedAt;
+
+		const auto begin = std::chrono::high_resolution_clock::now();
+		switch (kind) {
+		case AssetKind::Model: {
+			Model3D::EvictFromMemoryCache(path);
+			reload.model = std::make_shared<Model3D>(key, modelType);
+			reload.success = reload.model->load(path) && reload.model->init();
+			break;
+		}
+		case AssetKind::Texture: {
+			// ID3D11Device es seguro entre hilos; solo el contexto inmediato no lo es.
+			reload.texture = std::make_unique<Texture>();
+			reload.success = SUCCEEDED(reload.texture->init(*device, key, extensionType));
+			break;
+		}
+		case AssetKind::Shader: {
+			reload.shader = std::make_unique<ShaderProgram>();
+			reload.success = SUCCEEDED(reload.shader->init(*device, path, layoutBuilder));
+			break;
+		}
+		}
+		reload.importMs = ElapsedMs(begin, std::chrono::high_resolution_clock::now());
+
+		std::lock_guard<std::mutex> lock(m_completedMutex);
+		m_completed.push_back(std::move(reload));
+	}));
+}
+
+void
+AssetHotReloader::applyReload(CompletedReload& reload) {
+	if (reload.assetIndex >= m_assets.size()) {
+		return;
+	}
+	WatchedAsset& asset = m_assets[reload.assetIndex];
+	asset.inFlight = false;
+
+	const auto swapBegin = std::chrono::high_resolution_clock::now();
+	if (reload.success) {
+		switch (asset.kind) {
+		case AssetKind::Model:
+			reload.success = ResourceManager::getInstance().Replace<Model3D>(asset.key, reload.model);
+			if (reload.success && asset.onReloaded) {
+				asset.onReloaded(*reload.model);
+			}
+			break;
+		case AssetKind::Texture:
+			asset.texture->swap(*reload.texture);
+			break;
+		case AssetKind::Shader:
+			asset.shader->swap(*reload.shader);
+			break;
+		}
+	}
+	// Tras el swap el objeto temporal contiene la version anterior (o la fallida).
+	if (reload.texture) {
+		reload.texture->destroy();
+	}
+	if (reload.shader) {
+		reload.shader->destroy();
+	}
+	const auto swapEnd = std::chrono::high_resolution_clock::now();
+
+	if (reload.success) {
+		++m_stats.reloads;
+		m_stats.lastImportMs = reload.importMs;
+		m_stats.lastSwapMs = ElapsedMs(swapBegin, swapEnd);
+		m_stats.lastLatencyMs = ElapsedMs(reload.detectedAt, swapEnd);
+		MESSAGE("AssetHotReloader", "applyReload",
+			L"Reloaded '" << ToWide(asset.path) << L"' import " << m_stats.lastImportMs
+			<< L" ms, swap " << m_stats.lastSwapMs << L" ms, latency " << m_stats.lastLatencyMs << L" ms")
+	}
+	else {
+		++m_stats.failures;
+		ERROR("AssetHotReloader", "applyReload",
+			L"Failed to reload '" << ToWide(asset.path) << L"'. Keeping previous version.");
+	}
+
+	if (asset.changedAgain) {
+		launchReload(reload.assetIndex, std::chrono::high_resolution_clock::now());
+	}
+}
@@ -0,0 +1,222 @@
+/**
+ * @file AssetPreloader.cpp
+ * @brief Implementa la logica de AssetPreloader dentro del subsistema Core.
+ * @ingroup core
+ */
+#include "AssetPreloader.h"
+#include "AssetArchive.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+bool FileExists(const std::string& path) {
+	const DWORD attributes = GetFileAttributesA(path.c_str());
+	return attributes != INVALID_FILE_ATTRIBUTES && !(attributes & FILE_ATTRIBUTE_DIRECTORY);
+}
+
+/// Archivo que el loader del nodo va a leer, o cadena vacia si no hay nada que precargar.
+std::string GetPrefetchPath(const std::string& path, ResourceType type) {
+	std::string cachePath;
+	switch (type) {
+	case ResourceType::Model3D:
+		cachePath = path + ".wvmesh";
+		break;
+	case ResourceType::Texture:
+		cachePath = path + ".wvtx";
+		break;
+	default:
+		// Los shaders los lee el compilador de D3DX directamente desde disco.
+		return std::string();
+	}
+
+	AssetBlob blob;
+	if (AssetArchive::getInstance().find(cachePath, blob)) {
+		return std::string(); // Ya esta mapeado en memoria.
+	}
+	if (FileExists(cachePath)) {
+		return cachePath;
+	}
+	// Sin cache, Texture decodifica el fuente desde memoria; Model3D lo importa con su SDK.
+	return (type == ResourceType::Texture && FileExists(path)) ? path : std::string();
+}
+
+int ComputeLevel(const std::string& path,
+                 const ResourceManager::DependencyGraph& graph,
+                 std::unordered_map<std::string, int>& levels) {
+	auto known = levels.find(path);
+	if (known != levels.end()) {
+		return known->second;
+	}
+	levels[path] = 0; // Corta ciclos: un nodo en visita cuenta como hoja.
+
+	int level = 0;
+	auto node = graph.find(path);
+	if (node != graph.end()) {
+		for (const std::string& dependency : node->second.dependencies) {
+			level = (std::max)(level, ComputeLevel(dependency, graph, levels) + 1);
+		}
+	}
+	levels[path] = level;
+	return level;
+}
+}
+
+std::string
+AssetPreloader::normalizePath(const std::string& path) {
+	std::string normalized = path;
+	for (char& c : normalized) {
+		c = (c == '\\') ? '/' : static_cast<char>(tolower(static_cast<unsigned char>(c)));
+	}
+	return normalized;
+}
+
+bool
+AssetPreloader::writeManifest(const std::string& manifestPath,
+                              const ResourceManager::DependencyGraph& graph) {
+	std::unordered_map<std::string, int> levels;
+	std::vector<std::pair<int, std::string>> files;
+	for (const auto& [path, node] : graph) {
+		const std::string prefetchPath = GetPrefetchPath(path, node.type);
+		if (!prefetchPath.empty()) {
+			files.emplace_back(ComputeLevel(path, graph, levels), prefetchPath);
+		}
+	}
+	std::sort(files.begin(), files.end());
+
+	std::ofstream stream(manifestPath, std::ios::trunc);
+	if (!stream.is_open()) {
+		ERROR("AssetPreloader", "writeManifest", ("Failed to open manifest for writing: " + manifestPath).c_str());
+		return false;
+	}
+
+	stream << "WVPRELOAD 1\n";
+	for (const auto& [level, path] : files) {
+		stream << "FILE " << level << " " << std::quoted(path) << "\n";
+	}
+	return stream.good();
+}
+
+bool
+AssetPreloader::begin(const std::string& manifestPath) {
+	end();
+
+	std::ifstream stream(manifestPath);
+	if (!stream.is_open()) {
+		return false;
+	}
+
+	std::string token;
+	int version = 0;
+	stream >> token >> version;
+	if (token != "WVPRELOAD" || version != 1) {
+		return false;
+	}
+
+	const auto begin = std::chrono::high_resolution_clock::now();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	// El manifiesto ya viene ordenado por nivel: las hojas se piden primero.
+	while (stream >> token) {
+		if (token != "FILE") {
+			continue;
+		}
+		int level = 0;
+		std::string path;
+		stream >> level >> std::quoted(path);
+
+		auto read = std::make_unique<PendingRead>();
+		read->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (read->file == INVALID_HANDLE_VALUE) {
+			continue;
+		}
+
+		LARGE_INTEGER size{};
+		if (!GetFileSizeEx(read->file, &size) || size.QuadPart <= 0 || size.QuadPart > MAXDWORD) {
+			closeRead(*read);
+			continue;
+		}
+
+		read->data.resize(static_cast<size_t>(size.QuadPart));
+		read->overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+		const BOOL issued = ReadFile(read->file, read->data.data(), static_cast<DWORD>(size.QuadPart),
+			nullptr, &read->overlapped);
+		if (!issued && GetLastError() != ERROR_IO_PENDING) {
+			closeRead(*read);
+			continue;
+		}
+
+		m_bytesIssued += read->data.size();
+		++m_issued;
+		m_reads[normalizePath(path)] = std::move(read);
+	}
+	m_active = true;
+
+	const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::high_resolution_clock::now() - begin).count();
+	MESSAGE("AssetPreloader", "begin",
+		L"Issued " << m_issued << L" reads (" << (m_bytesIssued / 1024) << L" KB) in " << elapsedUs << L" us")
+	return true;
+}
+
+bool
+AssetPreloader::consume(const std::string& path, std::vector<unsigned char>& outData) {
+	std::unique_ptr<PendingRead> read;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_reads.find(normalizePath(path));
+		if (it == m_reads.end()) {
+			return false;
+		}
+		read = std::move(it->second);
+		m_reads.erase(it);
+	}
+
+	DWORD bytesRead = 0;
+	const BOOL completed = GetOverlappedResult(read->file, &read->overlapped, &bytesRead, TRUE);
+	closeRead(*read);
+	if (!completed || bytesRead != read->data.size()) {
+		return false;
+	}
+
+	outData = std::move(read->data);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	++m_consumed;
+	return true;
+}
+
+void
+AssetPreloader::end() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_active) {
+		return;
+	}
+
+	for (auto& [path, read] : m_reads) {
+		CancelIoEx(read->file, &read->overlapped);
+		DWORD ignored = 0;
+		GetOverlappedResult(read->file, &read->overlapped, &ignored, TRUE);
+		closeRead(*read);
+	}
+
+	MESSAGE("AssetPreloader", "end",
+		L"Consumed " << m_consumed << L" of " << m_issued << L" preloaded files")
+	m_reads.clear();
+	m_active = false;
+	m_issued = 0;
+	m_consumed = 0;
+	m_bytesIssued = 0;
+}
+
+void
+AssetPreloader::closeRead(PendingRead& read) {
+	if (read.overlapped.hEvent) {
+		CloseHandle(read.overlapped.hEvent);
+		read.overlapped.hEvent = nullptr;
+	}
+	if (read.file != INVALID_HANDLE_VALUE) {
+		CloseHandle(read.file);
+		read.file = INVALID_HANDLE_VALUE;
+	}
+}
@@ -5,7 +5,10 @@
  */
 #include "BaseApp.h"
 #include "ResourceManager.h"
+#include "AssetArchive.h"
+#include "AssetPreloader.h"
 #include <algorithm>
+#include <chrono>
 #include <cctype>
 #include <fstream>
 #include <iomanip>
@@ -15,6 +18,7 @@ BaseApp::awake() {
 	HRESULT hr = S_OK;
 
 	// Inicializacion de dlls y elementos externos al motor.
+	JobSystem::getInstance().init();
 	m_sceneGraph.init();
 
 	// Log Success Message
@@ -24,6 +28,9 @@ BaseApp::awake() {
 
 int
 BaseApp::run(HINSTANCE hInst, int nCmdShow) {
+	const auto startupBegin = std::chrono::high_resolution_clock::now();
+	bool firstFrameLogged = false;
+
 	// 1) Initialize Window
 	if (FAILED(m_window.init(hInst, nCmdShow, WndProc, this))) {
 		ERROR("Main", "Run", "Failed to initialize window.");
@@ -63,6 +70,15 @@ BaseApp::run(HINSTANCE hInst, int nCmdShow) {
 			prev = curr;
 			update(deltaTime);
 			render();
+
+			if (!firstFrameLogged) {
+				firstFrameLogged = true;
+				const auto firstFrameMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+					std::chrono::high_resolution_clock::now() - startupBegin).count();
+				MESSAGE("Main", "Run",
+					L"Time to first frame: " << firstFrameMs << L" ms (preload manifest "
+					<< (m_preloadManifestUsed ? L"used" : L"not found") << L")")
+			}
 		}
 	}
 	return (int)msg.wParam;
@@ -137,13 +153,20 @@ BaseApp::init() {
 	};
 	m_skyboxTex.CreateCubemap(m_device, m_deviceContext, faces, false);
 
+	// Mount the packed caches (if any) before the first asset load
+	const auto assetLoadBegin = std::chrono::high_resolution_clock::now();
+	AssetArchive::getInstance().mount(getAssetArchivePath());
+	// Issue every read listed by the previous run's manifest up front
+	m_preloadManifestUsed = AssetPreloader::getInstance().begin(getPreloadManifestPath(getDefaultScenePath()));
+
 	// Set CyberGun Actor
 	m_cyberGun = EU::MakeShared<Actor>(m_device);
 	m_drakefirePistol = EU::MakeShared<Actor>(m_device);
 
 	if (!m_cyberGun.isNull()) {
-		m_model = new Model3D("CyberGun.fbx", ModelType::FBX);
-		if (!m_model || !m_model->load("CyberGun.fbx")) {
+		m_cyberGunModel = ResourceManager::getInstance().LoadHandle<Model3D>(
+			"CyberGun.fbx", "CyberGun.fbx", ModelType::FBX);
+		if (!ResourceManager::getInstance().Resolve(m_cyberGunModel)) {
 			ERROR("Main", "InitDevice", "Failed to load CyberGun model.");
 			return E_FAIL;
 		}
@@ -195,8 +218,11 @@ BaseApp::init() {
 	}
 
 	if (!m_drakefirePistol.isNull()) {
-		m_drakefireModel = new Model3D("Models/drakefire_pistol_low_OBJ/drakefire_pistol_low.obj", ModelType::OBJ);
-		if (!m_drakefireModel || !m_drakefireModel->load("Models/drakefire_pistol_low_OBJ/drakefire_pistol_low.obj")) {
+		m_drakefireModel = ResourceManager::getInstance().LoadHandle<Model3D>(
+			"Models/drakefire_pistol_low_OBJ/drakefire_pistol_low.obj",
+			"Models/drakefire_pistol_low_OBJ/drakefire_pistol_low.obj",
+			ModelType::OBJ);
+		if (!ResourceManager::getInstance().Resolve(m_drakefireModel)) {
 			ERROR("Main", "InitDevice", "Failed to load Drakefire pistol model.");
 			return E_FAIL;
 		}
@@ -345,64 +371,42 @@ BaseApp::init() {
 	m_drakefireMaterial.getParams().normalScale = 1.0f;
 	m_drakefireMaterial.getParams().alphaCutoff = 0.5f;
 
-	m_cyberGunRenderMesh.destroy();
-	for (const MeshComponent& meshComponent : m_model->GetMeshes()) {
-		Submesh submesh{};
-		hr = submesh.vertexBuffer.init(m_device, meshComponent, D3D11_BIND_VERTEX_BUFFER);
-		if (FAILED(hr)) {
-			ERROR("Main", "InitDevice",
-				("Failed to initialize CyberGun vertex buffer. HRESULT: " + std::to_string(hr)).c_str());
-			return hr;
-		}
-
-		hr = submesh.indexBuffer.init(m_device, meshComponent, D3D11_BIND_INDEX_BUFFER);
-		if (FAILED(hr)) {
-			ERROR("Main", "InitDevice",
-				("Failed to initialize CyberGun index buffer. HRESULT: " + std::to_string(hr)).c_str());
-			return hr;
-		}
-
-		submesh.indexCount = meshComponent.m_numIndex;
-		submesh.materialSlot = 0;
-		m_cyberGunRenderMesh.getSubmeshes().push_back(std::move(submesh));
+	hr = buildRenderMesh(m_cyberGunRenderMesh, *ResourceManager::getInstance().Resolve(m_cyberGunModel));
+	if (FAILED(hr)) {
+		ERROR("Main", "InitDevice",
+			("Failed to initialize CyberGun render mesh. HRESULT: " + std::to_string(hr)).c_str());
+		return hr;
 	}
 
-	m_drakefireRenderMesh.destroy();
-	for (const MeshComponent& meshComponent : m_drakefireModel->GetMeshes()) {
-		Submesh submesh{};
-		hr = submesh.vertexBuffer.init(m_device, meshComponent, D3D11_BIND_VERTEX_BUFFER);
-		if (FAILED(hr)) {
-			ERROR("Main", "InitDevice",
-				("Failed to initialize Drakefire vertex buffer. HRESULT: " + std::to_string(hr)).c_str());
-			return hr;
-		}
-
-		hr = submesh.indexBuffer.init(m_device, meshComponent, D3D11_BIND_INDEX_BUFFER);
-		if (FAILED(hr)) {
-			ERROR("Main", "InitDevice",
-				("Failed to initialize Drakefire index buffer. HRESULT: " + std::to_string(hr)).c_str());
-			return hr;
-		}
-
-		submesh.indexCount = meshComponent.m_numIndex;
-		submesh.materialSlot = 0;
-		m_drakefireRenderMesh.getSubmeshes().push_back(std::move(submesh));
+	hr = buildRenderMesh(m_drakefireRenderMesh, *ResourceManager::getInstance().Resolve(m_drakefireModel));
+	if (FAILED(hr)) {
+		ERROR("Main", "InitDevice",
+			("Failed to initialize Drakefire render mesh. HRESULT: " + std::to_string(hr)).c_str());
+		return hr;
 	}
 
-	EU::TSharedPointer<MeshRendererComponent> meshRenderer = m_cyberGun->getComponent<MeshRendererComponent>();
+	const auto assetLoadMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::high_resolution_clock::now() - assetLoadBegin).count();
+	MESSAGE("Main", "InitDevice",
+		L"Startup asset load took " << assetLoadMs << L" ms ("
+		<< (AssetArchive::getInstance().isMounted() ? L"packed" : L"loose") << L" caches)")
+
+	MeshRendererComponent* meshRenderer = m_cyberGun->getComponent<MeshRendererComponent>();
 	if (!meshRenderer) {
-		meshRenderer = EU::MakeShared<MeshRendererComponent>();
-		m_cyberGun->addComponent(meshRenderer);
+		EU::TSharedPointer<MeshRendererComponent> created = EU::MakeShared<MeshRendererComponent>();
+		m_cyberGun->addComponent(created);
+		meshRenderer = created.get();
 	}
 	meshRenderer->setMesh(&m_cyberGunRenderMesh);
 	meshRenderer->setMaterialInstance(&m_cyberGunMaterial);
 	meshRenderer->setVisible(true);
 	meshRenderer->setCastShadow(true);
 
-	EU::TSharedPointer<MeshRendererComponent> drakefireMeshRenderer = m_drakefirePistol->getComponent<MeshRendererComponent>();
+	MeshRendererComponent* drakefireMeshRenderer = m_drakefirePistol->getComponent<MeshRendererComponent>();
 	if (!drakefireMeshRenderer) {
-		drakefireMeshRenderer = EU::MakeShared<MeshRendererComponent>();
-		m_drakefirePistol->addComponent(drakefireMeshRenderer);
+		EU::TSharedPointer<MeshRendererComponent> created = EU::MakeShared<MeshRendererComponent>();
+		m_drakefirePistol->addComponent(created);
+		drakefireMeshRenderer = created.get();
 	}
 	drakefireMeshRenderer->setMesh(&m_drakefireRenderMesh);
 	drakefireMeshRenderer->setMaterialInstance(&m_drakefireMaterial);
@@ -412,10 +416,11 @@ BaseApp::init() {
 	m_directionalLightActor = EU::MakeShared<Actor>(m_device);
 	if (!m_directionalLightActor.isNull()) {
 		m_directionalLightActor->setName("DirectionalLight");
-		EU::TSharedPointer<LightComponent> lightComponent = m_directionalLightActor->getComponent<LightComponent>();
+		LightComponent* lightComponent = m_directionalLightActor->getComponent<LightComponent>();
 		if (!lightComponent) {
-			lightComponent = EU::MakeShared<LightComponent>();
-			m_directionalLightActor->addComponent(lightComponent);
+			EU::TSharedPointer<LightComponent> created = EU::MakeShared<LightComponent>();
+			m_directionalLightActor->addComponent(created);
+			lightComponent = created.get();
 		}
 
 		lightComponent->getLightData().type = LightType::Directional;
@@ -429,6 +434,13 @@ BaseApp::init() {
 
 	loadScene(getDefaultScenePath());
 
+	const EU::PoolStats refCountPool = EU::RefCountPool::getInstance().getStats();
+	MESSAGE("Main", "InitDevice",
+		L"Pools: " << Actor::getPoolStats().liveCount << L" actors, "
+		<< Transform::getPoolStats().liveCount << L" transforms, "
+		<< MeshRendererComponent::getPoolStats().liveCount << L" mesh renderers, "
+		<< refCountPool.liveCount << L" ref counts (" << refCountPool.blockCount << L" blocks)")
+
 	hr = m_editorViewportPass.init(m_device, 1280, 720);
 	if (FAILED(hr)) {
 		ERROR("Main", "InitDevice",
@@ -443,9 +455,96 @@ BaseApp::init() {
 		return hr;
 	}
 
+	// Hot reload: los cambios en disco se reimportan en segundo plano.
+	m_hotReloader.init(m_device);
+	m_hotReloader.watchModel("CyberGun.fbx", "CyberGun.fbx", ModelType::FBX,
+		[this](Model3D& model) { reloadRenderMesh(m_cyberGunRenderMesh, model); });
+	m_hotReloader.watchModel("Models/drakefire_pistol_low_OBJ/drakefire_pistol_low.obj",
+		"Models/drakefire_pistol_low_OBJ/drakefire_pistol_low.obj", ModelType::OBJ,
+		[this](Model3D& model) { reloadRenderMesh(m_drakefireRenderMesh, model); });
+	m_hotReloader.watchTexture(m_AlbedoSRV, "Textures/CyberGun/base.tga", PNG);
+	m_hotReloader.watchTexture(m_MetallicSRV, "Textures/CyberGun/metallic.tga", PNG);
+	m_hotReloader.watchTexture(m_RoughnessSRV, "Textures/CyberGun/roughness.tga", PNG);
+	m_hotReloader.watchTexture(m_AOSRV, "Textures/CyberGun/ao.tga", PNG);
+	m_hotReloader.watchTexture(m_NormalSRV, "Textures/CyberGun/normal.tga", PNG);
+	m_hotReloader.watchTexture(m_drakefireAlbedoSRV, "Textures/drakefire_pistol_low_Textures/base_albedo", JPG);
+	m_hotReloader.watchTexture(m_drakefireNormalSRV, "Textures/drakefire_pistol_low_Textures/base_normal", JPG);
+	m_hotReloader.watchTexture(m_drakefireMetallicSRV, "Textures/drakefire_pistol_low_Textures/base_metallic", JPG);
+	m_hotReloader.watchTexture(m_drakefireRoughnessSRV, "Textures/drakefire_pistol_low_Textures/base_roughness", JPG);
+	m_hotReloader.watchTexture(m_drakefireAOSRV, "Textures/drakefire_pistol_low_Textures/base_AO", JPG);
+	m_hotReloader.watchShader(m_shaderProgram, "PBRShader.hlsl", builder);
+
+	// Record scene -> model/shader -> texture dependencies and refresh the preload manifest
+	AssetPreloader::getInstance().end();
+	ResourceManager& resources = ResourceManager::getInstance();
+	const std::string scenePath = getDefaultScenePath();
+	resources.RecordAsset("PBRShader.hlsl", ResourceType::Shader);
+	resources.RecordDependency(scenePath, "PBRShader.hlsl");
+
+	auto recordModel = [&](const TResourceHandle<Model3D>& handle,
+	                       std::initializer_list<const Texture*> textures) {
+		Model3D* model = resources.Resolve(handle);
+		if (!model) {
+			return;
+		}
+		resources.RecordDependency(scenePath, model->GetPath());
+		for (const Texture* texture : textures) {
+			if (!texture->m_textureName.empty()) {
+				resources.RecordAsset(texture->m_textureName, ResourceType::Texture);
+				resources.RecordDependency(model->GetPath(), texture->m_textureName);
+			}
+		}
+	};
+	recordModel(m_cyberGunModel,
+		{ &m_AlbedoSRV, &m_MetallicSRV, &m_RoughnessSRV, &m_AOSRV, &m_NormalSRV, &m_EmissiveSRV });
+	recordModel(m_drakefireModel,
+		{ &m_drakefireAlbedoSRV, &m_drakefireNormalSRV, &m_drakefireMetallicSRV,
+		  &m_drakefireRoughnessSRV, &m_drakefireAOSRV });
+	AssetPreloader::writeManifest(getPreloadManifestPath(scenePath), resources.GetDependencyGraph());
+
 	return S_OK;
 }
 
+HRESULT
+BaseApp::buildRenderMesh(Mesh& renderMesh, const Model3D& model) {
+	// Se construye aparte: si algo falla, `renderMesh` conserva la geometria anterior
+	Mesh built;
+	for (const MeshComponent& meshComponent : model.GetMeshes()) {
+		Submesh submesh{};
+		HRESULT hr = submesh.vertexBuffer.init(m_device, meshComponent, D3D11_BIND_VERTEX_BUFFER);
+		if (FAILED(hr)) {
+			built.destroy();
+			return hr;
+		}
+
+		hr = submesh.indexBuffer.init(m_device, meshComponent, D3D11_BIND_INDEX_BUFFER);
+		if (FAILED(hr)) {
+			submesh.vertexBuffer.destroy();
+			built.destroy();
+			return hr;
+		}
+
+		submesh.indexCount = meshComponent.m_numIndex;
+		submesh.materialSlot = 0;
+		submesh.bounds = Bounds::fromVertices(meshComponent.m_vertex.data(), meshComponent.m_vertex.size());
+		built.getSubmeshes().push_back(std::move(submesh));
+	}
+	built.setTriangleBVH(model.GetTriangleBVH());
+
+	// Misma direccion, nueva revision: el indice espacial y la cache de sombras la notan
+	renderMesh.replaceWith(built);
+	return S_OK;
+}
+
+void
+BaseApp::reloadRenderMesh(Mesh& renderMesh, const Model3D& model) {
+	const HRESULT hr = buildRenderMesh(renderMesh, model);
+	if (FAILED(hr)) {
+		ERROR("Main", "HotReload",
+			("Failed to rebuild render mesh; keeping the previous one. HRESULT: " + std::to_string(hr)).c_str());
+	}
+}
+
 void 
 BaseApp::update(float deltaTime) {
 	// Update our time
@@ -462,11 +561,39 @@ BaseApp::update(float deltaTime) {
 			dwTimeStart = dwTimeCur;
 		t = (dwTimeCur - dwTimeStart) / 1000.0f;
 	}
+	// Apply finished asset reloads before anything reads them this frame
+	m_hotReloader.update();
+
 	// Update User Interface
 	m_gui.update(m_viewport, m_window);
 	bool show_demo_window = true;
 	//ImGui::ShowDemoWindow(&show_demo_window);
 	m_gui.drawViewportPanel(m_editorViewportPass.getSRV());
+	ImVec2 pickPosition;
+	if (m_gui.consumeViewportPick(pickPosition)) {
+		XMFLOAT3 rayOrigin;
+		XMFLOAT3 rayDirection;
+		m_camera.screenPointToRay(pickPosition.x, pickPosition.y,
+			m_gui.m_viewportSize.x, m_gui.m_viewportSize.y, rayOrigin, rayDirection);
+
+		RaycastHit hit;
+		const auto pickBegin = std::chrono::high_resolution_clock::now();
+		const bool picked = m_sceneGraph.raycast(rayOrigin, rayDirection, m_camera.getFarZ(), hit);
+		// Se muestra en el panel Render Debug
+		m_gui.m_lastPickUs = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::high_resolution_clock::now() - pickBegin).count();
+		m_gui.m_lastPickCandidates = hit.candidatesTested;
+
+		m_gui.selectedActorIndex = -1;
+		if (picked) {
+			for (size_t i = 0; i < m_actors.size(); ++i) {
+				if (m_actors[i].get() == hit.entity) {
+					m_gui.selectedActorIndex = static_cast<int>(i);
+					break;
+				}
+			}
+		}
+	}
 	m_gui.drawRenderDebugPanel(m_forwardRenderer.getPreShadowSRV(), m_editorViewportPass.getSRV(), m_forwardRenderer.getShadowMapSRV());
 	m_gui.outliner(m_actors);
 	EU::TSharedPointer<Actor> selectedActor;
@@ -479,6 +606,9 @@ BaseApp::update(float deltaTime) {
 	if (m_gui.consumeSaveSceneRequest()) {
 		saveScene(getDefaultScenePath());
 	}
+	if (m_gui.consumeBuildAssetArchiveRequest()) {
+		buildAssetArchive();
+	}
 
 	unsigned int desiredW = static_cast<unsigned int>(m_gui.m_viewportSize.x);
 	unsigned int desiredH = static_cast<unsigned int>(m_gui.m_viewportSize.y);
@@ -526,7 +656,7 @@ BaseApp::update(float deltaTime) {
 	m_gui.vec3Control("Light Direction", &m_constantBufferStruct.LightDir.x, 0.1f);
 	m_gui.vec3Control("Light Color", &m_constantBufferStruct.LightColor.x, 0.1f);
 	if (!m_directionalLightActor.isNull()) {
-		EU::TSharedPointer<LightComponent> lightComponent = m_directionalLightActor->getComponent<LightComponent>();
+		LightComponent* lightComponent = m_directionalLightActor->getComponent<LightComponent>();
 		if (lightComponent) {
 			lightComponent->getLightData().direction = m_constantBufferStruct.LightDir;
 			lightComponent->getLightData().color = m_constantBufferStruct.LightColor;
@@ -548,6 +678,8 @@ BaseApp::render() {
 	float ClearColor[4] = { 0.1f, 0.1f, 0.1f, 1.0f };
 
 	m_renderScene.clear();
+	m_sceneGraph.gatherLights(m_renderScene);
+	m_forwardRenderer.prepareShadowVolumes(m_camera, m_renderScene);
 	m_sceneGraph.gatherRenderScene(m_renderScene, m_camera);
 	m_renderScene.skybox = &m_skybox;
 	m_forwardRenderer.render(
@@ -570,6 +702,7 @@ BaseApp::render() {
 
 void
 BaseApp::destroy() {
+	m_hotReloader.destroy();
 	if (m_deviceContext.m_deviceContext) m_deviceContext.m_deviceContext->ClearState();
 	m_sceneGraph.destroy();
 	m_editorViewportPass.destroy();
@@ -602,12 +735,12 @@ BaseApp::destroy() {
 		m_gui.destroy();
 		m_guiInitialized = false;
 	}
-	delete m_model;
-	m_model = nullptr;
-	delete m_drakefireModel;
-	m_drakefireModel = nullptr;
+	ResourceManager::getInstance().UnloadAll();
+	m_cyberGunModel = TResourceHandle<Model3D>{};
+	m_drakefireModel = TResourceHandle<Model3D>{};
 	m_deviceContext.destroy();
 	m_device.destroy();
+	JobSystem::getInstance().destroy();
 }
 
 LRESULT
@@ -738,6 +871,47 @@ std::string BaseApp::getDefaultScenePath() const
 	return "Saved/DefaultScene.wvscene";
 }
 
+std::string BaseApp::getPreloadManifestPath(const std::string& scenePath) const
+{
+	const size_t extension = scenePath.find_last_of('.');
+	return scenePath.substr(0, extension) + ".wvpreload";
+}
+
+std::string BaseApp::getAssetArchivePath() const
+{
+	CreateDirectoryA("Saved", nullptr);
+	return "Saved/Assets.wvpak";
+}
+
+bool BaseApp::buildAssetArchive()
+{
+	std::vector<std::string> cookedFiles;
+	ResourceManager& resources = ResourceManager::getInstance();
+	for (const TResourceHandle<Model3D>& handle : { m_cyberGunModel, m_drakefireModel }) {
+		if (Model3D* model = resources.Resolve(handle)) {
+			cookedFiles.push_back(model->GetPath() + ".wvmesh");
+		}
+	}
+
+	const Texture* textures[] = {
+		&m_AlbedoSRV, &m_MetallicSRV, &m_RoughnessSRV, &m_AOSRV, &m_NormalSRV, &m_EmissiveSRV,
+		&m_drakefireAlbedoSRV, &m_drakefireNormalSRV, &m_drakefireMetallicSRV,
+		&m_drakefireRoughnessSRV, &m_drakefireAOSRV
+	};
+	for (const Texture* texture : textures) {
+		if (!texture->m_textureName.empty()) {
+			cookedFiles.push_back(texture->m_textureName + ".wvtx");
+		}
+	}
+
+	// El archivo montado bloquea la escritura; se remonta al terminar.
+	AssetArchive& archive = AssetArchive::getInstance();
+	archive.unmount();
+	const bool built = AssetArchive::build(getAssetArchivePath(), cookedFiles);
+	archive.mount(getAssetArchivePath());
+	return built;
+}
+
 bool BaseApp::saveScene(const std::string& path)
 {
 	std::ofstream stream(path, std::ios::trunc);
@@ -757,7 +931,7 @@ bool BaseApp::saveScene(const std::string& path)
 
 		stream << "ACTOR " << actorIndex << " " << std::quoted(actor->getName()) << "\n";
 
-		EU::TSharedPointer<Transform> transform = actor->getComponent<Transform>();
+		Transform* transform = actor->getComponent<Transform>();
 		if (transform) {
 			const EU::Vector3& position = transform->getPosition();
 			const EU::Vector3& rotation = transform->getRotation();
@@ -767,10 +941,12 @@ bool BaseApp::saveScene(const std::string& path)
 			stream << "SCALE " << scale.x << " " << scale.y << " " << scale.z << "\n";
 		}
 
-		EU::TSharedPointer<MeshRendererComponent> meshRenderer = actor->getComponent<MeshRendererComponent>();
+		MeshRendererComponent* meshRenderer = actor->getComponent<MeshRendererComponent>();
 		if (meshRenderer) {
 			stream << "VISIBLE " << (meshRenderer->isVisible() ? 1 : 0) << "\n";
 			stream << "CAST_SHADOW " << (meshRenderer->canCastShadow() ? 1 : 0) << "\n";
+			stream << "STATIC " << (meshRenderer->isStatic() ? 1 : 0) << "\n";
+			stream << "OCCLUDER " << (meshRenderer->isOccluder() ? 1 : 0) << "\n";
 
 			const std::vector<MaterialInstance*>& materials = meshRenderer->getMaterialInstances();
 			stream << "MATERIAL_COUNT " << materials.size() << "\n";
@@ -858,7 +1034,7 @@ bool BaseApp::loadScene(const std::string& path)
 		else if (token == "POSITION" && !currentActor.isNull()) {
 			float x = 0.0f, y = 0.0f, z = 0.0f;
 			stream >> x >> y >> z;
-			EU::TSharedPointer<Transform> transform = currentActor->getComponent<Transform>();
+			Transform* transform = currentActor->getComponent<Transform>();
 			if (transform) {
 				transform->setPosition(EU::Vector3(x, y, z));
 			}
@@ -866,7 +1042,7 @@ bool BaseApp::loadScene(const std::string& path)
 		else if (token == "ROTATION" && !currentActor.isNull()) {
 			float x = 0.0f, y = 0.0f, z = 0.0f;
 			stream >> x >> y >> z;
-			EU::TSharedPointer<Transform> transform = currentActor->getComponent<Transform>();
+			Transform* transform = currentActor->getComponent<Transform>();
 			if (transform) {
 				transform->setRotation(EU::Vector3(x, y, z));
 			}
@@ -874,7 +1050,7 @@ bool BaseApp::loadScene(const std::string& path)
 		else if (token == "SCALE" && !currentActor.isNull()) {
 			float x = 1.0f, y = 1.0f, z = 1.0f;
 			stream >> x >> y >> z;
-			EU::TSharedPointer<Transform> transform = currentActor->getComponent<Transform>();
+			Transform* transform = currentActor->getComponent<Transform>();
 			if (transform) {
 				transform->setScale(EU::Vector3(x, y, z));
 			}
@@ -882,7 +1058,7 @@ bool BaseApp::loadScene(const std::string& path)
 		else if (token == "VISIBLE" && !currentActor.isNull()) {
 			int value = 1;
 			stream >> value;
-			EU::TSharedPointer<MeshRendererComponent> meshRenderer = currentActor->getComponent<MeshRendererComponent>();
+			MeshRendererComponent* meshRenderer = currentActor->getComponent<MeshRendererComponent>();
 			if (meshRenderer) {
 				meshRenderer->setVisible(value != 0);
 			}
@@ -890,11 +1066,27 @@ bool BaseApp::loadScene(const std::string& path)
 		else if (token == "CAST_SHADOW" && !currentActor.isNull()) {
 			int value = 1;
 			stream >> value;
-			EU::TSharedPointer<MeshRendererComponent> meshRenderer = currentActor->getComponent<MeshRendererComponent>();
+			MeshRendererComponent* meshRenderer = currentActor->getComponent<MeshRendererComponent>();
 			if (meshRenderer) {
 				meshRenderer->setCastShadow(value != 0);
 			}
 		}
+		else if (token == "STATIC" && !currentActor.isNull()) {
+			int value = 0;
+			stream >> value;
+			MeshRendererComponent* meshRenderer = currentActor->getComponent<MeshRendererComponent>();
+			if (meshRenderer) {
+				meshRenderer->setStatic(value != 0);
+			}
+		}
+		else if (token == "OCCLUDER" && !currentActor.isNull()) {
+			int value = 0;
+			stream >> value;
+			MeshRendererComponent* meshRenderer = currentActor->getComponent<MeshRendererComponent>();
+			if (meshRenderer) {
+				meshRenderer->setOccluder(value != 0);
+			}
+		}
 		else if (token == "MATERIAL_COUNT") {
 			size_t ignoredCount = 0;
 			stream >> ignoredCount;
@@ -917,7 +1109,7 @@ bool BaseApp::loadScene(const std::string& path)
 				>> params.normalScale
 				>> params.alphaCutoff;
 
-			EU::TSharedPointer<MeshRendererComponent> meshRenderer = currentActor->getComponent<MeshRendererComponent>();
+			MeshRendererComponent* meshRenderer = currentActor->getComponent<MeshRendererComponent>();
 			if (meshRenderer) {
 				const std::vector<MaterialInstance*>& materials = meshRenderer->getMaterialInstances();
 				if (materialIndex < materials.size() && materials[materialIndex]) {
@@ -939,7 +1131,7 @@ bool BaseApp::loadScene(const std::string& path)
 				>> m_constantBufferStruct.LightColor.z;
 
 			if (!m_directionalLightActor.isNull()) {
-				EU::TSharedPointer<LightComponent> lightComponent = m_directionalLightActor->getComponent<LightComponent>();
+				LightComponent* lightComponent = m_directionalLightActor->getComponent<LightComponent>();
 				if (lightComponent) {
 					lightComponent->getLightData().direction = m_constantBufferStruct.LightDir;
 					lightComponent->getLightData().color = m_constantBufferStruct.LightColor;
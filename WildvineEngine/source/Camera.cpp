@@ -133,4 +133,16 @@ Camera::updateViewMatrix() {
 	m_viewDirty = false;
 }
 
-
+void
+Camera::screenPointToRay(float x, float y, float width, float height,
+                         XMFLOAT3& outOrigin, XMFLOAT3& outDirection) const {
+	const float ndcX = 2.0f * x / width - 1.0f;
+	const float ndcY = 1.0f - 2.0f * y / height;
+	const float tanHalfFov = tanf(m_fovY * 0.5f);
+
+	// Direccion en espacio de vista (LH: +Z hacia delante)
+	const XMVECTOR viewDirection = XMVectorSet(ndcX * tanHalfFov * m_aspectRatio, ndcY * tanHalfFov, 1.0f, 0.0f);
+	const XMMATRIX inverseView = XMMatrixInverse(nullptr, getView());
+	XMStoreFloat3(&outDirection, XMVector3Normalize(XMVector3TransformNormal(viewDirection, inverseView)));
+	XMStoreFloat3(&outOrigin, inverseView.r[3]);
+}
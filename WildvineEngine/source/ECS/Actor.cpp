@@ -81,8 +81,13 @@ Actor::update(float deltaTime, DeviceContext& deviceContext) {
 		}
 	}
 
-	// Update the model buffer
-	m_model.mWorld = XMMatrixTranspose(getComponent<Transform>()->matrix);
+	// Update the model buffer (solo si el transform cambio desde la ultima subida)
+	Transform* transform = getComponent<Transform>();
+	if (transform->getVersion() == m_uploadedTransformVersion) {
+		return;
+	}
+	m_uploadedTransformVersion = transform->getVersion();
+	m_model.mWorld = XMMatrixTranspose(transform->getLocalMatrix());
 	m_model.vMeshColor = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 	// Update the constant buffer
 	m_modelBuffer.update(deviceContext, nullptr, 0, nullptr, &m_model, 0, 0);
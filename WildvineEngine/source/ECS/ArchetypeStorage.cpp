@@ -0,0 +1,242 @@
+/**
+ * @file ArchetypeStorage.cpp
+ * @brief Implementa la logica de ArchetypeStorage dentro del subsistema ECS.
+ * @ingroup ecs
+ */
+#include "ECS/ArchetypeStorage.h"
+#include <malloc.h>
+
+namespace {
+constexpr size_t kChunkAlignment = 64;
+
+size_t AlignUp(size_t value, size_t alignment) {
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/// Bytes que ocupan las columnas de `capacity` filas; kNoColumn marca columnas ausentes.
+size_t ComputeLayout(uint32_t capacity, bool hasTransform, bool hasMeshRenderer,
+                     size_t& outTransformOffset, size_t& outMeshRendererOffset) {
+	size_t offset = sizeof(Entity*) * capacity;
+	outTransformOffset = Archetype::kNoColumn;
+	outMeshRendererOffset = Archetype::kNoColumn;
+	if (hasTransform) {
+		offset = AlignUp(offset, alignof(TransformData));
+		outTransformOffset = offset;
+		offset += sizeof(TransformData) * capacity;
+	}
+	if (hasMeshRenderer) {
+		offset = AlignUp(offset, alignof(MeshRendererData));
+		outMeshRendererOffset = offset;
+		offset += sizeof(MeshRendererData) * capacity;
+	}
+	return offset;
+}
+}
+
+Archetype::Archetype(uint32_t mask) : m_mask(mask) {
+	const bool hasTransform = (mask & Entity::componentBit(ComponentType::TRANSFORM)) != 0;
+	const bool hasMeshRenderer = (mask & Entity::componentBit(ComponentType::MESH_RENDERER)) != 0;
+
+	size_t rowSize = sizeof(Entity*);
+	rowSize += hasTransform ? sizeof(TransformData) : 0;
+	rowSize += hasMeshRenderer ? sizeof(MeshRendererData) : 0;
+
+	// Estimacion por tamano de fila; el padding entre columnas puede quitar alguna fila.
+	m_capacity = static_cast<uint32_t>(kChunkSize / rowSize);
+	while (m_capacity > 1 &&
+	       ComputeLayout(m_capacity, hasTransform, hasMeshRenderer,
+	                     m_transformOffset, m_meshRendererOffset) > kChunkSize) {
+		--m_capacity;
+	}
+	ComputeLayout(m_capacity, hasTransform, hasMeshRenderer, m_transformOffset, m_meshRendererOffset);
+}
+
+void
+ArchetypeStorage::add(Entity* entity) {
+	if (!entity || entity->m_storageSlot.storage) {
+		return;
+	}
+	insertRow(getOrCreateArchetype(entity->getComponentMask()), entity);
+	++m_entityCount;
+}
+
+void
+ArchetypeStorage::remove(Entity* entity) {
+	if (!entity || entity->m_storageSlot.storage != this) {
+		return;
+	}
+
+	if (Transform* transform = entity->getComponent<Transform>()) {
+		transform->unbindData();
+	}
+	if (MeshRendererComponent* meshRenderer = entity->getComponent<MeshRendererComponent>()) {
+		meshRenderer->unbindData();
+	}
+
+	removeRow(entity->m_storageSlot);
+	entity->m_storageSlot = EntityStorageSlot{};
+	--m_entityCount;
+}
+
+void
+ArchetypeStorage::migrate(Entity* entity) {
+	if (!entity || entity->m_storageSlot.storage != this) {
+		return;
+	}
+
+	const uint32_t target = getOrCreateArchetype(entity->getComponentMask());
+	const EntityStorageSlot previous = entity->m_storageSlot;
+	if (target == previous.archetype) {
+		return;
+	}
+
+	// insertRow copia desde la fila anterior (la fachada aun apunta a ella).
+	insertRow(target, entity);
+	removeRow(previous);
+}
+
+void
+ArchetypeStorage::clear() {
+	for (const std::unique_ptr<Archetype>& archetype : m_archetypes) {
+		for (ArchetypeChunk& chunk : archetype->m_chunks) {
+			Entity** entities = archetype->entities(chunk);
+			for (uint32_t row = 0; row < chunk.count; ++row) {
+				Entity* entity = entities[row];
+				if (Transform* transform = entity->getComponent<Transform>()) {
+					transform->unbindData();
+				}
+				if (MeshRendererComponent* meshRenderer = entity->getComponent<MeshRendererComponent>()) {
+					meshRenderer->unbindData();
+				}
+				entity->m_storageSlot = EntityStorageSlot{};
+			}
+			_aligned_free(chunk.memory);
+		}
+	}
+	m_archetypes.clear();
+	m_archetypeByMask.clear();
+	for (auto& [mask, query] : m_queries) {
+		query->m_archetypes.clear();
+	}
+	m_entityCount = 0;
+}
+
+EntityQuery&
+ArchetypeStorage::getQuery(uint32_t requiredMask) {
+	auto it = m_queries.find(requiredMask);
+	if (it != m_queries.end()) {
+		return *it->second;
+	}
+
+	std::unique_ptr<EntityQuery> query = std::make_unique<EntityQuery>(requiredMask);
+	for (const std::unique_ptr<Archetype>& archetype : m_archetypes) {
+		if (archetype->matches(requiredMask)) {
+			query->m_archetypes.push_back(archetype.get());
+		}
+	}
+	EntityQuery& result = *query;
+	m_queries[requiredMask] = std::move(query);
+	return result;
+}
+
+size_t
+EntityQuery::getEntityCount() const {
+	size_t count = 0;
+	forEachChunk([&count](const Archetype&, const ArchetypeChunk& chunk) {
+		count += chunk.count;
+	});
+	return count;
+}
+
+size_t
+ArchetypeStorage::getChunkCount() const {
+	size_t count = 0;
+	for (const std::unique_ptr<Archetype>& archetype : m_archetypes) {
+		count += archetype->getChunks().size();
+	}
+	return count;
+}
+
+uint32_t
+ArchetypeStorage::getOrCreateArchetype(uint32_t mask) {
+	auto it = m_archetypeByMask.find(mask);
+	if (it != m_archetypeByMask.end()) {
+		return it->second;
+	}
+
+	const uint32_t index = static_cast<uint32_t>(m_archetypes.size());
+	m_archetypes.push_back(std::make_unique<Archetype>(mask));
+	m_archetypeByMask[mask] = index;
+
+	// Actualizacion incremental de las consultas cacheadas.
+	for (auto& [queryMask, query] : m_queries) {
+		if (m_archetypes.back()->matches(queryMask)) {
+			query->m_archetypes.push_back(m_archetypes.back().get());
+		}
+	}
+	return index;
+}
+
+void
+ArchetypeStorage::insertRow(uint32_t archetypeIndex, Entity* entity) {
+	Archetype& archetype = *m_archetypes[archetypeIndex];
+	std::vector<ArchetypeChunk>& chunks = archetype.m_chunks;
+	if (chunks.empty() || chunks.back().count == archetype.m_capacity) {
+		ArchetypeChunk chunk;
+		chunk.memory = static_cast<unsigned char*>(_aligned_malloc(Archetype::kChunkSize, kChunkAlignment));
+		chunks.push_back(chunk);
+	}
+
+	const uint32_t chunkIndex = static_cast<uint32_t>(chunks.size() - 1);
+	ArchetypeChunk& chunk = chunks.back();
+	const uint32_t row = chunk.count++;
+	archetype.entities(chunk)[row] = entity;
+
+	if (TransformData* transforms = archetype.transforms(chunk)) {
+		Transform* transform = entity->getComponent<Transform>();
+		transforms[row] = transform->getData();
+		transform->bindData(&transforms[row]);
+	}
+	if (MeshRendererData* meshRenderers = archetype.meshRenderers(chunk)) {
+		MeshRendererComponent* meshRenderer = entity->getComponent<MeshRendererComponent>();
+		meshRenderers[row] = meshRenderer->getData();
+		meshRenderer->bindData(&meshRenderers[row]);
+	}
+
+	entity->m_storageSlot.storage = this;
+	entity->m_storageSlot.archetype = archetypeIndex;
+	entity->m_storageSlot.chunk = chunkIndex;
+	entity->m_storageSlot.row = row;
+}
+
+void
+ArchetypeStorage::removeRow(const EntityStorageSlot& slot) {
+	Archetype& archetype = *m_archetypes[slot.archetype];
+	std::vector<ArchetypeChunk>& chunks = archetype.m_chunks;
+	ArchetypeChunk& chunk = chunks[slot.chunk];
+	ArchetypeChunk& last = chunks.back();
+	const uint32_t lastRow = last.count - 1;
+
+	// Swap-remove: la ultima fila del arquetipo ocupa el hueco.
+	if (&chunk != &last || slot.row != lastRow) {
+		Entity* moved = archetype.entities(last)[lastRow];
+		archetype.entities(chunk)[slot.row] = moved;
+
+		if (TransformData* transforms = archetype.transforms(chunk)) {
+			transforms[slot.row] = archetype.transforms(last)[lastRow];
+			moved->getComponent<Transform>()->bindData(&transforms[slot.row]);
+		}
+		if (MeshRendererData* meshRenderers = archetype.meshRenderers(chunk)) {
+			meshRenderers[slot.row] = archetype.meshRenderers(last)[lastRow];
+			moved->getComponent<MeshRendererComponent>()->bindData(&meshRenderers[slot.row]);
+		}
+
+		moved->m_storageSlot.chunk = slot.chunk;
+		moved->m_storageSlot.row = slot.row;
+	}
+
+	if (--last.count == 0) {
+		_aligned_free(last.memory);
+		chunks.pop_back();
+	}
+}
@@ -0,0 +1,20 @@
+/**
+ * @file Entity.cpp
+ * @brief Implementa la logica de Entity dentro del subsistema ECS.
+ * @ingroup ecs
+ */
+#include "ECS/Entity.h"
+#include "ECS/ArchetypeStorage.h"
+
+Entity::~Entity() {
+	if (m_storageSlot.storage) {
+		m_storageSlot.storage->remove(this);
+	}
+}
+
+void
+Entity::onComponentMaskChanged() {
+	if (m_storageSlot.storage) {
+		m_storageSlot.storage->migrate(this);
+	}
+}
@@ -0,0 +1,77 @@
+/**
+ * @file SystemScheduler.cpp
+ * @brief Implementa la logica de SystemScheduler dentro del subsistema ECS.
+ * @ingroup ecs
+ */
+#include "ECS/SystemScheduler.h"
+
+void
+SystemScheduler::addSystem(const std::string& name, uint32_t readMask, uint32_t writeMask, SystemFn fn) {
+	System system;
+	system.name = name;
+	system.readMask = readMask;
+	system.writeMask = writeMask;
+	system.fn = std::move(fn);
+	m_systems.push_back(std::move(system));
+
+	// El grafo y los contadores solo cambian al registrar: run() no reserva memoria
+	buildGraph();
+	m_remaining = std::make_unique<std::atomic<uint32_t>[]>(m_systems.size());
+}
+
+void
+SystemScheduler::buildGraph() {
+	for (System& system : m_systems) {
+		system.dependents.clear();
+		system.dependencyCount = 0;
+	}
+
+	for (uint32_t later = 0; later < m_systems.size(); ++later) {
+		System& b = m_systems[later];
+		for (uint32_t earlier = 0; earlier < later; ++earlier) {
+			System& a = m_systems[earlier];
+			const bool conflict = (a.writeMask & (b.readMask | b.writeMask)) != 0 ||
+			                      (a.readMask & b.writeMask) != 0;
+			if (conflict) {
+				a.dependents.push_back(later);
+				++b.dependencyCount;
+			}
+		}
+	}
+}
+
+void
+SystemScheduler::run(const SystemContext& context) {
+	if (m_systems.empty()) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < m_systems.size(); ++i) {
+		m_remaining[i] = m_systems[i].dependencyCount;
+	}
+
+	JobSystem& jobs = *context.jobs;
+	JobCounter counter;
+	for (uint32_t i = 0; i < m_systems.size(); ++i) {
+		if (m_systems[i].dependencyCount == 0) {
+			launch(i, context, counter);
+		}
+	}
+	jobs.wait(counter);
+}
+
+void
+SystemScheduler::launch(uint32_t index, const SystemContext& context, JobCounter& counter) {
+	context.jobs->schedule([this, index, &context, &counter]() {
+		System& system = m_systems[index];
+		SystemContext systemContext = context;
+		systemContext.chunkScratch = &system.chunks;
+		system.fn(systemContext);
+		// Se lanza a los dependientes antes de que este trabajo descuente el contador.
+		for (uint32_t dependent : system.dependents) {
+			if (m_remaining[dependent].fetch_sub(1) == 1) {
+				launch(dependent, context, counter);
+			}
+		}
+	}, counter);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file FileWatcher.cpp
+ * @brief Implementa la logica de FileWatcher dentro del subsistema Core.
+ * @ingroup core
+ */
+#include "FileWatcher.h"
+#include <algorithm>
+
+namespace {
+bool GetFileWriteTime(const std::string& path, ULONGLONG& outWriteTime) {
+	WIN32_FILE_ATTRIBUTE_DATA attributes{};
+	if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes)) {
+		return false;
+	}
+
+	ULARGE_INTEGER fileTime{};
+	fileTime.LowPart = attributes.ftLastWriteTime.dwLowDateTime;
+	fileTime.HighPart = attributes.ftLastWriteTime.dwHighDateTime;
+	outWriteTime = fileTime.QuadPart;
+	return true;
+}
+
+std::string GetDirectoryOf(const std::string& path) {
+	const size_t slash = path.find_last_of("/\\");
+	return slash == std::string::npos ? std::string(".") : path.substr(0, slash);
+}
+}
+
+void
+FileWatcher::start(unsigned int pollIntervalMs) {
+	if (m_running) {
+		return;
+	}
+	m_pollIntervalMs = pollIntervalMs > 0 ? pollIntervalMs : 1;
+	m_running = true;
+	m_thread = std::thread(&FileWatcher::run, this);
+}
+
+void
+FileWatcher::stop() {
+	m_running = false;
+	if (m_thread.joinable()) {
+		m_thread.join();
+	}
+}
+
+void
+FileWatcher::watch(const std::string& path) {
+	std::lock_guard<std::mutex> lock(m_filesMutex);
+	for (const WatchedFile& file : m_files) {
+		if (file.path == path) {
+			return;
+		}
+	}
+
+	WatchedFile file;
+	file.path = path;
+	GetFileWriteTime(path, file.knownWriteTime);
+	file.pendingWriteTime = file.knownWriteTime;
+	m_files.push_back(file);
+
+	const std::string directory = GetDirectoryOf(path);
+	if (std::find(m_directories.begin(), m_directories.end(), directory) == m_directories.end()) {
+		m_directories.push_back(directory);
+		m_directoriesDirty = true;
+	}
+}
+
+void
+FileWatcher::consumeChanges(std::vector<FileChange>& outChanges) {
+	std::lock_guard<std::mutex> lock(m_changesMutex);
+	outChanges.insert(outChanges.end(), m_changes.begin(), m_changes.end());
+	m_changes.clear();
+}
+
+void
+FileWatcher::rebuildNotifications(std::vector<HANDLE>& handles) {
+	for (HANDLE handle : handles) {
+		FindCloseChangeNotification(handle);
+	}
+	handles.clear();
+
+	std::lock_guard<std::mutex> lock(m_filesMutex);
+	for (const std::string& directory : m_directories) {
+		// WaitForMultipleObjects acepta como maximo MAXIMUM_WAIT_OBJECTS; el resto
+		// de directorios queda cubierto por el sondeo periodico.
+		if (handles.size() >= MAXIMUM_WAIT_OBJECTS) {
+			break;
+		}
+		HANDLE handle = FindFirstChangeNotificationA(directory.c_str(), FALSE,
+			FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+		if (handle != INVALID_HANDLE_VALUE) {
+			handles.push_back(handle);
+		}
+	}
+	m_directoriesDirty = false;
+}
+
+void
+FileWatcher::run() {
+	std::vector<HANDLE> handles;
+
+	while (m_running) {
+		bool directoriesDirty = false;
+		{
+			std::lock_guard<std::mutex> lock(m_filesMutex);
+			directoriesDirty = m_directoriesDirty;
+		}
+		if (directoriesDirty) {
+			rebuildNotifications(handles);
+		}
+
+		if (handles.empty()) {
+			Sleep(m_pollIntervalMs);
+		}
+		else {
+			const DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()),
+				handles.data(), FALSE, m_pollIntervalMs);
+			if (result >= WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + handles.size()) {
+				FindNextChangeNotification(handles[result - WAIT_OBJECT_0]);
+			}
+		}
+
+		scanFiles();
+	}
+
+	for (HANDLE handle : handles) {
+		FindCloseChangeNotification(handle);
+	}
+}
+
+void
+FileWatcher::scanFiles() {
+	const auto now = std::chrono::high_resolution_clock::now();
+	std::vector<FileChange> detected;
+	{
+		std::lock_guard<std::mutex> lock(m_filesMutex);
+		for (WatchedFile& file : m_files) {
+			ULONGLONG writeTime = 0;
+			if (!GetFileWriteTime(file.path, writeTime) || writeTime == file.knownWriteTime) {
+				continue;
+			}
+			// Esperar un escaneo con el mismo tiempo antes de reportar el cambio.
+			if (writeTime != file.pendingWriteTime) {
+				file.pendingWriteTime = writeTime;
+				continue;
+			}
+			file.knownWriteTime = writeTime;
+			detected.push_back(FileChange{ file.path, now });
+		}
+	}
+
+	if (!detected.empty()) {
+		std::lock_guard<std::mutex> lock(m_changesMutex);
+		m_changes.insert(m_changes.end(), detected.begin(), detected.end());
+	}
+}
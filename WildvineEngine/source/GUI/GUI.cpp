@@ -111,15 +111,15 @@ const char* GetActorTypeLabel(EU::TSharedPointer<Actor> actor) {
 	}
 
 	auto lightComponent = actor->getComponent<LightComponent>();
-	if (!lightComponent.isNull()) {
+	if (lightComponent) {
 		return GetLightTypeLabel(lightComponent->getLightData().type);
 	}
 
-	if (!actor->getComponent<MeshRendererComponent>().isNull()) {
+	if (actor->hasComponent<MeshRendererComponent>()) {
 		return "Static Mesh Actor";
 	}
 
-	if (!actor->getComponent<Transform>().isNull()) {
+	if (actor->hasComponent<Transform>()) {
 		return "Empty Actor";
 	}
 
@@ -132,11 +132,11 @@ ImVec4 GetActorTypeColor(EU::TSharedPointer<Actor> actor) {
 	}
 
 	auto lightComponent = actor->getComponent<LightComponent>();
-	if (!lightComponent.isNull()) {
+	if (lightComponent) {
 		return ImVec4(0.92f, 0.68f, 0.22f, 1.0f);
 	}
 
-	if (!actor->getComponent<MeshRendererComponent>().isNull()) {
+	if (actor->hasComponent<MeshRendererComponent>()) {
 		return ImVec4(0.24f, 0.50f, 0.92f, 1.0f);
 	}
 
@@ -558,9 +558,9 @@ GUI::inspectorGeneral(EU::TSharedPointer<Actor> actor) {
 	auto meshRenderer = actor->getComponent<MeshRendererComponent>();
 	auto lightComponent = actor->getComponent<LightComponent>();
 	auto transform = actor->getComponent<Transform>();
-	const bool hasMeshRenderer = !meshRenderer.isNull();
-	const bool hasLightComponent = !lightComponent.isNull();
-	const bool hasTransform = !transform.isNull();
+	const bool hasMeshRenderer = meshRenderer != nullptr;
+	const bool hasLightComponent = lightComponent != nullptr;
+	const bool hasTransform = transform != nullptr;
 	const ImVec4 accentColor = GetActorTypeColor(actor);
 	const char* actorTypeLabel = GetActorTypeLabel(actor);
 
@@ -619,6 +619,14 @@ GUI::inspectorGeneral(EU::TSharedPointer<Actor> actor) {
 				DrawPropertyToggle("Cast Shadow", "##RendererCastShadow", &castShadow);
 				meshRenderer->setCastShadow(castShadow);
 
+				bool isStatic = meshRenderer->isStatic();
+				DrawPropertyToggle("Static", "##RendererStatic", &isStatic);
+				meshRenderer->setStatic(isStatic);
+
+				bool isOccluder = meshRenderer->isOccluder();
+				DrawPropertyToggle("Occluder", "##RendererOccluder", &isOccluder);
+				meshRenderer->setOccluder(isOccluder);
+
 				char countBuffer[32] = {};
 				sprintf_s(countBuffer, "%d", submeshCount);
 				DrawPropertyValueText("Submeshes", countBuffer);
@@ -722,9 +730,25 @@ void
 GUI::inspectorContainer(EU::TSharedPointer<Actor> actor) {
 	//ImGui::Begin("Transform");
 	// Draw the structure
-	vec3Control("Position", const_cast<float*>(actor->getComponent<Transform>()->getPosition().data()), 0.0f, 78.0f, false);
-	vec3Control("Rotation", const_cast<float*>(actor->getComponent<Transform>()->getRotation().data()), 0.0f, 78.0f, true);
-	vec3Control("Scale", const_cast<float*>(actor->getComponent<Transform>()->getScale().data()), 1.0f, 78.0f, false);
+	Transform* transform = actor->getComponent<Transform>();
+	if (!transform) return;
+
+	// Se editan copias y se aplican con los setters para que el transform quede sucio
+	EU::Vector3 position = transform->getPosition();
+	EU::Vector3 rotation = transform->getRotation();
+	EU::Vector3 scale = transform->getScale();
+	vec3Control("Position", position.data(), 0.0f, 78.0f, false);
+	vec3Control("Rotation", rotation.data(), 0.0f, 78.0f, true);
+	vec3Control("Scale", scale.data(), 1.0f, 78.0f, false);
+
+	auto changed = [](const EU::Vector3& a, const EU::Vector3& b) {
+		return a.x != b.x || a.y != b.y || a.z != b.z;
+	};
+	if (changed(position, transform->getPosition()) ||
+	    changed(rotation, transform->getRotation()) ||
+	    changed(scale, transform->getScale())) {
+		transform->setTransform(position, rotation, scale);
+	}
 
 	//ImGui::End();
 }
@@ -753,10 +777,10 @@ GUI::outliner(const std::vector<EU::TSharedPointer<Actor>>& actors) {
 			continue;
 		}
 
-		auto meshRenderer = actor ? actor->getComponent<MeshRendererComponent>() : EU::TSharedPointer<MeshRendererComponent>();
-		auto lightComponent = actor ? actor->getComponent<LightComponent>() : EU::TSharedPointer<LightComponent>();
-		const bool hasMeshRenderer = !meshRenderer.isNull();
-		const bool hasLightComponent = !lightComponent.isNull();
+		auto meshRenderer = actor ? actor->getComponent<MeshRendererComponent>() : nullptr;
+		auto lightComponent = actor ? actor->getComponent<LightComponent>() : nullptr;
+		const bool hasMeshRenderer = meshRenderer != nullptr;
+		const bool hasLightComponent = lightComponent != nullptr;
 
 		ImGui::PushID(i);
 		const bool isSelected = (selectedActorIndex == i);
@@ -801,7 +825,7 @@ void GUI::editTransform(Camera& cam, Window& window, EU::TSharedPointer<Actor> a
 {
 	if (actor.isNull()) return;
 	auto transform = actor->getComponent<Transform>();
-	if (transform.isNull()) return;
+	if (!transform) return;
 
 	float rectX = m_viewportPos.x;
 	float rectY = m_viewportPos.y;
@@ -975,6 +999,10 @@ void GUI::drawStudioTopRibbon()
 				{
 					m_requestSaveScene = true;
 				}
+				if (ImGui::MenuItem("Build Asset Pack"))
+				{
+					m_requestBuildAssetArchive = true;
+				}
 				ImGui::Separator();
 				if (ImGui::MenuItem("Exit"))
 				{
@@ -1248,6 +1276,14 @@ void GUI::drawViewportPanel(ID3D11ShaderResourceView* viewportSRV)
 		m_viewportHovered = ImGui::IsItemHovered();
 		m_viewportActive = ImGui::IsItemActive();
 		m_viewportFocused = ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows);
+
+		// Clic fuera del gizmo: BaseApp lanza un rayo desde ese pixel para seleccionar
+		if (m_viewportHovered && ImGui::IsMouseClicked(ImGuiMouseButton_Left) &&
+			!m_isUsingGizmo && !ImGuizmo::IsOver()) {
+			const ImVec2 mouse = ImGui::GetMousePos();
+			m_viewportPickPosition = ImVec2(mouse.x - itemMin.x, mouse.y - itemMin.y);
+			m_requestViewportPick = true;
+		}
 	}
 	ImGui::End();
 
@@ -1299,6 +1335,12 @@ void GUI::drawRenderDebugPanel(ID3D11ShaderResourceView* preShadowSRV,
 		ImGui::PopID();
 	}
 
+	if (m_lastPickUs >= 0) {
+		ImGui::Separator();
+		ImGui::Text("Last Pick: %lld us, %u meshes tested",
+			static_cast<long long>(m_lastPickUs), m_lastPickCandidates);
+	}
+
 	ImGui::Separator();
 	ImGui::Text("Focused View: %s", items[selectedView].label);
 
@@ -0,0 +1,142 @@
+/**
+ * @file JobSystem.cpp
+ * @brief Implementa la logica de JobSystem dentro del subsistema Utilities.
+ * @ingroup utilities
+ */
+#include "EngineUtilities\Utilities\JobSystem.h"
+#include <chrono>
+
+namespace {
+/// Cola del hilo actual: 0 para hilos externos, 1..N para workers.
+thread_local uint32_t t_queueIndex = 0;
+}
+
+void
+JobSystem::init(uint32_t workerCount) {
+	destroy();
+
+	if (workerCount == 0) {
+		const uint32_t cores = std::thread::hardware_concurrency();
+		workerCount = cores > 1 ? cores - 1 : 0;
+	}
+
+	m_queues.clear();
+	for (uint32_t i = 0; i <= workerCount; ++i) {
+		m_queues.push_back(std::make_unique<WorkerQueue>());
+	}
+
+	m_running = true;
+	for (uint32_t i = 1; i <= workerCount; ++i) {
+		m_threads.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+
+	MESSAGE("JobSystem", "init", L"Started " << workerCount << L" worker threads")
+}
+
+void
+JobSystem::destroy() {
+	if (!m_running) {
+		return;
+	}
+
+	// Vaciar lo pendiente antes de parar para no dejar contadores colgados.
+	while (m_queuedJobs > 0) {
+		if (!tryRunJob(0)) {
+			std::this_thread::yield();
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_running = false;
+	}
+	m_wake.notify_all();
+	for (std::thread& thread : m_threads) {
+		thread.join();
+	}
+	m_threads.clear();
+	m_queues.clear();
+}
+
+void
+JobSystem::schedule(Job job, JobCounter& counter) {
+	counter.pending.fetch_add(1);
+
+	if (m_queues.empty()) {
+		// Sin init(): se ejecuta en el acto.
+		job();
+		counter.pending.fetch_sub(1);
+		return;
+	}
+
+	WorkerQueue& queue = *m_queues[t_queueIndex];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(QueuedJob{ std::move(job), &counter });
+	}
+	m_queuedJobs.fetch_add(1);
+	m_wake.notify_one();
+}
+
+void
+JobSystem::wait(JobCounter& counter) {
+	while (counter.pending.load() > 0) {
+		if (!tryRunJob(t_queueIndex)) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool
+JobSystem::tryRunJob(uint32_t queueIndex) {
+	if (m_queues.empty()) {
+		return false;
+	}
+
+	QueuedJob queued;
+	bool found = false;
+	{
+		// Cola propia: el ultimo encolado (LIFO).
+		WorkerQueue& own = *m_queues[queueIndex];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.jobs.empty()) {
+			queued = std::move(own.jobs.back());
+			own.jobs.pop_back();
+			found = true;
+		}
+	}
+
+	// Robo: el mas antiguo de las demas colas (FIFO).
+	const size_t queueCount = m_queues.size();
+	for (size_t offset = 1; !found && offset < queueCount; ++offset) {
+		WorkerQueue& victim = *m_queues[(queueIndex + offset) % queueCount];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty()) {
+			queued = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			found = true;
+		}
+	}
+
+	if (!found) {
+		return false;
+	}
+
+	m_queuedJobs.fetch_sub(1);
+	queued.job();
+	queued.counter->pending.fetch_sub(1);
+	return true;
+}
+
+void
+JobSystem::workerLoop(uint32_t queueIndex) {
+	t_queueIndex = queueIndex;
+	while (m_running) {
+		if (tryRunJob(queueIndex)) {
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_wake.wait_for(lock, std::chrono::milliseconds(1),
+			[this]() { return !m_running || m_queuedJobs > 0; });
+	}
+}
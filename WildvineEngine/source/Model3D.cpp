@@ -4,23 +4,30 @@
  * @ingroup core
  */
 #include "Model3D.h"
+#include "AssetArchive.h"
+#include "AssetPreloader.h"
 #include <chrono>
 #include <cstdint>
 #include <cmath>
 #include <fstream>
+#include <mutex>
 #include <unordered_map>
 #include <sstream>
 
 namespace {
 constexpr uint32_t kModelCacheMagic = 0x48564D57; // WMVH
-constexpr uint32_t kModelCacheVersion = 1;
+constexpr uint32_t kModelCacheVersion = 2;        // 2: agrega el BVH de triangulos
+constexpr uint32_t kModelCacheVersionNoBVH = 1;   // se acepta y el BVH se construye al cargar
 
 struct ModelCacheEntry {
 	std::vector<MeshComponent> meshes;
 	std::vector<std::string> textureFileNames;
+	std::shared_ptr<const TriangleBVH> triangleBVH;
 };
 
 std::unordered_map<std::string, ModelCacheEntry> g_modelCache;
+// La recarga en caliente importa modelos desde hilos de fondo.
+std::mutex g_modelCacheMutex;
 
 bool GetFileWriteTime(const std::string& path, ULONGLONG& outWriteTime) {
 	WIN32_FILE_ATTRIBUTE_DATA attributes{};
@@ -35,6 +42,16 @@ bool GetFileWriteTime(const std::string& path, ULONGLONG& outWriteTime) {
 	return true;
 }
 
+// Una entrada del archivo sigue vigente si el fuente no existe (build empaquetado)
+// o si no se modifico despues de empaquetar.
+bool IsArchiveEntryUpToDate(const std::string& sourcePath, const AssetBlob& blob) {
+	ULONGLONG sourceWriteTime = 0;
+	if (!GetFileWriteTime(sourcePath, sourceWriteTime)) {
+		return true;
+	}
+	return blob.sourceWriteTime >= sourceWriteTime;
+}
+
 bool WriteString(std::ofstream& stream, const std::string& value) {
 	const uint32_t length = static_cast<uint32_t>(value.size());
 	stream.write(reinterpret_cast<const char*>(&length), sizeof(length));
@@ -43,20 +60,6 @@ bool WriteString(std::ofstream& stream, const std::string& value) {
 	}
 	return stream.good();
 }
-
-bool ReadString(std::ifstream& stream, std::string& value) {
-	uint32_t length = 0;
-	stream.read(reinterpret_cast<char*>(&length), sizeof(length));
-	if (!stream.good()) {
-		return false;
-	}
-
-	value.resize(length);
-	if (length > 0) {
-		stream.read(&value[0], length);
-	}
-	return stream.good();
-}
 }
 
 Model3D::~Model3D() {
@@ -68,27 +71,52 @@ Model3D::load(const std::string& path) {
 	SetPath(path);
 	SetState(ResourceState::Loading);
 
-	auto cacheIt = g_modelCache.find(path);
-	if (cacheIt != g_modelCache.end()) {
-		m_meshes = cacheIt->second.meshes;
-		textureFileNames = cacheIt->second.textureFileNames;
-		SetState(ResourceState::Loaded);
-		return true;
+	{
+		std::lock_guard<std::mutex> lock(g_modelCacheMutex);
+		auto cacheIt = g_modelCache.find(path);
+		if (cacheIt != g_modelCache.end()) {
+			m_meshes = cacheIt->second.meshes;
+			textureFileNames = cacheIt->second.textureFileNames;
+			m_triangleBVH = cacheIt->second.triangleBVH;
+			SetState(ResourceState::Loaded);
+			return true;
+		}
 	}
 
-	const bool success = init();
+	const bool success = ImportModel();
 	SetState(success ? ResourceState::Loaded : ResourceState::Failed);
 	return success;
 }
 
 bool Model3D::init()
+{
+	// La importacion ocurre en load(); ResourceManager llama init() despues de
+	// load(), asi que aqui solo se valida el resultado para no importar dos veces.
+	return !m_meshes.empty();
+}
+
+bool Model3D::ImportModel()
 {
 	m_meshes.clear();
 	textureFileNames.clear();
+	m_triangleBVH.reset();
 
 	const std::string cachePath = GetBinaryCachePath();
+
+	// 1. Cache empaquetado en el .wvpak montado (sin abrir archivos).
+	AssetBlob blob;
+	if (AssetArchive::getInstance().find(cachePath, blob) &&
+	    IsArchiveEntryUpToDate(m_filePath, blob) &&
+	    ParseBinaryCache(blob.data, blob.size)) {
+		std::lock_guard<std::mutex> lock(g_modelCacheMutex);
+		g_modelCache[m_filePath] = ModelCacheEntry{ m_meshes, textureFileNames, m_triangleBVH };
+		return true;
+	}
+
+	// 2. Cache suelto .wvmesh junto al modelo.
 	if (IsBinaryCacheUpToDate(m_filePath, cachePath) && LoadBinaryCache(cachePath)) {
-		g_modelCache[m_filePath] = ModelCacheEntry{ m_meshes, textureFileNames };
+		std::lock_guard<std::mutex> lock(g_modelCacheMutex);
+		g_modelCache[m_filePath] = ModelCacheEntry{ m_meshes, textureFileNames, m_triangleBVH };
 		return true;
 	}
 
@@ -108,7 +136,11 @@ bool Model3D::init()
 	}
 
 	m_meshes = loadedMeshes;
-	g_modelCache[m_filePath] = ModelCacheEntry{ m_meshes, textureFileNames };
+	BuildTriangleBVH();
+	{
+		std::lock_guard<std::mutex> lock(g_modelCacheMutex);
+		g_modelCache[m_filePath] = ModelCacheEntry{ m_meshes, textureFileNames, m_triangleBVH };
+	}
 	SaveBinaryCache(cachePath);
 
 	const std::wstring modelPathW(m_filePath.begin(), m_filePath.end());
@@ -131,6 +163,12 @@ void Model3D::unload()
 	SetState(ResourceState::Unloaded);
 }
 
+void Model3D::EvictFromMemoryCache(const std::string& path)
+{
+	std::lock_guard<std::mutex> lock(g_modelCacheMutex);
+	g_modelCache.erase(path);
+}
+
 size_t Model3D::getSizeInBytes() const
 {
 	size_t totalSize = 0;
@@ -138,6 +176,10 @@ size_t Model3D::getSizeInBytes() const
 		totalSize += mesh.m_vertex.size() * sizeof(SimpleVertex);
 		totalSize += mesh.m_index.size() * sizeof(unsigned int);
 	}
+	if (m_triangleBVH) {
+		totalSize += m_triangleBVH->getNodes().size() * sizeof(TriangleBVH::Node);
+		totalSize += m_triangleBVH->getPackets().size() * sizeof(TriangleBVH::TrianglePacket);
+	}
 	return totalSize;
 }
 
@@ -700,22 +742,46 @@ Model3D::IsBinaryCacheUpToDate(const std::string& sourcePath, const std::string&
 
 bool
 Model3D::LoadBinaryCache(const std::string& cachePath) {
-	std::ifstream stream(cachePath, std::ios::binary);
-	if (!stream.is_open()) {
+	// Una sola lectura del archivo completo; el parseo se hace desde memoria,
+	// igual que cuando el cache viene de un AssetArchive. Si el manifiesto de
+	// precarga ya pidio este archivo, se reutilizan esos bytes.
+	std::vector<unsigned char> data;
+	if (!AssetPreloader::getInstance().consume(cachePath, data)) {
+		std::ifstream stream(cachePath, std::ios::binary | std::ios::ate);
+		if (!stream.is_open()) {
+			return false;
+		}
+
+		const std::streamsize size = stream.tellg();
+		stream.seekg(0, std::ios::beg);
+		data.resize(static_cast<size_t>(size > 0 ? size : 0));
+		if (size <= 0 || !stream.read(reinterpret_cast<char*>(data.data()), size).good()) {
+			return false;
+		}
+	}
+
+	if (!ParseBinaryCache(data.data(), data.size())) {
 		return false;
 	}
 
+	const std::wstring cachePathW(cachePath.begin(), cachePath.end());
+	MESSAGE("ModelLoader", "BinaryCache",
+		L"Loaded binary cache '" << cachePathW << L"'")
+	return true;
+}
+
+bool
+Model3D::ParseBinaryCache(const unsigned char* data, size_t size) {
+	MemoryReader reader(data, size);
 	uint32_t magic = 0;
 	uint32_t version = 0;
 	uint32_t meshCount = 0;
 	uint32_t textureCount = 0;
 
-	stream.read(reinterpret_cast<char*>(&magic), sizeof(magic));
-	stream.read(reinterpret_cast<char*>(&version), sizeof(version));
-	stream.read(reinterpret_cast<char*>(&meshCount), sizeof(meshCount));
-	stream.read(reinterpret_cast<char*>(&textureCount), sizeof(textureCount));
-
-	if (!stream.good() || magic != kModelCacheMagic || version != kModelCacheVersion) {
+	if (!reader.read(magic) || !reader.read(version) ||
+	    !reader.read(meshCount) || !reader.read(textureCount) ||
+	    magic != kModelCacheMagic ||
+	    (version != kModelCacheVersion && version != kModelCacheVersionNoBVH)) {
 		return false;
 	}
 
@@ -726,7 +792,7 @@ Model3D::LoadBinaryCache(const std::string& cachePath) {
 
 	for (uint32_t i = 0; i < textureCount; ++i) {
 		std::string textureName;
-		if (!ReadString(stream, textureName)) {
+		if (!reader.readString(textureName)) {
 			return false;
 		}
 		loadedTextures.push_back(std::move(textureName));
@@ -734,27 +800,27 @@ Model3D::LoadBinaryCache(const std::string& cachePath) {
 
 	for (uint32_t i = 0; i < meshCount; ++i) {
 		MeshComponent mesh;
-		if (!ReadString(stream, mesh.m_name)) {
+		if (!reader.readString(mesh.m_name)) {
 			return false;
 		}
 
 		uint32_t vertexCount = 0;
 		uint32_t indexCount = 0;
-		stream.read(reinterpret_cast<char*>(&vertexCount), sizeof(vertexCount));
-		stream.read(reinterpret_cast<char*>(&indexCount), sizeof(indexCount));
-		if (!stream.good()) {
+		if (!reader.read(vertexCount) || !reader.read(indexCount)) {
+			return false;
+		}
+		// Un conteo corrupto no debe reservar mas memoria de la que queda en el cache
+		if (static_cast<uint64_t>(vertexCount) * sizeof(SimpleVertex) +
+		    static_cast<uint64_t>(indexCount) * sizeof(unsigned int) > reader.remaining()) {
 			return false;
 		}
 
 		mesh.m_vertex.resize(vertexCount);
 		mesh.m_index.resize(indexCount);
-		if (vertexCount > 0) {
-			stream.read(reinterpret_cast<char*>(mesh.m_vertex.data()), sizeof(SimpleVertex) * vertexCount);
-		}
-		if (indexCount > 0) {
-			stream.read(reinterpret_cast<char*>(mesh.m_index.data()), sizeof(unsigned int) * indexCount);
+		if (vertexCount > 0 && !reader.read(mesh.m_vertex.data(), sizeof(SimpleVertex) * vertexCount)) {
+			return false;
 		}
-		if (!stream.good()) {
+		if (indexCount > 0 && !reader.read(mesh.m_index.data(), sizeof(unsigned int) * indexCount)) {
 			return false;
 		}
 
@@ -763,12 +829,51 @@ Model3D::LoadBinaryCache(const std::string& cachePath) {
 		loadedMeshes.push_back(std::move(mesh));
 	}
 
+	// BVH de triangulos: nodos y paquetes tal cual estan en memoria
+	std::vector<TriangleBVH::Node> nodes;
+	std::vector<TriangleBVH::TrianglePacket> packets;
+	bool hasBVH = false;
+	if (version >= kModelCacheVersion) {
+		uint32_t nodeCount = 0;
+		uint32_t packetCount = 0;
+		if (!reader.read(nodeCount) || !reader.read(packetCount)) {
+			return false;
+		}
+		if (static_cast<uint64_t>(nodeCount) * sizeof(TriangleBVH::Node) +
+		    static_cast<uint64_t>(packetCount) * sizeof(TriangleBVH::TrianglePacket) > reader.remaining()) {
+			return false;
+		}
+		nodes.resize(nodeCount);
+		packets.resize(packetCount);
+		if ((nodeCount > 0 && !reader.read(nodes.data(), sizeof(TriangleBVH::Node) * nodeCount)) ||
+		    (packetCount > 0 && !reader.read(packets.data(), sizeof(TriangleBVH::TrianglePacket) * packetCount))) {
+			return false;
+		}
+
+		// Indices fuera de rango invalidan el arbol; se reconstruye en lugar de confiar en el.
+		// Los hijos van siempre despues del padre: asi un cache corrupto no puede formar ciclos.
+		hasBVH = nodeCount > 0;
+		for (uint32_t i = 0; i < nodeCount; ++i) {
+			const TriangleBVH::Node& node = nodes[i];
+			const bool valid = node.count == 0 ? node.first > i && node.first < nodeCount - 1
+			                                   : node.count <= TriangleBVH::kLeafSize && node.first < packetCount;
+			if (!valid) {
+				hasBVH = false;
+				break;
+			}
+		}
+	}
+
 	m_meshes = std::move(loadedMeshes);
 	textureFileNames = std::move(loadedTextures);
-
-	const std::wstring cachePathW(cachePath.begin(), cachePath.end());
-	MESSAGE("ModelLoader", "BinaryCache",
-		L"Loaded binary cache '" << cachePathW << L"'")
+	if (hasBVH) {
+		auto triangleBVH = std::make_shared<TriangleBVH>();
+		triangleBVH->assign(std::move(nodes), std::move(packets));
+		m_triangleBVH = std::move(triangleBVH);
+	}
+	else {
+		BuildTriangleBVH();
+	}
 	return true;
 }
 
@@ -815,7 +920,32 @@ Model3D::SaveBinaryCache(const std::string& cachePath) const {
 		}
 	}
 
+	const std::vector<TriangleBVH::Node> emptyNodes;
+	const std::vector<TriangleBVH::TrianglePacket> emptyPackets;
+	const std::vector<TriangleBVH::Node>& nodes = m_triangleBVH ? m_triangleBVH->getNodes() : emptyNodes;
+	const std::vector<TriangleBVH::TrianglePacket>& packets = m_triangleBVH ? m_triangleBVH->getPackets() : emptyPackets;
+	const uint32_t nodeCount = static_cast<uint32_t>(nodes.size());
+	const uint32_t packetCount = static_cast<uint32_t>(packets.size());
+	stream.write(reinterpret_cast<const char*>(&nodeCount), sizeof(nodeCount));
+	stream.write(reinterpret_cast<const char*>(&packetCount), sizeof(packetCount));
+	if (nodeCount > 0) {
+		stream.write(reinterpret_cast<const char*>(nodes.data()), sizeof(TriangleBVH::Node) * nodeCount);
+	}
+	if (packetCount > 0) {
+		stream.write(reinterpret_cast<const char*>(packets.data()), sizeof(TriangleBVH::TrianglePacket) * packetCount);
+	}
+
 	return stream.good();
 }
 
+void
+Model3D::BuildTriangleBVH() {
+	auto triangleBVH = std::make_shared<TriangleBVH>();
+	for (const MeshComponent& mesh : m_meshes) {
+		triangleBVH->addSubmesh(mesh.m_vertex.data(), mesh.m_vertex.size(), mesh.m_index.data(), mesh.m_index.size());
+	}
+	triangleBVH->build();
+	m_triangleBVH = triangleBVH->isEmpty() ? nullptr : std::move(triangleBVH);
+}
+
 
@@ -14,9 +14,25 @@
 #include "SamplerState.h"
 #include "EngineUtilities/Utilities/Camera.h"
 #include "EngineUtilities/Utilities/EditorViewportPass.h"
+#include "EngineUtilities/Utilities/JobSystem.h"
 #include "EngineUtilities/Utilities/LayoutBuilder.h"
 #include "EngineUtilities/Utilities/Skybox.h"
 
+static_assert(ShadowCascades::kMaxCascades <= 4, "El atlas de sombras tiene cuadrantes de 2x2");
+
+namespace {
+/// Cajas de los casters que tienen una, en el orden de `casters`.
+void
+FillCasterBatch(EU::TSpan<const RenderObject* const> casters, BoundsBatch& batch) {
+	batch.clear();
+	for (const RenderObject* object : casters) {
+		if (object->worldBounds.isValid()) {
+			batch.push(object->worldBounds);
+		}
+	}
+}
+}
+
 HRESULT
 ForwardRenderer::init(Device& device) {
 	HRESULT hr = m_perFrameBuffer.init(device, sizeof(CBPerFrame));
@@ -69,7 +85,6 @@ void
 ForwardRenderer::updatePerFrame(const Camera& camera,
 	const RenderScene& scene,
 	DeviceContext& deviceContext) {
-	updateLightMatrices(camera, scene);
 	XMStoreFloat4x4(&m_cbPerFrame.View, XMMatrixTranspose(camera.getView()));
 	XMStoreFloat4x4(&m_cbPerFrame.Projection, XMMatrixTranspose(camera.getProj()));
 	m_cbPerFrame.CameraPos = camera.getPosition();
@@ -93,6 +108,15 @@ ForwardRenderer::render(DeviceContext& deviceContext,
 	const float viewportClear[4] = { 0.10f, 0.10f, 0.10f, 1.0f };
 
 	buildQueues(scene, camera);
+	if (m_lightClustering && !scene.localLights.empty()) {
+		m_lightClusters.build(camera.getView(), camera.getProj(), camera.getNearZ(), camera.getFarZ(),
+			scene.localLights, &JobSystem::getInstance());
+	}
+	else {
+		m_lightClusters.clear();
+	}
+	updateLightMatrices(camera, scene);
+	cullShadowCasters();
 	updatePerFrame(camera, scene, deviceContext);
 
 	renderPreShadowDebugPass(deviceContext, scene);
@@ -107,8 +131,12 @@ ForwardRenderer::render(DeviceContext& deviceContext,
 
 void
 ForwardRenderer::destroy() {
-	m_opaqueQueue.clear();
-	m_transparentQueue.clear();
+	m_queues.clear();
+	for (uint32_t c = 0; c < ShadowCascades::kMaxCascades; ++c) {
+		m_cascadeQueues[c].clear();
+		m_staticCascadeQueues[c].clear();
+	}
+	m_lightClusters.clear();
 	SAFE_RELEASE(m_alphaBlendState);
 	SAFE_RELEASE(m_opaqueBlendState);
 	SAFE_RELEASE(m_additiveBlendState);
@@ -122,35 +150,71 @@ ForwardRenderer::destroy() {
 	m_shadowDSV.destroy();
 	m_shadowDepthSRV.destroy();
 	m_shadowDepthTexture.destroy();
+	m_staticShadowDSV.destroy();
+	m_staticShadowSRV.destroy();
+	m_staticShadowTexture.destroy();
+	m_activeShadowSRV = nullptr;
+	m_shadowCacheTracker.invalidate();
 	m_preShadowDebugPass.destroy();
 }
 
 void
 ForwardRenderer::buildQueues(RenderScene& scene, const Camera& camera) {
 	(void)camera;
-	m_opaqueQueue.clear();
-	m_transparentQueue.clear();
+	m_queues.build(scene, m_cacheStaticShadows);
 
-	for (auto& object : scene.opaqueObjects) {
-		m_opaqueQueue.push_back(&object);
+	// Las colas de cascada se llenan en cullShadowCasters(), tambien en el arena del frame
+	EU::LinearArena* arena = &scene.getFrameArena();
+	for (uint32_t c = 0; c < ShadowCascades::kMaxCascades; ++c) {
+		m_cascadeQueues[c].reset(arena, m_cascadeQueues[c].size());
+		m_staticCascadeQueues[c].reset(arena, m_staticCascadeQueues[c].size());
 	}
+}
+
+void
+ForwardRenderer::cullShadowCasters() {
+	// El gather conserva fuera de camara los casters que tocan algun volumen de
+	// prepareShadowVolumes(); cada cascada se queda con los que caen en el suyo.
+	const uint32_t cascadeCount = m_shadowCascades.getCascadeCount();
+	m_shadowStats = ShadowStats{};
+	m_shadowStats.cascadeCount = cascadeCount;
+	m_shadowStats.castersTested = m_shadowBatch.size() + m_staticShadowBatch.size();
+
+	for (uint32_t c = 0; c < ShadowCascades::kMaxCascades; ++c) {
+		m_cascadeQueues[c].clear();
+		m_staticCascadeQueues[c].clear();
+		if (c >= cascadeCount) {
+			continue;
+		}
 
-	for (auto& object : scene.transparentObjects) {
-		m_transparentQueue.push_back(&object);
+		const Frustum& frustum = m_shadowCascades.getCascade(c).casterFrustum;
+		cullCascadeCasters(frustum, m_queues.shadow, m_shadowBatch, m_cascadeQueues[c]);
+		cullCascadeCasters(frustum, m_queues.staticShadow, m_staticShadowBatch, m_staticCascadeQueues[c]);
+		m_shadowStats.cascadeCasters[c] = m_cascadeQueues[c].size() + m_staticCascadeQueues[c].size();
 	}
 
-	std::sort(m_opaqueQueue.begin(), m_opaqueQueue.end(),
-		[](const RenderObject* lhs, const RenderObject* rhs) {
-			if (lhs->materialInstance != rhs->materialInstance) {
-				return lhs->materialInstance < rhs->materialInstance;
-			}
-			return lhs->distanceToCamera < rhs->distanceToCamera;
-		});
+	m_staticShadowDirty = false;
+	if (m_cacheStaticShadows) {
+		m_shadowStats.cacheInvalidation =
+			m_shadowCacheTracker.update(m_shadowLightDirection, m_shadowCascades, m_staticCascadeQueues);
+		m_staticShadowDirty = m_shadowStats.cacheInvalidation != ShadowCacheInvalidation::None;
+	}
+}
 
-	std::sort(m_transparentQueue.begin(), m_transparentQueue.end(),
-		[](const RenderObject* lhs, const RenderObject* rhs) {
-			return lhs->distanceToCamera > rhs->distanceToCamera;
-	});
+void
+ForwardRenderer::cullCascadeCasters(const Frustum& frustum,
+	EU::TSpan<const RenderObject* const> casters,
+	const BoundsBatch& batch,
+	RenderQueue& outQueue) {
+	m_shadowVisible.resize(batch.size());
+	frustum.cull(batch, m_shadowVisible.data());
+	size_t batchIndex = 0;
+	for (const RenderObject* object : casters) {
+		// Sin caja no se puede descartar
+		if (!object->worldBounds.isValid() || m_shadowVisible[batchIndex++]) {
+			outQueue.push_back(object);
+		}
+	}
 }
 
 void
@@ -161,27 +225,84 @@ ForwardRenderer::renderShadowPass(DeviceContext& deviceContext) {
 
 	ID3D11ShaderResourceView* nullShadowSRV[1] = { nullptr };
 	deviceContext.PSSetShaderResources(6, 1, nullShadowSRV);
-	deviceContext.OMSetRenderTargets(0, nullptr, m_shadowDSV.m_depthStencilView);
-	deviceContext.ClearDepthStencilView(m_shadowDSV.m_depthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
-
-	D3D11_VIEWPORT shadowViewport{};
-	shadowViewport.TopLeftX = 0.0f;
-	shadowViewport.TopLeftY = 0.0f;
-	shadowViewport.Width = static_cast<float>(m_shadowMapSize);
-	shadowViewport.Height = static_cast<float>(m_shadowMapSize);
-	shadowViewport.MinDepth = 0.0f;
-	shadowViewport.MaxDepth = 1.0f;
-	deviceContext.RSSetViewports(1, &shadowViewport);
-
 	m_shadowRasterizer.render(deviceContext);
 	m_perFrameBuffer.render(deviceContext, 0, 1, false);
 
-	for (const RenderObject* object : m_opaqueQueue) {
-		if (!object || !object->castShadow) {
-			continue;
+	bool hasDynamicCasters = false;
+	for (uint32_t c = 0; c < m_shadowCascades.getCascadeCount(); ++c) {
+		hasDynamicCasters = hasDynamicCasters || !m_cascadeQueues[c].empty();
+	}
+
+	const XMFLOAT4X4 mainLightViewProjection = m_cbPerFrame.LightViewProjection;
+	size_t staticDrawn = 0;
+	size_t dynamicDrawn = 0;
+	if (m_cacheStaticShadows) {
+		if (m_staticShadowDirty) {
+			deviceContext.OMSetRenderTargets(0, nullptr, m_staticShadowDSV.m_depthStencilView);
+			deviceContext.ClearDepthStencilView(m_staticShadowDSV.m_depthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
+			staticDrawn = drawShadowCascades(deviceContext, m_staticCascadeQueues);
+		}
+		else {
+			for (uint32_t c = 0; c < m_shadowCascades.getCascadeCount(); ++c) {
+				m_shadowStats.staticCached += m_staticCascadeQueues[c].size();
+			}
+		}
+
+		m_activeShadowSRV = m_staticShadowSRV.m_textureFromImg;
+		if (hasDynamicCasters) {
+			// Copia del frame: la cache estatica y encima los casters dinamicos
+			deviceContext.OMSetRenderTargets(0, nullptr, nullptr);
+			deviceContext.m_deviceContext->CopyResource(m_shadowDepthTexture.m_texture, m_staticShadowTexture.m_texture);
+			deviceContext.OMSetRenderTargets(0, nullptr, m_shadowDSV.m_depthStencilView);
+			dynamicDrawn = drawShadowCascades(deviceContext, m_cascadeQueues);
+			m_activeShadowSRV = m_shadowDepthSRV.m_textureFromImg;
 		}
-		renderShadowObject(deviceContext, *object);
 	}
+	else {
+		deviceContext.OMSetRenderTargets(0, nullptr, m_shadowDSV.m_depthStencilView);
+		deviceContext.ClearDepthStencilView(m_shadowDSV.m_depthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
+		dynamicDrawn = drawShadowCascades(deviceContext, m_cascadeQueues);
+		m_activeShadowSRV = m_shadowDepthSRV.m_textureFromImg;
+	}
+
+	m_cbPerFrame.LightViewProjection = mainLightViewProjection;
+	m_perFrameBuffer.update(deviceContext, nullptr, 0, nullptr, &m_cbPerFrame, 0, 0);
+
+	m_shadowStats.staticDrawn = staticDrawn;
+	m_shadowStats.dynamicDrawn = dynamicDrawn;
+	m_shadowStats.castersDrawn = staticDrawn + dynamicDrawn;
+}
+
+size_t
+ForwardRenderer::drawShadowCascades(DeviceContext& deviceContext,
+	const RenderQueue* cascadeQueues) {
+	const uint32_t columns = shadowAtlasColumns();
+	const float tileSize = static_cast<float>(m_shadowMapSize / columns);
+	size_t drawn = 0;
+	for (uint32_t c = 0; c < m_shadowCascades.getCascadeCount(); ++c) {
+		D3D11_VIEWPORT shadowViewport{};
+		shadowViewport.TopLeftX = tileSize * static_cast<float>(c % columns);
+		shadowViewport.TopLeftY = tileSize * static_cast<float>(c / columns);
+		shadowViewport.Width = tileSize;
+		shadowViewport.Height = tileSize;
+		shadowViewport.MinDepth = 0.0f;
+		shadowViewport.MaxDepth = 1.0f;
+		deviceContext.RSSetViewports(1, &shadowViewport);
+
+		// El vertex shader de sombras lee LightViewProjection: se sube la de la cascada
+		XMStoreFloat4x4(&m_cbPerFrame.LightViewProjection,
+			XMMatrixTranspose(m_shadowCascades.getCascade(c).viewProjection));
+		m_perFrameBuffer.update(deviceContext, nullptr, 0, nullptr, &m_cbPerFrame, 0, 0);
+
+		for (const RenderObject* object : cascadeQueues[c]) {
+			if (!object) {
+				continue;
+			}
+			renderShadowObject(deviceContext, *object);
+			++drawn;
+		}
+	}
+	return drawn;
 }
 
 void
@@ -208,8 +329,8 @@ ForwardRenderer::renderPreShadowDebugPass(DeviceContext& deviceContext, RenderSc
 void
 ForwardRenderer::renderOpaquePass(DeviceContext& deviceContext) {
 	m_perFrameBuffer.render(deviceContext, 0, 1, true);
-	if (m_applyShadows && m_shadowDepthSRV.m_textureFromImg) {
-		deviceContext.PSSetShaderResources(6, 1, &m_shadowDepthSRV.m_textureFromImg);
+	if (m_applyShadows && m_activeShadowSRV) {
+		deviceContext.PSSetShaderResources(6, 1, &m_activeShadowSRV);
 	}
 	else {
 		ID3D11ShaderResourceView* nullShadowSRV[1] = { nullptr };
@@ -217,7 +338,7 @@ ForwardRenderer::renderOpaquePass(DeviceContext& deviceContext) {
 	}
 	deviceContext.OMSetBlendState(m_opaqueBlendState, m_blendFactor, 0xffffffff);
 
-	for (const RenderObject* object : m_opaqueQueue) {
+	for (const RenderObject* object : m_queues.opaque) {
 		if (!object) {
 			continue;
 		}
@@ -228,15 +349,15 @@ ForwardRenderer::renderOpaquePass(DeviceContext& deviceContext) {
 void
 ForwardRenderer::renderTransparentPass(DeviceContext& deviceContext) {
 	m_perFrameBuffer.render(deviceContext, 0, 1, true);
-	if (m_applyShadows && m_shadowDepthSRV.m_textureFromImg) {
-		deviceContext.PSSetShaderResources(6, 1, &m_shadowDepthSRV.m_textureFromImg);
+	if (m_applyShadows && m_activeShadowSRV) {
+		deviceContext.PSSetShaderResources(6, 1, &m_activeShadowSRV);
 	}
 	else {
 		ID3D11ShaderResourceView* nullShadowSRV[1] = { nullptr };
 		deviceContext.PSSetShaderResources(6, 1, nullShadowSRV);
 	}
 
-	for (const RenderObject* object : m_transparentQueue) {
+	for (const RenderObject* object : m_queues.transparent) {
 		if (!object) {
 			continue;
 		}
@@ -372,6 +493,27 @@ ForwardRenderer::createShadowResources(Device& device) {
 		return hr;
 	}
 
+	// Mismo formato que el atlas del frame: se copia sobre el con CopyResource
+	hr = m_staticShadowTexture.init(
+		device,
+		m_shadowMapSize,
+		m_shadowMapSize,
+		DXGI_FORMAT_R24G8_TYPELESS,
+		D3D11_BIND_DEPTH_STENCIL | D3D11_BIND_SHADER_RESOURCE);
+	if (FAILED(hr)) {
+		return hr;
+	}
+
+	hr = m_staticShadowSRV.init(device, m_staticShadowTexture, DXGI_FORMAT_R24_UNORM_X8_TYPELESS);
+	if (FAILED(hr)) {
+		return hr;
+	}
+
+	hr = m_staticShadowDSV.init(device, m_staticShadowTexture, DXGI_FORMAT_D24_UNORM_S8_UINT, D3D11_DSV_DIMENSION_TEXTURE2D);
+	if (FAILED(hr)) {
+		return hr;
+	}
+
 	LayoutBuilder builder;
 	builder.Add("POSITION", DXGI_FORMAT_R32G32B32_FLOAT)
 		.Add("NORMAL", DXGI_FORMAT_R32G32B32_FLOAT)
@@ -384,7 +526,9 @@ ForwardRenderer::createShadowResources(Device& device) {
 		return hr;
 	}
 
-	hr = m_shadowRasterizer.init(device, D3D11_FILL_SOLID, D3D11_CULL_BACK, false, true);
+	// Sin depth clip: los casters extruidos hacia la luz quedan delante del plano
+	// cercano y se aplastan contra el en lugar de recortarse.
+	hr = m_shadowRasterizer.init(device, D3D11_FILL_SOLID, D3D11_CULL_BACK, false, false);
 	if (FAILED(hr)) {
 		return hr;
 	}
@@ -393,24 +537,62 @@ ForwardRenderer::createShadowResources(Device& device) {
 }
 
 void
-ForwardRenderer::updateLightMatrices(const Camera& camera, const RenderScene& scene) {
+ForwardRenderer::prepareShadowVolumes(const Camera& camera, RenderScene& scene) {
+	// Sin casters solo cambia el plano cercano, que los volumenes no usan
+	fitShadowCascades(camera, scene, BoundsBatch());
+	for (uint32_t c = 0; c < m_shadowCascades.getCascadeCount(); ++c) {
+		scene.shadowCasterVolumes.push_back(m_shadowCascades.getCascade(c).casterFrustum);
+	}
+}
+
+void
+ForwardRenderer::fitShadowCascades(const Camera& camera, const RenderScene& scene, const BoundsBatch& casters) {
 	EU::Vector3 lightDir = EU::Vector3(0.0f, -1.0f, 0.0f);
 	if (!scene.directionalLights.empty()) {
 		lightDir = scene.directionalLights.front().direction;
 	}
 
-	XMVECTOR lightDirVec = XMVector3Normalize(XMVectorSet(lightDir.x, lightDir.y, lightDir.z, 0.0f));
-	XMVECTOR cameraPos = XMVectorSet(camera.getPosition().x, camera.getPosition().y, camera.getPosition().z, 1.0f);
-	XMVECTOR lightTarget = cameraPos;
-	XMVECTOR lightEye = XMVectorSubtract(lightTarget, XMVectorScale(lightDirVec, 35.0f));
-	XMVECTOR worldUp = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-	if (fabsf(XMVectorGetX(XMVector3Dot(lightDirVec, worldUp))) > 0.98f) {
-		worldUp = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+	m_shadowLightDirection = XMFLOAT3(lightDir.x, lightDir.y, lightDir.z);
+	m_shadowCascades.fit(camera.getView(), camera.getProj(), camera.getNearZ(), camera.getFarZ(),
+		m_shadowLightDirection, casters, m_shadowMapSize / shadowAtlasColumns());
+}
+
+void
+ForwardRenderer::updateLightMatrices(const Camera& camera, const RenderScene& scene) {
+	// Cajas de los casters: se cullean por cascada y ajustan su profundidad. Con la
+	// cache solo cuentan los estaticos; si contaran los dinamicos, moverlos la invalidaria.
+	FillCasterBatch(m_queues.shadow, m_shadowBatch);
+	FillCasterBatch(m_queues.staticShadow, m_staticShadowBatch);
+	const BoundsBatch& depthCasters = m_cacheStaticShadows ? m_staticShadowBatch : m_shadowBatch;
+	fitShadowCascades(camera, scene, depthCasters);
+
+	const uint32_t columns = shadowAtlasColumns();
+	const uint32_t cascadeCount = m_shadowCascades.getCascadeCount();
+	const float tileScale = 1.0f / static_cast<float>(columns);
+	float splits[ShadowCascades::kMaxCascades] = {};
+	for (uint32_t c = 0; c < cascadeCount; ++c) {
+		const ShadowCascade& cascade = m_shadowCascades.getCascade(c);
+		// NDC de la cascada -> su cuadrante del atlas (y de NDC hacia arriba, filas hacia abajo)
+		const float offsetX = -1.0f + tileScale * (2.0f * static_cast<float>(c % columns) + 1.0f);
+		const float offsetY = 1.0f - tileScale * (2.0f * static_cast<float>(c / columns) + 1.0f);
+		const XMMATRIX toTile = XMMatrixScaling(tileScale, tileScale, 1.0f) * XMMatrixTranslation(offsetX, offsetY, 0.0f);
+		XMStoreFloat4x4(&m_cbPerFrame.CascadeViewProjection[c], XMMatrixTranspose(cascade.viewProjection * toTile));
+		splits[c] = cascade.splitFar;
+	}
+	m_cbPerFrame.CascadeSplits = XMFLOAT4(splits[0], splits[1], splits[2], splits[3]);
+	m_cbPerFrame.ShadowParams = XMFLOAT4(static_cast<float>(cascadeCount),
+		1.0f / static_cast<float>(m_shadowMapSize), 0.0f, 0.0f);
+
+	// Los shaders con una sola matriz usan la ultima cascada: cubre todo el alcance
+	if (cascadeCount > 0) {
+		m_cbPerFrame.LightViewProjection = m_cbPerFrame.CascadeViewProjection[cascadeCount - 1];
 	}
+}
 
-	XMMATRIX lightView = XMMatrixLookAtLH(lightEye, lightTarget, worldUp);
-	XMMATRIX lightProjection = XMMatrixOrthographicLH(40.0f, 40.0f, 1.0f, 80.0f);
-	XMStoreFloat4x4(&m_cbPerFrame.LightViewProjection, XMMatrixTranspose(lightView * lightProjection));
+uint32_t
+ForwardRenderer::shadowAtlasColumns() const {
+	// Una cascada ocupa el atlas completo; con mas, cuadrantes de 2x2
+	return m_shadowCascades.getSettings().cascadeCount > 1 ? 2u : 1u;
 }
 
 HRESULT
@@ -0,0 +1,153 @@
+/**
+ * @file Frustum.cpp
+ * @brief Implementa la logica de Frustum dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#include "Rendering/Frustum.h"
+
+void
+Frustum::setFromMatrix(const XMMATRIX& viewProjection) {
+	// Con p' = p * M cada coordenada de clip es el producto con una columna de M.
+	const XMMATRIX columns = XMMatrixTranspose(viewProjection);
+	const XMVECTOR x = columns.r[0];
+	const XMVECTOR y = columns.r[1];
+	const XMVECTOR z = columns.r[2];
+	const XMVECTOR w = columns.r[3];
+
+	const XMVECTOR planes[PlaneCount] = {
+		XMVectorAdd(w, x),      // -w <= x
+		XMVectorSubtract(w, x), //  x <= w
+		XMVectorAdd(w, y),      // -w <= y
+		XMVectorSubtract(w, y), //  y <= w
+		z,                      //  0 <= z
+		XMVectorSubtract(w, z)  //  z <= w
+	};
+
+	for (int i = 0; i < PlaneCount; ++i) {
+		XMStoreFloat4(&m_planes[i], XMPlaneNormalize(planes[i]));
+	}
+}
+
+bool
+Frustum::intersects(const Bounds& bounds) const {
+	return classify(bounds) != Containment::Outside;
+}
+
+bool
+Frustum::intersectsSphere(const XMFLOAT3& center, float radius) const {
+	for (const XMFLOAT4& plane : m_planes) {
+		const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+		if (distance < -radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+Frustum::Containment
+Frustum::classify(const Bounds& bounds) const {
+	if (!bounds.isValid()) {
+		return Containment::Intersects;
+	}
+
+	Containment result = Containment::Inside;
+	for (const XMFLOAT4& plane : m_planes) {
+		const float distance = plane.x * bounds.center.x + plane.y * bounds.center.y +
+		                       plane.z * bounds.center.z + plane.w;
+		const float radius = fabsf(plane.x) * bounds.extents.x + fabsf(plane.y) * bounds.extents.y +
+		                     fabsf(plane.z) * bounds.extents.z;
+		if (distance + radius < 0.0f) {
+			return Containment::Outside;
+		}
+		if (distance - radius < 0.0f) {
+			result = Containment::Intersects;
+		}
+	}
+	return result;
+}
+
+size_t
+Frustum::cull(const BoundsBatch& batch, uint8_t* outVisible) const {
+	const size_t count = batch.size();
+	const size_t simdCount = count & ~static_cast<size_t>(3);
+	size_t visible = 0;
+
+	for (size_t i = 0; i < simdCount; i += 4) {
+		const XMVECTOR cx = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&batch.centerX[i]));
+		const XMVECTOR cy = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&batch.centerY[i]));
+		const XMVECTOR cz = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&batch.centerZ[i]));
+		const XMVECTOR ex = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&batch.extentX[i]));
+		const XMVECTOR ey = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&batch.extentY[i]));
+		const XMVECTOR ez = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&batch.extentZ[i]));
+
+		// Cuatro cajas contra un plano por iteracion; basta un plano para descartar.
+		XMVECTOR outside = XMVectorFalseInt();
+		for (const XMFLOAT4& plane : m_planes) {
+			const XMVECTOR nx = XMVectorReplicate(plane.x);
+			const XMVECTOR ny = XMVectorReplicate(plane.y);
+			const XMVECTOR nz = XMVectorReplicate(plane.z);
+
+			XMVECTOR distance = XMVectorMultiplyAdd(cx, nx, XMVectorReplicate(plane.w));
+			distance = XMVectorMultiplyAdd(cy, ny, distance);
+			distance = XMVectorMultiplyAdd(cz, nz, distance);
+
+			XMVECTOR radius = XMVectorMultiply(ex, XMVectorAbs(nx));
+			radius = XMVectorMultiplyAdd(ey, XMVectorAbs(ny), radius);
+			radius = XMVectorMultiplyAdd(ez, XMVectorAbs(nz), radius);
+
+			outside = XMVectorOrInt(outside, XMVectorLess(XMVectorAdd(distance, radius), XMVectorZero()));
+		}
+
+		UINT mask[4];
+		XMStoreInt4(mask, outside);
+		for (size_t lane = 0; lane < 4; ++lane) {
+			outVisible[i + lane] = mask[lane] ? 0 : 1;
+			visible += outVisible[i + lane];
+		}
+	}
+
+	for (size_t i = simdCount; i < count; ++i) {
+		Bounds bounds;
+		bounds.center = XMFLOAT3(batch.centerX[i], batch.centerY[i], batch.centerZ[i]);
+		bounds.extents = XMFLOAT3(batch.extentX[i], batch.extentY[i], batch.extentZ[i]);
+		outVisible[i] = intersects(bounds) ? 1 : 0;
+		visible += outVisible[i];
+	}
+	return visible;
+}
+
+bool
+Frustum::computeBounds(XMFLOAT3& outLower, XMFLOAT3& outUpper) const {
+	for (const XMFLOAT4& plane : m_planes) {
+		if (plane.w == FLT_MAX) {
+			return false;
+		}
+	}
+
+	XMVECTOR lower = XMVectorReplicate(FLT_MAX);
+	XMVECTOR upper = XMVectorReplicate(-FLT_MAX);
+	for (int corner = 0; corner < 8; ++corner) {
+		const XMFLOAT4& a = m_planes[(corner & 1) ? Right : Left];
+		const XMFLOAT4& b = m_planes[(corner & 2) ? Top : Bottom];
+		const XMFLOAT4& c = m_planes[(corner & 4) ? Far : Near];
+		const XMVECTOR na = XMVectorSet(a.x, a.y, a.z, 0.0f);
+		const XMVECTOR nb = XMVectorSet(b.x, b.y, b.z, 0.0f);
+		const XMVECTOR nc = XMVectorSet(c.x, c.y, c.z, 0.0f);
+
+		// p = -(da (nb x nc) + db (nc x na) + dc (na x nb)) / (na . (nb x nc))
+		const XMVECTOR bc = XMVector3Cross(nb, nc);
+		const float denominator = XMVectorGetX(XMVector3Dot(na, bc));
+		if (fabsf(denominator) < 1e-6f) {
+			return false;
+		}
+		XMVECTOR point = XMVectorScale(bc, a.w);
+		point = XMVectorAdd(point, XMVectorScale(XMVector3Cross(nc, na), b.w));
+		point = XMVectorAdd(point, XMVectorScale(XMVector3Cross(na, nb), c.w));
+		point = XMVectorScale(point, -1.0f / denominator);
+		lower = XMVectorMin(lower, point);
+		upper = XMVectorMax(upper, point);
+	}
+	XMStoreFloat3(&outLower, lower);
+	XMStoreFloat3(&outUpper, upper);
+	return true;
+}
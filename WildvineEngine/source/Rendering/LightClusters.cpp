@@ -0,0 +1,329 @@
+/**
+ * @file LightClusters.cpp
+ * @brief Implementa la logica de LightClusters dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#include "Rendering/LightClusters.h"
+#include "EngineUtilities/Utilities/JobSystem.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+
+namespace {
+/// Tesela que contiene la coordenada NDC `ndc` en un eje de `tiles` teselas.
+uint8_t
+TileOf(float ndc, uint32_t tiles) {
+	const float tile = std::floor((ndc + 1.0f) * 0.5f * static_cast<float>(tiles));
+	return static_cast<uint8_t>((std::min)((std::max)(tile, 0.0f), static_cast<float>(tiles - 1)));
+}
+}
+
+void
+LightClusters::build(const XMMATRIX& view, const XMMATRIX& projection, float nearZ, float farZ,
+                     EU::TSpan<const LightData> lights, JobSystem* jobs) {
+	const auto begin = std::chrono::high_resolution_clock::now();
+	if (nearZ <= 0.0f || farZ <= nearZ) {
+		clear();
+		return;
+	}
+
+	XMFLOAT4X4 proj;
+	XMStoreFloat4x4(&proj, projection);
+	if (m_clusters.size() != kClusterCount || proj._11 != m_scaleX || proj._22 != m_scaleY ||
+	    nearZ != m_nearZ || farZ != m_farZ) {
+		rebuildClusterBounds(proj._11, proj._22, nearZ, farZ);
+	}
+
+	// 1) Luces en espacio de vista y su rango de celdas
+	m_viewLights.resize(lights.size());
+	auto setupRange = [this, &view, &lights](size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) {
+			setupLight(view, lights[i], static_cast<uint32_t>(i), m_viewLights[i]);
+		}
+	};
+	if (jobs) {
+		jobs->parallelFor(lights.size(), kLightGrain, setupRange);
+	}
+	else {
+		setupRange(0, lights.size());
+	}
+
+	// 2) Luces visibles agrupadas por rebanada (orden de conteo, estable por indice)
+	m_sliceLightOffsets.assign(kSlices + 1, 0);
+	size_t visibleLights = 0;
+	for (const ViewLight& light : m_viewLights) {
+		if (!light.visible) {
+			continue;
+		}
+		++visibleLights;
+		for (uint32_t slice = light.minSlice; slice <= light.maxSlice; ++slice) {
+			++m_sliceLightOffsets[slice + 1];
+		}
+	}
+	for (uint32_t slice = 0; slice < kSlices; ++slice) {
+		m_sliceLightOffsets[slice + 1] += m_sliceLightOffsets[slice];
+	}
+	std::array<uint32_t, kSlices> cursor;
+	std::copy(m_sliceLightOffsets.begin(), m_sliceLightOffsets.end() - 1, cursor.begin());
+	m_sliceLights.resize(m_sliceLightOffsets[kSlices]);
+	for (uint32_t i = 0; i < m_viewLights.size(); ++i) {
+		const ViewLight& light = m_viewLights[i];
+		if (!light.visible) {
+			continue;
+		}
+		for (uint32_t slice = light.minSlice; slice <= light.maxSlice; ++slice) {
+			m_sliceLights[cursor[slice]++] = i;
+		}
+	}
+
+	// 3) Cada rebanada escribe solo sus celdas: se reparten entre los workers
+	auto assignRange = [this](size_t first, size_t last) {
+		for (size_t slice = first; slice < last; ++slice) {
+			assignSlice(static_cast<uint32_t>(slice));
+		}
+	};
+	if (jobs) {
+		jobs->parallelFor(kSlices, 1, assignRange);
+	}
+	else {
+		assignRange(0, kSlices);
+	}
+
+	// 4) Las celdas de una rebanada son contiguas: basta concatenar sus listas
+	size_t indexCount = 0;
+	for (const SliceScratch& scratch : m_slices) {
+		indexCount += scratch.indices.size();
+	}
+	m_lightIndices.resize(indexCount);
+
+	uint32_t base = 0;
+	uint32_t maxPerCluster = 0;
+	size_t tests = 0;
+	for (uint32_t slice = 0; slice < kSlices; ++slice) {
+		const SliceScratch& scratch = m_slices[slice];
+		std::copy(scratch.indices.begin(), scratch.indices.end(), m_lightIndices.begin() + base);
+		LightCluster* clusters = &m_clusters[slice * kClustersPerSlice];
+		for (uint32_t cluster = 0; cluster < kClustersPerSlice; ++cluster) {
+			clusters[cluster].offset += base;
+			maxPerCluster = (std::max)(maxPerCluster, clusters[cluster].count);
+		}
+		base += static_cast<uint32_t>(scratch.indices.size());
+		tests += scratch.tests;
+	}
+
+	m_stats.lightCount = lights.size();
+	m_stats.visibleLights = visibleLights;
+	m_stats.indexCount = indexCount;
+	m_stats.maxPerCluster = maxPerCluster;
+	m_stats.clusterTests = tests;
+	m_stats.buildUs = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::high_resolution_clock::now() - begin).count();
+}
+
+void
+LightClusters::clear() {
+	m_clusters.clear();
+	m_lightIndices.clear();
+	m_viewLights.clear();
+	m_sliceLights.clear();
+	m_sliceLightOffsets.clear();
+	m_scaleX = 0.0f;
+	m_scaleY = 0.0f;
+	m_stats = LightClusterStats{};
+}
+
+uint32_t
+LightClusters::sliceOf(float viewDepth) const {
+	if (viewDepth <= m_nearZ) {
+		return 0;
+	}
+	const float slice = std::log(viewDepth / m_nearZ) * m_sliceScale;
+	return (std::min)(static_cast<uint32_t>(slice), kSlices - 1);
+}
+
+void
+LightClusters::rebuildClusterBounds(float scaleX, float scaleY, float nearZ, float farZ) {
+	m_scaleX = scaleX;
+	m_scaleY = scaleY;
+	m_nearZ = nearZ;
+	m_farZ = farZ;
+	m_sliceScale = static_cast<float>(kSlices) / std::log(farZ / nearZ);
+
+	for (std::vector<float>* column : { &m_minX, &m_maxX, &m_minY, &m_maxY, &m_minZ, &m_maxZ,
+	                                     &m_sphereX, &m_sphereY, &m_sphereZ, &m_sphereRadius }) {
+		column->resize(kClusterCount);
+	}
+	m_clusters.assign(kClusterCount, LightCluster{});
+	m_slices.resize(kSlices);
+
+	// En vista LH un punto en NDC `n` a profundidad `z` esta en `n * z / escala`.
+	for (uint32_t slice = 0; slice < kSlices; ++slice) {
+		const float zNear = nearZ * std::pow(farZ / nearZ, static_cast<float>(slice) / kSlices);
+		const float zFar = nearZ * std::pow(farZ / nearZ, static_cast<float>(slice + 1) / kSlices);
+		for (uint32_t y = 0; y < kTilesY; ++y) {
+			const float ndcY0 = -1.0f + 2.0f * y / kTilesY;
+			const float ndcY1 = -1.0f + 2.0f * (y + 1) / kTilesY;
+			for (uint32_t x = 0; x < kTilesX; ++x) {
+				const float ndcX0 = -1.0f + 2.0f * x / kTilesX;
+				const float ndcX1 = -1.0f + 2.0f * (x + 1) / kTilesX;
+				const uint32_t cluster = clusterIndex(x, y, slice);
+
+				m_minX[cluster] = (std::min)(ndcX0 * zNear, ndcX0 * zFar) / scaleX;
+				m_maxX[cluster] = (std::max)(ndcX1 * zNear, ndcX1 * zFar) / scaleX;
+				m_minY[cluster] = (std::min)(ndcY0 * zNear, ndcY0 * zFar) / scaleY;
+				m_maxY[cluster] = (std::max)(ndcY1 * zNear, ndcY1 * zFar) / scaleY;
+				m_minZ[cluster] = zNear;
+				m_maxZ[cluster] = zFar;
+
+				const float halfX = (m_maxX[cluster] - m_minX[cluster]) * 0.5f;
+				const float halfY = (m_maxY[cluster] - m_minY[cluster]) * 0.5f;
+				const float halfZ = (zFar - zNear) * 0.5f;
+				m_sphereX[cluster] = m_minX[cluster] + halfX;
+				m_sphereY[cluster] = m_minY[cluster] + halfY;
+				m_sphereZ[cluster] = zNear + halfZ;
+				m_sphereRadius[cluster] = std::sqrt(halfX * halfX + halfY * halfY + halfZ * halfZ);
+			}
+		}
+	}
+}
+
+void
+LightClusters::setupLight(const XMMATRIX& view, const LightData& light, uint32_t index, ViewLight& outLight) const {
+	outLight.index = index;
+	outLight.visible = false;
+	if (light.type == LightType::Directional || light.range <= 0.0f) {
+		return;
+	}
+
+	const XMVECTOR center = XMVector3TransformCoord(
+		XMVectorSet(light.position.x, light.position.y, light.position.z, 1.0f), view);
+	XMStoreFloat3(&outLight.center, center);
+	const float radius = light.range;
+	const XMFLOAT3& c = outLight.center;
+	if (c.z + radius < m_nearZ || c.z - radius > m_farZ) {
+		return;
+	}
+
+	// Rango de teselas: proyeccion de las esquinas de la caja de la esfera. x / z
+	// es monotona en x y en z, asi que basta probar las profundidades extremas.
+	const float zLow = (std::max)(c.z - radius, m_nearZ);
+	const float zHigh = (std::min)(c.z + radius, m_farZ);
+	const float ndcMinX = (std::min)((c.x - radius) / zLow, (c.x - radius) / zHigh) * m_scaleX;
+	const float ndcMaxX = (std::max)((c.x + radius) / zLow, (c.x + radius) / zHigh) * m_scaleX;
+	const float ndcMinY = (std::min)((c.y - radius) / zLow, (c.y - radius) / zHigh) * m_scaleY;
+	const float ndcMaxY = (std::max)((c.y + radius) / zLow, (c.y + radius) / zHigh) * m_scaleY;
+	if (ndcMinX > 1.0f || ndcMaxX < -1.0f || ndcMinY > 1.0f || ndcMaxY < -1.0f) {
+		return;
+	}
+
+	outLight.radius = radius;
+	outLight.minX = TileOf(ndcMinX, kTilesX);
+	outLight.maxX = TileOf(ndcMaxX, kTilesX);
+	outLight.minY = TileOf(ndcMinY, kTilesY);
+	outLight.maxY = TileOf(ndcMaxY, kTilesY);
+	outLight.minSlice = static_cast<uint8_t>(sliceOf(zLow));
+	outLight.maxSlice = static_cast<uint8_t>(sliceOf(zHigh));
+
+	// Un cono de 90 grados o mas no recorta nada respecto de la esfera.
+	outLight.spot = light.type == LightType::Spot && light.spotAngle > 0.0f && light.spotAngle < XM_PIDIV2;
+	if (outLight.spot) {
+		const XMVECTOR direction = XMVector3Normalize(XMVector3TransformNormal(
+			XMVectorSet(light.direction.x, light.direction.y, light.direction.z, 0.0f), view));
+		XMStoreFloat3(&outLight.direction, direction);
+		outLight.cosAngle = std::cos(light.spotAngle);
+		outLight.sinAngle = std::sin(light.spotAngle);
+		outLight.spot = XMVectorGetX(XMVector3LengthSq(direction)) > 0.0f;
+	}
+	outLight.visible = true;
+}
+
+void
+LightClusters::assignSlice(uint32_t slice) {
+	SliceScratch& scratch = m_slices[slice];
+	scratch.pairs.clear();
+	scratch.tests = 0;
+
+	const uint32_t sliceBase = slice * kClustersPerSlice;
+	const float sliceMinZ = m_minZ[sliceBase];
+	const float sliceMaxZ = m_maxZ[sliceBase];
+	const XMVECTOR zero = XMVectorZero();
+	for (uint32_t k = m_sliceLightOffsets[slice]; k < m_sliceLightOffsets[slice + 1]; ++k) {
+		const ViewLight& light = m_viewLights[m_sliceLights[k]];
+		const XMVECTOR centerX = XMVectorReplicate(light.center.x);
+		const XMVECTOR radiusSq = XMVectorReplicate(light.radius * light.radius);
+		const float dz = (std::max)((std::max)(sliceMinZ - light.center.z, 0.0f), light.center.z - sliceMaxZ);
+
+		for (uint32_t y = light.minY; y <= light.maxY; ++y) {
+			const uint32_t row = sliceBase + y * kTilesX;
+			// Dentro de una fila solo varia x: y, z aportan una distancia constante.
+			const float dy = (std::max)((std::max)(m_minY[row] - light.center.y, 0.0f), light.center.y - m_maxY[row]);
+			const XMVECTOR distanceYZ = XMVectorReplicate(dy * dy + dz * dz);
+
+			for (uint32_t x = light.minX & ~3u; x <= light.maxX; x += 4) {
+				const uint32_t cluster = row + x;
+				const XMVECTOR minX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_minX[cluster]));
+				const XMVECTOR maxX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_maxX[cluster]));
+				const XMVECTOR dx = XMVectorMax(XMVectorMax(XMVectorSubtract(minX, centerX), zero),
+				                                XMVectorSubtract(centerX, maxX));
+				XMVECTOR hit = XMVectorLessOrEqual(XMVectorMultiplyAdd(dx, dx, distanceYZ), radiusSq);
+
+				if (light.spot) {
+					// Cono contra la esfera envolvente de cada celda
+					const XMVECTOR vx = XMVectorSubtract(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_sphereX[cluster])), centerX);
+					const XMVECTOR vy = XMVectorSubtract(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_sphereY[cluster])), XMVectorReplicate(light.center.y));
+					const XMVECTOR vz = XMVectorSubtract(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_sphereZ[cluster])), XMVectorReplicate(light.center.z));
+					const XMVECTOR sphereRadius = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_sphereRadius[cluster]));
+
+					XMVECTOR lengthSq = XMVectorMultiply(vx, vx);
+					lengthSq = XMVectorMultiplyAdd(vy, vy, lengthSq);
+					lengthSq = XMVectorMultiplyAdd(vz, vz, lengthSq);
+					XMVECTOR axial = XMVectorMultiply(vx, XMVectorReplicate(light.direction.x));
+					axial = XMVectorMultiplyAdd(vy, XMVectorReplicate(light.direction.y), axial);
+					axial = XMVectorMultiplyAdd(vz, XMVectorReplicate(light.direction.z), axial);
+
+					// Distancia de la esfera al borde del cono, medida sobre su normal
+					const XMVECTOR lateral = XMVectorSqrt(XMVectorMax(XMVectorNegativeMultiplySubtract(axial, axial, lengthSq), zero));
+					const XMVECTOR toEdge = XMVectorNegativeMultiplySubtract(axial, XMVectorReplicate(light.sinAngle),
+					                                                       XMVectorMultiply(lateral, XMVectorReplicate(light.cosAngle)));
+					hit = XMVectorAndInt(hit, XMVectorLessOrEqual(toEdge, sphereRadius));
+					hit = XMVectorAndInt(hit, XMVectorLessOrEqual(axial, XMVectorAdd(sphereRadius, XMVectorReplicate(light.radius))));
+					hit = XMVectorAndInt(hit, XMVectorGreaterOrEqual(axial, XMVectorNegate(sphereRadius)));
+				}
+
+				UINT mask[4];
+				XMStoreInt4(mask, hit);
+				scratch.tests += 4;
+				for (uint32_t lane = 0; lane < 4; ++lane) {
+					const uint32_t tile = x + lane;
+					if (mask[lane] && tile >= light.minX && tile <= light.maxX) {
+						ClusterLight pair;
+						pair.cluster = cluster + lane - sliceBase;
+						pair.light = light.index;
+						scratch.pairs.push_back(pair);
+					}
+				}
+			}
+		}
+	}
+
+	// Orden de conteo por celda; las luces ya vienen en orden de indice.
+	LightCluster* clusters = &m_clusters[sliceBase];
+	for (uint32_t cluster = 0; cluster < kClustersPerSlice; ++cluster) {
+		clusters[cluster].count = 0;
+	}
+	for (const ClusterLight& pair : scratch.pairs) {
+		++clusters[pair.cluster].count;
+	}
+	std::array<uint32_t, kClustersPerSlice> cursor;
+	uint32_t offset = 0;
+	for (uint32_t cluster = 0; cluster < kClustersPerSlice; ++cluster) {
+		clusters[cluster].offset = offset;
+		cursor[cluster] = offset;
+		offset += clusters[cluster].count;
+	}
+	scratch.indices.resize(scratch.pairs.size());
+	for (const ClusterLight& pair : scratch.pairs) {
+		scratch.indices[cursor[pair.cluster]++] = pair.light;
+	}
+}
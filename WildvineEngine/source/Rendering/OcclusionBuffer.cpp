@@ -0,0 +1,297 @@
+/**
+ * @file OcclusionBuffer.cpp
+ * @brief Implementa la logica de OcclusionBuffer dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#include "Rendering/OcclusionBuffer.h"
+#include "Rendering/TriangleBVH.h"
+#include "EngineUtilities/Utilities/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+/// w minimo para proyectar; por debajo el punto esta en o detras del ojo.
+constexpr float kMinW = 1e-5f;
+}
+
+void
+OcclusionBuffer::begin(const XMMATRIX& viewProjection) {
+	m_viewProjection = viewProjection;
+	if (m_levels.empty()) {
+		for (uint32_t width = kWidth, height = kHeight; width > 0 && height > 0; width /= 2, height /= 2) {
+			m_levels.emplace_back(static_cast<size_t>(width) * height);
+		}
+		m_tileTriangles.resize(kTilesX * kTilesY);
+	}
+	std::fill(m_levels[0].begin(), m_levels[0].end(), 1.0f);
+	m_triangles.clear();
+	m_stats = OcclusionStats{};
+}
+
+void
+OcclusionBuffer::addOccluder(const TriangleBVH& triangles, const XMMATRIX& world) {
+	const XMMATRIX toClip = world * m_viewProjection;
+	for (const TriangleBVH::TrianglePacket& packet : triangles.getPackets()) {
+		for (uint32_t lane = 0; lane < TriangleBVH::kLeafSize; ++lane) {
+			const XMFLOAT3 v0((&packet.v0x.x)[lane], (&packet.v0y.x)[lane], (&packet.v0z.x)[lane]);
+			const XMFLOAT3 e1((&packet.e1x.x)[lane], (&packet.e1y.x)[lane], (&packet.e1z.x)[lane]);
+			const XMFLOAT3 e2((&packet.e2x.x)[lane], (&packet.e2y.x)[lane], (&packet.e2z.x)[lane]);
+			// Los carriles sin triangulo tienen aristas nulas y se descartan como degenerados
+			const XMVECTOR p0 = XMLoadFloat3(&v0);
+			addClipTriangle(XMVector3Transform(p0, toClip),
+			                XMVector3Transform(XMVectorAdd(p0, XMLoadFloat3(&e1)), toClip),
+			                XMVector3Transform(XMVectorAdd(p0, XMLoadFloat3(&e2)), toClip));
+		}
+	}
+	++m_stats.occluders;
+}
+
+void
+OcclusionBuffer::addOccluder(const XMFLOAT3* positions, size_t positionCount,
+                             const uint32_t* indices, size_t indexCount, const XMMATRIX& world) {
+	const XMMATRIX toClip = world * m_viewProjection;
+	for (size_t i = 0; i + 2 < indexCount; i += 3) {
+		if (indices[i] >= positionCount || indices[i + 1] >= positionCount || indices[i + 2] >= positionCount) {
+			++m_stats.trianglesSkipped;
+			continue;
+		}
+		addClipTriangle(XMVector3Transform(XMLoadFloat3(&positions[indices[i]]), toClip),
+		                XMVector3Transform(XMLoadFloat3(&positions[indices[i + 1]]), toClip),
+		                XMVector3Transform(XMLoadFloat3(&positions[indices[i + 2]]), toClip));
+	}
+	++m_stats.occluders;
+}
+
+void
+OcclusionBuffer::addClipTriangle(const XMVECTOR& c0, const XMVECTOR& c1, const XMVECTOR& c2) {
+	XMFLOAT4 clip[3];
+	XMStoreFloat4(&clip[0], c0);
+	XMStoreFloat4(&clip[1], c1);
+	XMStoreFloat4(&clip[2], c2);
+
+	ScreenTriangle triangle;
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	for (uint32_t i = 0; i < 3; ++i) {
+		// Cruza el plano cercano: recortarlo no vale la pena en un oclusor
+		if (clip[i].w < kMinW || clip[i].z < 0.0f) {
+			++m_stats.trianglesSkipped;
+			return;
+		}
+		const float invW = 1.0f / clip[i].w;
+		XMFLOAT3& v = triangle.v[i];
+		v.x = (clip[i].x * invW * 0.5f + 0.5f) * static_cast<float>(kWidth);
+		v.y = (0.5f - clip[i].y * invW * 0.5f) * static_cast<float>(kHeight);
+		v.z = clip[i].z * invW;
+		minX = (std::min)(minX, v.x);
+		maxX = (std::max)(maxX, v.x);
+		minY = (std::min)(minY, v.y);
+		maxY = (std::max)(maxY, v.y);
+	}
+
+	// Ambas caras: se ordena para que el area sea positiva
+	const XMFLOAT3& v0 = triangle.v[0];
+	const float area = (triangle.v[1].x - v0.x) * (triangle.v[2].y - v0.y) -
+	                   (triangle.v[2].x - v0.x) * (triangle.v[1].y - v0.y);
+	if (std::fabs(area) < 1e-6f) {
+		++m_stats.trianglesSkipped;
+		return;
+	}
+	if (area < 0.0f) {
+		std::swap(triangle.v[1], triangle.v[2]);
+	}
+
+	// Pixeles cuyo centro (x + 0.5) cae dentro del rectangulo
+	triangle.minX = (std::max)(static_cast<int32_t>(std::ceil(minX - 0.5f)), 0);
+	triangle.minY = (std::max)(static_cast<int32_t>(std::ceil(minY - 0.5f)), 0);
+	triangle.maxX = (std::min)(static_cast<int32_t>(std::floor(maxX - 0.5f)), static_cast<int32_t>(kWidth) - 1);
+	triangle.maxY = (std::min)(static_cast<int32_t>(std::floor(maxY - 0.5f)), static_cast<int32_t>(kHeight) - 1);
+	if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+		++m_stats.trianglesSkipped;
+		return;
+	}
+
+	m_triangles.push_back(triangle);
+	++m_stats.triangles;
+}
+
+void
+OcclusionBuffer::rasterize(JobSystem* jobs) {
+	const auto begin = std::chrono::high_resolution_clock::now();
+
+	// Binning: cada triangulo va a las teselas que toca su rectangulo
+	for (std::vector<uint32_t>& bin : m_tileTriangles) {
+		bin.clear();
+	}
+	const int32_t tileSize = static_cast<int32_t>(kTileSize);
+	for (uint32_t i = 0; i < m_triangles.size(); ++i) {
+		const ScreenTriangle& triangle = m_triangles[i];
+		for (int32_t ty = triangle.minY / tileSize; ty <= triangle.maxY / tileSize; ++ty) {
+			for (int32_t tx = triangle.minX / tileSize; tx <= triangle.maxX / tileSize; ++tx) {
+				m_tileTriangles[ty * kTilesX + tx].push_back(i);
+				++m_stats.binnedTriangles;
+			}
+		}
+	}
+
+	auto rasterizeRange = [this](size_t first, size_t last) {
+		for (size_t tile = first; tile < last; ++tile) {
+			rasterizeTile(static_cast<uint32_t>(tile));
+		}
+	};
+	if (jobs) {
+		jobs->parallelFor(m_tileTriangles.size(), 1, rasterizeRange);
+	}
+	else {
+		rasterizeRange(0, m_tileTriangles.size());
+	}
+
+	buildHierarchy();
+	m_stats.rasterUs = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::high_resolution_clock::now() - begin).count();
+}
+
+void
+OcclusionBuffer::rasterizeTile(uint32_t tile) {
+	const int32_t tileMinX = static_cast<int32_t>((tile % kTilesX) * kTileSize);
+	const int32_t tileMinY = static_cast<int32_t>((tile / kTilesX) * kTileSize);
+	const int32_t tileMaxX = tileMinX + static_cast<int32_t>(kTileSize) - 1;
+	const int32_t tileMaxY = tileMinY + static_cast<int32_t>(kTileSize) - 1;
+	float* depth = m_levels[0].data();
+	const XMVECTOR laneCenters = XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+	const XMVECTOR zero = XMVectorZero();
+
+	for (uint32_t index : m_tileTriangles[tile]) {
+		const ScreenTriangle& triangle = m_triangles[index];
+
+		// Arista e (opuesta al vertice e) como a * x + b * y + c, positiva dentro
+		float a[3], b[3], c[3];
+		for (uint32_t e = 0; e < 3; ++e) {
+			const XMFLOAT3& p = triangle.v[(e + 1) % 3];
+			const XMFLOAT3& q = triangle.v[(e + 2) % 3];
+			a[e] = p.y - q.y;
+			b[e] = q.x - p.x;
+			c[e] = (q.y - p.y) * p.x - (q.x - p.x) * p.y;
+		}
+		// z / w es lineal en pantalla: z = za * x + zb * y + zc con las baricentricas
+		const float invArea = 1.0f / (a[0] * triangle.v[0].x + b[0] * triangle.v[0].y + c[0]);
+		float za = 0.0f, zb = 0.0f, zc = 0.0f;
+		for (uint32_t e = 0; e < 3; ++e) {
+			za += a[e] * triangle.v[e].z;
+			zb += b[e] * triangle.v[e].z;
+			zc += c[e] * triangle.v[e].z;
+		}
+		za *= invArea;
+		zb *= invArea;
+		zc *= invArea;
+
+		const int32_t minX = (std::max)(triangle.minX, tileMinX) & ~3;
+		const int32_t maxX = (std::min)(triangle.maxX, tileMaxX);
+		const int32_t minY = (std::max)(triangle.minY, tileMinY);
+		const int32_t maxY = (std::min)(triangle.maxY, tileMaxY);
+		const XMVECTOR edgeA0 = XMVectorReplicate(a[0]);
+		const XMVECTOR edgeA1 = XMVectorReplicate(a[1]);
+		const XMVECTOR edgeA2 = XMVectorReplicate(a[2]);
+		const XMVECTOR depthA = XMVectorReplicate(za);
+
+		for (int32_t y = minY; y <= maxY; ++y) {
+			const float py = static_cast<float>(y) + 0.5f;
+			const XMVECTOR row0 = XMVectorReplicate(b[0] * py + c[0]);
+			const XMVECTOR row1 = XMVectorReplicate(b[1] * py + c[1]);
+			const XMVECTOR row2 = XMVectorReplicate(b[2] * py + c[2]);
+			const XMVECTOR rowDepth = XMVectorReplicate(zb * py + zc);
+			float* depthRow = depth + static_cast<size_t>(y) * kWidth;
+
+			for (int32_t x = minX; x <= maxX; x += 4) {
+				const XMVECTOR px = XMVectorAdd(XMVectorReplicate(static_cast<float>(x)), laneCenters);
+				XMVECTOR inside = XMVectorGreaterOrEqual(XMVectorMultiplyAdd(px, edgeA0, row0), zero);
+				inside = XMVectorAndInt(inside, XMVectorGreaterOrEqual(XMVectorMultiplyAdd(px, edgeA1, row1), zero));
+				inside = XMVectorAndInt(inside, XMVectorGreaterOrEqual(XMVectorMultiplyAdd(px, edgeA2, row2), zero));
+
+				XMFLOAT4* target = reinterpret_cast<XMFLOAT4*>(depthRow + x);
+				const XMVECTOR current = XMLoadFloat4(target);
+				const XMVECTOR z = XMVectorMultiplyAdd(px, depthA, rowDepth);
+				XMStoreFloat4(target, XMVectorSelect(current, XMVectorMin(current, z), inside));
+			}
+		}
+	}
+}
+
+void
+OcclusionBuffer::buildHierarchy() {
+	uint32_t width = kWidth;
+	for (size_t level = 1; level < m_levels.size(); ++level) {
+		const std::vector<float>& source = m_levels[level - 1];
+		std::vector<float>& target = m_levels[level];
+		const uint32_t targetWidth = width / 2;
+		const uint32_t targetHeight = static_cast<uint32_t>(target.size()) / targetWidth;
+		for (uint32_t y = 0; y < targetHeight; ++y) {
+			const float* top = &source[(2 * y) * width];
+			const float* bottom = top + width;
+			float* out = &target[y * targetWidth];
+			for (uint32_t x = 0; x < targetWidth; ++x) {
+				out[x] = (std::max)((std::max)(top[2 * x], top[2 * x + 1]),
+				                    (std::max)(bottom[2 * x], bottom[2 * x + 1]));
+			}
+		}
+		width = targetWidth;
+	}
+}
+
+bool
+OcclusionBuffer::isVisible(const Bounds& worldBounds) const {
+	if (!worldBounds.isValid() || m_levels.empty()) {
+		return true;
+	}
+
+	const XMFLOAT3 lower = worldBounds.getMin();
+	const XMFLOAT3 upper = worldBounds.getMax();
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	float nearestZ = FLT_MAX;
+	for (uint32_t i = 0; i < 8; ++i) {
+		const XMVECTOR corner = XMVectorSet((i & 1) ? upper.x : lower.x,
+		                                    (i & 2) ? upper.y : lower.y,
+		                                    (i & 4) ? upper.z : lower.z, 1.0f);
+		XMFLOAT4 clip;
+		XMStoreFloat4(&clip, XMVector3Transform(corner, m_viewProjection));
+		// La caja cruza el plano cercano: la camara esta dentro o muy cerca
+		if (clip.w < kMinW || clip.z < 0.0f) {
+			return true;
+		}
+		const float invW = 1.0f / clip.w;
+		const float sx = (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(kWidth);
+		const float sy = (0.5f - clip.y * invW * 0.5f) * static_cast<float>(kHeight);
+		minX = (std::min)(minX, sx);
+		maxX = (std::max)(maxX, sx);
+		minY = (std::min)(minY, sy);
+		maxY = (std::max)(maxY, sy);
+		nearestZ = (std::min)(nearestZ, clip.z * invW);
+	}
+
+	// Fuera de la pantalla no hay oclusores: lo decide el frustum
+	if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(kWidth) || minY >= static_cast<float>(kHeight)) {
+		return true;
+	}
+	const int32_t x0 = (std::max)(static_cast<int32_t>(std::floor(minX)), 0);
+	const int32_t y0 = (std::max)(static_cast<int32_t>(std::floor(minY)), 0);
+	const int32_t x1 = (std::min)(static_cast<int32_t>(std::floor(maxX)), static_cast<int32_t>(kWidth) - 1);
+	const int32_t y1 = (std::min)(static_cast<int32_t>(std::floor(maxY)), static_cast<int32_t>(kHeight) - 1);
+
+	// Nivel donde el rectangulo ocupa a lo sumo 4x4 texels; cada texel cubre un
+	// bloque que contiene a sus pixeles, asi la prueba sigue siendo conservadora.
+	uint32_t level = 0;
+	while (level + 1 < m_levels.size() && ((x1 >> level) - (x0 >> level) >= 4 || (y1 >> level) - (y0 >> level) >= 4)) {
+		++level;
+	}
+
+	const std::vector<float>& depth = m_levels[level];
+	const int32_t levelWidth = static_cast<int32_t>(kWidth >> level);
+	for (int32_t y = y0 >> level; y <= (y1 >> level); ++y) {
+		for (int32_t x = x0 >> level; x <= (x1 >> level); ++x) {
+			if (depth[y * levelWidth + x] >= nearestZ) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
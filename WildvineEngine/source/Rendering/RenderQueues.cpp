@@ -0,0 +1,58 @@
+/**
+ * @file RenderQueues.cpp
+ * @brief Implementa la logica de RenderQueues dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#include "Rendering/RenderQueues.h"
+#include <algorithm>
+
+void
+RenderQueues::build(RenderScene& scene, bool cacheStaticShadows) {
+	// Cada cola reserva en el arena del frame lo que ocupo en el anterior
+	EU::LinearArena* arena = &scene.getFrameArena();
+	opaque.reset(arena, opaque.size());
+	transparent.reset(arena, transparent.size());
+	shadow.reset(arena, shadow.size());
+	staticShadow.reset(arena, staticShadow.size());
+
+	// El gather ya descarto lo que no se ve ni proyecta sombra.
+	for (auto& object : scene.opaqueObjects) {
+		if (object.cameraVisible) {
+			opaque.push_back(&object);
+		}
+		if (!object.castShadow) {
+			continue;
+		}
+		if (object.staticShadow && cacheStaticShadows) {
+			staticShadow.push_back(&object);
+		}
+		else {
+			shadow.push_back(&object);
+		}
+	}
+
+	for (auto& object : scene.transparentObjects) {
+		transparent.push_back(&object);
+	}
+
+	std::sort(opaque.begin(), opaque.end(),
+		[](const RenderObject* lhs, const RenderObject* rhs) {
+			if (lhs->materialInstance != rhs->materialInstance) {
+				return lhs->materialInstance < rhs->materialInstance;
+			}
+			return lhs->distanceToCamera < rhs->distanceToCamera;
+		});
+
+	std::sort(transparent.begin(), transparent.end(),
+		[](const RenderObject* lhs, const RenderObject* rhs) {
+			return lhs->distanceToCamera > rhs->distanceToCamera;
+	});
+}
+
+void
+RenderQueues::clear() {
+	opaque.clear();
+	transparent.clear();
+	shadow.clear();
+	staticShadow.clear();
+}
@@ -7,9 +7,12 @@
 
 void
 RenderScene::clear() {
-	opaqueObjects.clear();
-	transparentObjects.clear();
-	directionalLights.clear();
+	EU::LinearArena& arena = m_frameArena.beginFrame();
+	opaqueObjects.reset(&arena, opaqueObjects.size());
+	transparentObjects.reset(&arena, transparentObjects.size());
+	directionalLights.reset(&arena, directionalLights.size());
+	localLights.reset(&arena, localLights.size());
+	shadowCasterVolumes.reset(&arena, shadowCasterVolumes.size());
 	skybox = nullptr;
 }
 
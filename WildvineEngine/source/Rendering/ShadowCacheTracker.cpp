@@ -0,0 +1,85 @@
+/**
+ * @file ShadowCacheTracker.cpp
+ * @brief Implementa la logica de ShadowCacheTracker dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#include "Rendering/ShadowCacheTracker.h"
+#include "Rendering/Mesh.h"
+#include <cstring>
+
+namespace {
+/// FNV-1a de 64 bits sobre la malla (puntero y revision) y la matriz world del caster.
+uint64_t
+HashCaster(const RenderObject& object) {
+	uint64_t hash = 1469598103934665603ull;
+	auto mix = [&hash](const void* data, size_t size) {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	};
+
+	const Mesh* mesh = object.mesh;
+	const uint32_t revision = mesh ? mesh->getRevision() : 0;
+	XMFLOAT4X4 world;
+	XMStoreFloat4x4(&world, object.world);
+	mix(&mesh, sizeof(mesh));
+	mix(&revision, sizeof(revision));
+	mix(&world, sizeof(world));
+	return hash;
+}
+}
+
+ShadowCacheInvalidation
+ShadowCacheTracker::update(const XMFLOAT3& lightDirection, const ShadowCascades& cascades,
+                           const EU::TArenaArray<const RenderObject*>* cascadeCasters) {
+	ShadowCacheInvalidation reason = ShadowCacheInvalidation::None;
+	if (!m_valid) {
+		reason = ShadowCacheInvalidation::Empty;
+	}
+	else if (lightDirection.x != m_lightDirection.x || lightDirection.y != m_lightDirection.y ||
+	         lightDirection.z != m_lightDirection.z) {
+		reason = ShadowCacheInvalidation::LightDirection;
+	}
+
+	// Las cascadas ya vienen ajustadas al texel: solo cambian al cruzar uno
+	const uint32_t cascadeCount = cascades.getCascadeCount();
+	XMFLOAT4X4 viewProjection[ShadowCascades::kMaxCascades]{};
+	for (uint32_t c = 0; c < cascadeCount; ++c) {
+		XMStoreFloat4x4(&viewProjection[c], cascades.getCascade(c).viewProjection);
+	}
+	if (reason == ShadowCacheInvalidation::None &&
+	    (cascadeCount != m_cascadeCount ||
+	     std::memcmp(viewProjection, m_cascadeViewProjection, sizeof(XMFLOAT4X4) * cascadeCount) != 0)) {
+		reason = ShadowCacheInvalidation::Cascades;
+	}
+
+	uint64_t signature = 0;
+	size_t casterCount = 0;
+	for (uint32_t c = 0; c < cascadeCount; ++c) {
+		for (const RenderObject* object : cascadeCasters[c]) {
+			signature += HashCaster(*object);
+		}
+		casterCount += cascadeCasters[c].size();
+	}
+	if (reason == ShadowCacheInvalidation::None &&
+	    (signature != m_casterSignature || casterCount != m_casterCount)) {
+		reason = ShadowCacheInvalidation::StaticCasters;
+	}
+
+	if (reason == ShadowCacheInvalidation::None) {
+		++m_reuseCount;
+		return reason;
+	}
+
+	m_valid = true;
+	m_lightDirection = lightDirection;
+	m_cascadeCount = cascadeCount;
+	std::memcpy(m_cascadeViewProjection, viewProjection, sizeof(viewProjection));
+	m_casterSignature = signature;
+	m_casterCount = casterCount;
+	++m_rebuildCount;
+	m_lastRebuildReason = reason;
+	return reason;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file ShadowCascades.cpp
+ * @brief Implementa la logica de ShadowCascades dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#include "Rendering/ShadowCascades.h"
+#include <algorithm>
+#include <cmath>
+
+void
+ShadowCascades::computeSplits(float nearZ, float farZ, uint32_t count, float lambda, float* outSplits) {
+	lambda = (std::min)((std::max)(lambda, 0.0f), 1.0f);
+	outSplits[0] = nearZ;
+	for (uint32_t i = 1; i < count; ++i) {
+		const float t = static_cast<float>(i) / static_cast<float>(count);
+		const float logSplit = nearZ * std::pow(farZ / nearZ, t);
+		const float linearSplit = nearZ + (farZ - nearZ) * t;
+		outSplits[i] = lambda * logSplit + (1.0f - lambda) * linearSplit;
+	}
+	outSplits[count] = farZ;
+}
+
+void
+ShadowCascades::setSettings(const ShadowCascadeSettings& settings) {
+	m_settings = settings;
+	m_settings.cascadeCount = (std::min)((std::max)(m_settings.cascadeCount, 1u), kMaxCascades);
+}
+
+void
+ShadowCascades::fit(const XMMATRIX& cameraView, const XMMATRIX& cameraProjection, float nearZ, float farZ,
+                    const XMFLOAT3& lightDirection, const BoundsBatch& casters, uint32_t resolution) {
+	const float shadowFar = (std::min)(farZ, m_settings.maxDistance);
+	if (nearZ <= 0.0f || shadowFar <= nearZ || resolution <= 2) {
+		m_cascadeCount = 0;
+		return;
+	}
+
+	// Vista de la luz sin traslacion: x, y en el plano del shadow map y z a lo largo de la luz
+	XMVECTOR lightDir = XMVector3Normalize(XMLoadFloat3(&lightDirection));
+	XMVECTOR worldUp = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+	if (fabsf(XMVectorGetX(XMVector3Dot(lightDir, worldUp))) > 0.98f) {
+		worldUp = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+	}
+	const XMMATRIX lightView = XMMatrixLookAtLH(XMVectorZero(), lightDir, worldUp);
+
+	// Casters en espacio de luz, una vez para todas las cascadas
+	const size_t casterCount = casters.size();
+	m_casterMin.resize(casterCount);
+	m_casterMax.resize(casterCount);
+	for (size_t i = 0; i < casterCount; ++i) {
+		Bounds bounds;
+		bounds.center = XMFLOAT3(casters.centerX[i], casters.centerY[i], casters.centerZ[i]);
+		bounds.extents = XMFLOAT3(casters.extentX[i], casters.extentY[i], casters.extentZ[i]);
+		const Bounds lightBounds = bounds.transformed(lightView);
+		m_casterMin[i] = lightBounds.getMin();
+		m_casterMax[i] = lightBounds.getMax();
+	}
+
+	XMFLOAT4X4 proj;
+	XMStoreFloat4x4(&proj, cameraProjection);
+	const float tanX = 1.0f / proj._11;
+	const float tanY = 1.0f / proj._22;
+	const XMMATRIX viewToLight = XMMatrixInverse(nullptr, cameraView) * lightView;
+
+	float splits[kMaxCascades + 1];
+	m_cascadeCount = m_settings.cascadeCount;
+	computeSplits(nearZ, shadowFar, m_cascadeCount, m_settings.splitLambda, splits);
+
+	for (uint32_t c = 0; c < m_cascadeCount; ++c) {
+		ShadowCascade& cascade = m_cascades[c];
+		cascade.splitNear = splits[c];
+		cascade.splitFar = splits[c + 1];
+
+		// Esfera de la rebanada en espacio de vista: el centro esta sobre el eje
+		// de la camara, asi el radio no depende de su orientacion.
+		XMFLOAT3 corners[8];
+		XMFLOAT3 sliceCenter(0.0f, 0.0f, 0.0f);
+		for (uint32_t i = 0; i < 8; ++i) {
+			const float z = (i & 4) ? cascade.splitFar : cascade.splitNear;
+			corners[i] = XMFLOAT3((i & 1) ? z * tanX : -z * tanX, (i & 2) ? z * tanY : -z * tanY, z);
+			sliceCenter.z += z * 0.125f;
+		}
+		float radiusSq = 0.0f;
+		for (const XMFLOAT3& corner : corners) {
+			const float dz = corner.z - sliceCenter.z;
+			radiusSq = (std::max)(radiusSq, corner.x * corner.x + corner.y * corner.y + dz * dz);
+		}
+		// Radio redondeado para que errores de coma flotante no cambien el tamano del
+		// texel, mas un texel por lado para el desplazamiento del ajuste.
+		const float sliceRadius = std::ceil(std::sqrt(radiusSq) * 16.0f) / 16.0f;
+		const float radius = sliceRadius * static_cast<float>(resolution) / static_cast<float>(resolution - 2);
+
+		XMFLOAT3 center;
+		XMStoreFloat3(&center, XMVector3TransformCoord(XMLoadFloat3(&sliceCenter), viewToLight));
+
+		// Centro en multiplos del texel: al moverse la camara el volumen salta de
+		// texel en texel y los bordes de las sombras no tiemblan.
+		const float texelSize = 2.0f * radius / static_cast<float>(resolution);
+		center.x = std::floor(center.x / texelSize) * texelSize;
+		center.y = std::floor(center.y / texelSize) * texelSize;
+
+		// La profundidad se ajusta en pasos mas gruesos; el rango crece un paso para
+		// seguir cubriendo la rebanada. Asi la matriz solo cambia al cruzar un
+		// texel o un paso y la cache de sombras estaticas sobrevive a movimientos pequenos.
+		const float depthStep = radius * kDepthSnapFraction;
+		center.z = std::floor(center.z / depthStep) * depthStep;
+
+		const float minX = center.x - radius;
+		const float maxX = center.x + radius;
+		const float minY = center.y - radius;
+		const float maxY = center.y + radius;
+		float cascadeNear = center.z - radius;
+		const float cascadeFar = center.z + radius + depthStep;
+
+		// Los casters que cortan la huella pueden estar entre la luz y la rebanada
+		uint32_t fitted = 0;
+		for (size_t i = 0; i < casterCount; ++i) {
+			const XMFLOAT3& lower = m_casterMin[i];
+			const XMFLOAT3& upper = m_casterMax[i];
+			if (upper.x < minX || lower.x > maxX || upper.y < minY || lower.y > maxY || lower.z > cascadeFar) {
+				continue;
+			}
+			if (lower.z < cascadeNear) {
+				cascadeNear = lower.z;
+				++fitted;
+			}
+		}
+
+		cascade.view = lightView;
+		cascade.projection = XMMatrixOrthographicOffCenterLH(minX, maxX, minY, maxY, cascadeNear, cascadeFar);
+		cascade.viewProjection = lightView * cascade.projection;
+		cascade.casterFrustum.setFromMatrix(cascade.viewProjection);
+		cascade.casterFrustum.removePlane(Frustum::Near);
+		cascade.center = center;
+		cascade.radius = radius;
+		cascade.texelSize = texelSize;
+		cascade.nearZ = cascadeNear;
+		cascade.farZ = cascadeFar;
+		cascade.fittedCasters = fitted;
+	}
+}
@@ -0,0 +1,349 @@
+/**
+ * @file TriangleBVH.cpp
+ * @brief Implementa la logica de TriangleBVH dentro del subsistema Rendering.
+ * @ingroup rendering
+ */
+#include "Rendering/TriangleBVH.h"
+#include <algorithm>
+
+namespace {
+constexpr float kDeterminantEpsilon = 1e-12f;
+constexpr float kMinDistance = 1e-6f;
+
+float
+Component(const XMFLOAT3& value, int axis) {
+	return (&value.x)[axis];
+}
+
+float
+SurfaceArea(const XMFLOAT3& lower, const XMFLOAT3& upper) {
+	const float dx = upper.x - lower.x;
+	const float dy = upper.y - lower.y;
+	const float dz = upper.z - lower.z;
+	return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+void
+Grow(XMFLOAT3& lower, XMFLOAT3& upper, const XMFLOAT3& otherLower, const XMFLOAT3& otherUpper) {
+	lower = XMFLOAT3((std::min)(lower.x, otherLower.x), (std::min)(lower.y, otherLower.y), (std::min)(lower.z, otherLower.z));
+	upper = XMFLOAT3((std::max)(upper.x, otherUpper.x), (std::max)(upper.y, otherUpper.y), (std::max)(upper.z, otherUpper.z));
+}
+
+struct Bin {
+	XMFLOAT3 lower = XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+	XMFLOAT3 upper = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+	uint32_t count = 0;
+};
+}
+
+void
+TriangleBVH::build() {
+	m_nodes.clear();
+	m_packets.clear();
+	m_triangleCount = m_build.size();
+	if (m_build.empty()) {
+		m_submeshCount = 0;
+		return;
+	}
+
+	m_nodes.reserve(2 * (m_build.size() / kLeafSize + 1));
+	m_packets.reserve(m_build.size() / kLeafSize + 1);
+
+	struct BuildTask {
+		uint32_t node;
+		size_t begin;
+		size_t end;
+	};
+	std::vector<BuildTask> stack;
+	m_nodes.emplace_back();
+	stack.push_back({ 0, 0, m_build.size() });
+
+	while (!stack.empty()) {
+		const BuildTask task = stack.back();
+		stack.pop_back();
+
+		XMFLOAT3 lower(FLT_MAX, FLT_MAX, FLT_MAX);
+		XMFLOAT3 upper(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		XMFLOAT3 centroidLower = lower;
+		XMFLOAT3 centroidUpper = upper;
+		for (size_t i = task.begin; i < task.end; ++i) {
+			Grow(lower, upper, m_build[i].lower, m_build[i].upper);
+			Grow(centroidLower, centroidUpper, m_build[i].centroid, m_build[i].centroid);
+		}
+		m_nodes[task.node].lower = lower;
+		m_nodes[task.node].upper = upper;
+
+		const size_t count = task.end - task.begin;
+		if (count <= kLeafSize) {
+			makeLeaf(m_nodes[task.node], task.begin, task.end);
+			continue;
+		}
+
+		// SAH por bins: coste = area(izq) * n(izq) + area(der) * n(der)
+		int bestAxis = -1;
+		uint32_t bestSplit = 0;
+		float bestCost = FLT_MAX;
+		for (int axis = 0; axis < 3; ++axis) {
+			const float minCentroid = Component(centroidLower, axis);
+			const float maxCentroid = Component(centroidUpper, axis);
+			if (!(maxCentroid > minCentroid)) {
+				continue;
+			}
+
+			Bin bins[kBinCount];
+			const float scale = kBinCount / (maxCentroid - minCentroid);
+			for (size_t i = task.begin; i < task.end; ++i) {
+				const uint32_t bin = (std::min)(kBinCount - 1,
+					static_cast<uint32_t>((Component(m_build[i].centroid, axis) - minCentroid) * scale));
+				Grow(bins[bin].lower, bins[bin].upper, m_build[i].lower, m_build[i].upper);
+				++bins[bin].count;
+			}
+
+			float leftArea[kBinCount - 1];
+			uint32_t leftCount[kBinCount - 1];
+			Bin accumulated;
+			for (uint32_t i = 0; i + 1 < kBinCount; ++i) {
+				Grow(accumulated.lower, accumulated.upper, bins[i].lower, bins[i].upper);
+				accumulated.count += bins[i].count;
+				leftArea[i] = SurfaceArea(accumulated.lower, accumulated.upper);
+				leftCount[i] = accumulated.count;
+			}
+
+			accumulated = Bin{};
+			for (uint32_t i = kBinCount - 1; i > 0; --i) {
+				Grow(accumulated.lower, accumulated.upper, bins[i].lower, bins[i].upper);
+				accumulated.count += bins[i].count;
+				if (leftCount[i - 1] == 0 || accumulated.count == 0) {
+					continue;
+				}
+				const float cost = leftArea[i - 1] * leftCount[i - 1] +
+				                   SurfaceArea(accumulated.lower, accumulated.upper) * accumulated.count;
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = i - 1;
+				}
+			}
+		}
+
+		size_t middle = task.begin + count / 2;
+		if (bestAxis >= 0) {
+			const float minCentroid = Component(centroidLower, bestAxis);
+			const float scale = kBinCount / (Component(centroidUpper, bestAxis) - minCentroid);
+			const auto split = std::partition(m_build.begin() + task.begin, m_build.begin() + task.end,
+				[&](const BuildTriangle& triangle) {
+					const uint32_t bin = (std::min)(kBinCount - 1,
+						static_cast<uint32_t>((Component(triangle.centroid, bestAxis) - minCentroid) * scale));
+					return bin <= bestSplit;
+				});
+			middle = static_cast<size_t>(split - m_build.begin());
+		}
+		// Centroides coincidentes: cualquier mitad sirve.
+		if (middle == task.begin || middle == task.end) {
+			middle = task.begin + count / 2;
+		}
+
+		const uint32_t left = static_cast<uint32_t>(m_nodes.size());
+		m_nodes.emplace_back();
+		m_nodes.emplace_back();
+		m_nodes[task.node].first = left;
+		m_nodes[task.node].count = 0;
+		stack.push_back({ left + 1, middle, task.end });
+		stack.push_back({ left, task.begin, middle });
+	}
+
+	m_build.clear();
+	m_build.shrink_to_fit();
+	m_submeshCount = 0;
+}
+
+void
+TriangleBVH::makeLeaf(Node& node, size_t begin, size_t end) {
+	TrianglePacket packet{};
+	for (size_t i = begin; i < end; ++i) {
+		const BuildTriangle& triangle = m_build[i];
+		const size_t lane = i - begin;
+		(&packet.v0x.x)[lane] = triangle.v0.x;
+		(&packet.v0y.x)[lane] = triangle.v0.y;
+		(&packet.v0z.x)[lane] = triangle.v0.z;
+		(&packet.e1x.x)[lane] = triangle.v1.x - triangle.v0.x;
+		(&packet.e1y.x)[lane] = triangle.v1.y - triangle.v0.y;
+		(&packet.e1z.x)[lane] = triangle.v1.z - triangle.v0.z;
+		(&packet.e2x.x)[lane] = triangle.v2.x - triangle.v0.x;
+		(&packet.e2y.x)[lane] = triangle.v2.y - triangle.v0.y;
+		(&packet.e2z.x)[lane] = triangle.v2.z - triangle.v0.z;
+		packet.submesh[lane] = triangle.submesh;
+		packet.triangle[lane] = triangle.triangle;
+	}
+
+	node.first = static_cast<uint32_t>(m_packets.size());
+	node.count = static_cast<uint32_t>(end - begin);
+	m_packets.push_back(packet);
+}
+
+bool
+TriangleBVH::intersect(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, TriangleHit& outHit) const {
+	if (m_nodes.empty()) {
+		return false;
+	}
+
+	const XMFLOAT3 inverse(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+	const XMVECTOR rayOrigin = XMLoadFloat3(&origin);
+	const XMVECTOR rayDirection = XMLoadFloat3(&direction);
+
+	TriangleHit hit;
+	hit.distance = maxDistance;
+
+	struct StackEntry {
+		uint32_t node;
+		float enter;
+	};
+	std::vector<StackEntry> stack;
+	stack.reserve(64);
+
+	float rootEnter = 0.0f;
+	if (!Bounds::rayIntersects(m_nodes[0].lower, m_nodes[0].upper, origin, inverse, hit.distance, rootEnter)) {
+		return false;
+	}
+	stack.push_back({ 0, rootEnter });
+
+	while (!stack.empty()) {
+		const StackEntry entry = stack.back();
+		stack.pop_back();
+		// Un impacto posterior pudo dejar este nodo detras.
+		if (entry.enter > hit.distance) {
+			continue;
+		}
+
+		const Node& node = m_nodes[entry.node];
+		if (node.count > 0) {
+			intersectPacket(m_packets[node.first], node.count, rayOrigin, rayDirection, hit);
+			continue;
+		}
+
+		float enter0 = 0.0f;
+		float enter1 = 0.0f;
+		const Node& child0 = m_nodes[node.first];
+		const Node& child1 = m_nodes[node.first + 1];
+		const bool hit0 = Bounds::rayIntersects(child0.lower, child0.upper, origin, inverse, hit.distance, enter0);
+		const bool hit1 = Bounds::rayIntersects(child1.lower, child1.upper, origin, inverse, hit.distance, enter1);
+
+		// El mas cercano se apila al final para visitarlo primero.
+		if (hit0 && hit1) {
+			if (enter0 <= enter1) {
+				stack.push_back({ node.first + 1, enter1 });
+				stack.push_back({ node.first, enter0 });
+			}
+			else {
+				stack.push_back({ node.first, enter0 });
+				stack.push_back({ node.first + 1, enter1 });
+			}
+		}
+		else if (hit0) {
+			stack.push_back({ node.first, enter0 });
+		}
+		else if (hit1) {
+			stack.push_back({ node.first + 1, enter1 });
+		}
+	}
+
+	if (!hit.isValid()) {
+		return false;
+	}
+	outHit = hit;
+	return true;
+}
+
+bool
+TriangleBVH::intersectPacket(const TrianglePacket& packet, uint32_t count,
+                             FXMVECTOR origin, FXMVECTOR direction, TriangleHit& hit) const {
+	const XMVECTOR dx = XMVectorSplatX(direction);
+	const XMVECTOR dy = XMVectorSplatY(direction);
+	const XMVECTOR dz = XMVectorSplatZ(direction);
+	const XMVECTOR e1x = XMLoadFloat4(&packet.e1x);
+	const XMVECTOR e1y = XMLoadFloat4(&packet.e1y);
+	const XMVECTOR e1z = XMLoadFloat4(&packet.e1z);
+	const XMVECTOR e2x = XMLoadFloat4(&packet.e2x);
+	const XMVECTOR e2y = XMLoadFloat4(&packet.e2y);
+	const XMVECTOR e2z = XMLoadFloat4(&packet.e2z);
+
+	// Moller-Trumbore en cuatro carriles: p = d x e2, det = e1 . p
+	const XMVECTOR px = XMVectorSubtract(XMVectorMultiply(dy, e2z), XMVectorMultiply(dz, e2y));
+	const XMVECTOR py = XMVectorSubtract(XMVectorMultiply(dz, e2x), XMVectorMultiply(dx, e2z));
+	const XMVECTOR pz = XMVectorSubtract(XMVectorMultiply(dx, e2y), XMVectorMultiply(dy, e2x));
+	const XMVECTOR det = XMVectorMultiplyAdd(e1z, pz, XMVectorMultiplyAdd(e1y, py, XMVectorMultiply(e1x, px)));
+	const XMVECTOR invDet = XMVectorReciprocal(det);
+
+	// s = o - v0, u = (s . p) / det
+	const XMVECTOR sx = XMVectorSubtract(XMVectorSplatX(origin), XMLoadFloat4(&packet.v0x));
+	const XMVECTOR sy = XMVectorSubtract(XMVectorSplatY(origin), XMLoadFloat4(&packet.v0y));
+	const XMVECTOR sz = XMVectorSubtract(XMVectorSplatZ(origin), XMLoadFloat4(&packet.v0z));
+	const XMVECTOR u = XMVectorMultiply(
+		XMVectorMultiplyAdd(sz, pz, XMVectorMultiplyAdd(sy, py, XMVectorMultiply(sx, px))), invDet);
+
+	// q = s x e1, v = (d . q) / det, t = (e2 . q) / det
+	const XMVECTOR qx = XMVectorSubtract(XMVectorMultiply(sy, e1z), XMVectorMultiply(sz, e1y));
+	const XMVECTOR qy = XMVectorSubtract(XMVectorMultiply(sz, e1x), XMVectorMultiply(sx, e1z));
+	const XMVECTOR qz = XMVectorSubtract(XMVectorMultiply(sx, e1y), XMVectorMultiply(sy, e1x));
+	const XMVECTOR v = XMVectorMultiply(
+		XMVectorMultiplyAdd(dz, qz, XMVectorMultiplyAdd(dy, qy, XMVectorMultiply(dx, qx))), invDet);
+	const XMVECTOR t = XMVectorMultiply(
+		XMVectorMultiplyAdd(e2z, qz, XMVectorMultiplyAdd(e2y, qy, XMVectorMultiply(e2x, qx))), invDet);
+
+	const XMVECTOR zero = XMVectorZero();
+	XMVECTOR valid = XMVectorGreater(XMVectorAbs(det), XMVectorReplicate(kDeterminantEpsilon));
+	valid = XMVectorAndInt(valid, XMVectorGreaterOrEqual(u, zero));
+	valid = XMVectorAndInt(valid, XMVectorGreaterOrEqual(v, zero));
+	valid = XMVectorAndInt(valid, XMVectorLessOrEqual(XMVectorAdd(u, v), XMVectorSplatOne()));
+	valid = XMVectorAndInt(valid, XMVectorGreater(t, XMVectorReplicate(kMinDistance)));
+	valid = XMVectorAndInt(valid, XMVectorLess(t, XMVectorReplicate(hit.distance)));
+
+	UINT mask[4];
+	XMStoreInt4(mask, valid);
+	if (!(mask[0] | mask[1] | mask[2] | mask[3])) {
+		return false;
+	}
+
+	XMFLOAT4 distances;
+	XMFLOAT4 us;
+	XMFLOAT4 vs;
+	XMStoreFloat4(&distances, t);
+	XMStoreFloat4(&us, u);
+	XMStoreFloat4(&vs, v);
+
+	bool improved = false;
+	for (uint32_t lane = 0; lane < count; ++lane) {
+		const float distance = (&distances.x)[lane];
+		if (mask[lane] && distance < hit.distance) {
+			hit.distance = distance;
+			hit.submesh = packet.submesh[lane];
+			hit.triangle = packet.triangle[lane];
+			hit.u = (&us.x)[lane];
+			hit.v = (&vs.x)[lane];
+			improved = true;
+		}
+	}
+	return improved;
+}
+
+void
+TriangleBVH::assign(std::vector<Node>&& nodes, std::vector<TrianglePacket>&& packets) {
+	m_nodes = std::move(nodes);
+	m_packets = std::move(packets);
+	m_build.clear();
+	m_submeshCount = 0;
+
+	m_triangleCount = 0;
+	for (const Node& node : m_nodes) {
+		m_triangleCount += node.count;
+	}
+}
+
+void
+TriangleBVH::clear() {
+	m_nodes.clear();
+	m_packets.clear();
+	m_build.clear();
+	m_submeshCount = 0;
+	m_triangleCount = 0;
+}
@@ -0,0 +1,371 @@
+/**
+ * @file DynamicAABBTree.cpp
+ * @brief Implementa la logica de DynamicAABBTree dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ */
+#include "SceneGraph/DynamicAABBTree.h"
+
+namespace {
+XMFLOAT3
+Min3(const XMFLOAT3& a, const XMFLOAT3& b) {
+	return XMFLOAT3((std::min)(a.x, b.x), (std::min)(a.y, b.y), (std::min)(a.z, b.z));
+}
+
+XMFLOAT3
+Max3(const XMFLOAT3& a, const XMFLOAT3& b) {
+	return XMFLOAT3((std::max)(a.x, b.x), (std::max)(a.y, b.y), (std::max)(a.z, b.z));
+}
+
+bool
+Contains(const XMFLOAT3& outerLower, const XMFLOAT3& outerUpper,
+         const XMFLOAT3& innerLower, const XMFLOAT3& innerUpper) {
+	return outerLower.x <= innerLower.x && outerLower.y <= innerLower.y && outerLower.z <= innerLower.z &&
+	       innerUpper.x <= outerUpper.x && innerUpper.y <= outerUpper.y && innerUpper.z <= outerUpper.z;
+}
+
+XMFLOAT3
+Offset(const XMFLOAT3& point, float amount) {
+	return XMFLOAT3(point.x + amount, point.y + amount, point.z + amount);
+}
+}
+
+int32_t
+DynamicAABBTree::createProxy(const Bounds& bounds, void* userData) {
+	const int32_t proxy = allocateNode();
+	Node& node = m_nodes[proxy];
+	node.lower = Offset(bounds.getMin(), -m_margin);
+	node.upper = Offset(bounds.getMax(), m_margin);
+	node.userData = userData;
+	node.height = 0;
+	insertLeaf(proxy);
+	++m_proxyCount;
+	return proxy;
+}
+
+void
+DynamicAABBTree::destroyProxy(int32_t proxy) {
+	// Un nodo libre tambien "es hoja" (sin hijos): solo height == 0 marca un proxy vivo
+	if (proxy < 0 || proxy >= static_cast<int32_t>(m_nodes.size()) || !m_nodes[proxy].isLeaf() ||
+	    m_nodes[proxy].height != 0) {
+		return;
+	}
+	removeLeaf(proxy);
+	freeNode(proxy);
+	--m_proxyCount;
+}
+
+bool
+DynamicAABBTree::moveProxy(int32_t proxy, const Bounds& bounds) {
+	Node& node = m_nodes[proxy];
+	const XMFLOAT3 lower = bounds.getMin();
+	const XMFLOAT3 upper = bounds.getMax();
+	const XMFLOAT3 fatLower = Offset(lower, -m_margin);
+	const XMFLOAT3 fatUpper = Offset(upper, m_margin);
+
+	// Sin cambios si la caja gorda la contiene y no quedo desproporcionada (objeto que encogio).
+	if (Contains(node.lower, node.upper, lower, upper) &&
+	    Contains(Offset(fatLower, -4.0f * m_margin), Offset(fatUpper, 4.0f * m_margin), node.lower, node.upper)) {
+		return false;
+	}
+
+	removeLeaf(proxy);
+	m_nodes[proxy].lower = fatLower;
+	m_nodes[proxy].upper = fatUpper;
+	insertLeaf(proxy);
+	++m_reinsertCount;
+	return true;
+}
+
+void
+DynamicAABBTree::clear() {
+	m_nodes.clear();
+	m_root = kNullNode;
+	m_freeList = kNullNode;
+	m_proxyCount = 0;
+	m_reinsertCount = 0;
+}
+
+uint32_t
+DynamicAABBTree::collectFrustum(const Frustum& frustum, std::vector<SpatialHit>& outHits) const {
+	return queryFrustum(frustum, [&outHits](int32_t proxy, bool fullyInside) {
+		SpatialHit hit;
+		hit.proxy = proxy;
+		hit.fullyInside = fullyInside;
+		outHits.push_back(hit);
+	});
+}
+
+void
+DynamicAABBTree::collectSphere(const XMFLOAT3& center, float radius, std::vector<int32_t>& outProxies) const {
+	querySphere(center, radius, [&outProxies](int32_t proxy) {
+		outProxies.push_back(proxy);
+		return true;
+	});
+}
+
+void
+DynamicAABBTree::collectAABB(const Bounds& bounds, std::vector<int32_t>& outProxies) const {
+	queryAABB(bounds, [&outProxies](int32_t proxy) {
+		outProxies.push_back(proxy);
+		return true;
+	});
+}
+
+void
+DynamicAABBTree::collectRay(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance,
+                            std::vector<SpatialRayHit>& outHits) const {
+	queryRay(origin, direction, maxDistance, [&outHits, maxDistance](int32_t proxy, float tEnter) {
+		SpatialRayHit hit;
+		hit.proxy = proxy;
+		hit.distance = tEnter;
+		outHits.push_back(hit);
+		return maxDistance;
+	});
+}
+
+int32_t
+DynamicAABBTree::allocateNode() {
+	if (m_freeList == kNullNode) {
+		m_nodes.emplace_back();
+		return static_cast<int32_t>(m_nodes.size() - 1);
+	}
+
+	const int32_t node = m_freeList;
+	m_freeList = m_nodes[node].parent;
+	m_nodes[node] = Node{};
+	return node;
+}
+
+void
+DynamicAABBTree::freeNode(int32_t node) {
+	m_nodes[node] = Node{};
+	m_nodes[node].parent = m_freeList;
+	m_freeList = node;
+}
+
+void
+DynamicAABBTree::insertLeaf(int32_t leaf) {
+	if (m_root == kNullNode) {
+		m_root = leaf;
+		m_nodes[leaf].parent = kNullNode;
+		return;
+	}
+
+	// 1) Descenso: el hermano con menor coste de area (SAH), incluido el area heredada.
+	const XMFLOAT3 leafLower = m_nodes[leaf].lower;
+	const XMFLOAT3 leafUpper = m_nodes[leaf].upper;
+	int32_t index = m_root;
+	while (!m_nodes[index].isLeaf()) {
+		const Node& node = m_nodes[index];
+		const float area = surfaceArea(node.lower, node.upper);
+		const float combinedArea = surfaceArea(Min3(node.lower, leafLower), Max3(node.upper, leafUpper));
+
+		// Crear un padre nuevo aqui, y lo que suben los ancestros al bajar un nivel.
+		const float cost = 2.0f * combinedArea;
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto childCost = [&](int32_t child) {
+			const Node& c = m_nodes[child];
+			const float unionArea = surfaceArea(Min3(c.lower, leafLower), Max3(c.upper, leafUpper));
+			return c.isLeaf() ? unionArea + inheritanceCost
+			                  : (unionArea - surfaceArea(c.lower, c.upper)) + inheritanceCost;
+		};
+		const float cost1 = childCost(node.child1);
+		const float cost2 = childCost(node.child2);
+
+		if (cost < cost1 && cost < cost2) {
+			break;
+		}
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	// 2) Nuevo padre de la hoja y su hermano.
+	const int32_t sibling = index;
+	const int32_t oldParent = m_nodes[sibling].parent;
+	const int32_t newParent = allocateNode();
+	m_nodes[newParent].parent = oldParent;
+	m_nodes[newParent].height = m_nodes[sibling].height + 1;
+	m_nodes[newParent].child1 = sibling;
+	m_nodes[newParent].child2 = leaf;
+	setUnion(m_nodes[newParent], m_nodes[sibling], m_nodes[leaf]);
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf].parent = newParent;
+
+	if (oldParent == kNullNode) {
+		m_root = newParent;
+	}
+	else if (m_nodes[oldParent].child1 == sibling) {
+		m_nodes[oldParent].child1 = newParent;
+	}
+	else {
+		m_nodes[oldParent].child2 = newParent;
+	}
+
+	// 3) Refit y balanceo hacia la raiz.
+	refitAncestors(m_nodes[leaf].parent);
+}
+
+void
+DynamicAABBTree::removeLeaf(int32_t leaf) {
+	if (leaf == m_root) {
+		m_root = kNullNode;
+		return;
+	}
+
+	const int32_t parent = m_nodes[leaf].parent;
+	const int32_t grandParent = m_nodes[parent].parent;
+	const int32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	// El hermano ocupa el lugar del padre.
+	if (grandParent == kNullNode) {
+		m_root = sibling;
+		m_nodes[sibling].parent = kNullNode;
+		freeNode(parent);
+		return;
+	}
+
+	if (m_nodes[grandParent].child1 == parent) {
+		m_nodes[grandParent].child1 = sibling;
+	}
+	else {
+		m_nodes[grandParent].child2 = sibling;
+	}
+	m_nodes[sibling].parent = grandParent;
+	freeNode(parent);
+	refitAncestors(grandParent);
+}
+
+void
+DynamicAABBTree::refitAncestors(int32_t index) {
+	while (index != kNullNode) {
+		index = balance(index);
+
+		Node& node = m_nodes[index];
+		const Node& child1 = m_nodes[node.child1];
+		const Node& child2 = m_nodes[node.child2];
+		node.height = 1 + (std::max)(child1.height, child2.height);
+		setUnion(node, child1, child2);
+
+		index = node.parent;
+	}
+}
+
+int32_t
+DynamicAABBTree::balance(int32_t iA) {
+	Node& a = m_nodes[iA];
+	if (a.isLeaf() || a.height < 2) {
+		return iA;
+	}
+
+	const int32_t iB = a.child1;
+	const int32_t iC = a.child2;
+	Node& b = m_nodes[iB];
+	Node& c = m_nodes[iC];
+	const int32_t difference = c.height - b.height;
+
+	// C sube: A pasa a ser su hijo izquierdo.
+	if (difference > 1) {
+		const int32_t iF = c.child1;
+		const int32_t iG = c.child2;
+		Node& f = m_nodes[iF];
+		Node& g = m_nodes[iG];
+
+		c.child1 = iA;
+		c.parent = a.parent;
+		a.parent = iC;
+		if (c.parent == kNullNode) {
+			m_root = iC;
+		}
+		else if (m_nodes[c.parent].child1 == iA) {
+			m_nodes[c.parent].child1 = iC;
+		}
+		else {
+			m_nodes[c.parent].child2 = iC;
+		}
+
+		// El nieto mas alto queda con C; el otro pasa a A.
+		if (f.height > g.height) {
+			c.child2 = iF;
+			a.child2 = iG;
+			g.parent = iA;
+			setUnion(a, b, g);
+			setUnion(c, a, f);
+			a.height = 1 + (std::max)(b.height, g.height);
+			c.height = 1 + (std::max)(a.height, f.height);
+		}
+		else {
+			c.child2 = iG;
+			a.child2 = iF;
+			f.parent = iA;
+			setUnion(a, b, f);
+			setUnion(c, a, g);
+			a.height = 1 + (std::max)(b.height, f.height);
+			c.height = 1 + (std::max)(a.height, g.height);
+		}
+		return iC;
+	}
+
+	// B sube: simetrico.
+	if (difference < -1) {
+		const int32_t iD = b.child1;
+		const int32_t iE = b.child2;
+		Node& d = m_nodes[iD];
+		Node& e = m_nodes[iE];
+
+		b.child1 = iA;
+		b.parent = a.parent;
+		a.parent = iB;
+		if (b.parent == kNullNode) {
+			m_root = iB;
+		}
+		else if (m_nodes[b.parent].child1 == iA) {
+			m_nodes[b.parent].child1 = iB;
+		}
+		else {
+			m_nodes[b.parent].child2 = iB;
+		}
+
+		if (d.height > e.height) {
+			b.child2 = iD;
+			a.child1 = iE;
+			e.parent = iA;
+			setUnion(a, c, e);
+			setUnion(b, a, d);
+			a.height = 1 + (std::max)(c.height, e.height);
+			b.height = 1 + (std::max)(a.height, d.height);
+		}
+		else {
+			b.child2 = iE;
+			a.child1 = iD;
+			d.parent = iA;
+			setUnion(a, c, d);
+			setUnion(b, a, e);
+			a.height = 1 + (std::max)(c.height, d.height);
+			b.height = 1 + (std::max)(a.height, e.height);
+		}
+		return iB;
+	}
+
+	return iA;
+}
+
+void
+DynamicAABBTree::setUnion(Node& node, const Node& a, const Node& b) {
+	node.lower = Min3(a.lower, b.lower);
+	node.upper = Max3(a.upper, b.upper);
+}
+
+float
+DynamicAABBTree::surfaceArea(const XMFLOAT3& lower, const XMFLOAT3& upper) {
+	const float dx = upper.x - lower.x;
+	const float dy = upper.y - lower.y;
+	const float dz = upper.z - lower.z;
+	return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+bool
+DynamicAABBTree::overlaps(const Node& node, const XMFLOAT3& lower, const XMFLOAT3& upper) {
+	return node.lower.x <= upper.x && lower.x <= node.upper.x &&
+	       node.lower.y <= upper.y && lower.y <= node.upper.y &&
+	       node.lower.z <= upper.z && lower.z <= node.upper.z;
+}
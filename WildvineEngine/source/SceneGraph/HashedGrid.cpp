@@ -0,0 +1,289 @@
+/**
+ * @file HashedGrid.cpp
+ * @brief Implementa la logica de HashedGrid dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ */
+#include "SceneGraph/HashedGrid.h"
+#include <cmath>
+
+namespace {
+constexpr int32_t kCoordinateBits = 21;
+constexpr int32_t kCoordinateLimit = (1 << (kCoordinateBits - 1)) - 1;
+constexpr uint64_t kCoordinateMask = (uint64_t(1) << kCoordinateBits) - 1;
+
+bool
+BoxesOverlap(const XMFLOAT3& aLower, const XMFLOAT3& aUpper,
+             const XMFLOAT3& bLower, const XMFLOAT3& bUpper) {
+	return aLower.x <= bUpper.x && bLower.x <= aUpper.x &&
+	       aLower.y <= bUpper.y && bLower.y <= aUpper.y &&
+	       aLower.z <= bUpper.z && bLower.z <= aUpper.z;
+}
+
+/// Distancia al cuadrado del punto a la caja (0 si esta dentro).
+float
+DistanceSqToBox(const XMFLOAT3& point, const XMFLOAT3& lower, const XMFLOAT3& upper) {
+	const float dx = (std::max)((std::max)(lower.x - point.x, 0.0f), point.x - upper.x);
+	const float dy = (std::max)((std::max)(lower.y - point.y, 0.0f), point.y - upper.y);
+	const float dz = (std::max)((std::max)(lower.z - point.z, 0.0f), point.z - upper.z);
+	return dx * dx + dy * dy + dz * dz;
+}
+}
+
+int32_t
+HashedGrid::createProxy(const Bounds& bounds, void* userData) {
+	int32_t proxy = kNullProxy;
+	if (m_freeProxies.empty()) {
+		proxy = static_cast<int32_t>(m_proxies.size());
+		m_proxies.emplace_back();
+	}
+	else {
+		proxy = m_freeProxies.back();
+		m_freeProxies.pop_back();
+	}
+
+	Proxy& record = m_proxies[proxy];
+	record.bounds = bounds;
+	record.userData = userData;
+	insertIntoCell(proxy);
+	++m_proxyCount;
+	return proxy;
+}
+
+void
+HashedGrid::destroyProxy(int32_t proxy) {
+	if (proxy < 0 || proxy >= static_cast<int32_t>(m_proxies.size()) ||
+	    m_proxies[proxy].cell == UINT32_MAX) {
+		return;
+	}
+	removeFromCell(proxy);
+	m_proxies[proxy] = Proxy{};
+	m_freeProxies.push_back(proxy);
+	--m_proxyCount;
+}
+
+bool
+HashedGrid::moveProxy(int32_t proxy, const Bounds& bounds) {
+	Proxy& record = m_proxies[proxy];
+	Cell& current = m_cells[record.cell];
+	record.bounds = bounds;
+
+	// Mismo centro de celda: basta con ampliar la caja suelta.
+	if (cellCoordinate(bounds.center.x) == current.x &&
+	    cellCoordinate(bounds.center.y) == current.y &&
+	    cellCoordinate(bounds.center.z) == current.z) {
+		const XMFLOAT3 lower = bounds.getMin();
+		const XMFLOAT3 upper = bounds.getMax();
+		current.lower = XMFLOAT3((std::min)(current.lower.x, lower.x), (std::min)(current.lower.y, lower.y), (std::min)(current.lower.z, lower.z));
+		current.upper = XMFLOAT3((std::max)(current.upper.x, upper.x), (std::max)(current.upper.y, upper.y), (std::max)(current.upper.z, upper.z));
+		m_maxExtent = (std::max)(m_maxExtent, (std::max)(bounds.extents.x, (std::max)(bounds.extents.y, bounds.extents.z)));
+		return false;
+	}
+
+	removeFromCell(proxy);
+	insertIntoCell(proxy);
+	++m_reinsertCount;
+	return true;
+}
+
+void
+HashedGrid::clear() {
+	m_cells.clear();
+	m_lookup.clear();
+	m_proxies.clear();
+	m_freeProxies.clear();
+	m_proxyCount = 0;
+	m_maxExtent = 0.0f;
+	m_reinsertCount = 0;
+}
+
+void
+HashedGrid::setCellSize(float cellSize) {
+	if (cellSize <= 0.0f || cellSize == m_cellSize) {
+		return;
+	}
+
+	m_cellSize = cellSize;
+	m_cells.clear();
+	m_lookup.clear();
+	m_maxExtent = 0.0f;
+	for (int32_t proxy = 0; proxy < static_cast<int32_t>(m_proxies.size()); ++proxy) {
+		if (m_proxies[proxy].cell != UINT32_MAX) {
+			insertIntoCell(proxy);
+		}
+	}
+}
+
+uint32_t
+HashedGrid::collectFrustum(const Frustum& frustum, std::vector<SpatialHit>& outHits) const {
+	uint32_t tested = 0;
+	auto visitCell = [&frustum, &outHits, &tested](const Cell& cell) {
+		++tested;
+		const Frustum::Containment containment = frustum.classify(Bounds::fromMinMax(cell.lower, cell.upper));
+		if (containment == Frustum::Containment::Outside) {
+			return;
+		}
+
+		SpatialHit hit;
+		hit.fullyInside = containment == Frustum::Containment::Inside;
+		for (int32_t proxy : cell.proxies) {
+			hit.proxy = proxy;
+			outHits.push_back(hit);
+		}
+	};
+
+	// Un frustum acotado en un mundo grande solo toca las celdas de su caja; si la
+	// caja abarca mas celdas que las ocupadas (o no esta acotado) se recorre el arreglo denso.
+	XMFLOAT3 lower;
+	XMFLOAT3 upper;
+	if (frustum.computeBounds(lower, upper)) {
+		forEachCellInRange(lower, upper, visitCell);
+	}
+	else {
+		for (const Cell& cell : m_cells) {
+			visitCell(cell);
+		}
+	}
+	return tested;
+}
+
+void
+HashedGrid::collectSphere(const XMFLOAT3& center, float radius, std::vector<int32_t>& outProxies) const {
+	const float radiusSq = radius * radius;
+	const XMFLOAT3 lower(center.x - radius, center.y - radius, center.z - radius);
+	const XMFLOAT3 upper(center.x + radius, center.y + radius, center.z + radius);
+	forEachCellInRange(lower, upper, [&](const Cell& cell) {
+		if (DistanceSqToBox(center, cell.lower, cell.upper) > radiusSq) {
+			return;
+		}
+		for (int32_t proxy : cell.proxies) {
+			const Bounds& bounds = m_proxies[proxy].bounds;
+			if (DistanceSqToBox(center, bounds.getMin(), bounds.getMax()) <= radiusSq) {
+				outProxies.push_back(proxy);
+			}
+		}
+	});
+}
+
+void
+HashedGrid::collectAABB(const Bounds& bounds, std::vector<int32_t>& outProxies) const {
+	if (!bounds.isValid()) {
+		return;
+	}
+
+	const XMFLOAT3 lower = bounds.getMin();
+	const XMFLOAT3 upper = bounds.getMax();
+	forEachCellInRange(lower, upper, [&](const Cell& cell) {
+		if (!BoxesOverlap(cell.lower, cell.upper, lower, upper)) {
+			return;
+		}
+		for (int32_t proxy : cell.proxies) {
+			const Bounds& proxyBounds = m_proxies[proxy].bounds;
+			if (BoxesOverlap(proxyBounds.getMin(), proxyBounds.getMax(), lower, upper)) {
+				outProxies.push_back(proxy);
+			}
+		}
+	});
+}
+
+void
+HashedGrid::collectRay(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance,
+                       std::vector<SpatialRayHit>& outHits) const {
+	// Un rayo cruza pocas celdas pero recorrerlas con DDA no sirve con cajas
+	// sueltas: se prueban las cajas de todas las celdas ocupadas, que son densas.
+	const XMFLOAT3 inverse(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+	for (const Cell& cell : m_cells) {
+		float tEnter = 0.0f;
+		if (!Bounds::rayIntersects(cell.lower, cell.upper, origin, inverse, maxDistance, tEnter)) {
+			continue;
+		}
+		for (int32_t proxy : cell.proxies) {
+			const Bounds& bounds = m_proxies[proxy].bounds;
+			if (Bounds::rayIntersects(bounds.getMin(), bounds.getMax(), origin, inverse, maxDistance, tEnter)) {
+				SpatialRayHit hit;
+				hit.proxy = proxy;
+				hit.distance = tEnter;
+				outHits.push_back(hit);
+			}
+		}
+	}
+}
+
+int32_t
+HashedGrid::cellCoordinate(float value) const {
+	const float cell = std::floor(value / m_cellSize);
+	if (!(cell > -static_cast<float>(kCoordinateLimit))) {
+		return -kCoordinateLimit;
+	}
+	if (cell > static_cast<float>(kCoordinateLimit)) {
+		return kCoordinateLimit;
+	}
+	return static_cast<int32_t>(cell);
+}
+
+uint64_t
+HashedGrid::cellKey(int32_t x, int32_t y, int32_t z) {
+	return ((static_cast<uint64_t>(x) & kCoordinateMask) << (2 * kCoordinateBits)) |
+	       ((static_cast<uint64_t>(y) & kCoordinateMask) << kCoordinateBits) |
+	       (static_cast<uint64_t>(z) & kCoordinateMask);
+}
+
+void
+HashedGrid::insertIntoCell(int32_t proxy) {
+	Proxy& record = m_proxies[proxy];
+	const Bounds& bounds = record.bounds;
+	const XMFLOAT3 lower = bounds.getMin();
+	const XMFLOAT3 upper = bounds.getMax();
+	const int32_t x = cellCoordinate(bounds.center.x);
+	const int32_t y = cellCoordinate(bounds.center.y);
+	const int32_t z = cellCoordinate(bounds.center.z);
+
+	const auto inserted = m_lookup.emplace(cellKey(x, y, z), static_cast<uint32_t>(m_cells.size()));
+	if (inserted.second) {
+		Cell cell;
+		cell.x = x;
+		cell.y = y;
+		cell.z = z;
+		cell.lower = lower;
+		cell.upper = upper;
+		m_cells.push_back(std::move(cell));
+	}
+
+	const uint32_t cellIndex = inserted.first->second;
+	Cell& cell = m_cells[cellIndex];
+	cell.lower = XMFLOAT3((std::min)(cell.lower.x, lower.x), (std::min)(cell.lower.y, lower.y), (std::min)(cell.lower.z, lower.z));
+	cell.upper = XMFLOAT3((std::max)(cell.upper.x, upper.x), (std::max)(cell.upper.y, upper.y), (std::max)(cell.upper.z, upper.z));
+	record.cell = cellIndex;
+	record.slot = static_cast<uint32_t>(cell.proxies.size());
+	cell.proxies.push_back(proxy);
+	m_maxExtent = (std::max)(m_maxExtent, (std::max)(bounds.extents.x, (std::max)(bounds.extents.y, bounds.extents.z)));
+}
+
+void
+HashedGrid::removeFromCell(int32_t proxy) {
+	Proxy& record = m_proxies[proxy];
+	const uint32_t cellIndex = record.cell;
+	Cell& cell = m_cells[cellIndex];
+
+	// Swap-remove dentro de la celda
+	const int32_t moved = cell.proxies.back();
+	cell.proxies[record.slot] = moved;
+	m_proxies[moved].slot = record.slot;
+	cell.proxies.pop_back();
+	record.cell = UINT32_MAX;
+	if (!cell.proxies.empty()) {
+		return;
+	}
+
+	// Celda vacia: swap-remove en el arreglo de celdas y en la tabla
+	m_lookup.erase(cellKey(cell.x, cell.y, cell.z));
+	const uint32_t lastIndex = static_cast<uint32_t>(m_cells.size() - 1);
+	if (cellIndex != lastIndex) {
+		m_cells[cellIndex] = std::move(m_cells[lastIndex]);
+		Cell& relocated = m_cells[cellIndex];
+		m_lookup[cellKey(relocated.x, relocated.y, relocated.z)] = cellIndex;
+		for (int32_t relocatedProxy : relocated.proxies) {
+			m_proxies[relocatedProxy].cell = cellIndex;
+		}
+	}
+	m_cells.pop_back();
+}
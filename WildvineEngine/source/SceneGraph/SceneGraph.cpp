@@ -11,12 +11,110 @@
 #include "ECS\MeshRendererComponent.h"
 #include "DeviceContext.h"
 #include "EngineUtilities/Utilities/Camera.h"
+#include "EngineUtilities/Utilities/JobSystem.h"
 #include "Rendering/Material.h"
 #include "Rendering/MaterialInstance.h"
+#include "Rendering/Mesh.h"
 #include "Rendering/RenderScene.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+/// Consulta que agrego un proxy o un nodo de rama en gatherRenderScene()
+constexpr uint8_t kCameraGather = 1;
+constexpr uint8_t kShadowGather = 2;
+
+/**
+ * @brief Prueba el rayo contra el BVH de triangulos de la malla de `entity`.
+ *
+ * Actualiza `best` si hay un impacto mas cercano que `best.distance`.
+ */
+void
+RaycastRenderable(Entity* entity, FXMVECTOR rayOrigin, FXMVECTOR rayDirection, RaycastHit& best) {
+	const Transform* transform = entity->getComponent<Transform>();
+	const MeshRendererComponent* meshRenderer = entity->getComponent<MeshRendererComponent>();
+	if (!transform || !meshRenderer || !meshRenderer->getData().visible || !meshRenderer->getData().mesh) {
+		return;
+	}
+	const std::shared_ptr<const TriangleBVH>& triangleBVH = meshRenderer->getData().mesh->getTriangleBVH();
+	if (!triangleBVH) {
+		return;
+	}
+
+	// Rayo en espacio local: una transformacion afin conserva el parametro t.
+	const XMMATRIX& world = transform->getData().worldMatrix;
+	XMVECTOR determinant;
+	const XMMATRIX inverseWorld = XMMatrixInverse(&determinant, world);
+	if (XMVectorGetX(determinant) == 0.0f) {
+		return;
+	}
+	XMFLOAT3 localOrigin;
+	XMFLOAT3 localDirection;
+	XMStoreFloat3(&localOrigin, XMVector3TransformCoord(rayOrigin, inverseWorld));
+	XMStoreFloat3(&localDirection, XMVector3TransformNormal(rayDirection, inverseWorld));
+
+	++best.candidatesTested;
+	TriangleHit triangleHit;
+	if (triangleBVH->intersect(localOrigin, localDirection, best.distance, triangleHit)) {
+		best.entity = entity;
+		best.submesh = triangleHit.submesh;
+		best.triangle = triangleHit.triangle;
+		best.distance = triangleHit.distance;
+	}
+}
+}
 
 void SceneGraph::init() {
-	m_entities.clear();
+	clearRegistry();
+	m_hierarchy.clear();
+
+	const uint32_t transformBit = Entity::componentBit(ComponentType::TRANSFORM);
+	const uint32_t hierarchyBit = Entity::componentBit(ComponentType::HIERARCHY);
+	const uint32_t meshRendererBit = Entity::componentBit(ComponentType::MESH_RENDERER);
+	m_scheduler.clear();
+	m_spatialTree.clear();
+	m_spatialGrid.clear();
+
+	// Consultas cacheadas: se crean aqui para que los sistemas solo las lean
+	m_transformQuery = &m_storage.query<Transform>();
+	m_lightQuery = &m_storage.query<LightComponent>();
+	m_renderQuery = &m_storage.query<Transform, MeshRendererComponent>();
+
+	// Matrices locales: cada chunk de Transform en un worker
+	m_scheduler.addSystem("LocalTransforms", 0, transformBit,
+		[this](const SystemContext& context) {
+			std::atomic<uint32_t> localUpdates{ 0 };
+			context.forEachChunkParallel(*m_transformQuery,
+				[&localUpdates](const Archetype& archetype, const ArchetypeChunk& chunk) {
+					TransformData* transforms = archetype.transforms(chunk);
+					uint32_t updated = 0;
+					for (uint32_t row = 0; row < chunk.count; ++row) {
+						if (transforms[row].flags & TransformData::kLocalDirty) {
+							Transform::updateMatrices(transforms[row]);
+							++updated;
+						}
+					}
+					localUpdates += updated;
+				});
+			m_stats.localUpdates = localUpdates;
+		});
+
+	// Propagacin World: jerarquia aplanada, por niveles en los workers
+	m_scheduler.addSystem("WorldTransforms", hierarchyBit, transformBit,
+		[this](const SystemContext& context) {
+			const auto begin = std::chrono::high_resolution_clock::now();
+			m_stats.worldUpdates = m_hierarchy.updateWorld(context.jobs);
+			m_stats.hierarchyLevels = m_hierarchy.getLevelCount();
+			m_stats.worldUs = std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::high_resolution_clock::now() - begin).count();
+		});
+
+	// Indice espacial: depende de las world ya propagadas. Marca las cajas de
+	// las ramas de la jerarquia cuando cambia la malla, asi que tambien la escribe
+	m_scheduler.addSystem("SpatialIndex", transformBit, meshRendererBit | hierarchyBit,
+		[this](const SystemContext&) {
+			syncSpatialIndex();
+		});
 }
 
 void SceneGraph::destroy() {
@@ -31,7 +129,10 @@ void SceneGraph::destroy() {
 		}
 	}
 
-	m_entities.clear();
+	resetSpatialIndex();
+	m_hierarchy.clear();
+	m_storage.clear();
+	clearRegistry();
 }
 
 void 
@@ -53,7 +154,11 @@ SceneGraph::addEntity(Entity* e) {
 		e->getComponent<HierarchyComponent>()->init();
 	}
 
+	e->m_sceneGraph = this;
+	e->m_sceneIndex = static_cast<uint32_t>(m_entities.size());
 	m_entities.push_back(e);
+	m_storage.add(e);
+	m_hierarchy.add(e);
 }
 
 void 
@@ -83,35 +188,54 @@ SceneGraph::removeEntity(Entity* e) {
 
 			// marcar dirty para recalcular world
 			auto wt = c->getComponent<Transform>();
-			//if (wt) wt->dirty = true;
-			//markWorldDirtyRecursive(wt);
+			if (wt) wt->markWorldDirty(); // su subarbol se recalcula al propagar
 		}
 
 		h->m_children.clear();
 	}
 
-	// 3) eliminar del registro
-	m_entities.erase(std::remove(m_entities.begin(), m_entities.end(), e), m_entities.end());
+	// 3) eliminar del registro (los hijos ya son roots en la jerarquia aplanada)
+	if (MeshRendererComponent* meshRenderer = e->getComponent<MeshRendererComponent>())
+		releaseSpatialProxy(meshRenderer->getData());
+	releaseBranchProxy(e);
+	m_hierarchy.remove(e);
+	m_storage.remove(e);
+
+	// Swap-remove: la ultima entidad ocupa el hueco
+	const uint32_t index = e->m_sceneIndex;
+	Entity* last = m_entities.back();
+	m_entities[index] = last;
+	last->m_sceneIndex = index;
+	m_entities.pop_back();
+	e->m_sceneGraph = nullptr;
+	e->m_sceneIndex = 0;
 }
 
 bool 
 SceneGraph::isAncestor(Entity* possibleAncestor, Entity* node) const {
-	// Recorre hacia arriba desde node: si encuentra possibleAncestor, hay ciclo
+	// Si encuentra possibleAncestor sobre node, hay ciclo
 	if (!possibleAncestor || !node) return false;
 
+	// Intervalos de preorden de la jerarquia aplanada: O(1)
+	if (m_hierarchy.contains(possibleAncestor) && m_hierarchy.contains(node))
+		return m_hierarchy.isAncestor(possibleAncestor, node);
+
+	// Entidades fuera del grafo: recorre hacia arriba desde node
 	auto h = node->getComponent<HierarchyComponent>();
 	while (h && h->m_parent)
 	{
 		if (h->m_parent == possibleAncestor) return true;
-		node = h->m_parent;
-		EU::TSharedPointer<HierarchyComponent> h;
-		if (node)
-			h = node->getComponent<HierarchyComponent>();
-
+		h = h->m_parent->getComponent<HierarchyComponent>();
 	}
 	return false;
 }
 
+bool 
+SceneGraph::isInSubtree(Entity* root, Entity* node) const {
+	if (!root || !node) return false;
+	return root == node || isAncestor(root, node);
+}
+
 bool
 SceneGraph::isRoot(Entity* e) const {
 	
@@ -122,7 +246,18 @@ SceneGraph::isRoot(Entity* e) const {
 
 bool 
 SceneGraph::isRegistered(Entity* e) const {
-	return std::find(m_entities.begin(), m_entities.end(), e) != m_entities.end();
+	return e && e->m_sceneGraph == this;
+}
+
+void
+SceneGraph::clearRegistry() {
+	for (Entity* e : m_entities) {
+		if (e) {
+			e->m_sceneGraph = nullptr;
+			e->m_sceneIndex = 0;
+		}
+	}
+	m_entities.clear();
 }
 
 bool 
@@ -147,8 +282,11 @@ SceneGraph::attach(Entity* child, Entity* parent)
 
 	hc->m_parent = parent;
 	hp->addChild(child);
+	m_hierarchy.attach(child, parent);
+	// Ya no es raiz: su rama pasa a formar parte de la del nuevo padre
+	releaseBranchProxy(child);
 
-	//markWorldDirtyRecursive(wt);
+	if (auto wt = child->getComponent<Transform>()) wt->markWorldDirty();
 	return true;
 }
 
@@ -166,48 +304,273 @@ SceneGraph::detach(Entity* child) {
 	if (hp) hp->removeChild(child);
 
 	hc->m_parent = nullptr;
+	m_hierarchy.detach(child);
 
-	//markWorldDirtyRecursive(wt);
+	if (auto wt = child->getComponent<Transform>()) wt->markWorldDirty();
 	return true;
 }
 
 void
 SceneGraph::update(float deltaTime, DeviceContext& deviceContext) {
-	// Actualiza todas las entidades
+	const auto begin = std::chrono::high_resolution_clock::now();
+
+	// 1) Sistemas ECS (transforms local y world) en el JobSystem
+	SystemContext context;
+	context.deltaTime = deltaTime;
+	context.storage = &m_storage;
+	context.jobs = &JobSystem::getInstance();
+	m_scheduler.run(context);
+
+	// 2) Actualiza todas las entidades. Actor::update escribe su constant buffer
+	//    en el contexto inmediato de D3D11, que no es thread-safe: queda en serie.
 	for (Entity* e : m_entities)
 	{
 		if (!e) continue;
 		e->update(deltaTime, deviceContext);
 	}
 
-	// 2) Propagacin World: procesa roots
-	for (Entity* e : m_entities)
-	{
-		if (!e) continue;
-		if (isRoot(e))
-		{
-			updateWorldRecursive(e, XMMatrixIdentity());
+	m_stats.updateUs = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::high_resolution_clock::now() - begin).count();
+	m_stats.entityCount = m_storage.getEntityCount();
+	m_stats.archetypeCount = m_storage.getArchetypes().size();
+	m_stats.chunkCount = m_storage.getChunkCount();
+	m_stats.workerCount = JobSystem::getInstance().getWorkerCount();
+}
+
+void
+SceneGraph::setSpatialPartition(SpatialPartition partition, float gridCellSize) {
+	m_spatialGrid.setCellSize(gridCellSize);
+	if (partition == m_spatialPartition) {
+		return;
+	}
+	resetSpatialIndex();
+	m_spatialPartition = partition;
+}
+
+const SpatialIndex&
+SceneGraph::getSpatialIndex() const {
+	if (m_spatialPartition == SpatialPartition::HashedGrid) {
+		return m_spatialGrid;
+	}
+	return m_spatialTree;
+}
+
+SpatialIndex&
+SceneGraph::spatialIndex() {
+	if (m_spatialPartition == SpatialPartition::HashedGrid) {
+		return m_spatialGrid;
+	}
+	return m_spatialTree;
+}
+
+void
+SceneGraph::resetSpatialIndex() {
+	if (m_renderQuery) {
+		m_renderQuery->forEachChunk([](const Archetype& archetype, const ArchetypeChunk& chunk) {
+			MeshRendererData* meshRenderers = archetype.meshRenderers(chunk);
+			for (uint32_t row = 0; row < chunk.count; ++row) {
+				meshRenderers[row].spatialProxy = SpatialIndex::kNullProxy;
+				meshRenderers[row].spatialVersion = UINT32_MAX;
+				meshRenderers[row].spatialMesh = nullptr;
+			}
+		});
+	}
+	for (Entity* e : m_entities) {
+		if (HierarchyComponent* hierarchy = e ? e->getComponent<HierarchyComponent>() : nullptr) {
+			hierarchy->m_spatialProxy = SpatialIndex::kNullProxy;
+			hierarchy->m_spatialVersion = UINT32_MAX;
 		}
 	}
+	spatialIndex().clear();
+	m_proxyReported.clear();
 }
 
-void 
-SceneGraph::updateWorldRecursive(Entity* node, const XMMATRIX& parentWorld) {
-	auto t = node->getComponent<Transform>();
-	// Dirty Matrix?
-	auto h = node->getComponent<HierarchyComponent>();
+void
+SceneGraph::syncSpatialIndex() {
+	SpatialIndex& index = spatialIndex();
+	index.resetCounters();
+	uint32_t updates = 0;
+	m_renderQuery->forEachChunk(
+		[this, &index, &updates](const Archetype& archetype, const ArchetypeChunk& chunk) {
+			Entity* const* entities = archetype.entities(chunk);
+			const TransformData* transforms = archetype.transforms(chunk);
+			MeshRendererData* meshRenderers = archetype.meshRenderers(chunk);
+			for (uint32_t row = 0; row < chunk.count; ++row) {
+				MeshRendererData& meshRenderer = meshRenderers[row];
+				const TransformData& transform = transforms[row];
+				const Mesh* mesh = meshRenderer.mesh;
+
+				// Miembros de una jerarquia: su caja entra en la del subarbol y se
+				// cullean con su rama. La world ya marco la caja; falta el cambio de malla
+				// (otra malla o la misma reconstruida por el hot reload).
+				const uint32_t meshRevision = mesh ? mesh->getRevision() : 0;
+				if (branchIndexOf(entities[row]) != UINT32_MAX) {
+					releaseSpatialProxy(meshRenderer);
+					if (meshRenderer.spatialMesh != mesh || meshRenderer.spatialMeshRevision != meshRevision) {
+						m_hierarchy.markBoundsDirty(entities[row]);
+						meshRenderer.spatialMesh = mesh;
+						meshRenderer.spatialMeshRevision = meshRevision;
+					}
+					continue;
+				}
+
+				if (!mesh || !mesh->getBounds().isValid()) {
+					releaseSpatialProxy(meshRenderer);
+					continue;
+				}
+
+				// Solo los proxies cuyo Transform o malla cambiaron
+				if (meshRenderer.spatialProxy != SpatialIndex::kNullProxy &&
+					meshRenderer.spatialVersion == transform.version &&
+					meshRenderer.spatialMesh == mesh &&
+					meshRenderer.spatialMeshRevision == meshRevision) {
+					continue;
+				}
+
+				const Bounds worldBounds = mesh->getBounds().transformed(transform.worldMatrix);
+				if (meshRenderer.spatialProxy == SpatialIndex::kNullProxy) {
+					meshRenderer.spatialProxy = index.createProxy(worldBounds, entities[row]);
+				}
+				else {
+					index.moveProxy(meshRenderer.spatialProxy, worldBounds);
+				}
+				meshRenderer.spatialVersion = transform.version;
+				meshRenderer.spatialMesh = mesh;
+				meshRenderer.spatialMeshRevision = meshRevision;
+				++updates;
+			}
+		});
+
+	m_stats.boundsUpdates = m_hierarchy.updateBounds();
+	m_stats.spatialUpdates = updates;
+	syncBranchProxies(index);
+	m_stats.spatialReinserts = index.getReinsertCount();
+	m_stats.spatialProxies = index.getProxyCount();
+	m_stats.spatialNodes = index.getNodeCount();
+	m_stats.spatialHeight = m_spatialPartition == SpatialPartition::DynamicTree ? m_spatialTree.getHeight() : -1;
+}
 
-	if (!t || !h) {
+void
+SceneGraph::releaseSpatialProxy(MeshRendererData& meshRenderer) {
+	if (meshRenderer.spatialProxy == SpatialIndex::kNullProxy) {
 		return;
 	}
-	// Tu Transform::matrix es LOCAL (S*R*T)
-	// World = Local * ParentWorld
-	auto worldMatrix = t->matrix * parentWorld;
-	t->worldMatrix = worldMatrix;
+	spatialIndex().destroyProxy(meshRenderer.spatialProxy);
+	meshRenderer.spatialProxy = SpatialIndex::kNullProxy;
+	meshRenderer.spatialVersion = UINT32_MAX;
+	meshRenderer.spatialMesh = nullptr;
+}
 
-	for (Entity* c : h->m_children) {
-			updateWorldRecursive(c, worldMatrix);
+void
+SceneGraph::syncBranchProxies(SpatialIndex& index) {
+	const std::vector<Entity*>& nodes = m_hierarchy.getEntities();
+	const std::vector<uint32_t>& subtreeSizes = m_hierarchy.getSubtreeSizes();
+	const std::vector<Bounds>& subtreeBounds = m_hierarchy.getSubtreeBounds();
+
+	// Solo las raices: cada salto pasa al siguiente subarbol de nivel 0.
+	size_t branches = 0;
+	for (size_t i = 0; i < nodes.size(); i += subtreeSizes[i]) {
+		HierarchyComponent* hierarchy = nodes[i]->getComponent<HierarchyComponent>();
+		if (subtreeSizes[i] == 1 || !subtreeBounds[i].isValid()) {
+			releaseBranchProxy(nodes[i]);
+			continue;
+		}
+
+		++branches;
+		if (hierarchy->m_spatialProxy != SpatialIndex::kNullProxy &&
+			hierarchy->m_spatialVersion == hierarchy->m_boundsVersion) {
+			continue;
+		}
+		if (hierarchy->m_spatialProxy == SpatialIndex::kNullProxy) {
+			hierarchy->m_spatialProxy = index.createProxy(subtreeBounds[i], nodes[i]);
+		}
+		else {
+			index.moveProxy(hierarchy->m_spatialProxy, subtreeBounds[i]);
+		}
+		hierarchy->m_spatialVersion = hierarchy->m_boundsVersion;
+		++m_stats.spatialUpdates;
+	}
+	m_stats.branchProxies = branches;
+}
+
+void
+SceneGraph::releaseBranchProxy(Entity* e) {
+	HierarchyComponent* hierarchy = e ? e->getComponent<HierarchyComponent>() : nullptr;
+	if (!hierarchy || hierarchy->m_spatialProxy == SpatialIndex::kNullProxy) {
+		return;
 	}
+	spatialIndex().destroyProxy(hierarchy->m_spatialProxy);
+	hierarchy->m_spatialProxy = SpatialIndex::kNullProxy;
+	hierarchy->m_spatialVersion = UINT32_MAX;
+}
+
+uint32_t
+SceneGraph::branchIndexOf(const Entity* e) const {
+	const HierarchyComponent* hierarchy = e->getComponent<HierarchyComponent>();
+	if (!hierarchy || hierarchy->m_flatIndex >= m_hierarchy.size() ||
+		!m_hierarchy.isBranchMember(hierarchy->m_flatIndex)) {
+		return UINT32_MAX;
+	}
+	return hierarchy->m_flatIndex;
+}
+
+bool
+SceneGraph::raycast(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, RaycastHit& outHit) const {
+	const XMVECTOR rayDirection = XMVector3Normalize(XMLoadFloat3(&direction));
+	if (XMVectorGetX(XMVector3LengthSq(rayDirection)) <= 0.0f) {
+		return false;
+	}
+	XMFLOAT3 unitDirection;
+	XMStoreFloat3(&unitDirection, rayDirection);
+	const XMFLOAT3 inverseDirection(1.0f / unitDirection.x, 1.0f / unitDirection.y, 1.0f / unitDirection.z);
+
+	const SpatialIndex& index = getSpatialIndex();
+	std::vector<SpatialRayHit> candidates;
+	index.collectRay(origin, unitDirection, maxDistance, candidates);
+	std::sort(candidates.begin(), candidates.end(),
+		[](const SpatialRayHit& a, const SpatialRayHit& b) { return a.distance < b.distance; });
+
+	RaycastHit best;
+	best.distance = maxDistance;
+	const XMVECTOR rayOrigin = XMLoadFloat3(&origin);
+	const std::vector<Entity*>& nodes = m_hierarchy.getEntities();
+	const std::vector<uint32_t>& subtreeSizes = m_hierarchy.getSubtreeSizes();
+	const std::vector<Bounds>& subtreeBounds = m_hierarchy.getSubtreeBounds();
+	for (const SpatialRayHit& candidate : candidates) {
+		if (candidate.distance > best.distance) {
+			break;
+		}
+
+		Entity* entity = static_cast<Entity*>(index.getUserData(candidate.proxy));
+		const HierarchyComponent* hierarchy = entity->getComponent<HierarchyComponent>();
+		if (!hierarchy || hierarchy->m_spatialProxy != candidate.proxy) {
+			RaycastRenderable(entity, rayOrigin, rayDirection, best);
+			continue;
+		}
+
+		// Rama: solo se desciende en los subarboles cuya caja cruza el rayo antes del mejor impacto
+		const uint32_t root = hierarchy->m_flatIndex;
+		const uint32_t end = root + subtreeSizes[root];
+		for (uint32_t i = root; i < end;) {
+			float tEnter = 0.0f;
+			if (!subtreeBounds[i].isValid() ||
+				!Bounds::rayIntersects(subtreeBounds[i].getMin(), subtreeBounds[i].getMax(),
+				                       origin, inverseDirection, best.distance, tEnter)) {
+				i += subtreeSizes[i];
+				continue;
+			}
+			RaycastRenderable(nodes[i], rayOrigin, rayDirection, best);
+			++i;
+		}
+	}
+
+	if (!best.entity) {
+		outHit.candidatesTested = best.candidatesTested;
+		return false;
+	}
+	XMStoreFloat3(&best.position, XMVectorMultiplyAdd(rayDirection, XMVectorReplicate(best.distance), rayOrigin));
+	outHit = best;
+	return true;
 }
 
 void SceneGraph::render(DeviceContext& deviceContext) {
@@ -219,48 +582,261 @@ void SceneGraph::render(DeviceContext& deviceContext) {
 	}
 }
 
+void
+SceneGraph::gatherLights(RenderScene& outScene) {
+	// Direccionales aparte; las locales toman la posicion de su Transform
+	m_lightQuery->forEachEntity([&outScene](Entity* entity) {
+		LightData light = entity->getComponent<LightComponent>()->getLightData();
+		if (light.type == LightType::Directional) {
+			outScene.directionalLights.push_back(light);
+			return;
+		}
+		if (const Transform* transform = entity->getComponent<Transform>()) {
+			XMFLOAT4X4 world;
+			XMStoreFloat4x4(&world, transform->getData().worldMatrix);
+			light.position = EU::Vector3(world._41, world._42, world._43);
+		}
+		outScene.localLights.push_back(light);
+	});
+	m_stats.lightCount = m_lightQuery->getEntityCount();
+}
+
 void
 SceneGraph::gatherRenderScene(RenderScene& outScene, const Camera& camera) {
-	for (Entity* entity : m_entities)
-	{
-		if (!entity) {
+	const auto begin = std::chrono::high_resolution_clock::now();
+
+	m_gatherCandidates.clear();
+	m_cullBatch.clear();
+	outScene.cameraFrustum.setFromMatrix(camera.getView() * camera.getProj());
+
+	// 1) Indice espacial: proxies cuyo nodo o celda toca el frustum. Los de
+	//    volumenes completamente dentro no necesitan mas pruebas.
+	//    Las ramas de una jerarquia se recorren con la caja de cada subarbol.
+	const SpatialIndex& index = getSpatialIndex();
+	m_proxyReported.assign(index.getProxyCapacity(), 0);
+	m_branchEmitted.assign(m_hierarchy.size(), 0);
+	m_spatialHits.clear();
+	m_stats.spatialNodesTested = index.collectFrustum(outScene.cameraFrustum, m_spatialHits);
+	m_stats.branchNodes = 0;
+	m_stats.branchTested = 0;
+	for (const SpatialHit& hit : m_spatialHits) {
+		m_proxyReported[hit.proxy] = kCameraGather;
+
+		Entity* entity = static_cast<Entity*>(index.getUserData(hit.proxy));
+		const HierarchyComponent* hierarchy = entity->getComponent<HierarchyComponent>();
+		if (hierarchy && hierarchy->m_spatialProxy == hit.proxy) {
+			gatherBranch(hierarchy->m_flatIndex, hit.fullyInside, outScene.cameraFrustum, false);
 			continue;
 		}
 
-		auto lightComponent = entity->getComponent<LightComponent>();
-		if (lightComponent) {
-			outScene.directionalLights.push_back(lightComponent->getLightData());
+		const Transform* transform = entity->getComponent<Transform>();
+		const MeshRendererComponent* meshRenderer = entity->getComponent<MeshRendererComponent>();
+		if (!transform || !meshRenderer || !meshRenderer->getData().visible || !meshRenderer->getData().mesh) {
+			continue;
+		}
+
+		GatherCandidate candidate;
+		candidate.transform = &transform->getData();
+		candidate.meshRenderer = &meshRenderer->getData();
+		candidate.worldBounds = candidate.meshRenderer->mesh->getBounds().transformed(candidate.transform->worldMatrix);
+		if (!hit.fullyInside) {
+			candidate.batchIndex = static_cast<uint32_t>(m_cullBatch.size());
+			m_cullBatch.push(candidate.worldBounds);
 		}
+		m_gatherCandidates.push_back(candidate);
+	}
 
-		auto meshRenderer = entity->getComponent<MeshRendererComponent>();
-		auto transform = entity->getComponent<Transform>();
-		if (!meshRenderer || !transform || !meshRenderer->isVisible()) {
+	// 2) Cajas ajustadas de los proxies que cortan el frustum, en lotes SIMD
+	m_cullVisible.resize(m_cullBatch.size());
+	const size_t batchVisible = outScene.cameraFrustum.cull(m_cullBatch, m_cullVisible.data());
+	for (GatherCandidate& candidate : m_gatherCandidates) {
+		if (candidate.batchIndex != UINT32_MAX) {
+			candidate.inFrustum = m_cullVisible[candidate.batchIndex] != 0;
+		}
+	}
+	size_t frustumCulled = m_cullBatch.size() - batchVisible;
+
+	// 2b) Casters fuera de camara: solo los proxies que tocan algun volumen de
+	//     sombra. Cada cascada los vuelve a cullear con el suyo en el renderer.
+	const size_t cameraCandidates = m_gatherCandidates.size();
+	for (const Frustum& volume : outScene.shadowCasterVolumes) {
+		m_spatialHits.clear();
+		index.collectFrustum(volume, m_spatialHits);
+		for (const SpatialHit& hit : m_spatialHits) {
+			Entity* entity = static_cast<Entity*>(index.getUserData(hit.proxy));
+			const HierarchyComponent* hierarchy = entity->getComponent<HierarchyComponent>();
+			if (hierarchy && hierarchy->m_spatialProxy == hit.proxy) {
+				// La camara pudo ver solo parte de la rama: se recorre con cada volumen
+				gatherBranch(hierarchy->m_flatIndex, hit.fullyInside, volume, true);
+				continue;
+			}
+			if (m_proxyReported[hit.proxy]) {
+				continue;
+			}
+			m_proxyReported[hit.proxy] = kShadowGather;
+
+			const Transform* transform = entity->getComponent<Transform>();
+			const MeshRendererComponent* meshRenderer = entity->getComponent<MeshRendererComponent>();
+			if (!transform || !meshRenderer || !meshRenderer->getData().visible ||
+				!meshRenderer->getData().mesh || !meshRenderer->getData().castShadow) {
+				continue;
+			}
+
+			GatherCandidate candidate;
+			candidate.transform = &transform->getData();
+			candidate.meshRenderer = &meshRenderer->getData();
+			candidate.worldBounds = candidate.meshRenderer->mesh->getBounds().transformed(candidate.transform->worldMatrix);
+			candidate.inFrustum = false;
+			if (!hit.fullyInside && volume.classify(candidate.worldBounds) == Frustum::Containment::Outside) {
+				continue;
+			}
+			m_gatherCandidates.push_back(candidate);
+		}
+	}
+	m_stats.shadowCasters = m_gatherCandidates.size() - cameraCandidates;
+
+	// 3) Resto de renderables: los que no tienen caja son siempre visibles; los
+	//    demas ya salieron de las consultas y aqui solo se cuentan los descartados
+	const std::vector<Bounds>& ownBounds = m_hierarchy.getOwnBounds();
+	m_renderQuery->forEachChunk(
+		[this, &ownBounds, &frustumCulled](const Archetype& archetype, const ArchetypeChunk& chunk) {
+			Entity* const* entities = archetype.entities(chunk);
+			const TransformData* transforms = archetype.transforms(chunk);
+			const MeshRendererData* meshRenderers = archetype.meshRenderers(chunk);
+			for (uint32_t row = 0; row < chunk.count; ++row) {
+				const MeshRendererData& meshRenderer = meshRenderers[row];
+				// Sin malla no hay nada que dibujar ni que rasterizar como oclusor
+				if (!meshRenderer.visible || !meshRenderer.mesh) {
+					continue;
+				}
+
+				// Miembro de una rama que la camara no agrego: descartado con su
+				// subarbol (quiza agregado como caster), o sin caja propia (siempre visible)
+				const uint32_t node = branchIndexOf(entities[row]);
+				if (node != UINT32_MAX) {
+					if (m_branchEmitted[node] == kCameraGather) {
+						continue;
+					}
+					if (ownBounds[node].isValid()) {
+						++frustumCulled;
+						continue;
+					}
+					GatherCandidate candidate;
+					candidate.transform = &transforms[row];
+					candidate.meshRenderer = &meshRenderer;
+					m_gatherCandidates.push_back(candidate);
+					continue;
+				}
+
+				const int32_t proxy = meshRenderer.spatialProxy;
+				if (proxy != SpatialIndex::kNullProxy) {
+					if (static_cast<size_t>(proxy) >= m_proxyReported.size() || m_proxyReported[proxy] != kCameraGather) {
+						++frustumCulled;
+					}
+					continue;
+				}
+
+				GatherCandidate candidate;
+				candidate.transform = &transforms[row];
+				candidate.meshRenderer = &meshRenderer;
+				m_gatherCandidates.push_back(candidate);
+			}
+		});
+
+	// 3b) Oclusion en CPU: los oclusores dentro del frustum se rasterizan y las
+	//     cajas que quedan detras dejan de ser visibles (siguen como sombreadores)
+	m_stats.occluders = 0;
+	m_stats.occlusionTested = 0;
+	m_stats.occlusionCulled = 0;
+	m_stats.occlusionUs = 0;
+	if (m_occlusionCulling) {
+		const auto occlusionBegin = std::chrono::high_resolution_clock::now();
+		m_occlusionBuffer.begin(camera.getView() * camera.getProj());
+		for (const GatherCandidate& candidate : m_gatherCandidates) {
+			const MeshRendererData& meshRenderer = *candidate.meshRenderer;
+			if (!candidate.inFrustum || !meshRenderer.occluder || !meshRenderer.mesh->getTriangleBVH()) {
+				continue;
+			}
+			// Un oclusor transparente no tapa lo que hay detras
+			const MaterialInstance* material = meshRenderer.materialInstance;
+			if (material && material->getMaterial() &&
+				material->getMaterial()->getDomain() == MaterialDomain::Transparent) {
+				continue;
+			}
+			m_occlusionBuffer.addOccluder(*meshRenderer.mesh->getTriangleBVH(), candidate.transform->worldMatrix);
+		}
+
+		m_stats.occluders = m_occlusionBuffer.getStats().occluders;
+		if (m_stats.occluders > 0) {
+			JobSystem& jobs = JobSystem::getInstance();
+			m_occlusionBuffer.rasterize(&jobs);
+
+			// Cada job escribe solo sus candidatos; el buffer es de solo lectura aqui
+			std::atomic<size_t> tested{ 0 };
+			std::atomic<size_t> culled{ 0 };
+			jobs.parallelFor(m_gatherCandidates.size(), 256, [this, &tested, &culled](size_t first, size_t last) {
+				size_t localTested = 0;
+				size_t localCulled = 0;
+				for (size_t i = first; i < last; ++i) {
+					GatherCandidate& candidate = m_gatherCandidates[i];
+					if (!candidate.inFrustum || !candidate.worldBounds.isValid()) {
+						continue;
+					}
+					++localTested;
+					if (!m_occlusionBuffer.isVisible(candidate.worldBounds)) {
+						candidate.inFrustum = false;
+						++localCulled;
+					}
+				}
+				tested += localTested;
+				culled += localCulled;
+			});
+			m_stats.occlusionTested = tested;
+			m_stats.occlusionCulled = culled;
+		}
+		m_stats.occlusionUs = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::high_resolution_clock::now() - occlusionBegin).count();
+	}
+
+	// 4) RenderObjects: los opacos fuera de camara se conservan solo si proyectan sombra.
+	//    Los materiales se copian al arena del frame: el componente puede cambiarlos
+	//    (inspector, recarga) antes de que el renderer los lea.
+	const EU::Vector3 cameraPos = camera.getPosition();
+	EU::LinearArena& frameArena = outScene.getFrameArena();
+	for (const GatherCandidate& candidate : m_gatherCandidates) {
+		const MeshRendererData& meshRenderer = *candidate.meshRenderer;
+		const bool inFrustum = candidate.inFrustum;
+
+		MaterialDomain domain = MaterialDomain::Opaque;
+		if (meshRenderer.materialInstance &&
+			meshRenderer.materialInstance->getMaterial()) {
+			domain = meshRenderer.materialInstance->getMaterial()->getDomain();
+		}
+		const bool transparent = (domain == MaterialDomain::Transparent);
+		if (!inFrustum && (transparent || !meshRenderer.castShadow)) {
 			continue;
 		}
 
+		const TransformData& transform = *candidate.transform;
 		RenderObject renderObject{};
-		renderObject.mesh = meshRenderer->getMesh();
-		renderObject.materialInstance = meshRenderer->getMaterialInstance();
-		renderObject.materialInstances = meshRenderer->getMaterialInstances();
-		renderObject.world = transform->worldMatrix;
-		renderObject.castShadow = meshRenderer->canCastShadow();
+		renderObject.mesh = meshRenderer.mesh;
+		renderObject.materialInstance = meshRenderer.materialInstance;
+		renderObject.materialInstances = frameArena.copy(meshRenderer.materialInstances->data(),
+			meshRenderer.materialInstances->size());
+		renderObject.world = transform.worldMatrix;
+		renderObject.worldBounds = candidate.worldBounds;
+		renderObject.castShadow = meshRenderer.castShadow;
+		renderObject.staticShadow = meshRenderer.isStatic;
+		renderObject.cameraVisible = inFrustum;
+		renderObject.transparent = transparent;
 
-		EU::Vector3 cameraPos = camera.getPosition();
 		XMFLOAT4X4 worldMatrix{};
-		XMStoreFloat4x4(&worldMatrix, transform->worldMatrix);
-		EU::Vector3 objectPos = EU::Vector3(worldMatrix._41, worldMatrix._42, worldMatrix._43);
-		float dx = objectPos.x - cameraPos.x;
-		float dy = objectPos.y - cameraPos.y;
-		float dz = objectPos.z - cameraPos.z;
+		XMStoreFloat4x4(&worldMatrix, transform.worldMatrix);
+		float dx = worldMatrix._41 - cameraPos.x;
+		float dy = worldMatrix._42 - cameraPos.y;
+		float dz = worldMatrix._43 - cameraPos.z;
 		renderObject.distanceToCamera = dx * dx + dy * dy + dz * dz;
 
-		MaterialDomain domain = MaterialDomain::Opaque;
-		if (renderObject.materialInstance &&
-			renderObject.materialInstance->getMaterial()) {
-			domain = renderObject.materialInstance->getMaterial()->getDomain();
-		}
-
-		renderObject.transparent = (domain == MaterialDomain::Transparent);
 		if (renderObject.transparent) {
 			outScene.transparentObjects.push_back(renderObject);
 		}
@@ -268,7 +844,69 @@ SceneGraph::gatherRenderScene(RenderScene& outScene, const Camera& camera) {
 			outScene.opaqueObjects.push_back(renderObject);
 		}
 	}
+
+	m_stats.gatherUs = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::high_resolution_clock::now() - begin).count();
+	m_stats.renderableCount = m_renderQuery->getEntityCount();
+	m_stats.frustumTested = m_cullBatch.size();
+	m_stats.frustumCulled = frustumCulled;
 }
 
+void
+SceneGraph::gatherBranch(uint32_t root, bool fullyInside, const Frustum& frustum, bool shadowCasters) {
+	const std::vector<Entity*>& nodes = m_hierarchy.getEntities();
+	const std::vector<uint32_t>& subtreeSizes = m_hierarchy.getSubtreeSizes();
+	const std::vector<Bounds>& ownBounds = m_hierarchy.getOwnBounds();
+	const std::vector<Bounds>& subtreeBounds = m_hierarchy.getSubtreeBounds();
+
+	// Los nodos por debajo de insideEnd estan en un subarbol completamente dentro.
+	const uint32_t end = root + subtreeSizes[root];
+	uint32_t insideEnd = fullyInside ? end : root;
+	m_stats.branchNodes += subtreeSizes[root];
+	for (uint32_t i = root; i < end;) {
+		bool inFrustum = true;
+		if (i >= insideEnd) {
+			// Subarbol sin cajas: sus renderables son siempre visibles y los agrega el paso 3
+			if (!subtreeBounds[i].isValid()) {
+				i += subtreeSizes[i];
+				continue;
+			}
+
+			++m_stats.branchTested;
+			const Frustum::Containment containment = frustum.classify(subtreeBounds[i]);
+			if (containment == Frustum::Containment::Outside) {
+				i += subtreeSizes[i];
+				continue;
+			}
+			if (containment == Frustum::Containment::Inside) {
+				insideEnd = i + subtreeSizes[i];
+			}
+			else if (subtreeSizes[i] > 1 && ownBounds[i].isValid()) {
+				// El subarbol corta el frustum: la caja propia de un nodo interior se prueba aparte
+				++m_stats.branchTested;
+				inFrustum = frustum.classify(ownBounds[i]) != Frustum::Containment::Outside;
+			}
+		}
 
+		const uint32_t node = i++;
+		if (!inFrustum || !ownBounds[node].isValid() || m_branchEmitted[node]) {
+			continue;
+		}
+		const Transform* transform = nodes[node]->getComponent<Transform>();
+		const MeshRendererComponent* meshRenderer = nodes[node]->getComponent<MeshRendererComponent>();
+		if (!transform || !meshRenderer || !meshRenderer->getData().visible || !meshRenderer->getData().mesh) {
+			continue;
+		}
+		if (shadowCasters && !meshRenderer->getData().castShadow) {
+			continue;
+		}
 
+		GatherCandidate candidate;
+		candidate.transform = &transform->getData();
+		candidate.meshRenderer = &meshRenderer->getData();
+		candidate.worldBounds = ownBounds[node];
+		candidate.inFrustum = !shadowCasters;
+		m_gatherCandidates.push_back(candidate);
+		m_branchEmitted[node] = shadowCasters ? kShadowGather : kCameraGather;
+	}
+}
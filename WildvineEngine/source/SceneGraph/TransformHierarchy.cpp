@@ -0,0 +1,454 @@
+/**
+ * @file TransformHierarchy.cpp
+ * @brief Implementa la logica de TransformHierarchy dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ */
+#include "SceneGraph/TransformHierarchy.h"
+#include "SceneGraph/HierarchyComponent.h"
+#include "ECS/Entity.h"
+#include "ECS/Transform.h"
+#include "ECS/MeshRendererComponent.h"
+#include "Rendering/Mesh.h"
+#include "EngineUtilities/Utilities/JobSystem.h"
+#include <algorithm>
+
+namespace {
+constexpr uint32_t kInvalidIndex = static_cast<uint32_t>(-1);
+
+uint32_t
+FlatIndexOf(Entity* entity) {
+	HierarchyComponent* hierarchy = entity ? entity->getComponent<HierarchyComponent>() : nullptr;
+	return hierarchy ? hierarchy->m_flatIndex : kInvalidIndex;
+}
+
+void
+SetFlatIndex(Entity* entity, uint32_t index) {
+	if (HierarchyComponent* hierarchy = entity->getComponent<HierarchyComponent>()) {
+		hierarchy->m_flatIndex = index;
+	}
+}
+}
+
+void
+TransformHierarchy::add(Entity* entity) {
+	Transform* transform = entity ? entity->getComponent<Transform>() : nullptr;
+	if (!transform || FlatIndexOf(entity) != kInvalidIndex) {
+		return;
+	}
+
+	SetFlatIndex(entity, static_cast<uint32_t>(m_entities.size()));
+	m_entities.push_back(entity);
+	m_transforms.push_back(transform);
+	m_parents.push_back(kNoParent);
+	m_subtreeSizes.push_back(1);
+	m_world.push_back(transform->getWorldMatrix());
+	m_changed.push_back(0);
+	m_ownBounds.emplace_back();
+	m_subtreeBounds.emplace_back();
+	m_boundsDirty.push_back(kOwnBoundsDirty);
+	++m_liveCount;
+	m_levelsDirty = true;
+	// La world se recalcula en el proximo updateWorld().
+	transform->markWorldDirty();
+}
+
+void
+TransformHierarchy::remove(Entity* entity) {
+	if (!contains(entity)) {
+		return;
+	}
+
+	const uint32_t index = FlatIndexOf(entity);
+	const int32_t parent = m_parents[index];
+	const uint32_t end = index + m_subtreeSizes[index];
+	for (uint32_t child = index + 1; child < end;) {
+		// Las lapidas del rango tienen tamano 1 y no cuelgan de nadie
+		const uint32_t next = child + m_subtreeSizes[child];
+		if (m_parents[child] == static_cast<int32_t>(index)) {
+			if (parent == kNoParent) {
+				// Hijos de una raiz: ya forman rangos de nivel 0 en su sitio
+				m_parents[child] = kNoParent;
+				m_transforms[child]->markWorldDirty();
+			}
+			else {
+				detachNode(child);
+			}
+		}
+		child = next;
+	}
+
+	if (parent != kNoParent) {
+		m_boundsDirty[parent] |= kChildBoundsDirty;
+	}
+	SetFlatIndex(entity, kInvalidIndex);
+	clearSlot(index);
+	--m_liveCount;
+	m_levelsDirty = true;
+	compactIfSparse();
+}
+
+void
+TransformHierarchy::attach(Entity* child, Entity* parent) {
+	if (!contains(child) || !contains(parent)) {
+		return;
+	}
+	if (m_parents[FlatIndexOf(child)] != kNoParent) {
+		detachNode(FlatIndexOf(child));
+	}
+
+	uint32_t childIndex = FlatIndexOf(child);
+	uint32_t parentIndex = FlatIndexOf(parent);
+	const uint32_t subtreeSize = m_subtreeSizes[childIndex];
+	const uint32_t parentEnd = parentIndex + m_subtreeSizes[parentIndex];
+
+	if (childIndex != parentEnd) {
+		if (parentEnd == m_entities.size()) {
+			// Borde derecho del ultimo arbol (el rango de su raiz tambien llega al
+			// final): basta con copiar el subarbol detras
+			const Segment segment = { childIndex, subtreeSize };
+			childIndex = appendSegments(&segment, 1);
+		}
+		else {
+			// Raiz del arbol del padre: O(profundidad)
+			uint32_t root = parentIndex;
+			while (m_parents[root] != kNoParent) {
+				root = static_cast<uint32_t>(m_parents[root]);
+			}
+			const uint32_t rootEnd = root + m_subtreeSizes[root];
+
+			// El arbol del padre se copia al final con el subarbol insertado
+			const Segment segments[3] = {
+				{ root, parentEnd - root },
+				{ childIndex, subtreeSize },
+				{ parentEnd, rootEnd - parentEnd },
+			};
+			const uint32_t base = appendSegments(segments, 3);
+			parentIndex = base + (parentIndex - root);
+			childIndex = base + (parentEnd - root);
+		}
+	}
+
+	m_parents[childIndex] = static_cast<int32_t>(parentIndex);
+	adjustSubtreeSizes(static_cast<int32_t>(parentIndex), static_cast<int32_t>(subtreeSize));
+	m_levelsDirty = true;
+	m_transforms[childIndex]->markWorldDirty();
+	compactIfSparse();
+}
+
+void
+TransformHierarchy::detach(Entity* child) {
+	if (!contains(child)) {
+		return;
+	}
+	const uint32_t childIndex = FlatIndexOf(child);
+	if (m_parents[childIndex] == kNoParent) {
+		return;
+	}
+	detachNode(childIndex);
+	compactIfSparse();
+}
+
+void
+TransformHierarchy::detachNode(uint32_t index) {
+	// Los ancestros conservan su tamano: el rango viejo queda lleno de lapidas
+	m_boundsDirty[m_parents[index]] |= kChildBoundsDirty;
+	const Segment segment = { index, m_subtreeSizes[index] };
+	const uint32_t newIndex = appendSegments(&segment, 1);
+	m_parents[newIndex] = kNoParent;
+	m_levelsDirty = true;
+	m_transforms[newIndex]->markWorldDirty();
+}
+
+bool
+TransformHierarchy::isAncestor(Entity* ancestor, Entity* node) const {
+	return ancestor != node && isInSubtree(ancestor, node);
+}
+
+bool
+TransformHierarchy::isInSubtree(Entity* root, Entity* node) const {
+	if (!contains(root) || !contains(node)) {
+		return false;
+	}
+	const uint32_t rootIndex = FlatIndexOf(root);
+	const uint32_t nodeIndex = FlatIndexOf(node);
+	return nodeIndex >= rootIndex && nodeIndex < rootIndex + m_subtreeSizes[rootIndex];
+}
+
+bool
+TransformHierarchy::contains(Entity* entity) const {
+	const uint32_t index = FlatIndexOf(entity);
+	return index < m_entities.size() && m_entities[index] == entity;
+}
+
+void
+TransformHierarchy::clear() {
+	for (Entity* entity : m_entities) {
+		SetFlatIndex(entity, kInvalidIndex);
+	}
+	m_entities.clear();
+	m_transforms.clear();
+	m_parents.clear();
+	m_subtreeSizes.clear();
+	m_depths.clear();
+	m_world.clear();
+	m_changed.clear();
+	m_ownBounds.clear();
+	m_subtreeBounds.clear();
+	m_boundsDirty.clear();
+	m_levelNodes.clear();
+	m_levelOffsets.clear();
+	m_liveCount = 0;
+	m_levelsDirty = true;
+}
+
+void
+TransformHierarchy::compact() {
+	const size_t count = m_entities.size();
+	if (m_liveCount == count) {
+		return;
+	}
+
+	// m_remap[i]: slots vivos antes de i; sirve para indices y para fines de rango
+	m_remap.resize(count + 1);
+	uint32_t live = 0;
+	for (size_t i = 0; i < count; ++i) {
+		m_remap[i] = live;
+		live += m_entities[i] ? 1 : 0;
+	}
+	m_remap[count] = live;
+
+	// El destino nunca supera al origen: se puede mover hacia delante en el sitio
+	for (uint32_t i = 0; i < count; ++i) {
+		if (!m_entities[i]) {
+			continue;
+		}
+		const uint32_t target = m_remap[i];
+		const int32_t parent = m_parents[i];
+		const uint32_t end = i + m_subtreeSizes[i];
+		m_entities[target] = m_entities[i];
+		m_transforms[target] = m_transforms[i];
+		m_parents[target] = parent == kNoParent ? kNoParent : static_cast<int32_t>(m_remap[parent]);
+		m_subtreeSizes[target] = m_remap[end] - target;
+		m_world[target] = m_world[i];
+		m_changed[target] = m_changed[i];
+		m_ownBounds[target] = m_ownBounds[i];
+		m_subtreeBounds[target] = m_subtreeBounds[i];
+		m_boundsDirty[target] = m_boundsDirty[i];
+		SetFlatIndex(m_entities[target], target);
+	}
+
+	m_entities.resize(live);
+	m_transforms.resize(live);
+	m_parents.resize(live);
+	m_subtreeSizes.resize(live);
+	m_world.resize(live);
+	m_changed.resize(live);
+	m_ownBounds.resize(live);
+	m_subtreeBounds.resize(live);
+	m_boundsDirty.resize(live);
+	m_levelsDirty = true;
+}
+
+bool
+TransformHierarchy::updateNode(size_t index) {
+	Transform* transform = m_transforms[index];
+	const int32_t parent = m_parents[index];
+
+	// El padre ya se proceso: su indice es menor y su nivel anterior.
+	const bool changed = transform->isWorldDirty() || (parent != kNoParent && m_changed[parent]);
+	m_changed[index] = changed ? 1 : 0;
+	if (!changed) {
+		return false;
+	}
+
+	// World = Local * ParentWorld
+	m_world[index] = parent == kNoParent ? transform->getLocalMatrix()
+	                                     : transform->getLocalMatrix() * m_world[parent];
+	transform->setWorldMatrix(m_world[index]);
+	m_boundsDirty[index] |= kOwnBoundsDirty;
+	return true;
+}
+
+uint32_t
+TransformHierarchy::updateWorld(JobSystem* jobs) {
+	compact();
+	const size_t count = m_entities.size();
+	if (!jobs || jobs->getWorkerCount() == 0 || count < kParallelMinNodes) {
+		uint32_t updated = 0;
+		for (size_t i = 0; i < count; ++i) {
+			updated += updateNode(i) ? 1 : 0;
+		}
+		return updated;
+	}
+
+	if (m_levelsDirty) {
+		rebuildLevels();
+	}
+
+	// Cada nivel se reparte entre los workers; parallelFor espera antes del siguiente.
+	std::atomic<uint32_t> updated{ 0 };
+	for (size_t level = 0; level + 1 < m_levelOffsets.size(); ++level) {
+		const uint32_t* nodes = m_levelNodes.data() + m_levelOffsets[level];
+		const size_t levelSize = m_levelOffsets[level + 1] - m_levelOffsets[level];
+		jobs->parallelFor(levelSize, kParallelGrain, [this, nodes, &updated](size_t begin, size_t end) {
+			uint32_t local = 0;
+			for (size_t i = begin; i < end; ++i) {
+				local += updateNode(nodes[i]) ? 1 : 0;
+			}
+			updated += local;
+		});
+	}
+	return updated;
+}
+
+uint32_t
+TransformHierarchy::updateBounds() {
+	compact();
+	// Pasada inversa: cuando se procesa un nodo, sus hijos ya tienen su caja final.
+	uint32_t updated = 0;
+	for (size_t i = m_entities.size(); i-- > 0;) {
+		const uint8_t dirty = m_boundsDirty[i];
+		if (!dirty) {
+			continue;
+		}
+		m_boundsDirty[i] = 0;
+
+		if (dirty & kOwnBoundsDirty) {
+			const MeshRendererComponent* meshRenderer = m_entities[i]->getComponent<MeshRendererComponent>();
+			const Mesh* mesh = meshRenderer ? meshRenderer->getData().mesh : nullptr;
+			m_ownBounds[i] = mesh ? mesh->getBounds().transformed(m_world[i]) : Bounds{};
+		}
+
+		// Hijos directos: el primero sigue al nodo y cada uno salta su subarbol.
+		Bounds subtree = m_ownBounds[i];
+		const size_t end = i + m_subtreeSizes[i];
+		for (size_t child = i + 1; child < end; child += m_subtreeSizes[child]) {
+			subtree.merge(m_subtreeBounds[child]);
+		}
+		m_subtreeBounds[i] = subtree;
+		if (HierarchyComponent* hierarchy = m_entities[i]->getComponent<HierarchyComponent>()) {
+			hierarchy->m_subtreeBounds = subtree;
+			++hierarchy->m_boundsVersion;
+		}
+		if (m_parents[i] != kNoParent) {
+			m_boundsDirty[m_parents[i]] |= kChildBoundsDirty;
+		}
+		++updated;
+	}
+	return updated;
+}
+
+void
+TransformHierarchy::markBoundsDirty(Entity* entity) {
+	if (contains(entity)) {
+		m_boundsDirty[FlatIndexOf(entity)] |= kOwnBoundsDirty;
+	}
+}
+
+void
+TransformHierarchy::rebuildLevels() {
+	// Preorden: el padre ya tiene su profundidad cuando se llega al hijo
+	const size_t count = m_entities.size();
+	m_depths.resize(count);
+	uint32_t levelCount = 0;
+	for (size_t i = 0; i < count; ++i) {
+		m_depths[i] = m_parents[i] == kNoParent ? 0 : m_depths[m_parents[i]] + 1;
+		levelCount = (std::max)(levelCount, m_depths[i] + 1);
+	}
+
+	m_levelOffsets.assign(levelCount + 1, 0);
+	for (uint32_t depth : m_depths) {
+		++m_levelOffsets[depth + 1];
+	}
+	for (uint32_t level = 0; level < levelCount; ++level) {
+		m_levelOffsets[level + 1] += m_levelOffsets[level];
+	}
+
+	// Recorrer en orden de indice deja cada nivel ordenado: accesos casi secuenciales.
+	std::vector<uint32_t> cursor(m_levelOffsets.begin(), m_levelOffsets.end() - 1);
+	m_levelNodes.resize(m_depths.size());
+	for (uint32_t i = 0; i < m_depths.size(); ++i) {
+		m_levelNodes[cursor[m_depths[i]]++] = i;
+	}
+	m_levelsDirty = false;
+}
+
+uint32_t
+TransformHierarchy::appendSegments(const Segment* segments, size_t segmentCount) {
+	const uint32_t base = static_cast<uint32_t>(m_entities.size());
+	uint32_t total = 0;
+	for (size_t s = 0; s < segmentCount; ++s) {
+		total += segments[s].count;
+	}
+
+	// Se redimensiona antes de copiar: las referencias al origen siguen validas
+	const size_t newSize = base + total;
+	m_entities.resize(newSize);
+	m_transforms.resize(newSize);
+	m_parents.resize(newSize);
+	m_subtreeSizes.resize(newSize);
+	m_world.resize(newSize);
+	m_changed.resize(newSize);
+	m_ownBounds.resize(newSize);
+	m_subtreeBounds.resize(newSize);
+	m_boundsDirty.resize(newSize);
+
+	auto remap = [&](int32_t index) -> int32_t {
+		uint32_t offset = base;
+		for (size_t s = 0; s < segmentCount; ++s) {
+			const uint32_t first = segments[s].first;
+			if (index >= static_cast<int32_t>(first) && index < static_cast<int32_t>(first + segments[s].count)) {
+				return static_cast<int32_t>(offset + (index - first));
+			}
+			offset += segments[s].count;
+		}
+		return index;
+	};
+
+	uint32_t target = base;
+	for (size_t s = 0; s < segmentCount; ++s) {
+		for (uint32_t i = segments[s].first; i < segments[s].first + segments[s].count; ++i, ++target) {
+			m_entities[target] = m_entities[i];
+			m_transforms[target] = m_transforms[i];
+			m_parents[target] = m_parents[i] == kNoParent ? kNoParent : remap(m_parents[i]);
+			m_subtreeSizes[target] = m_subtreeSizes[i];
+			m_world[target] = m_world[i];
+			m_changed[target] = m_changed[i];
+			m_ownBounds[target] = m_ownBounds[i];
+			m_subtreeBounds[target] = m_subtreeBounds[i];
+			m_boundsDirty[target] = m_boundsDirty[i];
+			if (m_entities[target]) {
+				SetFlatIndex(m_entities[target], target);
+			}
+			clearSlot(i);
+		}
+	}
+	return base;
+}
+
+void
+TransformHierarchy::clearSlot(uint32_t index) {
+	m_entities[index] = nullptr;
+	m_transforms[index] = nullptr;
+	m_parents[index] = kNoParent;
+	m_subtreeSizes[index] = 1;
+	m_changed[index] = 0;
+	m_ownBounds[index] = Bounds{};
+	m_subtreeBounds[index] = Bounds{};
+	m_boundsDirty[index] = 0;
+}
+
+void
+TransformHierarchy::compactIfSparse() {
+	if (m_entities.size() > 2 * m_liveCount) {
+		compact();
+	}
+}
+
+void
+TransformHierarchy::adjustSubtreeSizes(int32_t node, int32_t delta) {
+	while (node != kNoParent) {
+		m_subtreeSizes[node] = static_cast<uint32_t>(static_cast<int32_t>(m_subtreeSizes[node]) + delta);
+		node = m_parents[node];
+	}
+}
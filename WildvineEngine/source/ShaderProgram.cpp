@@ -254,3 +254,12 @@ ShaderProgram::destroy() {
 	SAFE_RELEASE(m_pixelShaderData);
 }
 
+void
+ShaderProgram::swap(ShaderProgram& other) {
+	std::swap(m_VertexShader, other.m_VertexShader);
+	std::swap(m_PixelShader, other.m_PixelShader);
+	std::swap(m_inputLayout.m_inputLayout, other.m_inputLayout.m_inputLayout);
+	std::swap(m_shaderFileName, other.m_shaderFileName);
+	std::swap(m_vertexShaderData, other.m_vertexShaderData);
+	std::swap(m_pixelShaderData, other.m_pixelShaderData);
+}
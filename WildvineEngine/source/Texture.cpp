@@ -8,6 +8,8 @@
 #include "Texture.h"
 #include "Device.h"
 #include "DeviceContext.h"
+#include "AssetArchive.h"
+#include "AssetPreloader.h"
 #include <cstdint>
 #include <fstream>
 
@@ -18,7 +20,8 @@ constexpr uint32_t kTextureCacheVersion = 1;
 struct CachedTextureData {
   int width = 0;
   int height = 0;
-  std::vector<unsigned char> rgba;
+  std::vector<unsigned char> fileData;    ///< Contenido del .wvtx suelto (vacio si viene del archivo).
+  const unsigned char* rgba = nullptr;    ///< Pixeles dentro de fileData o de la vista mapeada del .wvpak.
 };
 
 bool GetFileWriteTime(const std::string& path, ULONGLONG& outWriteTime) {
@@ -66,22 +69,16 @@ bool SaveTextureCache(const std::string& cachePath, int width, int height, const
   return stream.good();
 }
 
-bool LoadTextureCache(const std::string& cachePath, CachedTextureData& outTexture) {
-  std::ifstream stream(cachePath, std::ios::binary);
-  if (!stream.is_open()) {
-    return false;
-  }
-
+bool ParseTextureCache(const unsigned char* data, size_t size, CachedTextureData& outTexture) {
+  MemoryReader reader(data, size);
   uint32_t magic = 0;
   uint32_t version = 0;
   uint32_t dataSize = 0;
-  stream.read(reinterpret_cast<char*>(&magic), sizeof(magic));
-  stream.read(reinterpret_cast<char*>(&version), sizeof(version));
-  stream.read(reinterpret_cast<char*>(&outTexture.width), sizeof(outTexture.width));
-  stream.read(reinterpret_cast<char*>(&outTexture.height), sizeof(outTexture.height));
-  stream.read(reinterpret_cast<char*>(&dataSize), sizeof(dataSize));
-
-  if (!stream.good() ||
+  if (!reader.read(magic) ||
+      !reader.read(version) ||
+      !reader.read(outTexture.width) ||
+      !reader.read(outTexture.height) ||
+      !reader.read(dataSize) ||
       magic != kTextureCacheMagic ||
       version != kTextureCacheVersion ||
       outTexture.width <= 0 ||
@@ -90,9 +87,49 @@ bool LoadTextureCache(const std::string& cachePath, CachedTextureData& outTextur
     return false;
   }
 
-  outTexture.rgba.resize(dataSize);
-  stream.read(reinterpret_cast<char*>(outTexture.rgba.data()), dataSize);
-  return stream.good();
+  if (static_cast<size_t>(reader.end - reader.cursor) < dataSize) {
+    return false;
+  }
+  // Sin copia: se sube directamente desde el buffer de origen.
+  outTexture.rgba = reader.cursor;
+  return true;
+}
+
+bool LoadTextureCache(const std::string& cachePath, CachedTextureData& outTexture) {
+  if (AssetPreloader::getInstance().consume(cachePath, outTexture.fileData)) {
+    return ParseTextureCache(outTexture.fileData.data(), outTexture.fileData.size(), outTexture);
+  }
+
+  std::ifstream stream(cachePath, std::ios::binary | std::ios::ate);
+  if (!stream.is_open()) {
+    return false;
+  }
+
+  const std::streamsize size = stream.tellg();
+  stream.seekg(0, std::ios::beg);
+  if (size <= 0) {
+    return false;
+  }
+  outTexture.fileData.resize(static_cast<size_t>(size));
+  if (!stream.read(reinterpret_cast<char*>(outTexture.fileData.data()), size).good()) {
+    return false;
+  }
+  return ParseTextureCache(outTexture.fileData.data(), outTexture.fileData.size(), outTexture);
+}
+
+// Busca el cache en el .wvpak montado; vigente si el fuente no existe o no cambio.
+bool LoadTextureCacheFromArchive(const std::string& sourcePath,
+                                 const std::string& cachePath,
+                                 CachedTextureData& outTexture) {
+  AssetBlob blob;
+  if (!AssetArchive::getInstance().find(cachePath, blob)) {
+    return false;
+  }
+  ULONGLONG sourceWriteTime = 0;
+  if (GetFileWriteTime(sourcePath, sourceWriteTime) && sourceWriteTime > blob.sourceWriteTime) {
+    return false;
+  }
+  return ParseTextureCache(blob.data, blob.size, outTexture);
 }
 
 HRESULT CreateTextureFromRGBA(Device& device,
@@ -145,13 +182,21 @@ HRESULT InitTextureFromImage(Device& device, const std::string& fullPath, Textur
   unsigned char* decodedData = nullptr;
   const unsigned char* uploadData = nullptr;
 
-  if (IsTextureCacheUpToDate(fullPath, cachePath) && LoadTextureCache(cachePath, cachedTexture)) {
+  if (LoadTextureCacheFromArchive(fullPath, cachePath, cachedTexture) ||
+      (IsTextureCacheUpToDate(fullPath, cachePath) && LoadTextureCache(cachePath, cachedTexture))) {
     width = cachedTexture.width;
     height = cachedTexture.height;
-    uploadData = cachedTexture.rgba.data();
+    uploadData = cachedTexture.rgba;
   }
   else {
-    decodedData = stbi_load(fullPath.c_str(), &width, &height, &channels, 4);
+    std::vector<unsigned char> sourceData;
+    if (AssetPreloader::getInstance().consume(fullPath, sourceData)) {
+      decodedData = stbi_load_from_memory(sourceData.data(), static_cast<int>(sourceData.size()),
+                                          &width, &height, &channels, 4);
+    }
+    else {
+      decodedData = stbi_load(fullPath.c_str(), &width, &height, &channels, 4);
+    }
     if (!decodedData) {
       ERROR("Texture", "init",
         ("Failed to load texture: " + std::string(stbi_failure_reason())).c_str());
@@ -333,6 +378,13 @@ Texture::destroy() {
   }
 }
 
+void 
+Texture::swap(Texture& other) {
+  std::swap(m_texture, other.m_texture);
+  std::swap(m_textureFromImg, other.m_textureFromImg);
+  std::swap(m_textureName, other.m_textureName);
+}
+
 HRESULT 
 Texture::CreateCubemap(Device& device, 
                        DeviceContext& deviceContext, 
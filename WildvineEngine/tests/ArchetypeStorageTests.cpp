@@ -0,0 +1,167 @@
+/**
+ * @file ArchetypeStorageTests.cpp
+ * @brief Implementa las pruebas de ArchetypeStorage dentro del subsistema ECS.
+ * @ingroup ecs
+ *
+ * Altas, bajas y migraciones conservan los datos de cada fila; el benchmark compara
+ * update de matrices locales y gather de cajas world sobre 100k entidades con los
+ * componentes dispersos en el heap (layout anterior) y en columnas de chunks.
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "ECS/ArchetypeStorage.h"
+#include "ECS/LightComponent.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace {
+struct LayoutScene {
+	Mesh mesh;
+	std::vector<std::unique_ptr<TestEntity>> entities;
+};
+
+/// Entidades con Transform + MeshRenderer creadas en orden aleatorio entre otras
+/// reservas, como quedan tras cargar y editar una escena con MakeShared por componente.
+void
+BuildScatteredScene(LayoutScene& scene, size_t count) {
+	InitBoxMesh(scene.mesh, XMFLOAT3(0.5f, 0.5f, 0.5f));
+	std::vector<std::unique_ptr<char[]>> padding;
+	TestRandom random;
+	for (size_t i = 0; i < count; ++i) {
+		auto entity = std::make_unique<TestEntity>();
+		EU::TSharedPointer<Transform> transform = EU::MakeShared<Transform>();
+		transform->setPosition(EU::Vector3(random.range(-500.0f, 500.0f), 0.0f, random.range(-500.0f, 500.0f)));
+		entity->addComponent(transform);
+		padding.push_back(std::make_unique<char[]>(64 + random.next() % 512));
+		EU::TSharedPointer<MeshRendererComponent> meshRenderer = EU::MakeShared<MeshRendererComponent>();
+		meshRenderer->setMesh(&scene.mesh);
+		entity->addComponent(meshRenderer);
+		scene.entities.push_back(std::move(entity));
+	}
+	for (size_t i = scene.entities.size(); i > 1; --i) {
+		std::swap(scene.entities[i - 1], scene.entities[random.next() % i]);
+	}
+}
+
+float
+AccumulateBounds(const TransformData& transform, const MeshRendererData& meshRenderer) {
+	if (!meshRenderer.visible || !meshRenderer.mesh) {
+		return 0.0f;
+	}
+	return meshRenderer.mesh->getBounds().transformed(transform.worldMatrix).center.x;
+}
+}
+
+WV_TEST(TestStorageKeepsRowData) {
+	ArchetypeStorage storage;
+	EntityQuery& renderQuery = storage.query<Transform, MeshRendererComponent>();
+
+	std::vector<std::unique_ptr<TestEntity>> entities;
+	for (int i = 0; i < 600; ++i) {
+		entities.push_back(std::make_unique<TestEntity>());
+		EU::TSharedPointer<Transform> transform = EU::MakeShared<Transform>();
+		transform->setPosition(EU::Vector3(static_cast<float>(i), 0.0f, 0.0f));
+		entities.back()->addComponent(transform);
+		storage.add(entities.back().get());
+	}
+	CHECK(storage.getEntityCount() == 600);
+	CHECK(renderQuery.getEntityCount() == 0);
+
+	// Agregar un componente migra la fila al nuevo arquetipo con sus datos
+	for (int i = 0; i < 600; i += 3) {
+		entities[i]->addComponent(EU::MakeShared<MeshRendererComponent>());
+	}
+	CHECK(renderQuery.getEntityCount() == 200);
+
+	// Quitar entidades intercambia filas: cada fachada sigue viendo su posicion
+	for (int i = 0; i < 600; i += 5) {
+		storage.remove(entities[i].get());
+	}
+	CHECK(storage.getEntityCount() == 480);
+	for (int i = 0; i < 600; ++i) {
+		const Transform* transform = entities[i]->getComponent<Transform>();
+		CHECK(transform->getPosition().x == static_cast<float>(i));
+		CHECK(transform->isStored() == (i % 5 != 0));
+	}
+
+	size_t visited = 0;
+	renderQuery.forEachChunk([&visited](const Archetype& archetype, const ArchetypeChunk& chunk) {
+		Entity* const* rows = archetype.entities(chunk);
+		const TransformData* transforms = archetype.transforms(chunk);
+		for (uint32_t row = 0; row < chunk.count; ++row) {
+			CHECK(&rows[row]->getComponent<Transform>()->getData() == &transforms[row]);
+			++visited;
+		}
+	});
+	CHECK(visited == renderQuery.getEntityCount());
+	storage.clear();
+}
+
+WV_BENCHMARK(BenchChunksVsScatteredLayout) {
+	constexpr size_t kEntities = 100000;
+	constexpr int kFrames = 10;
+
+	LayoutScene scene;
+	BuildScatteredScene(scene, kEntities);
+
+	// Layout anterior: cada entidad alcanza sus componentes a traves del heap
+	TestHarness::BenchTimer timer;
+	for (int frame = 0; frame < kFrames; ++frame) {
+		for (const auto& entity : scene.entities) {
+			TransformData& transform = entity->getComponent<Transform>()->getData();
+			transform.flags |= TransformData::kLocalDirty;
+			Transform::updateMatrices(transform);
+			transform.worldMatrix = transform.matrix;
+		}
+	}
+	TestHarness::report("update disperso (100k x 10 frames)", timer.elapsedMs(), kEntities * kFrames);
+
+	float scatteredSum = 0.0f;
+	timer.restart();
+	for (int frame = 0; frame < kFrames; ++frame) {
+		for (const auto& entity : scene.entities) {
+			scatteredSum += AccumulateBounds(entity->getComponent<Transform>()->getData(),
+			                                 entity->getComponent<MeshRendererComponent>()->getData());
+		}
+	}
+	TestHarness::report("gather disperso (100k x 10 frames)", timer.elapsedMs(), kEntities * kFrames);
+
+	// Chunks: las mismas entidades copiadas a columnas contiguas
+	ArchetypeStorage storage;
+	for (const auto& entity : scene.entities) {
+		storage.add(entity.get());
+	}
+	EntityQuery& transformQuery = storage.query<Transform>();
+	EntityQuery& renderQuery = storage.query<Transform, MeshRendererComponent>();
+
+	timer.restart();
+	for (int frame = 0; frame < kFrames; ++frame) {
+		transformQuery.forEachChunk([](const Archetype& archetype, const ArchetypeChunk& chunk) {
+			TransformData* transforms = archetype.transforms(chunk);
+			for (uint32_t row = 0; row < chunk.count; ++row) {
+				transforms[row].flags |= TransformData::kLocalDirty;
+				Transform::updateMatrices(transforms[row]);
+				transforms[row].worldMatrix = transforms[row].matrix;
+			}
+		});
+	}
+	TestHarness::report("update en chunks (100k x 10 frames)", timer.elapsedMs(), kEntities * kFrames);
+
+	float chunkSum = 0.0f;
+	timer.restart();
+	for (int frame = 0; frame < kFrames; ++frame) {
+		renderQuery.forEachChunk([&chunkSum](const Archetype& archetype, const ArchetypeChunk& chunk) {
+			const TransformData* transforms = archetype.transforms(chunk);
+			const MeshRendererData* meshRenderers = archetype.meshRenderers(chunk);
+			for (uint32_t row = 0; row < chunk.count; ++row) {
+				chunkSum += AccumulateBounds(transforms[row], meshRenderers[row]);
+			}
+		});
+	}
+	TestHarness::report("gather en chunks (100k x 10 frames)", timer.elapsedMs(), kEntities * kFrames);
+
+	// Mismo trabajo en distinto orden: la suma coincide salvo redondeo
+	CHECK(std::fabs(scatteredSum - chunkSum) <= 1e-3f * (std::max)(1.0f, std::fabs(scatteredSum)));
+	storage.clear();
+}
@@ -0,0 +1,163 @@
+/**
+ * @file AssetArchiveTests.cpp
+ * @brief Implementa las pruebas de AssetArchive dentro del subsistema Core.
+ * @ingroup core
+ *
+ * Empaquetado y busqueda de blobs, rechazo de un .wvpak truncado y el benchmark de
+ * arranque: resolver todos los caches sueltos (dos consultas de fecha + abrir y leer
+ * cada archivo, como Model3D::ImportModel) frente a montar el .wvpak y buscar en la TOC.
+ * Los archivos se generan en el directorio temporal del sistema.
+ */
+#include "TestHarness.h"
+#include "AssetArchive.h"
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+namespace fs = std::filesystem;
+
+struct AssetSet {
+	std::vector<std::string> sources;
+	std::vector<std::string> caches;
+	std::vector<std::vector<char>> contents;
+};
+
+/// Genera `count` pares fuente/cache con contenido reconocible por indice.
+AssetSet
+WriteAssets(const fs::path& directory, uint32_t count, size_t cacheSize) {
+	fs::remove_all(directory);
+	fs::create_directories(directory);
+
+	AssetSet assets;
+	for (uint32_t i = 0; i < count; ++i) {
+		const std::string source = (directory / ("Prop_" + std::to_string(i) + ".fbx")).string();
+		std::ofstream(source, std::ios::binary) << "fbx " << i;
+
+		std::vector<char> content(cacheSize);
+		for (size_t b = 0; b < cacheSize; ++b) {
+			content[b] = static_cast<char>((b * 31 + i * 7) & 0xFF);
+		}
+		const std::string cache = source + ".wvmesh";
+		std::ofstream(cache, std::ios::binary).write(content.data(), static_cast<std::streamsize>(content.size()));
+
+		assets.sources.push_back(source);
+		assets.caches.push_back(cache);
+		assets.contents.push_back(std::move(content));
+	}
+	return assets;
+}
+
+uint64_t
+TouchBytes(const unsigned char* data, size_t size) {
+	uint64_t sum = 0;
+	for (size_t i = 0; i < size; i += 64) {
+		sum += data[i];
+	}
+	return sum;
+}
+
+/// Camino suelto de ImportModel: fechas de fuente y cache, luego lectura completa.
+uint64_t
+LoadLoose(const AssetSet& assets) {
+	uint64_t sum = 0;
+	std::vector<unsigned char> data;
+	for (size_t i = 0; i < assets.caches.size(); ++i) {
+		WIN32_FILE_ATTRIBUTE_DATA attributes{};
+		GetFileAttributesExA(assets.sources[i].c_str(), GetFileExInfoStandard, &attributes);
+		GetFileAttributesExA(assets.caches[i].c_str(), GetFileExInfoStandard, &attributes);
+
+		std::ifstream stream(assets.caches[i], std::ios::binary | std::ios::ate);
+		const std::streamsize size = stream.tellg();
+		stream.seekg(0, std::ios::beg);
+		data.resize(static_cast<size_t>(size));
+		stream.read(reinterpret_cast<char*>(data.data()), size);
+		sum += TouchBytes(data.data(), data.size());
+	}
+	return sum;
+}
+
+/// Camino empaquetado: montar una vez, buscar por hash y comprobar la fecha del fuente.
+uint64_t
+LoadPacked(AssetArchive& archive, const std::string& archivePath, const AssetSet& assets) {
+	if (!archive.mount(archivePath)) {
+		return 0;
+	}
+	uint64_t sum = 0;
+	for (size_t i = 0; i < assets.caches.size(); ++i) {
+		AssetBlob blob;
+		WIN32_FILE_ATTRIBUTE_DATA attributes{};
+		if (archive.find(assets.caches[i], blob) &&
+		    GetFileAttributesExA(assets.sources[i].c_str(), GetFileExInfoStandard, &attributes)) {
+			sum += TouchBytes(blob.data, blob.size);
+		}
+	}
+	archive.unmount();
+	return sum;
+}
+}
+
+WV_TEST(TestArchiveFindsPackedBlobs) {
+	const fs::path directory = fs::temp_directory_path() / "wv_archive_test";
+	const AssetSet assets = WriteAssets(directory, 16, 1000);
+	const std::string archivePath = (directory / "assets.wvpak").string();
+
+	AssetArchive archive;
+	CHECK(AssetArchive::build(archivePath, assets.caches));
+	CHECK(archive.mount(archivePath));
+	CHECK(archive.getEntryCount() == assets.caches.size());
+
+	for (size_t i = 0; i < assets.caches.size(); ++i) {
+		AssetBlob blob;
+		CHECK(archive.find(assets.caches[i], blob));
+		CHECK(blob.size == assets.contents[i].size());
+		CHECK(blob.data && memcmp(blob.data, assets.contents[i].data(), blob.size) == 0);
+		CHECK(reinterpret_cast<uintptr_t>(blob.data) % AssetArchive::kBlobAlignment == 0);
+	}
+
+	// Rutas normalizadas: mayusculas y separadores de Windows resuelven al mismo blob
+	std::string windowsPath = assets.caches[3];
+	for (char& c : windowsPath) {
+		c = (c == '/') ? '\\' : static_cast<char>(toupper(static_cast<unsigned char>(c)));
+	}
+	AssetBlob blob;
+	CHECK(archive.find(windowsPath, blob) && blob.size == assets.contents[3].size());
+	CHECK(!archive.find((directory / "missing.wvmesh").string(), blob));
+	archive.unmount();
+
+	// Un .wvpak truncado deja entradas fuera de la vista y no debe montarse
+	fs::resize_file(archivePath, fs::file_size(archivePath) / 2);
+	CHECK(!archive.mount(archivePath));
+	CHECK(!archive.isMounted());
+
+	fs::remove_all(directory);
+}
+
+WV_BENCHMARK(BenchLooseVsPackedStartup) {
+	constexpr uint32_t kAssets = 1000;
+	constexpr size_t kCacheSize = 48 * 1024;
+
+	const fs::path directory = fs::temp_directory_path() / "wv_archive_bench";
+	const AssetSet assets = WriteAssets(directory, kAssets, kCacheSize);
+	const std::string archivePath = (directory / "assets.wvpak").string();
+	CHECK(AssetArchive::build(archivePath, assets.caches));
+
+	// Los archivos recien escritos estan en la cache del SO: se mide el coste de
+	// syscalls y busquedas, no el de un disco frio.
+	AssetArchive archive;
+	const uint64_t warmLoose = LoadLoose(assets);
+	const uint64_t warmPacked = LoadPacked(archive, archivePath, assets);
+	CHECK(warmLoose == warmPacked);
+
+	TestHarness::BenchTimer timer;
+	const uint64_t loose = LoadLoose(assets);
+	TestHarness::report("loose .wvmesh (1000 x 48 KB)", timer.elapsedMs(), kAssets);
+
+	timer.restart();
+	const uint64_t packed = LoadPacked(archive, archivePath, assets);
+	TestHarness::report("packed .wvpak mount + find (1000 x 48 KB)", timer.elapsedMs(), kAssets);
+
+	CHECK(loose == packed);
+	fs::remove_all(directory);
+}
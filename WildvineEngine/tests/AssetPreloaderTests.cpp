@@ -0,0 +1,171 @@
+/**
+ * @file AssetPreloaderTests.cpp
+ * @brief Implementa las pruebas de AssetPreloader dentro del subsistema Core.
+ * @ingroup core
+ *
+ * Orden del manifiesto por nivel de dependencia, entrega de bytes precargados y el
+ * benchmark de tiempo hasta el primer frame sin GPU: los loaders de Model3D/Texture
+ * se reducen a su lectura del cache (consume() o disco) mas un recorrido de los bytes,
+ * en el mismo orden en que BaseApp::init los pide.
+ */
+#include "TestHarness.h"
+#include "AssetPreloader.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+namespace fs = std::filesystem;
+
+struct SceneAssets {
+	std::string manifestPath;
+	std::vector<std::string> models;                 ///< Fuentes .fbx en orden de carga.
+	std::vector<std::vector<std::string>> textures;  ///< Texturas de cada modelo.
+};
+
+void
+WriteBytes(const std::string& path, size_t size, uint32_t seed) {
+	std::vector<char> content(size);
+	for (size_t i = 0; i < size; ++i) {
+		content[i] = static_cast<char>((i * 131 + seed) & 0xFF);
+	}
+	std::ofstream(path, std::ios::binary).write(content.data(), static_cast<std::streamsize>(size));
+}
+
+/// Escena con `modelCount` modelos de `texturesPerModel` texturas; escribe fuentes,
+/// caches cocinados y el manifiesto generado desde el grafo de dependencias.
+SceneAssets
+WriteScene(const fs::path& directory, uint32_t modelCount, uint32_t texturesPerModel,
+           size_t modelCacheSize, size_t textureCacheSize) {
+	fs::remove_all(directory);
+	fs::create_directories(directory);
+
+	ResourceManager resources;
+	SceneAssets scene;
+	const std::string scenePath = (directory / "level.wvscene").string();
+	resources.RecordAsset(scenePath, ResourceType::Unknown);
+	for (uint32_t m = 0; m < modelCount; ++m) {
+		const std::string model = (directory / ("Model_" + std::to_string(m) + ".fbx")).string();
+		std::ofstream(model) << "fbx";
+		WriteBytes(model + ".wvmesh", modelCacheSize, m);
+		resources.RecordAsset(model, ResourceType::Model3D);
+		resources.RecordDependency(scenePath, model);
+
+		scene.models.push_back(model);
+		scene.textures.emplace_back();
+		for (uint32_t t = 0; t < texturesPerModel; ++t) {
+			const std::string texture =
+				(directory / ("Texture_" + std::to_string(m) + "_" + std::to_string(t) + ".png")).string();
+			std::ofstream(texture) << "png";
+			WriteBytes(texture + ".wvtx", textureCacheSize, m * 16 + t);
+			resources.RecordAsset(texture, ResourceType::Texture);
+			resources.RecordDependency(model, texture);
+			scene.textures.back().push_back(texture);
+		}
+	}
+
+	scene.manifestPath = (directory / "level.wvpreload").string();
+	AssetPreloader::writeManifest(scene.manifestPath, resources.GetDependencyGraph());
+	return scene;
+}
+
+/// Lectura del cache como la hacen LoadBinaryCache/LoadTextureCache: primero consume().
+uint64_t
+LoadCache(AssetPreloader& preloader, const std::string& cachePath) {
+	std::vector<unsigned char> data;
+	if (!preloader.consume(cachePath, data)) {
+		std::ifstream stream(cachePath, std::ios::binary | std::ios::ate);
+		const std::streamsize size = stream.tellg();
+		stream.seekg(0, std::ios::beg);
+		data.resize(static_cast<size_t>(size > 0 ? size : 0));
+		stream.read(reinterpret_cast<char*>(data.data()), size);
+	}
+	// Parseo: un recorrido completo de los bytes
+	uint64_t sum = 0;
+	for (unsigned char byte : data) {
+		sum += byte;
+	}
+	return sum;
+}
+
+/// Carga de la escena hasta el primer frame, con o sin manifiesto.
+uint64_t
+LoadScene(AssetPreloader& preloader, const SceneAssets& scene, bool useManifest) {
+	if (useManifest) {
+		preloader.begin(scene.manifestPath);
+	}
+	uint64_t sum = 0;
+	for (size_t m = 0; m < scene.models.size(); ++m) {
+		sum += LoadCache(preloader, scene.models[m] + ".wvmesh");
+		for (const std::string& texture : scene.textures[m]) {
+			sum += LoadCache(preloader, texture + ".wvtx");
+		}
+	}
+	preloader.end();
+	return sum;
+}
+}
+
+WV_TEST(TestManifestOrderAndConsume) {
+	const fs::path directory = fs::temp_directory_path() / "wv_preload_test";
+	const SceneAssets scene = WriteScene(directory, 3, 2, 4096, 2048);
+
+	// Las texturas (nivel 0) se piden antes que los modelos que las usan (nivel 1)
+	std::ifstream manifest(scene.manifestPath);
+	std::string header;
+	std::getline(manifest, header);
+	CHECK(header == "WVPRELOAD 1");
+	std::string line;
+	int previousLevel = 0;
+	size_t fileCount = 0;
+	while (std::getline(manifest, line)) {
+		int level = -1;
+		CHECK(std::sscanf(line.c_str(), "FILE %d", &level) == 1);
+		CHECK(level >= previousLevel);
+		CHECK((level == 0) == (line.find(".wvtx") != std::string::npos));
+		previousLevel = level;
+		++fileCount;
+	}
+	CHECK(fileCount == 3 + 3 * 2);
+	manifest.close();
+
+	AssetPreloader preloader;
+	CHECK(preloader.begin(scene.manifestPath));
+	CHECK(preloader.isActive());
+	std::vector<unsigned char> data;
+	CHECK(preloader.consume(scene.models[1] + ".wvmesh", data));
+	CHECK(data.size() == 4096);
+	CHECK(data[5] == static_cast<unsigned char>((5 * 131 + 1) & 0xFF));
+	// Cada archivo se entrega una sola vez; lo que no esta en el manifiesto va a disco
+	CHECK(!preloader.consume(scene.models[1] + ".wvmesh", data));
+	CHECK(!preloader.consume(scene.models[1], data));
+	preloader.end();
+	CHECK(!preloader.isActive());
+	CHECK(!preloader.begin((directory / "missing.wvpreload").string()));
+
+	fs::remove_all(directory);
+}
+
+WV_BENCHMARK(BenchTimeToFirstFrame) {
+	constexpr uint32_t kModels = 48;
+	constexpr uint32_t kTexturesPerModel = 4;
+	const fs::path directory = fs::temp_directory_path() / "wv_preload_bench";
+	const SceneAssets scene = WriteScene(directory, kModels, kTexturesPerModel, 256 * 1024, 192 * 1024);
+	const size_t files = kModels * (1 + kTexturesPerModel);
+
+	AssetPreloader preloader;
+	const uint64_t reference = LoadScene(preloader, scene, false);
+
+	// Cache del SO caliente en ambos casos: el manifiesto gana por solapar lecturas
+	// con el parseo, no por evitar el disco.
+	TestHarness::BenchTimer timer;
+	const uint64_t withoutManifest = LoadScene(preloader, scene, false);
+	TestHarness::report("sin manifiesto (lecturas bajo demanda)", timer.elapsedMs(), files);
+
+	timer.restart();
+	const uint64_t withManifest = LoadScene(preloader, scene, true);
+	TestHarness::report("con manifiesto (lecturas solapadas)", timer.elapsedMs(), files);
+
+	CHECK(withoutManifest == reference);
+	CHECK(withManifest == reference);
+	fs::remove_all(directory);
+}
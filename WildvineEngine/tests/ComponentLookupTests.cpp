@@ -0,0 +1,88 @@
+/**
+ * @file ComponentLookupTests.cpp
+ * @brief Implementa las pruebas de Entity::getComponent dentro del subsistema ECS.
+ * @ingroup ecs
+ *
+ * Tabla por tipo (duplicados, ausentes, mascara) y el benchmark sobre 100k entidades:
+ * la tabla frente a la busqueda anterior, que recorria m_components con
+ * dynamic_pointer_cast y copiaba el puntero compartido en cada intento.
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "ECS/Transform.h"
+#include "ECS/MeshRendererComponent.h"
+#include "ECS/LightComponent.h"
+#include "SceneGraph/HierarchyComponent.h"
+#include <memory>
+
+namespace {
+/// getComponent anterior a la tabla por tipo, tal como estaba en Entity.h.
+template<typename T>
+EU::TSharedPointer<T>
+LegacyGetComponent(const TestEntity& entity) {
+	for (const EU::TSharedPointer<Component>& component : entity.getComponents()) {
+		EU::TSharedPointer<T> specificComponent = component.template dynamic_pointer_cast<T>();
+		if (specificComponent) {
+			return specificComponent;
+		}
+	}
+	return EU::TSharedPointer<T>();
+}
+}
+
+WV_TEST(TestComponentTable) {
+	TestEntity entity;
+	CHECK(entity.getComponent<Transform>() == nullptr);
+	CHECK(!entity.hasComponent<Transform>());
+	CHECK(entity.getComponentMask() == 0);
+
+	EU::TSharedPointer<Transform> first = EU::MakeShared<Transform>();
+	EU::TSharedPointer<Transform> duplicate = EU::MakeShared<Transform>();
+	entity.addComponent(first);
+	entity.addComponent(duplicate);
+	entity.addComponent(EU::MakeShared<MeshRendererComponent>());
+
+	// Con duplicados gana el primero, como en la busqueda lineal
+	CHECK(entity.getComponent<Transform>() == first.get());
+	CHECK(LegacyGetComponent<Transform>(entity).get() == first.get());
+	CHECK(entity.hasComponent<MeshRendererComponent>());
+	CHECK(entity.getComponent<LightComponent>() == nullptr);
+	CHECK(entity.getComponentMask() ==
+	      (Entity::componentBit(ComponentType::TRANSFORM) | Entity::componentBit(ComponentType::MESH_RENDERER)));
+}
+
+WV_BENCHMARK(BenchGetComponent100k) {
+	constexpr size_t kEntities = 100000;
+
+	// Orden de alta de Actor + SceneGraph: Transform, Hierarchy, MeshRenderer
+	std::vector<std::unique_ptr<TestEntity>> entities;
+	entities.reserve(kEntities);
+	for (size_t i = 0; i < kEntities; ++i) {
+		entities.push_back(std::make_unique<TestEntity>());
+		entities.back()->addComponent(EU::MakeShared<Transform>());
+		entities.back()->addComponent(EU::MakeShared<HierarchyComponent>());
+		entities.back()->addComponent(EU::MakeShared<MeshRendererComponent>());
+	}
+
+	// Las tres consultas por entidad que hacia gatherRenderScene
+	size_t legacyFound = 0;
+	TestHarness::BenchTimer timer;
+	for (const auto& entity : entities) {
+		legacyFound += LegacyGetComponent<Transform>(*entity) ? 1 : 0;
+		legacyFound += LegacyGetComponent<MeshRendererComponent>(*entity) ? 1 : 0;
+		legacyFound += LegacyGetComponent<LightComponent>(*entity) ? 1 : 0;
+	}
+	TestHarness::report("lineal + dynamic_pointer_cast (3 por entidad)", timer.elapsedMs(), kEntities * 3);
+
+	size_t found = 0;
+	timer.restart();
+	for (const auto& entity : entities) {
+		found += entity->getComponent<Transform>() ? 1 : 0;
+		found += entity->getComponent<MeshRendererComponent>() ? 1 : 0;
+		found += entity->getComponent<LightComponent>() ? 1 : 0;
+	}
+	TestHarness::report("tabla por tipo (3 por entidad)", timer.elapsedMs(), kEntities * 3);
+
+	CHECK(found == kEntities * 2);
+	CHECK(legacyFound == found);
+}
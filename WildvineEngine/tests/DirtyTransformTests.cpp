@@ -0,0 +1,79 @@
+/**
+ * @file DirtyTransformTests.cpp
+ * @brief Implementa las pruebas de la propagacion por transforms sucios dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ *
+ * Solo los transforms modificados (y sus descendientes) recalculan matrices y
+ * avanzan su version. El benchmark mide SceneGraph::update sobre 100k renderables
+ * cuando se mueve el 1% por frame, frente a moverlos todos (lo que antes se
+ * recalculaba siempre) y a no mover ninguno.
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "EngineUtilities/Utilities/JobSystem.h"
+
+WV_TEST(TestOnlyDirtyTransformsAdvance) {
+	TestSceneGraph scene;
+	TestEntity* still = scene.spawn(EU::Vector3(0.0f, 0.0f, 0.0f), true);
+	TestEntity* parent = scene.spawn(EU::Vector3(10.0f, 0.0f, 0.0f), true);
+	TestEntity* child = scene.spawn(EU::Vector3(1.0f, 0.0f, 0.0f), true);
+	CHECK(scene.graph.attach(child, parent));
+	scene.update();
+
+	const uint32_t stillVersion = still->getComponent<Transform>()->getData().version;
+	const uint32_t childVersion = child->getComponent<Transform>()->getData().version;
+	scene.update();
+	CHECK(scene.graph.getStats().localUpdates == 0);
+	CHECK(scene.graph.getStats().worldUpdates == 0);
+	CHECK(still->getComponent<Transform>()->getData().version == stillVersion);
+
+	// Mover el padre recalcula su local y la world de todo su subarbol
+	parent->getComponent<Transform>()->setPosition(EU::Vector3(20.0f, 0.0f, 0.0f));
+	scene.update();
+	CHECK(scene.graph.getStats().localUpdates == 1);
+	CHECK(scene.graph.getStats().worldUpdates == 2);
+	CHECK(still->getComponent<Transform>()->getData().version == stillVersion);
+	CHECK(child->getComponent<Transform>()->getData().version != childVersion);
+
+	XMFLOAT4X4 childWorld;
+	XMStoreFloat4x4(&childWorld, child->getComponent<Transform>()->getWorldMatrix());
+	CHECK(std::fabs(childWorld._41 - 21.0f) < 1e-4f);
+}
+
+WV_BENCHMARK(BenchOnePercentMoving) {
+	constexpr size_t kEntities = 100000;
+	constexpr int kFrames = 60;
+	JobSystem::getInstance().destroy();
+
+	for (size_t movingPercent : { size_t(0), size_t(1), size_t(100) }) {
+		TestSceneGraph scene;
+		TestRandom random;
+		for (size_t i = 0; i < kEntities; ++i) {
+			scene.spawn(EU::Vector3(random.range(-500.0f, 500.0f), 0.0f, random.range(-500.0f, 500.0f)), true);
+		}
+		scene.update();
+
+		const size_t moving = kEntities * movingPercent / 100;
+		uint64_t localUpdates = 0;
+		double updateMs = 0.0;
+		for (int frame = 0; frame < kFrames; ++frame) {
+			// Un 1% distinto cada frame: los que se movieron antes vuelven a estar limpios
+			for (size_t i = 0; i < moving; ++i) {
+				const size_t index = (frame * moving + i) % kEntities;
+				Transform* transform = scene.entities[index]->getComponent<Transform>();
+				EU::Vector3 position = transform->getPosition();
+				position.y += 0.01f;
+				transform->setPosition(position);
+			}
+			TestHarness::BenchTimer timer;
+			scene.update();
+			updateMs += timer.elapsedMs();
+			localUpdates += scene.graph.getStats().localUpdates;
+		}
+		CHECK(localUpdates == moving * kFrames);
+
+		char label[96];
+		std::snprintf(label, sizeof(label), "SceneGraph::update, %zu%% en movimiento (100k, por frame)", movingPercent);
+		TestHarness::report(label, updateMs / kFrames, kEntities);
+	}
+}
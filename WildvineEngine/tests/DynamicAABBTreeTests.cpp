@@ -0,0 +1,158 @@
+/**
+ * @file DynamicAABBTreeTests.cpp
+ * @brief Implementa las pruebas de DynamicAABBTree dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ *
+ * Las consultas de frustum, caja, esfera y rayo cubren todo lo que acepta la
+ * prueba exacta tras crear, mover y destruir proxies; destruir dos veces no
+ * corrompe el arbol. El benchmark mide insertar, mover y consultar con 10k, 100k
+ * y 1M objetos a densidad constante.
+ */
+#include "TestHarness.h"
+#include "TestSpatial.h"
+#include "SceneGraph/DynamicAABBTree.h"
+#include <cmath>
+
+namespace {
+/// Cajas vivas indexadas por proxy; las destruidas quedan invalidas.
+struct TreeScene {
+	DynamicAABBTree tree;
+	std::vector<Bounds> boxes;
+
+	int32_t
+	create(const Bounds& bounds) {
+		const int32_t proxy = tree.createProxy(bounds, nullptr);
+		if (proxy >= static_cast<int32_t>(boxes.size())) {
+			boxes.resize(proxy + 1);
+		}
+		boxes[proxy] = bounds;
+		return proxy;
+	}
+};
+
+/// Caja desplazada hasta `distance` en XZ.
+Bounds
+Nudge(Bounds bounds, TestRandom& random, float distance) {
+	bounds.center.x += random.range(-distance, distance);
+	bounds.center.z += random.range(-distance, distance);
+	return bounds;
+}
+}
+
+WV_TEST(TestTreeQueriesCoverExact) {
+	TreeScene scene;
+	TestRandom random;
+	std::vector<int32_t> live;
+	for (int i = 0; i < 2000; ++i) {
+		live.push_back(scene.create(RandomBox(random, 100.0f)));
+	}
+	for (int i = 0; i < 500; ++i) {
+		const int32_t proxy = live[random.next() % live.size()];
+		scene.boxes[proxy] = Nudge(scene.boxes[proxy], random, 5.0f);
+		scene.tree.moveProxy(proxy, scene.boxes[proxy]);
+	}
+	for (int i = 0; i < 300; ++i) {
+		const size_t slot = random.next() % live.size();
+		const int32_t proxy = live[slot];
+		live[slot] = live.back();
+		live.pop_back();
+		scene.tree.destroyProxy(proxy);
+		scene.boxes[proxy] = Bounds{};
+
+		// El slot libre sigue pareciendo hoja: destruirlo otra vez no hace nada
+		scene.tree.destroyProxy(proxy);
+		CHECK(scene.tree.getProxyCount() == live.size());
+	}
+	// Los slots liberados se reutilizan
+	for (int i = 0; i < 100; ++i) {
+		live.push_back(scene.create(RandomBox(random, 100.0f)));
+	}
+	CHECK(scene.tree.getProxyCount() == live.size());
+	CHECK(scene.tree.getNodeCount() == 2 * live.size() - 1);
+
+	CheckQueriesCoverExact(scene.tree, scene.boxes, live);
+}
+
+WV_BENCHMARK(BenchTreeScaling) {
+	constexpr int kMoveFrames = 10;
+	constexpr int kFrustumQueries = 50;
+	constexpr int kRays = 1000;
+
+	for (size_t count : { size_t(10000), size_t(100000), size_t(1000000) }) {
+		// Densidad constante: una caja cada 16 unidades cuadradas
+		const float halfSize = 2.0f * std::sqrt(static_cast<float>(count));
+		TreeScene scene;
+		TestRandom random;
+		std::vector<Bounds> boxes(count);
+		for (Bounds& bounds : boxes) {
+			bounds = RandomBox(random, halfSize);
+		}
+		char label[96];
+
+		// Los indices de proxy son nodos del arbol: no son 0..count-1
+		std::vector<int32_t> proxies;
+		proxies.reserve(count);
+		TestHarness::BenchTimer timer;
+		for (const Bounds& bounds : boxes) {
+			proxies.push_back(scene.create(bounds));
+		}
+		std::snprintf(label, sizeof(label), "insertar (%zu, altura %d)", count, scene.tree.getHeight());
+		TestHarness::report(label, timer.elapsedMs(), count);
+
+		// El 10% se mueve cada frame; la mayoria no sale de su caja gorda
+		const size_t moving = count / 10;
+		scene.tree.resetCounters();
+		timer.restart();
+		for (int frame = 0; frame < kMoveFrames; ++frame) {
+			for (size_t i = 0; i < moving; ++i) {
+				const int32_t proxy = proxies[random.next() % count];
+				scene.boxes[proxy] = Nudge(scene.boxes[proxy], random, 0.05f);
+				scene.tree.moveProxy(proxy, scene.boxes[proxy]);
+			}
+		}
+		std::snprintf(label, sizeof(label), "mover 10%% (%zu, %u reinserciones)", count,
+		              scene.tree.getReinsertCount());
+		TestHarness::report(label, timer.elapsedMs() / kMoveFrames, moving);
+
+		const XMFLOAT3 eye(0.0f, 10.0f, 0.0f);
+		std::vector<SpatialHit> frustumHits;
+		size_t visible = 0;
+		uint32_t tested = 0;
+		timer.restart();
+		for (int query = 0; query < kFrustumQueries; ++query) {
+			frustumHits.clear();
+			tested += scene.tree.collectFrustum(CameraFrustum(eye, query * 0.125f, 300.0f), frustumHits);
+			visible += frustumHits.size();
+		}
+		std::snprintf(label, sizeof(label), "frustum (%zu, %zu visibles, %u nodos)", count,
+		              visible / kFrustumQueries, tested / kFrustumQueries);
+		TestHarness::report(label, timer.elapsedMs() / kFrustumQueries, 1);
+
+		std::vector<SpatialRayHit> rayHits;
+		size_t crossed = 0;
+		timer.restart();
+		for (int ray = 0; ray < kRays; ++ray) {
+			const float angle = random.range(0.0f, XM_2PI);
+			const XMFLOAT3 origin(random.range(-halfSize, halfSize), 10.0f, random.range(-halfSize, halfSize));
+			rayHits.clear();
+			scene.tree.collectRay(origin, XMFLOAT3(std::sin(angle), 0.0f, std::cos(angle)), 200.0f, rayHits);
+			crossed += rayHits.size();
+		}
+		std::snprintf(label, sizeof(label), "rayo de 200 (%zu, %zu cajas)", count, crossed / kRays);
+		TestHarness::report(label, timer.elapsedMs(), kRays);
+
+		// La ultima consulta de frustum cubre la prueba exacta
+		std::vector<int32_t> candidates;
+		std::vector<int32_t> expected;
+		const Frustum frustum = CameraFrustum(eye, (kFrustumQueries - 1) * 0.125f, 300.0f);
+		for (const SpatialHit& hit : frustumHits) {
+			candidates.push_back(hit.proxy);
+		}
+		for (int32_t proxy : proxies) {
+			if (frustum.intersects(scene.boxes[proxy])) {
+				expected.push_back(proxy);
+			}
+		}
+		CHECK(ContainsAll(candidates, expected));
+	}
+}
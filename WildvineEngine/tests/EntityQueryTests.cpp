@@ -0,0 +1,119 @@
+/**
+ * @file EntityQueryTests.cpp
+ * @brief Implementa las pruebas de EntityQuery dentro del subsistema ECS.
+ * @ingroup ecs
+ *
+ * La consulta cacheada se mantiene al dia con altas, bajas y cambios de componentes;
+ * el benchmark compara recorrer sus filas con volver a escanear todas las entidades
+ * probando componentes, con 1%, 10% y 100% de coincidencias sobre 100k entidades.
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "ECS/ArchetypeStorage.h"
+#include "ECS/LightComponent.h"
+#include <memory>
+
+namespace {
+struct QueryScene {
+	Mesh mesh;
+	std::vector<std::unique_ptr<TestEntity>> entities;
+	ArchetypeStorage storage;
+
+	~QueryScene() { storage.clear(); }
+};
+
+/// Todas con Transform; una de cada `stride` con MeshRenderer y LightComponent.
+void
+BuildScene(QueryScene& scene, size_t count, size_t stride) {
+	InitBoxMesh(scene.mesh, XMFLOAT3(0.5f, 0.5f, 0.5f));
+	for (size_t i = 0; i < count; ++i) {
+		auto entity = std::make_unique<TestEntity>();
+		entity->addComponent(EU::MakeShared<Transform>());
+		if (i % stride == 0) {
+			EU::TSharedPointer<MeshRendererComponent> meshRenderer = EU::MakeShared<MeshRendererComponent>();
+			meshRenderer->setMesh(&scene.mesh);
+			entity->addComponent(meshRenderer);
+			EU::TSharedPointer<LightComponent> light = EU::MakeShared<LightComponent>();
+			light->getLightData().intensity = 1.0f;
+			entity->addComponent(light);
+		}
+		scene.storage.add(entity.get());
+		scene.entities.push_back(std::move(entity));
+	}
+}
+}
+
+WV_TEST(TestQueryFollowsComponentChanges) {
+	QueryScene scene;
+	BuildScene(scene, 300, 3);
+	EntityQuery& lights = scene.storage.query<LightComponent>();
+	EntityQuery& renderables = scene.storage.query<Transform, MeshRendererComponent>();
+	CHECK(lights.getEntityCount() == 100);
+	CHECK(renderables.getEntityCount() == 100);
+
+	// Una consulta creada antes que su arquetipo lo recibe al crearse
+	EntityQuery& renderLights = scene.storage.query<MeshRendererComponent, LightComponent>();
+	CHECK(renderLights.getEntityCount() == 100);
+
+	scene.entities[1]->addComponent(EU::MakeShared<LightComponent>());
+	scene.storage.remove(scene.entities[0].get());
+	CHECK(lights.getEntityCount() == 100);
+	CHECK(renderables.getEntityCount() == 99);
+
+	size_t visited = 0;
+	lights.forEachEntity([&visited](Entity* entity) {
+		CHECK(entity->hasComponent<LightComponent>());
+		++visited;
+	});
+	CHECK(visited == 100);
+	CHECK(&scene.storage.query<LightComponent>() == &lights);
+}
+
+WV_BENCHMARK(BenchQueryMatchRatio) {
+	constexpr size_t kEntities = 100000;
+	constexpr int kFrames = 20;
+
+	for (size_t stride : { size_t(100), size_t(10), size_t(1) }) {
+		QueryScene scene;
+		BuildScene(scene, kEntities, stride);
+		const size_t matches = kEntities / stride;
+		char label[96];
+
+		// Antes: cada frame recorria todas las entidades probando sus componentes
+		float scanned = 0.0f;
+		size_t scannedRenderables = 0;
+		TestHarness::BenchTimer timer;
+		for (int frame = 0; frame < kFrames; ++frame) {
+			for (const auto& entity : scene.entities) {
+				if (const LightComponent* light = entity->getComponent<LightComponent>()) {
+					scanned += light->getLightData().intensity;
+				}
+				if (entity->getComponent<Transform>() && entity->getComponent<MeshRendererComponent>()) {
+					++scannedRenderables;
+				}
+			}
+		}
+		std::snprintf(label, sizeof(label), "escaneo completo, %zu%% coincide", 100 / stride);
+		TestHarness::report(label, timer.elapsedMs(), kEntities * kFrames);
+
+		EntityQuery& lights = scene.storage.query<LightComponent>();
+		EntityQuery& renderables = scene.storage.query<Transform, MeshRendererComponent>();
+		float queried = 0.0f;
+		size_t queriedRenderables = 0;
+		timer.restart();
+		for (int frame = 0; frame < kFrames; ++frame) {
+			lights.forEachEntity([&queried](Entity* entity) {
+				queried += entity->getComponent<LightComponent>()->getLightData().intensity;
+			});
+			renderables.forEachChunk([&queriedRenderables](const Archetype&, const ArchetypeChunk& chunk) {
+				queriedRenderables += chunk.count;
+			});
+		}
+		std::snprintf(label, sizeof(label), "consulta cacheada, %zu%% coincide", 100 / stride);
+		TestHarness::report(label, timer.elapsedMs(), kEntities * kFrames);
+
+		CHECK(scanned == queried);
+		CHECK(scannedRenderables == matches * kFrames);
+		CHECK(queriedRenderables == scannedRenderables);
+	}
+}
@@ -0,0 +1,198 @@
+/**
+ * @file FrameAllocationTests.cpp
+ * @brief Implementa las pruebas de asignaciones por frame dentro del subsistema Rendering.
+ * @ingroup rendering
+ *
+ * Cuenta las llamadas al operator new global durante el camino real de un frame:
+ * RenderScene::clear(), SceneGraph::gatherRenderScene() y RenderQueues::build().
+ * Con la camara quieta y tras unos frames de calentamiento ese camino no debe
+ * tocar el heap; el benchmark reporta el tiempo y las asignaciones por frame
+ * con 10k y 100k renderables, con la camara quieta y orbitando.
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "Rendering/Material.h"
+#include "Rendering/MaterialInstance.h"
+#include "Rendering/RenderQueues.h"
+#include "EngineUtilities/Utilities/Camera.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<size_t> g_newCalls{ 0 };
+}
+
+// Reemplazo global: cuenta cada reserva del binario de pruebas
+void*
+operator new(size_t size) {
+	g_newCalls.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size ? size : 1)) {
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void
+operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void
+operator delete(void* memory, size_t) noexcept {
+	std::free(memory);
+}
+
+namespace {
+constexpr float kSpacing = 3.0f;
+
+/**
+ * @brief Rejilla de cajas con tres materiales opacos y uno transparente.
+ *
+ * Uno de cada cuatro renderables es estatico para llenar la cola de sombras
+ * cacheadas. Un volumen de sombra que cubre toda la rejilla hace que el gather
+ * agregue tambien los casters fuera de camara.
+ */
+struct FrameScene {
+	TestSceneGraph scene;
+	Material opaqueMaterial;
+	Material transparentMaterial;
+	MaterialInstance materials[4];
+	RenderScene renderScene;
+	RenderQueues queues;
+	Camera camera;
+	Frustum shadowVolume;
+	float halfSize = 0.0f;
+
+	explicit FrameScene(size_t count) {
+		transparentMaterial.setDomain(MaterialDomain::Transparent);
+		for (uint32_t i = 0; i < 3; ++i) {
+			materials[i].setMaterial(&opaqueMaterial);
+		}
+		materials[3].setMaterial(&transparentMaterial);
+
+		const size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+		halfSize = side * kSpacing * 0.5f;
+		TestRandom random;
+		for (size_t i = 0; i < count; ++i) {
+			const EU::Vector3 position((i % side) * kSpacing - halfSize, random.range(0.0f, 4.0f),
+			                           (i / side) * kSpacing - halfSize);
+			TestEntity* entity = scene.create(position, true);
+			MeshRendererComponent* meshRenderer = entity->getComponent<MeshRendererComponent>();
+			meshRenderer->setMaterialInstance(&materials[random.next() % 4]);
+			meshRenderer->setStatic(i % 4 == 0);
+			scene.graph.addEntity(entity);
+		}
+		scene.update();
+
+		const XMMATRIX lightView = XMMatrixLookToLH(XMVectorSet(0.0f, 100.0f, 0.0f, 1.0f),
+			XMVectorSet(0.0f, -1.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f));
+		shadowVolume.setFromMatrix(lightView *
+			XMMatrixOrthographicOffCenterLH(-halfSize, halfSize, -halfSize, halfSize, 1.0f, 200.0f));
+
+		camera.setLens(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 500.0f);
+		place(0.0f);
+	}
+
+	/// Camara a media altura orbitando el centro de la rejilla.
+	void
+	place(float angle) {
+		const float radius = halfSize * 0.5f;
+		camera.lookAt(EU::Vector3(std::cos(angle) * radius, 20.0f, std::sin(angle) * radius),
+		              EU::Vector3(0.0f, 0.0f, 0.0f));
+		camera.updateViewMatrix();
+	}
+
+	/// Camino del frame que prepara las colas del renderer.
+	void
+	frame(bool cacheStaticShadows) {
+		renderScene.clear();
+		renderScene.shadowCasterVolumes.push_back(shadowVolume);
+		scene.graph.gatherRenderScene(renderScene, camera);
+		queues.build(renderScene, cacheStaticShadows);
+	}
+};
+
+/// Llamadas a operator new durante `frames` frames.
+size_t
+CountFrameAllocations(FrameScene& frameScene, uint32_t frames, bool cacheStaticShadows) {
+	const size_t before = g_newCalls.load();
+	for (uint32_t i = 0; i < frames; ++i) {
+		frameScene.frame(cacheStaticShadows);
+	}
+	return g_newCalls.load() - before;
+}
+} // namespace
+
+WV_TEST(TestSteadyFrameDoesNotAllocate) {
+	FrameScene frameScene(4096);
+
+	// Calentamiento: los vectores del gather y los bloques de los arenas crecen
+	for (uint32_t i = 0; i < 2 * RenderScene::kFramesInFlight; ++i) {
+		frameScene.frame(true);
+	}
+	const uint64_t arenaBlocks = frameScene.renderScene.getArenaStats().heapAllocations;
+
+	CHECK(CountFrameAllocations(frameScene, 8, true) == 0);
+	CHECK(CountFrameAllocations(frameScene, 8, false) == 0);
+	CHECK(frameScene.renderScene.getArenaStats().heapAllocations == arenaBlocks);
+
+	// Las colas cubren la escena y respetan su orden
+	const RenderQueues& queues = frameScene.queues;
+	CHECK(queues.opaque.size() > 0);
+	CHECK(queues.transparent.size() > 0);
+	CHECK(queues.staticShadow.size() == 0);
+	CHECK(queues.shadow.size() == frameScene.renderScene.opaqueObjects.size());
+	for (size_t i = 1; i < queues.opaque.size(); ++i) {
+		const RenderObject* lhs = queues.opaque[i - 1];
+		const RenderObject* rhs = queues.opaque[i];
+		CHECK(lhs->materialInstance < rhs->materialInstance ||
+		      (lhs->materialInstance == rhs->materialInstance && lhs->distanceToCamera <= rhs->distanceToCamera));
+	}
+	for (size_t i = 1; i < queues.transparent.size(); ++i) {
+		CHECK(queues.transparent[i - 1]->distanceToCamera >= queues.transparent[i]->distanceToCamera);
+	}
+
+	frameScene.frame(true);
+	CHECK(queues.staticShadow.size() > 0);
+	CHECK(queues.shadow.size() + queues.staticShadow.size() == frameScene.renderScene.opaqueObjects.size());
+}
+
+WV_BENCHMARK(BenchFrameAllocations) {
+	constexpr uint32_t kFrames = 32;
+	const size_t counts[] = { 10000, 100000 };
+
+	for (size_t count : counts) {
+		FrameScene frameScene(count);
+		for (uint32_t i = 0; i < 2 * RenderScene::kFramesInFlight; ++i) {
+			frameScene.frame(true);
+		}
+
+		char label[96];
+		TestHarness::BenchTimer timer;
+		const size_t fixedAllocations = CountFrameAllocations(frameScene, kFrames, true);
+		std::snprintf(label, sizeof(label), "%zu renderables, camara quieta (frame)", count);
+		TestHarness::report(label, timer.elapsedMs(), kFrames);
+		std::printf("    operator new por frame: %.2f\n", static_cast<double>(fixedAllocations) / kFrames);
+		CHECK(fixedAllocations == 0);
+
+		// Al girar cambia lo visible: solo crece lo que supera el maximo anterior
+		size_t orbitAllocations = 0;
+		timer.restart();
+		for (uint32_t i = 0; i < kFrames; ++i) {
+			frameScene.place(i * XM_2PI / kFrames);
+			orbitAllocations += CountFrameAllocations(frameScene, 1, true);
+		}
+		std::snprintf(label, sizeof(label), "%zu renderables, camara orbitando (frame)", count);
+		TestHarness::report(label, timer.elapsedMs(), kFrames);
+		std::printf("    operator new por frame: %.2f\n", static_cast<double>(orbitAllocations) / kFrames);
+
+		// Informativo: el update no forma parte del camino medido
+		const size_t beforeUpdate = g_newCalls.load();
+		frameScene.scene.update();
+		std::printf("    operator new en SceneGraph::update: %zu\n", g_newCalls.load() - beforeUpdate);
+
+		TestHarness::keep(frameScene.queues.opaque.size());
+	}
+}
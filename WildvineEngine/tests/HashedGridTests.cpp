@@ -0,0 +1,258 @@
+/**
+ * @file HashedGridTests.cpp
+ * @brief Implementa las pruebas de HashedGrid dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ *
+ * Las consultas de la rejilla cubren la prueba exacta tras crear, mover,
+ * destruir y cambiar el tamano de celda, y un frustum acotado solo visita las
+ * celdas de su caja. El benchmark compara rejilla, arbol dinamico y escaneo
+ * lineal en escenas de streaming (100k y 1M objetos casi estaticos, el 1% en
+ * movimiento) con consultas de frustum y de radio.
+ */
+#include "TestHarness.h"
+#include "TestSpatial.h"
+#include "SceneGraph/DynamicAABBTree.h"
+#include "SceneGraph/HashedGrid.h"
+#include <cmath>
+
+namespace {
+/// Resultados de una estructura en el benchmark; deben coincidir entre todas.
+struct QueryTotals {
+	size_t frustumHits = 0;
+	size_t radiusHits = 0;
+};
+
+/**
+ * @brief Frustums y esferas del benchmark: siempre los mismos para cada estructura.
+ */
+struct StreamingQueries {
+	std::vector<Frustum> frustums;
+	std::vector<XMFLOAT3> centers;
+	float radius = 40.0f;
+
+	StreamingQueries(float halfSize, TestRandom& random) {
+		for (int i = 0; i < 20; ++i) {
+			const XMFLOAT3 eye(random.range(-halfSize, halfSize), 10.0f, random.range(-halfSize, halfSize));
+			frustums.push_back(CameraFrustum(eye, random.range(0.0f, XM_2PI), 300.0f));
+		}
+		for (int i = 0; i < 200; ++i) {
+			centers.emplace_back(random.range(-halfSize, halfSize), 10.0f, random.range(-halfSize, halfSize));
+		}
+	}
+};
+
+/**
+ * @brief Mide una particion: alta, 1% en movimiento, frustum y radio.
+ *
+ * Los candidatos se filtran con la prueba exacta, como hace el SceneGraph, para
+ * que los totales se puedan comparar con el escaneo lineal.
+ */
+QueryTotals
+BenchIndex(const char* name, SpatialIndex& index, std::vector<Bounds> boxes, const StreamingQueries& queries) {
+	const size_t count = boxes.size();
+	char label[96];
+	std::vector<int32_t> proxies(count);
+	std::vector<Bounds> proxyBoxes;
+
+	TestHarness::BenchTimer timer;
+	for (size_t i = 0; i < count; ++i) {
+		proxies[i] = index.createProxy(boxes[i], nullptr);
+	}
+	std::snprintf(label, sizeof(label), "%s: alta (%zu)", name, count);
+	TestHarness::report(label, timer.elapsedMs(), count);
+	proxyBoxes.resize(index.getProxyCapacity());
+	for (size_t i = 0; i < count; ++i) {
+		proxyBoxes[proxies[i]] = boxes[i];
+	}
+
+	// El 1% de los objetos (siempre los mismos) se mueve cada frame
+	const size_t dynamicCount = count / 100;
+	timer.restart();
+	for (int frame = 0; frame < 10; ++frame) {
+		for (size_t i = 0; i < dynamicCount; ++i) {
+			Bounds& bounds = proxyBoxes[proxies[i * 100]];
+			bounds.center.x += (frame & 1) ? -0.5f : 0.5f;
+			index.moveProxy(proxies[i * 100], bounds);
+		}
+	}
+	std::snprintf(label, sizeof(label), "%s: mover 1%% por frame", name);
+	TestHarness::report(label, timer.elapsedMs() / 10, dynamicCount);
+
+	QueryTotals totals;
+	std::vector<SpatialHit> hits;
+	timer.restart();
+	for (const Frustum& frustum : queries.frustums) {
+		hits.clear();
+		index.collectFrustum(frustum, hits);
+		for (const SpatialHit& hit : hits) {
+			totals.frustumHits += (hit.fullyInside || frustum.intersects(proxyBoxes[hit.proxy])) ? 1 : 0;
+		}
+	}
+	std::snprintf(label, sizeof(label), "%s: frustum de 300", name);
+	TestHarness::report(label, timer.elapsedMs() / queries.frustums.size(), 1);
+
+	std::vector<int32_t> candidates;
+	const float radiusSq = queries.radius * queries.radius;
+	timer.restart();
+	for (const XMFLOAT3& center : queries.centers) {
+		candidates.clear();
+		index.collectSphere(center, queries.radius, candidates);
+		for (int32_t proxy : candidates) {
+			totals.radiusHits += DistanceSqToBox(proxyBoxes[proxy], center) <= radiusSq ? 1 : 0;
+		}
+	}
+	std::snprintf(label, sizeof(label), "%s: radio de 40", name);
+	TestHarness::report(label, timer.elapsedMs() / queries.centers.size(), 1);
+	return totals;
+}
+
+/// Escaneo lineal de referencia con los mismos movimientos y consultas.
+QueryTotals
+BenchLinear(std::vector<Bounds> boxes, const StreamingQueries& queries) {
+	const size_t count = boxes.size();
+	for (int frame = 0; frame < 10; ++frame) {
+		for (size_t i = 0; i < count / 100; ++i) {
+			boxes[i * 100].center.x += (frame & 1) ? -0.5f : 0.5f;
+		}
+	}
+
+	QueryTotals totals;
+	TestHarness::BenchTimer timer;
+	for (const Frustum& frustum : queries.frustums) {
+		for (const Bounds& bounds : boxes) {
+			totals.frustumHits += frustum.intersects(bounds) ? 1 : 0;
+		}
+	}
+	TestHarness::report("lineal: frustum de 300", timer.elapsedMs() / queries.frustums.size(), 1);
+
+	const float radiusSq = queries.radius * queries.radius;
+	timer.restart();
+	for (const XMFLOAT3& center : queries.centers) {
+		for (const Bounds& bounds : boxes) {
+			totals.radiusHits += DistanceSqToBox(bounds, center) <= radiusSq ? 1 : 0;
+		}
+	}
+	TestHarness::report("lineal: radio de 40", timer.elapsedMs() / queries.centers.size(), 1);
+	return totals;
+}
+}
+
+WV_TEST(TestGridQueriesCoverExact) {
+	HashedGrid grid(8.0f);
+	TestRandom random;
+	std::vector<Bounds> boxes;
+	std::vector<int32_t> live;
+	auto create = [&](const Bounds& bounds) {
+		const int32_t proxy = grid.createProxy(bounds, nullptr);
+		boxes.resize((std::max)(boxes.size(), static_cast<size_t>(proxy) + 1));
+		boxes[proxy] = bounds;
+		live.push_back(proxy);
+	};
+
+	for (int i = 0; i < 2000; ++i) {
+		create(RandomBox(random, 100.0f));
+	}
+	// Moverse dentro de la celda no cuenta como reinsercion; cambiar de celda si
+	uint32_t crossed = 0;
+	for (int i = 0; i < 500; ++i) {
+		const int32_t proxy = live[random.next() % live.size()];
+		Bounds& bounds = boxes[proxy];
+		const int32_t before = static_cast<int32_t>(std::floor(bounds.center.x / 8.0f));
+		bounds.center.x += random.range(-6.0f, 6.0f);
+		crossed += static_cast<int32_t>(std::floor(bounds.center.x / 8.0f)) != before ? 1 : 0;
+		grid.moveProxy(proxy, bounds);
+	}
+	CHECK(grid.getReinsertCount() == crossed);
+
+	for (int i = 0; i < 300; ++i) {
+		const size_t slot = random.next() % live.size();
+		grid.destroyProxy(live[slot]);
+		live[slot] = live.back();
+		live.pop_back();
+	}
+	for (int i = 0; i < 100; ++i) {
+		create(RandomBox(random, 100.0f));
+	}
+	CHECK(grid.getProxyCount() == live.size());
+	CheckQueriesCoverExact(grid, boxes, live);
+
+	// Otro tamano de celda redistribuye los proxies sin perder ninguno
+	grid.setCellSize(24.0f);
+	CHECK(grid.getProxyCount() == live.size());
+	CheckQueriesCoverExact(grid, boxes, live);
+}
+
+WV_TEST(TestGridFrustumVisitsOnlyNearbyCells) {
+	// Mundo de 4000 x 4000: el frustum de 100 unidades toca una fraccion de las celdas
+	HashedGrid grid;
+	TestRandom random;
+	std::vector<Bounds> boxes;
+	std::vector<int32_t> live;
+	for (int i = 0; i < 20000; ++i) {
+		boxes.push_back(RandomBox(random, 2000.0f));
+		live.push_back(grid.createProxy(boxes.back(), nullptr));
+	}
+
+	const Frustum frustum = CameraFrustum(XMFLOAT3(300.0f, 10.0f, -200.0f), 1.0f, 100.0f);
+	XMFLOAT3 lower;
+	XMFLOAT3 upper;
+	CHECK(frustum.computeBounds(lower, upper));
+	// Los puntos dentro de todos los planos caen dentro de la caja del frustum
+	size_t inside = 0;
+	for (int i = 0; i < 20000; ++i) {
+		const XMFLOAT3 point(random.range(100.0f, 500.0f), random.range(-100.0f, 100.0f), random.range(-400.0f, 0.0f));
+		if (frustum.intersectsSphere(point, 0.0f)) {
+			++inside;
+			CHECK(point.x >= lower.x && point.y >= lower.y && point.z >= lower.z);
+			CHECK(point.x <= upper.x && point.y <= upper.y && point.z <= upper.z);
+		}
+	}
+	CHECK(inside > 100);
+
+	std::vector<SpatialHit> hits;
+	const uint32_t tested = grid.collectFrustum(frustum, hits);
+	CHECK(tested * 20 < grid.getNodeCount());
+	std::vector<int32_t> candidates;
+	std::vector<int32_t> expected;
+	for (const SpatialHit& hit : hits) {
+		candidates.push_back(hit.proxy);
+	}
+	for (int32_t proxy : live) {
+		if (frustum.intersects(boxes[proxy])) {
+			expected.push_back(proxy);
+		}
+	}
+	CHECK(!expected.empty());
+	CHECK(ContainsAll(candidates, expected));
+
+	// Sin plano cercano el volumen no esta acotado: se recorren todas las celdas
+	Frustum extruded = frustum;
+	extruded.removePlane(Frustum::Near);
+	CHECK(!extruded.computeBounds(lower, upper));
+	hits.clear();
+	CHECK(grid.collectFrustum(extruded, hits) == grid.getNodeCount());
+}
+
+WV_BENCHMARK(BenchGridTreeLinear) {
+	for (size_t count : { size_t(100000), size_t(1000000) }) {
+		std::printf("  -- %zu objetos --\n", count);
+		const float halfSize = 2.0f * std::sqrt(static_cast<float>(count));
+		TestRandom random;
+		std::vector<Bounds> boxes(count);
+		for (Bounds& bounds : boxes) {
+			bounds = RandomBox(random, halfSize);
+		}
+		const StreamingQueries queries(halfSize, random);
+
+		HashedGrid grid;
+		const QueryTotals gridTotals = BenchIndex("rejilla", grid, boxes, queries);
+		DynamicAABBTree tree;
+		const QueryTotals treeTotals = BenchIndex("arbol", tree, boxes, queries);
+		const QueryTotals linearTotals = BenchLinear(boxes, queries);
+
+		CHECK(gridTotals.frustumHits == linearTotals.frustumHits);
+		CHECK(treeTotals.frustumHits == linearTotals.frustumHits);
+		CHECK(gridTotals.radiusHits == linearTotals.radiusHits);
+		CHECK(treeTotals.radiusHits == linearTotals.radiusHits);
+	}
+}
@@ -0,0 +1,204 @@
+/**
+ * @file HierarchyPropagationTests.cpp
+ * @brief Implementa las pruebas de la propagacion world de TransformHierarchy dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ *
+ * La pasada lineal y la paralela por niveles dan las mismas world que el
+ * recorrido recursivo anterior por HierarchyComponent::m_children. El benchmark
+ * compara los tres con 100k nodos en cadenas profundas (10 de 10k niveles) y en
+ * un arbol ancho (una raiz con 99 999 hijos).
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "SceneGraph/HierarchyComponent.h"
+#include "SceneGraph/TransformHierarchy.h"
+#include "EngineUtilities/Utilities/JobSystem.h"
+#include <cstring>
+#include <thread>
+
+namespace {
+/// Entidades con Transform y HierarchyComponent fuera de un SceneGraph.
+struct HierarchyScene {
+	std::vector<std::unique_ptr<TestEntity>> entities;
+	std::vector<Entity*> roots;
+	TransformHierarchy hierarchy;
+
+	~HierarchyScene() { hierarchy.clear(); }
+
+	/// Agrega un nodo con una traslacion y un giro pequenos, colgado de `parent` si no es nulo.
+	Entity*
+	spawn(Entity* parent, TestRandom& random) {
+		entities.push_back(std::make_unique<TestEntity>());
+		TestEntity* entity = entities.back().get();
+		EU::TSharedPointer<Transform> transform = EU::MakeShared<Transform>();
+		transform->setTransform(EU::Vector3(random.range(-1.0f, 1.0f), 0.5f, random.range(-1.0f, 1.0f)),
+		                        EU::Vector3(0.0f, random.range(-0.1f, 0.1f), 0.0f), EU::Vector3(1.0f, 1.0f, 1.0f));
+		// Sin almacenamiento por arquetipos update() calcula la matriz local
+		transform->update(0.0f);
+		entity->addComponent(transform);
+		entity->addComponent(EU::MakeShared<HierarchyComponent>());
+		hierarchy.add(entity);
+
+		if (parent) {
+			hierarchy.attach(entity, parent);
+			entity->getComponent<HierarchyComponent>()->m_parent = parent;
+			parent->getComponent<HierarchyComponent>()->addChild(entity);
+		}
+		else {
+			roots.push_back(entity);
+		}
+		return entity;
+	}
+};
+
+/**
+ * @brief Recorrido anterior (SceneGraph::updateWorldRecursive) sobre m_children.
+ *
+ * Usa una pila explicita en lugar de recursion: una cadena de 10k niveles
+ * puede desbordar la pila del hilo. El orden y las operaciones son los mismos.
+ */
+uint32_t
+RecursiveWorldWalk(const std::vector<Entity*>& roots, std::vector<std::pair<Entity*, bool>>& stack) {
+	uint32_t updated = 0;
+	for (Entity* root : roots) {
+		stack.emplace_back(root, false);
+		while (!stack.empty()) {
+			const auto [node, parentChanged] = stack.back();
+			stack.pop_back();
+			Transform* transform = node->getComponent<Transform>();
+			HierarchyComponent* hierarchy = node->getComponent<HierarchyComponent>();
+
+			const bool changed = parentChanged || transform->isWorldDirty();
+			if (changed) {
+				const XMMATRIX parentWorld = hierarchy->m_parent
+					? hierarchy->m_parent->getComponent<Transform>()->getWorldMatrix() : XMMatrixIdentity();
+				transform->setWorldMatrix(transform->getLocalMatrix() * parentWorld);
+				++updated;
+			}
+			for (auto child = hierarchy->m_children.rbegin(); child != hierarchy->m_children.rend(); ++child) {
+				stack.emplace_back(*child, changed);
+			}
+		}
+	}
+	return updated;
+}
+
+/// Copia las world de todas las entidades, en orden de alta.
+std::vector<XMFLOAT4X4>
+CaptureWorlds(const HierarchyScene& scene) {
+	std::vector<XMFLOAT4X4> worlds(scene.entities.size());
+	for (size_t i = 0; i < scene.entities.size(); ++i) {
+		XMStoreFloat4x4(&worlds[i], scene.entities[i]->getComponent<Transform>()->getWorldMatrix());
+	}
+	return worlds;
+}
+
+bool
+SameWorlds(const std::vector<XMFLOAT4X4>& a, const std::vector<XMFLOAT4X4>& b) {
+	return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(XMFLOAT4X4)) == 0;
+}
+
+/// Marca las raices: la pasada siguiente recalcula toda la jerarquia.
+void
+MarkRootsDirty(const HierarchyScene& scene) {
+	for (Entity* root : scene.roots) {
+		root->getComponent<Transform>()->markWorldDirty();
+	}
+}
+}
+
+WV_TEST(TestPropagationMatchesRecursiveWalk) {
+	// Suficientes nodos para que updateWorld(jobs) tome el camino por niveles
+	HierarchyScene scene;
+	TestRandom random;
+	std::vector<Entity*> created;
+	for (size_t i = 0; i < TransformHierarchy::kParallelMinNodes + 1000; ++i) {
+		Entity* parent = created.empty() || random.next() % 8 == 0 ? nullptr : created[random.next() % created.size()];
+		created.push_back(scene.spawn(parent, random));
+	}
+
+	std::vector<std::pair<Entity*, bool>> stack;
+	CHECK(RecursiveWorldWalk(scene.roots, stack) == created.size());
+	const std::vector<XMFLOAT4X4> expected = CaptureWorlds(scene);
+
+	MarkRootsDirty(scene);
+	CHECK(scene.hierarchy.updateWorld() == created.size());
+	CHECK(SameWorlds(CaptureWorlds(scene), expected));
+
+	JobSystem jobs;
+	jobs.init(3);
+	MarkRootsDirty(scene);
+	CHECK(scene.hierarchy.updateWorld(&jobs) == created.size());
+	CHECK(scene.hierarchy.getLevelCount() > 1);
+	CHECK(SameWorlds(CaptureWorlds(scene), expected));
+
+	// Sin nada sucio no se recalcula ningun nodo
+	CHECK(scene.hierarchy.updateWorld(&jobs) == 0);
+	jobs.destroy();
+}
+
+WV_BENCHMARK(BenchDeepAndWidePropagation) {
+	constexpr size_t kNodes = 100000;
+	constexpr size_t kChainDepth = 10000;
+	constexpr int kFrames = 20;
+	const uint32_t workers = (std::max)(1u, std::thread::hardware_concurrency()) - 1;
+	JobSystem jobs;
+	if (workers > 0) {
+		jobs.init(workers);
+	}
+
+	for (const char* shape : { "profundo", "ancho" }) {
+		HierarchyScene scene;
+		TestRandom random;
+		TestHarness::BenchTimer timer;
+		if (std::strcmp(shape, "profundo") == 0) {
+			// Cada attach ajusta el tamano de todos los ancestros: la carga es O(profundidad)
+			for (size_t chain = 0; chain < kNodes / kChainDepth; ++chain) {
+				Entity* last = nullptr;
+				for (size_t i = 0; i < kChainDepth; ++i) {
+					last = scene.spawn(last, random);
+				}
+			}
+		}
+		else {
+			Entity* root = scene.spawn(nullptr, random);
+			for (size_t i = 1; i < kNodes; ++i) {
+				scene.spawn(root, random);
+			}
+		}
+		char label[96];
+		std::snprintf(label, sizeof(label), "%s: construir 100k", shape);
+		TestHarness::report(label, timer.elapsedMs(), kNodes);
+
+		std::vector<std::pair<Entity*, bool>> stack;
+		timer.restart();
+		for (int frame = 0; frame < kFrames; ++frame) {
+			MarkRootsDirty(scene);
+			CHECK(RecursiveWorldWalk(scene.roots, stack) == kNodes);
+		}
+		std::snprintf(label, sizeof(label), "%s: recorrido por m_children", shape);
+		TestHarness::report(label, timer.elapsedMs() / kFrames, kNodes);
+		const std::vector<XMFLOAT4X4> expected = CaptureWorlds(scene);
+
+		timer.restart();
+		for (int frame = 0; frame < kFrames; ++frame) {
+			MarkRootsDirty(scene);
+			CHECK(scene.hierarchy.updateWorld() == kNodes);
+		}
+		std::snprintf(label, sizeof(label), "%s: pasada lineal", shape);
+		TestHarness::report(label, timer.elapsedMs() / kFrames, kNodes);
+		CHECK(SameWorlds(CaptureWorlds(scene), expected));
+
+		if (workers > 0) {
+			timer.restart();
+			for (int frame = 0; frame < kFrames; ++frame) {
+				MarkRootsDirty(scene);
+				CHECK(scene.hierarchy.updateWorld(&jobs) == kNodes);
+			}
+			std::snprintf(label, sizeof(label), "%s: por niveles (%u workers)", shape, workers);
+			TestHarness::report(label, timer.elapsedMs() / kFrames, kNodes);
+			CHECK(SameWorlds(CaptureWorlds(scene), expected));
+		}
+	}
+	jobs.destroy();
+}
@@ -0,0 +1,148 @@
+/**
+ * @file HierarchyQueryTests.cpp
+ * @brief Implementa las pruebas de las consultas de ancestro por intervalos dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ *
+ * isAncestor/isInSubtree por intervalos de preorden coinciden con subir por
+ * HierarchyComponent::m_parent despues de reparentar al azar. El benchmark usa
+ * una cadena de 10k niveles: consultas de ancestro con ambos metodos y el
+ * reparentado que haria arrastrar un nodo en el editor (attach a otra raiz y
+ * de vuelta a su padre).
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "SceneGraph/HierarchyComponent.h"
+
+namespace {
+/// Consulta anterior: sube desde `node` buscando la entidad en cada nivel.
+bool
+ParentWalkIsAncestor(Entity* possibleAncestor, Entity* node) {
+	HierarchyComponent* hierarchy = node->getComponent<HierarchyComponent>();
+	while (hierarchy && hierarchy->m_parent) {
+		if (hierarchy->m_parent == possibleAncestor) {
+			return true;
+		}
+		hierarchy = hierarchy->m_parent->getComponent<HierarchyComponent>();
+	}
+	return false;
+}
+
+Entity*
+ParentOf(Entity* entity) {
+	return entity->getComponent<HierarchyComponent>()->m_parent;
+}
+}
+
+WV_TEST(TestIntervalsMatchParentWalk) {
+	TestSceneGraph scene;
+	TestRandom random;
+	constexpr size_t kNodes = 300;
+	for (size_t i = 0; i < kNodes; ++i) {
+		scene.spawn(EU::Vector3(0.0f, 1.0f, 0.0f), false);
+	}
+
+	// Reparentados al azar; los que crearian un ciclo se rechazan
+	for (int step = 0; step < 2000; ++step) {
+		Entity* child = scene.entities[random.next() % kNodes].get();
+		Entity* parent = scene.entities[random.next() % kNodes].get();
+		const bool cycle = child == parent || ParentWalkIsAncestor(child, parent);
+		if (random.next() % 5 == 0) {
+			CHECK(scene.graph.detach(child));
+		}
+		else {
+			CHECK(scene.graph.attach(child, parent) == !cycle);
+		}
+	}
+
+	for (const auto& a : scene.entities) {
+		for (const auto& b : scene.entities) {
+			const bool ancestor = ParentWalkIsAncestor(a.get(), b.get());
+			CHECK(scene.graph.isAncestor(a.get(), b.get()) == ancestor);
+			CHECK(scene.graph.isInSubtree(a.get(), b.get()) == (a == b || ancestor));
+		}
+	}
+	scene.update();
+}
+
+WV_BENCHMARK(BenchDeepChainQueries) {
+	constexpr size_t kDepth = 10000;
+	constexpr size_t kQueries = 10000;
+	constexpr size_t kDrags = 1000;
+
+	TestSceneGraph scene;
+	TestRandom random;
+	for (size_t i = 0; i < kDepth; ++i) {
+		scene.spawn(EU::Vector3(0.0f, 1.0f, 0.0f), true);
+		if (i > 0) {
+			scene.graph.attach(scene.entities[i].get(), scene.entities[i - 1].get());
+		}
+	}
+	Entity* dropTarget = scene.spawn(EU::Vector3(0.0f, 0.0f, 0.0f), true);
+	scene.update();
+
+	std::vector<std::pair<Entity*, Entity*>> pairs(kQueries);
+	for (auto& [a, b] : pairs) {
+		a = scene.entities[random.next() % kDepth].get();
+		b = scene.entities[random.next() % kDepth].get();
+	}
+	// Peor caso del recorrido: el ancestro es la raiz y el nodo la hoja
+	Entity* root = scene.entities.front().get();
+	Entity* leaf = scene.entities[kDepth - 1].get();
+
+	size_t walkHits = 0;
+	TestHarness::BenchTimer timer;
+	for (const auto& [a, b] : pairs) {
+		walkHits += ParentWalkIsAncestor(a, b) ? 1 : 0;
+	}
+	TestHarness::report("isAncestor subiendo por m_parent (al azar)", timer.elapsedMs(), kQueries);
+
+	size_t intervalHits = 0;
+	timer.restart();
+	for (const auto& [a, b] : pairs) {
+		intervalHits += scene.graph.isAncestor(a, b) ? 1 : 0;
+	}
+	TestHarness::report("isAncestor por intervalos (al azar)", timer.elapsedMs(), kQueries);
+	CHECK(walkHits == intervalHits);
+
+	timer.restart();
+	for (size_t i = 0; i < 1000; ++i) {
+		walkHits += ParentWalkIsAncestor(root, leaf) ? 1 : 0;
+	}
+	TestHarness::report("isAncestor subiendo por m_parent (raiz, hoja)", timer.elapsedMs(), 1000);
+	timer.restart();
+	for (size_t i = 0; i < 1000; ++i) {
+		intervalHits += scene.graph.isAncestor(root, leaf) ? 1 : 0;
+	}
+	TestHarness::report("isAncestor por intervalos (raiz, hoja)", timer.elapsedMs(), 1000);
+	CHECK(walkHits == intervalHits);
+
+	// Arrastrar un nodo a otra raiz y soltarlo de vuelta en su padre: dos attach por arrastre
+	double dragMs = 0.0;
+	double updateMs = 0.0;
+	for (size_t drag = 0; drag < kDrags; ++drag) {
+		const size_t index = 1 + random.next() % (kDepth - 1);
+		Entity* node = scene.entities[index].get();
+		Entity* parent = scene.entities[index - 1].get();
+		timer.restart();
+		CHECK(scene.graph.attach(node, dropTarget));
+		CHECK(scene.graph.attach(node, parent));
+		dragMs += timer.elapsedMs();
+
+		// La rama soltada se recalcula en el frame siguiente
+		timer.restart();
+		scene.update();
+		updateMs += timer.elapsedMs();
+	}
+	TestHarness::report("arrastrar y soltar en la cadena (2 attach)", dragMs, kDrags);
+	TestHarness::report("update tras soltar", updateMs, kDrags);
+
+	// La cadena quedo como al principio
+	for (size_t i = 1; i < kDepth; ++i) {
+		CHECK(ParentOf(scene.entities[i].get()) == scene.entities[i - 1].get());
+	}
+	CHECK(scene.graph.isAncestor(root, leaf));
+	CHECK(!scene.graph.isAncestor(dropTarget, leaf));
+	XMFLOAT4X4 leafWorld;
+	XMStoreFloat4x4(&leafWorld, leaf->getComponent<Transform>()->getWorldMatrix());
+	CHECK(std::fabs(leafWorld._42 - static_cast<float>(kDepth)) < 1e-2f);
+}
@@ -0,0 +1,292 @@
+/**
+ * @file LightClustersTests.cpp
+ * @brief Implementa las pruebas de LightClusters dentro del subsistema Rendering.
+ * @ingroup rendering
+ *
+ * La asignacion se compara con una referencia por fuerza bruta: todo punto de
+ * una celda iluminado por una luz (dentro de su esfera y de su cono) tiene esa
+ * luz en la lista de la celda, y toda luz asignada toca la caja de la celda.
+ * Con y sin workers el resultado es el mismo. El benchmark mide build() con 1k
+ * a 10k luces frente a probar cada celda contra cada luz.
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "Rendering/LightClusters.h"
+#include "EngineUtilities/Utilities/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+constexpr float kNear = 0.5f;
+constexpr float kFar = 400.0f;
+
+/// Camara en el borde de la escena mirando hacia su centro, algo inclinada hacia abajo.
+struct ClusterCamera {
+	XMMATRIX view = XMMatrixLookToLH(XMVectorSet(0.0f, 12.0f, -20.0f, 1.0f), XMVectorSet(0.1f, -0.15f, 1.0f, 0.0f),
+	                                 XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, kNear, kFar);
+	float scaleX = XMVectorGetX(projection.r[0]);
+	float scaleY = XMVectorGetY(projection.r[1]);
+};
+
+/// Luces repartidas delante de la camara: un tercio focales y alguna direccional, que se ignora.
+std::vector<LightData>
+MakeLights(TestRandom& random, size_t count) {
+	std::vector<LightData> lights(count);
+	for (LightData& light : lights) {
+		const uint32_t kind = random.next() % 16;
+		light.type = kind == 0 ? LightType::Directional : (kind % 3 == 0 ? LightType::Spot : LightType::Point);
+		light.position = EU::Vector3(random.range(-150.0f, 150.0f), random.range(0.0f, 25.0f), random.range(-40.0f, 380.0f));
+		light.range = random.range(2.0f, 14.0f);
+		const XMVECTOR direction = XMVector3Normalize(
+			XMVectorSet(random.range(-1.0f, 1.0f), random.range(-1.0f, 0.2f), random.range(-1.0f, 1.0f), 0.0f));
+		light.direction = EU::Vector3(XMVectorGetX(direction), XMVectorGetY(direction), XMVectorGetZ(direction));
+		light.spotAngle = random.range(0.15f, 1.2f);
+	}
+	return lights;
+}
+
+/// Profundidad de vista del plano `slice` (de 0 a kSlices) de las rebanadas exponenciales.
+float
+SliceDepth(float slice) {
+	return kNear * std::pow(kFar / kNear, slice / LightClusters::kSlices);
+}
+
+/**
+ * @brief Caja en espacio de vista de la celda, calculada de nuevo a partir de su definicion.
+ *
+ * Una celda es la tesela de pantalla entre dos profundidades: su caja toma los
+ * bordes de la tesela en el plano cercano y en el lejano de la rebanada.
+ */
+void
+ReferenceClusterBox(const ClusterCamera& camera, uint32_t x, uint32_t y, uint32_t slice,
+                    XMFLOAT3& lower, XMFLOAT3& upper) {
+	const float zNear = SliceDepth(static_cast<float>(slice));
+	const float zFar = SliceDepth(static_cast<float>(slice + 1));
+	const float ndcX0 = -1.0f + 2.0f * x / LightClusters::kTilesX;
+	const float ndcX1 = -1.0f + 2.0f * (x + 1) / LightClusters::kTilesX;
+	const float ndcY0 = -1.0f + 2.0f * y / LightClusters::kTilesY;
+	const float ndcY1 = -1.0f + 2.0f * (y + 1) / LightClusters::kTilesY;
+	lower = XMFLOAT3((std::min)(ndcX0 * zNear, ndcX0 * zFar) / camera.scaleX,
+	                 (std::min)(ndcY0 * zNear, ndcY0 * zFar) / camera.scaleY, zNear);
+	upper = XMFLOAT3((std::max)(ndcX1 * zNear, ndcX1 * zFar) / camera.scaleX,
+	                 (std::max)(ndcY1 * zNear, ndcY1 * zFar) / camera.scaleY, zFar);
+}
+
+/// Centros de las luces en espacio de vista; la referencia no usa nada de LightClusters.
+std::vector<XMFLOAT3>
+ViewCenters(const ClusterCamera& camera, const std::vector<LightData>& lights) {
+	std::vector<XMFLOAT3> centers(lights.size());
+	for (size_t i = 0; i < lights.size(); ++i) {
+		const XMVECTOR center = XMVector3TransformCoord(
+			XMVectorSet(lights[i].position.x, lights[i].position.y, lights[i].position.z, 1.0f), camera.view);
+		XMStoreFloat3(&centers[i], center);
+	}
+	return centers;
+}
+
+bool
+SphereTouchesBox(const XMFLOAT3& center, float radius, const XMFLOAT3& lower, const XMFLOAT3& upper) {
+	const float dx = (std::max)((std::max)(lower.x - center.x, 0.0f), center.x - upper.x);
+	const float dy = (std::max)((std::max)(lower.y - center.y, 0.0f), center.y - upper.y);
+	const float dz = (std::max)((std::max)(lower.z - center.z, 0.0f), center.z - upper.z);
+	return dx * dx + dy * dy + dz * dz <= radius * radius * 1.0001f + 1e-4f;
+}
+
+/// `true` si la luz ilumina el punto en world (con un margen para no depender del redondeo).
+bool
+LightReaches(const LightData& light, const XMFLOAT3& point) {
+	if (light.type == LightType::Directional) {
+		return false;
+	}
+	const XMVECTOR toPoint = XMVectorSubtract(XMLoadFloat3(&point),
+		XMVectorSet(light.position.x, light.position.y, light.position.z, 0.0f));
+	const float distance = XMVectorGetX(XMVector3Length(toPoint));
+	if (distance >= light.range * 0.999f) {
+		return false;
+	}
+	if (light.type == LightType::Spot && distance > 0.0f) {
+		const XMVECTOR axis = XMVectorSet(light.direction.x, light.direction.y, light.direction.z, 0.0f);
+		const float cosine = XMVectorGetX(XMVector3Dot(toPoint, axis)) / distance;
+		return cosine > std::cos(light.spotAngle * 0.999f);
+	}
+	return true;
+}
+
+/// Asignacion por fuerza bruta: cuenta los pares celda-luz cuya esfera toca la caja de la celda.
+size_t
+CountReferencePairs(const ClusterCamera& camera, const std::vector<LightData>& lights) {
+	const std::vector<XMFLOAT3> centers = ViewCenters(camera, lights);
+	size_t pairs = 0;
+	for (uint32_t slice = 0; slice < LightClusters::kSlices; ++slice) {
+		for (uint32_t y = 0; y < LightClusters::kTilesY; ++y) {
+			for (uint32_t x = 0; x < LightClusters::kTilesX; ++x) {
+				XMFLOAT3 lower;
+				XMFLOAT3 upper;
+				ReferenceClusterBox(camera, x, y, slice, lower, upper);
+				for (size_t i = 0; i < lights.size(); ++i) {
+					pairs += lights[i].type != LightType::Directional &&
+					         SphereTouchesBox(centers[i], lights[i].range, lower, upper) ? 1 : 0;
+				}
+			}
+		}
+	}
+	return pairs;
+}
+
+/// Luces asignadas a la celda.
+const uint32_t*
+ClusterLights(const LightClusters& clusters, uint32_t cluster, uint32_t& count) {
+	const LightCluster& range = clusters.getClusters()[cluster];
+	count = range.count;
+	return clusters.getLightIndices().data() + range.offset;
+}
+
+/**
+ * @brief Compara la asignacion con la fuerza bruta.
+ *
+ * Los puntos de muestra caen dentro de una celda conocida, lejos de sus bordes:
+ * cada luz que los ilumina debe estar en la lista de esa celda. Ademas cada par
+ * asignado debe tocar la caja de su celda, y las listas deben ser contiguas.
+ */
+void
+CheckAgainstBruteForce(const LightClusters& clusters, const ClusterCamera& camera,
+                       const std::vector<LightData>& lights, TestRandom& random, size_t samples) {
+	const std::vector<LightCluster>& ranges = clusters.getClusters();
+	CHECK(ranges.size() == LightClusters::kClusterCount);
+	uint32_t offset = 0;
+	for (const LightCluster& range : ranges) {
+		CHECK(range.offset == offset);
+		offset += range.count;
+	}
+	CHECK(offset == clusters.getLightIndices().size());
+
+	const std::vector<XMFLOAT3> centers = ViewCenters(camera, lights);
+	for (uint32_t slice = 0; slice < LightClusters::kSlices; ++slice) {
+		for (uint32_t y = 0; y < LightClusters::kTilesY; ++y) {
+			for (uint32_t x = 0; x < LightClusters::kTilesX; ++x) {
+				XMFLOAT3 lower;
+				XMFLOAT3 upper;
+				ReferenceClusterBox(camera, x, y, slice, lower, upper);
+				uint32_t count = 0;
+				const uint32_t* assigned = ClusterLights(clusters, LightClusters::clusterIndex(x, y, slice), count);
+				for (uint32_t k = 0; k < count; ++k) {
+					CHECK(k == 0 || assigned[k - 1] < assigned[k]);
+					CHECK(lights[assigned[k]].type != LightType::Directional);
+					CHECK(SphereTouchesBox(centers[assigned[k]], lights[assigned[k]].range, lower, upper));
+				}
+			}
+		}
+	}
+
+	const XMMATRIX inverseView = XMMatrixInverse(nullptr, camera.view);
+	size_t reached = 0;
+	for (size_t sample = 0; sample < samples; ++sample) {
+		const uint32_t x = random.next() % LightClusters::kTilesX;
+		const uint32_t y = random.next() % LightClusters::kTilesY;
+		const uint32_t slice = random.next() % LightClusters::kSlices;
+		const float ndcX = -1.0f + 2.0f * (x + random.range(0.05f, 0.95f)) / LightClusters::kTilesX;
+		const float ndcY = -1.0f + 2.0f * (y + random.range(0.05f, 0.95f)) / LightClusters::kTilesY;
+		const float depth = SliceDepth(slice + random.range(0.05f, 0.95f));
+		XMFLOAT3 point;
+		XMStoreFloat3(&point, XMVector3TransformCoord(
+			XMVectorSet(ndcX * depth / camera.scaleX, ndcY * depth / camera.scaleY, depth, 1.0f), inverseView));
+
+		uint32_t count = 0;
+		const uint32_t* assigned = ClusterLights(clusters, LightClusters::clusterIndex(x, y, slice), count);
+		for (uint32_t i = 0; i < lights.size(); ++i) {
+			if (LightReaches(lights[i], point)) {
+				++reached;
+				CHECK(std::binary_search(assigned, assigned + count, i));
+			}
+		}
+	}
+	CHECK(reached > 0);
+}
+
+void
+Build(LightClusters& clusters, const ClusterCamera& camera, const std::vector<LightData>& lights, JobSystem* jobs) {
+	clusters.build(camera.view, camera.projection, kNear, kFar,
+	               EU::TSpan<const LightData>(lights.data(), lights.size()), jobs);
+}
+}
+
+WV_TEST(TestClusterAssignmentMatchesBruteForce) {
+	const ClusterCamera camera;
+	TestRandom random;
+	const std::vector<LightData> lights = MakeLights(random, 600);
+
+	LightClusters clusters;
+	Build(clusters, camera, lights, nullptr);
+	CHECK(clusters.getStats().visibleLights > 100);
+	CHECK(clusters.getStats().indexCount > 0);
+	CheckAgainstBruteForce(clusters, camera, lights, random, 20000);
+	// Las focales recortan pares respecto de sus esferas; nunca se agregan de mas
+	CHECK(clusters.getStats().indexCount <= CountReferencePairs(camera, lights));
+
+	// Con workers cada rebanada se asigna aparte y el resultado es el mismo
+	const std::vector<uint32_t> serialIndices = clusters.getLightIndices();
+	JobSystem jobs;
+	jobs.init(3);
+	LightClusters parallel;
+	Build(parallel, camera, lights, &jobs);
+	CHECK(parallel.getLightIndices() == serialIndices);
+	for (uint32_t cluster = 0; cluster < LightClusters::kClusterCount; ++cluster) {
+		CHECK(parallel.getClusters()[cluster].offset == clusters.getClusters()[cluster].offset);
+		CHECK(parallel.getClusters()[cluster].count == clusters.getClusters()[cluster].count);
+	}
+	jobs.destroy();
+
+	// Volver a construir con otras luces reutiliza las cajas y no deja restos
+	const std::vector<LightData> moved = MakeLights(random, 300);
+	Build(clusters, camera, moved, nullptr);
+	CheckAgainstBruteForce(clusters, camera, moved, random, 5000);
+}
+
+WV_BENCHMARK(BenchClusterAssignment) {
+	constexpr int kFrames = 20;
+	const uint32_t workers = (std::max)(1u, std::thread::hardware_concurrency()) - 1;
+	JobSystem jobs;
+	if (workers > 0) {
+		jobs.init(workers);
+	}
+	const ClusterCamera camera;
+	char label[96];
+
+	for (size_t count : { size_t(1000), size_t(2500), size_t(5000), size_t(10000) }) {
+		TestRandom random;
+		const std::vector<LightData> lights = MakeLights(random, count);
+		LightClusters clusters;
+		Build(clusters, camera, lights, nullptr);
+
+		TestHarness::BenchTimer timer;
+		for (int frame = 0; frame < kFrames; ++frame) {
+			Build(clusters, camera, lights, nullptr);
+		}
+		const LightClusterStats& stats = clusters.getStats();
+		std::snprintf(label, sizeof(label), "build (%zu luces, %zu visibles, %zu pares)", count,
+		              stats.visibleLights, stats.indexCount);
+		TestHarness::report(label, timer.elapsedMs() / kFrames, count);
+
+		if (workers > 0) {
+			LightClusters parallel;
+			timer.restart();
+			for (int frame = 0; frame < kFrames; ++frame) {
+				Build(parallel, camera, lights, &jobs);
+			}
+			std::snprintf(label, sizeof(label), "build con %u workers (%zu luces)", workers, count);
+			TestHarness::report(label, timer.elapsedMs() / kFrames, count);
+			CHECK(parallel.getLightIndices() == clusters.getLightIndices());
+		}
+
+		// Referencia: cada celda contra cada luz
+		timer.restart();
+		const size_t referencePairs = CountReferencePairs(camera, lights);
+		std::snprintf(label, sizeof(label), "fuerza bruta (%zu pares de esferas)", referencePairs);
+		TestHarness::report(label, timer.elapsedMs(), count);
+		CHECK(stats.indexCount <= referencePairs);
+		CheckAgainstBruteForce(clusters, camera, lights, random, 2000);
+	}
+	jobs.destroy();
+}
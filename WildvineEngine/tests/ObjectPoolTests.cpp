@@ -0,0 +1,142 @@
+/**
+ * @file ObjectPoolTests.cpp
+ * @brief Implementa las pruebas de TObjectPool dentro del subsistema Memory.
+ * @ingroup memory
+ *
+ * Reutilizacion de slots, estadisticas, liberacion desde otro hilo y el benchmark
+ * de spawn/despawn de 10k-1M componentes: `new T` + `new int` (MakeShared antes
+ * de los pools) frente a MakeSharedBulk con TPooledObject y RefCountPool.
+ */
+#include "TestHarness.h"
+#include "ECS/Component.h"
+#include <thread>
+
+namespace {
+/// Tamano parecido al de un componente con datos en linea.
+struct ProbePayload {
+	float values[24] = {};
+};
+
+class HeapProbe : public Component {
+public:
+	HeapProbe() : Component(ComponentType::NONE) {}
+	void init() override {}
+	void update(float) override {}
+	void render(DeviceContext&) override {}
+	void destroy() override {}
+
+	ProbePayload payload;
+};
+
+class PooledProbe : public Component, public EU::TPooledObject<PooledProbe> {
+public:
+	PooledProbe() : Component(ComponentType::NONE) {}
+	void init() override {}
+	void update(float) override {}
+	void render(DeviceContext&) override {}
+	void destroy() override {}
+
+	ProbePayload payload;
+};
+
+/// Tipo propio de la prueba entre hilos: su pool empieza vacio.
+class ThreadProbe : public Component, public EU::TPooledObject<ThreadProbe> {
+public:
+	ThreadProbe() : Component(ComponentType::NONE) {}
+	void init() override {}
+	void update(float) override {}
+	void render(DeviceContext&) override {}
+	void destroy() override {}
+
+	ProbePayload payload;
+};
+}
+
+WV_TEST(TestPoolReusesSlots) {
+	const EU::PoolStats before = PooledProbe::getPoolStats();
+	PooledProbe* first = new PooledProbe();
+	delete first;
+	PooledProbe* second = new PooledProbe();
+	// La lista libre del hilo es LIFO: el slot recien liberado vuelve primero
+	CHECK(second == first);
+	delete second;
+
+	std::vector<EU::TSharedPointer<PooledProbe>> probes;
+	EU::MakeSharedBulk<PooledProbe>(1000, probes);
+	const EU::PoolStats alive = PooledProbe::getPoolStats();
+	CHECK(alive.liveCount == before.liveCount + 1000);
+	CHECK(alive.capacity >= alive.liveCount);
+	CHECK(alive.allocations == before.allocations + 1002);
+
+	probes.clear();
+	const EU::PoolStats released = PooledProbe::getPoolStats();
+	CHECK(released.liveCount == before.liveCount);
+	CHECK(released.peakCount >= before.liveCount + 1000);
+}
+
+WV_TEST(TestPoolReleaseFromOtherThread) {
+	std::vector<ThreadProbe*> probes(5000);
+	std::thread spawner([&probes]() {
+		for (ThreadProbe*& probe : probes) {
+			probe = new ThreadProbe();
+		}
+	});
+	spawner.join();
+
+	// Otro hilo destruye lo que creo el primero: devuelve lotes a la lista compartida
+	std::thread destroyer([&probes]() {
+		for (ThreadProbe* probe : probes) {
+			delete probe;
+		}
+	});
+	destroyer.join();
+
+	const EU::PoolStats stats = ThreadProbe::getPoolStats();
+	CHECK(stats.liveCount == 0);
+	CHECK(stats.allocations == probes.size());
+	// Al terminar ambos hilos sus listas volvieron: toda la memoria se puede liberar
+	CHECK(EU::TObjectPool<ThreadProbe>::getInstance().shrink());
+	CHECK(ThreadProbe::getPoolStats().capacity == 0);
+}
+
+WV_BENCHMARK(BenchSpawnDespawn) {
+	for (size_t count : { size_t(10000), size_t(100000), size_t(1000000) }) {
+		char label[96];
+
+		// Antes de los pools: un new para el objeto y otro para el contador
+		std::vector<std::pair<HeapProbe*, int*>> heapProbes;
+		heapProbes.reserve(count);
+		TestHarness::BenchTimer timer;
+		for (size_t i = 0; i < count; ++i) {
+			heapProbes.emplace_back(new HeapProbe(), new int(1));
+		}
+		std::snprintf(label, sizeof(label), "spawn new T + new int (%zu)", count);
+		TestHarness::report(label, timer.elapsedMs(), count);
+
+		timer.restart();
+		for (auto& [probe, refCount] : heapProbes) {
+			delete probe;
+			delete refCount;
+		}
+		std::snprintf(label, sizeof(label), "despawn delete (%zu)", count);
+		TestHarness::report(label, timer.elapsedMs(), count);
+
+		// Pools: la primera ronda crece, la segunda reutiliza los bloques
+		std::vector<EU::TSharedPointer<PooledProbe>> probes;
+		for (const char* round : { "frio", "caliente" }) {
+			timer.restart();
+			EU::MakeSharedBulk<PooledProbe>(count, probes);
+			std::snprintf(label, sizeof(label), "spawn MakeSharedBulk %s (%zu)", round, count);
+			TestHarness::report(label, timer.elapsedMs(), count);
+
+			timer.restart();
+			probes.clear();
+			std::snprintf(label, sizeof(label), "despawn pool %s (%zu)", round, count);
+			TestHarness::report(label, timer.elapsedMs(), count);
+		}
+
+		const EU::PoolStats stats = PooledProbe::getPoolStats();
+		CHECK(stats.liveCount == 0);
+		std::printf("  pool: pico %zu, capacidad %zu, bloques %zu\n", stats.peakCount, stats.capacity, stats.blockCount);
+	}
+}
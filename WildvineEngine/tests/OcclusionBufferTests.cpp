@@ -0,0 +1,318 @@
+/**
+ * @file OcclusionBufferTests.cpp
+ * @brief Implementa las pruebas de OcclusionBuffer dentro del subsistema Rendering.
+ * @ingroup rendering
+ *
+ * Un quad conocido cubre exactamente los pixeles cuyo centro cae dentro y deja
+ * su profundidad interpolada; cada texel de la piramide es el maximo de los
+ * pixeles de su bloque; isVisible() nunca descarta una caja que la prueba pixel
+ * a pixel sobre el nivel 0 ve. El benchmark mide rasterizar una ciudad de
+ * edificios y probar 100k cajas.
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "Rendering/OcclusionBuffer.h"
+#include "Rendering/TriangleBVH.h"
+#include "EngineUtilities/Utilities/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+constexpr uint32_t kWidth = OcclusionBuffer::kWidth;
+constexpr uint32_t kHeight = OcclusionBuffer::kHeight;
+
+/// Quad de NDC [x0, x1] x [y0, y1] con profundidad z0 + slope * x (viewProjection identidad).
+void
+AddScreenQuad(OcclusionBuffer& buffer, float x0, float y0, float x1, float y1, float z0, float slope) {
+	const XMFLOAT3 positions[4] = { XMFLOAT3(x0, y0, z0 + slope * x0), XMFLOAT3(x1, y0, z0 + slope * x1),
+	                                XMFLOAT3(x1, y1, z0 + slope * x1), XMFLOAT3(x0, y1, z0 + slope * x0) };
+	const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+	buffer.addOccluder(positions, 4, indices, 6, XMMatrixIdentity());
+}
+
+/// Caja unitaria centrada en el origen: ocho esquinas y doce triangulos.
+struct UnitBox {
+	XMFLOAT3 positions[8];
+	uint32_t indices[36] = { 0, 1, 3, 0, 3, 2,  4, 6, 7, 4, 7, 5,  0, 4, 5, 0, 5, 1,
+	                         2, 3, 7, 2, 7, 6,  0, 2, 6, 0, 6, 4,  1, 5, 7, 1, 7, 3 };
+
+	UnitBox() {
+		for (uint32_t i = 0; i < 8; ++i) {
+			positions[i] = XMFLOAT3((i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f);
+		}
+	}
+};
+
+/// Camara a ras de suelo mirando a lo largo de +z, con el aspecto del buffer.
+XMMATRIX
+StreetViewProjection() {
+	const XMMATRIX view = XMMatrixLookToLH(XMVectorSet(0.0f, 2.0f, -10.0f, 1.0f), XMVectorSet(0.0f, -0.05f, 1.0f, 0.0f),
+	                                       XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	return view * XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<float>(kWidth) / kHeight, 0.5f, 500.0f);
+}
+
+/// Edificios a ambos lados y delante de la calle; devuelve los triangulos agregados.
+size_t
+AddCity(OcclusionBuffer& buffer, TestRandom& random, size_t buildings) {
+	const UnitBox box;
+	for (size_t i = 0; i < buildings; ++i) {
+		const float height = random.range(4.0f, 30.0f);
+		const XMMATRIX world = XMMatrixScaling(random.range(3.0f, 12.0f), height, random.range(3.0f, 12.0f)) *
+		                       XMMatrixTranslation(random.range(-120.0f, 120.0f), 0.5f * height, random.range(10.0f, 300.0f));
+		buffer.addOccluder(box.positions, 8, box.indices, 36, world);
+	}
+	return buildings * 12;
+}
+
+/// Cajas pequenas por toda la ciudad, a veces detras de los edificios y a veces no.
+std::vector<Bounds>
+MakeProbes(TestRandom& random, size_t count) {
+	std::vector<Bounds> probes(count);
+	for (Bounds& bounds : probes) {
+		bounds.center = XMFLOAT3(random.range(-150.0f, 150.0f), random.range(0.0f, 12.0f), random.range(5.0f, 400.0f));
+		bounds.extents = XMFLOAT3(random.range(0.2f, 3.0f), random.range(0.2f, 3.0f), random.range(0.2f, 3.0f));
+	}
+	return probes;
+}
+
+/**
+ * @brief Referencia: la caja esta oculta si cada pixel de su rectangulo tiene un oclusor delante.
+ *
+ * Proyecta las esquinas por su cuenta y recorre el nivel 0 entero, sin piramide.
+ */
+bool
+BruteForceHidden(const OcclusionBuffer& buffer, const XMMATRIX& viewProjection, const Bounds& bounds) {
+	const XMFLOAT3 lower = bounds.getMin();
+	const XMFLOAT3 upper = bounds.getMax();
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	float nearestZ = FLT_MAX;
+	for (uint32_t i = 0; i < 8; ++i) {
+		XMFLOAT4 clip;
+		XMStoreFloat4(&clip, XMVector3Transform(XMVectorSet((i & 1) ? upper.x : lower.x, (i & 2) ? upper.y : lower.y,
+		                                                    (i & 4) ? upper.z : lower.z, 1.0f), viewProjection));
+		if (clip.w <= 0.0f || clip.z < 0.0f) {
+			return false;
+		}
+		const float sx = (clip.x / clip.w * 0.5f + 0.5f) * kWidth;
+		const float sy = (0.5f - clip.y / clip.w * 0.5f) * kHeight;
+		minX = (std::min)(minX, sx);
+		maxX = (std::max)(maxX, sx);
+		minY = (std::min)(minY, sy);
+		maxY = (std::max)(maxY, sy);
+		nearestZ = (std::min)(nearestZ, clip.z / clip.w);
+	}
+	if (maxX < 0.0f || maxY < 0.0f || minX >= kWidth || minY >= kHeight) {
+		return false;
+	}
+	const int32_t x0 = (std::max)(static_cast<int32_t>(std::floor(minX)), 0);
+	const int32_t y0 = (std::max)(static_cast<int32_t>(std::floor(minY)), 0);
+	const int32_t x1 = (std::min)(static_cast<int32_t>(std::floor(maxX)), static_cast<int32_t>(kWidth) - 1);
+	const int32_t y1 = (std::min)(static_cast<int32_t>(std::floor(maxY)), static_cast<int32_t>(kHeight) - 1);
+	for (int32_t y = y0; y <= y1; ++y) {
+		for (int32_t x = x0; x <= x1; ++x) {
+			if (buffer.getDepth(x, y) >= nearestZ) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/// Cuenta las cajas descartadas y comprueba que la referencia tambien las da por ocultas.
+size_t
+CheckNoFalseCull(const OcclusionBuffer& buffer, const XMMATRIX& viewProjection,
+                 const std::vector<Bounds>& probes, size_t& outHidden) {
+	size_t culled = 0;
+	outHidden = 0;
+	for (const Bounds& bounds : probes) {
+		const bool hidden = BruteForceHidden(buffer, viewProjection, bounds);
+		const bool visible = buffer.isVisible(bounds);
+		CHECK(visible || hidden);
+		culled += visible ? 0 : 1;
+		outHidden += hidden ? 1 : 0;
+	}
+	return culled;
+}
+
+/// Cada texel de cada nivel es el maximo del bloque de pixeles del nivel 0 que cubre.
+void
+CheckPyramid(const OcclusionBuffer& buffer) {
+	CHECK(buffer.getLevelCount() > 1);
+	for (uint32_t level = 1; level < buffer.getLevelCount(); ++level) {
+		const uint32_t block = 1u << level;
+		for (uint32_t y = 0; y < (kHeight >> level); ++y) {
+			for (uint32_t x = 0; x < (kWidth >> level); ++x) {
+				float expected = 0.0f;
+				for (uint32_t py = y * block; py < (y + 1) * block; ++py) {
+					for (uint32_t px = x * block; px < (x + 1) * block; ++px) {
+						expected = (std::max)(expected, buffer.getDepth(px, py));
+					}
+				}
+				CHECK(buffer.getDepth(level, x, y) == expected);
+			}
+		}
+	}
+}
+}
+
+WV_TEST(TestQuadCoverage) {
+	OcclusionBuffer buffer;
+	buffer.begin(XMMatrixIdentity());
+	// Alineado a pixeles: [64, 192) x [32, 96). Desalineado e inclinado, mas lejos y solapado.
+	AddScreenQuad(buffer, -0.5f, -0.5f, 0.5f, 0.5f, 0.4f, 0.0f);
+	AddScreenQuad(buffer, 0.13f, -0.81f, 0.77f, 0.27f, 0.6f, 0.2f);
+	buffer.rasterize();
+	CHECK(buffer.getStats().triangles == 4);
+
+	size_t covered = 0;
+	for (uint32_t y = 0; y < kHeight; ++y) {
+		for (uint32_t x = 0; x < kWidth; ++x) {
+			const float px = static_cast<float>(x) + 0.5f;
+			const float py = static_cast<float>(y) + 0.5f;
+			const float ndcX = px / kWidth * 2.0f - 1.0f;
+			const float ndcY = 1.0f - py / kHeight * 2.0f;
+			const bool inFirst = x >= 64 && x < 192 && y >= 32 && y < 96;
+			const bool inSecond = ndcX >= 0.13f && ndcX <= 0.77f && ndcY >= -0.81f && ndcY <= 0.27f;
+			const float depth = buffer.getDepth(x, y);
+			if (inFirst) {
+				CHECK(std::fabs(depth - 0.4f) < 1e-6f);
+				++covered;
+			}
+			else if (inSecond) {
+				CHECK(std::fabs(depth - (0.6f + 0.2f * ndcX)) < 1e-5f);
+				++covered;
+			}
+			else {
+				CHECK(depth == 1.0f);
+			}
+		}
+	}
+	CHECK(covered > 128 * 64);
+	CheckPyramid(buffer);
+
+	// El mismo quad desde el BVH de una malla deja la misma profundidad
+	SimpleVertex vertices[4] = {};
+	vertices[0].Position = EU::Vector3(-0.5f, -0.5f, 0.4f);
+	vertices[1].Position = EU::Vector3(0.5f, -0.5f, 0.4f);
+	vertices[2].Position = EU::Vector3(0.5f, 0.5f, 0.4f);
+	vertices[3].Position = EU::Vector3(-0.5f, 0.5f, 0.4f);
+	const unsigned int indices[6] = { 0, 1, 2, 0, 2, 3 };
+	TriangleBVH bvh;
+	bvh.addSubmesh(vertices, 4, indices, 6);
+	bvh.build();
+	OcclusionBuffer fromBVH;
+	fromBVH.begin(XMMatrixIdentity());
+	fromBVH.addOccluder(bvh, XMMatrixIdentity());
+	fromBVH.rasterize();
+	CHECK(fromBVH.getStats().triangles == 2);
+	for (uint32_t y = 0; y < kHeight; ++y) {
+		for (uint32_t x = 0; x < kWidth; ++x) {
+			const bool inFirst = x >= 64 && x < 192 && y >= 32 && y < 96;
+			CHECK(fromBVH.getDepth(x, y) == (inFirst ? buffer.getDepth(x, y) : 1.0f));
+		}
+	}
+
+	// Un triangulo que cruza el plano cercano se descarta entero
+	OcclusionBuffer clipped;
+	clipped.begin(XMMatrixIdentity());
+	AddScreenQuad(clipped, -0.5f, -0.5f, 0.5f, 0.5f, -0.1f, 0.5f);
+	clipped.rasterize();
+	CHECK(clipped.getStats().triangles == 0 && clipped.getStats().trianglesSkipped == 2);
+	CHECK(clipped.getDepth(128, 64) == 1.0f);
+}
+
+WV_TEST(TestVisibilityNeverCullsVisibleBoxes) {
+	const XMMATRIX viewProjection = StreetViewProjection();
+	OcclusionBuffer buffer;
+	TestRandom random;
+	buffer.begin(viewProjection);
+	AddCity(buffer, random, 150);
+	buffer.rasterize();
+	CheckPyramid(buffer);
+
+	size_t hidden = 0;
+	const std::vector<Bounds> probes = MakeProbes(random, 5000);
+	const size_t culled = CheckNoFalseCull(buffer, viewProjection, probes, hidden);
+	// La piramide es mas gruesa que el nivel 0, pero sigue descartando buena parte
+	CHECK(culled > 0 && culled <= hidden);
+	CHECK(culled * 2 > hidden);
+
+	// Con workers cada tesela se rasteriza aparte y la profundidad es la misma
+	JobSystem jobs;
+	jobs.init(3);
+	OcclusionBuffer parallel;
+	TestRandom sameCity;
+	parallel.begin(viewProjection);
+	AddCity(parallel, sameCity, 150);
+	parallel.rasterize(&jobs);
+	for (uint32_t y = 0; y < kHeight; ++y) {
+		for (uint32_t x = 0; x < kWidth; ++x) {
+			CHECK(parallel.getDepth(x, y) == buffer.getDepth(x, y));
+		}
+	}
+	jobs.destroy();
+}
+
+WV_BENCHMARK(BenchRasterAndTest) {
+	constexpr int kFrames = 20;
+	constexpr size_t kProbes = 100000;
+	const uint32_t workers = (std::max)(1u, std::thread::hardware_concurrency()) - 1;
+	JobSystem jobs;
+	if (workers > 0) {
+		jobs.init(workers);
+	}
+	const XMMATRIX viewProjection = StreetViewProjection();
+	char label[96];
+
+	for (size_t buildings : { size_t(100), size_t(1000), size_t(10000) }) {
+		OcclusionBuffer buffer;
+		size_t triangles = 0;
+		TestHarness::BenchTimer timer;
+		for (int frame = 0; frame < kFrames; ++frame) {
+			TestRandom random;
+			buffer.begin(viewProjection);
+			triangles = AddCity(buffer, random, buildings);
+			buffer.rasterize();
+		}
+		std::snprintf(label, sizeof(label), "rasterizar %zu edificios (%zu en pantalla)", buildings,
+		              buffer.getStats().triangles);
+		TestHarness::report(label, timer.elapsedMs() / kFrames, triangles);
+
+		if (workers > 0) {
+			OcclusionBuffer parallel;
+			timer.restart();
+			for (int frame = 0; frame < kFrames; ++frame) {
+				TestRandom random;
+				parallel.begin(viewProjection);
+				AddCity(parallel, random, buildings);
+				parallel.rasterize(&jobs);
+			}
+			std::snprintf(label, sizeof(label), "rasterizar %zu edificios (%u workers)", buildings, workers);
+			TestHarness::report(label, timer.elapsedMs() / kFrames, triangles);
+		}
+
+		TestRandom random;
+		const std::vector<Bounds> probes = MakeProbes(random, kProbes);
+		size_t culled = 0;
+		timer.restart();
+		for (const Bounds& bounds : probes) {
+			culled += buffer.isVisible(bounds) ? 0 : 1;
+		}
+		std::snprintf(label, sizeof(label), "isVisible (%zu ocultas)", culled);
+		TestHarness::report(label, timer.elapsedMs(), kProbes);
+
+		size_t hidden = 0;
+		timer.restart();
+		for (const Bounds& bounds : probes) {
+			hidden += BruteForceHidden(buffer, viewProjection, bounds) ? 1 : 0;
+		}
+		std::snprintf(label, sizeof(label), "pixel a pixel en el nivel 0 (%zu ocultas)", hidden);
+		TestHarness::report(label, timer.elapsedMs(), kProbes);
+
+		size_t checkedHidden = 0;
+		CHECK(CheckNoFalseCull(buffer, viewProjection, probes, checkedHidden) == culled);
+		CHECK(checkedHidden == hidden);
+	}
+	jobs.destroy();
+}
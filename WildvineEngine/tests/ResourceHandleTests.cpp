@@ -0,0 +1,97 @@
+/**
+ * @file ResourceHandleTests.cpp
+ * @brief Implementa las pruebas de TResourceSlotArray dentro del subsistema Core.
+ * @ingroup core
+ *
+ * Handles obsoletos tras descargar y reutilizar slots, y el benchmark de busqueda:
+ * Get<T> por clave string (hash + dynamic_pointer_cast) frente a Resolve(handle).
+ */
+#include "TestHarness.h"
+#include "ResourceManager.h"
+
+namespace {
+class TestResource : public IResource {
+public:
+	explicit TestResource(const std::string& name) : IResource(name) {}
+
+	bool init() override { return true; }
+	bool load(const std::string&) override { SetState(ResourceState::Loaded); return true; }
+	void unload() override { SetState(ResourceState::Unloaded); }
+	size_t getSizeInBytes() const override { return sizeof(*this); }
+};
+
+std::string
+ResourceKey(uint32_t index) {
+	return "Assets/Models/prop_" + std::to_string(index) + ".fbx";
+}
+}
+
+WV_TEST(TestStaleHandleAfterUnload) {
+	ResourceManager manager;
+	auto first = std::make_shared<TestResource>("first");
+	const TResourceHandle<TestResource> handle = manager.Register<TestResource>("first", first);
+	CHECK(handle.isValid());
+	CHECK(manager.Resolve(handle) == first.get());
+
+	manager.Unload("first");
+	CHECK(manager.Resolve(handle) == nullptr);
+
+	// El slot liberado se reutiliza con otra generacion: el handle viejo sigue sin resolver
+	auto second = std::make_shared<TestResource>("second");
+	const TResourceHandle<TestResource> reused = manager.Register<TestResource>("second", second);
+	CHECK(reused.index == handle.index);
+	CHECK(reused.generation != handle.generation);
+	CHECK(manager.Resolve(handle) == nullptr);
+	CHECK(manager.Resolve(reused) == second.get());
+	CHECK(manager.Resolve(TResourceHandle<TestResource>{}) == nullptr);
+}
+
+WV_TEST(TestReplaceKeepsHandle) {
+	ResourceManager manager;
+	const TResourceHandle<TestResource> handle =
+		manager.Register<TestResource>("mesh", std::make_shared<TestResource>("mesh"));
+	auto reloaded = std::make_shared<TestResource>("mesh");
+	CHECK(manager.Replace<TestResource>("mesh", reloaded));
+	CHECK(manager.Resolve(handle) == reloaded.get());
+	CHECK(manager.FindHandle<TestResource>("mesh") == handle);
+}
+
+WV_BENCHMARK(BenchHandleLookup) {
+	constexpr uint32_t kResources = 4096;
+	constexpr uint32_t kLookups = 4000000;
+
+	ResourceManager manager;
+	std::vector<std::string> keys;
+	std::vector<TResourceHandle<TestResource>> handles;
+	keys.reserve(kResources);
+	handles.reserve(kResources);
+	for (uint32_t i = 0; i < kResources; ++i) {
+		keys.push_back(ResourceKey(i));
+		handles.push_back(manager.Register<TestResource>(keys.back(), std::make_shared<TestResource>(keys.back())));
+	}
+
+	// Orden de acceso pseudoaleatorio comun a ambos caminos
+	std::vector<uint32_t> order(kLookups);
+	uint32_t state = 12345u;
+	for (uint32_t& index : order) {
+		state = state * 1664525u + 1013904223u;
+		index = (state >> 8) % kResources;
+	}
+
+	uint64_t checksum = 0;
+	TestHarness::BenchTimer timer;
+	for (uint32_t index : order) {
+		checksum += manager.Get<TestResource>(keys[index])->GetID();
+	}
+	TestHarness::report("Get<T>(string) + dynamic_pointer_cast", timer.elapsedMs(), kLookups);
+
+	uint64_t handleChecksum = 0;
+	timer.restart();
+	for (uint32_t index : order) {
+		handleChecksum += manager.Resolve(handles[index])->GetID();
+	}
+	TestHarness::report("Resolve(handle)", timer.elapsedMs(), kLookups);
+
+	CHECK(checksum == handleChecksum);
+	TestHarness::keep(checksum);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file SceneLoadTests.cpp
+ * @brief Implementa las pruebas del registro de entidades dentro del subsistema SceneGraph.
+ * @ingroup scenegraph
+ *
+ * addEntity/removeEntity mantienen el registro denso y la jerarquia coherentes.
+ * El benchmark mide cargar y desmontar escenas de 10k y 100k entidades, planas y
+ * con jerarquias, frente al registro anterior (std::find al agregar y
+ * std::remove al quitar sobre todo el vector).
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "SceneGraph/HierarchyComponent.h"
+#include <algorithm>
+
+namespace {
+constexpr size_t kGroupSize = 10; ///< Raiz y nueve hijos en la escena con jerarquias.
+
+/// Crea `count` entidades sin registrar; con `grouped`, cada grupo cuelga de su primera entidad.
+void
+CreateScene(TestSceneGraph& scene, size_t count, bool grouped, std::vector<Entity*>& parents) {
+	TestRandom random;
+	parents.assign(count, nullptr);
+	for (size_t i = 0; i < count; ++i) {
+		scene.create(EU::Vector3(random.range(-500.0f, 500.0f), 0.0f, random.range(-500.0f, 500.0f)), true);
+		if (grouped && i % kGroupSize != 0) {
+			parents[i] = scene.entities[i - i % kGroupSize].get();
+		}
+	}
+}
+
+/// Registra las entidades en orden de creacion; attach() registra al hijo y cuelga.
+void
+LoadScene(TestSceneGraph& scene, const std::vector<Entity*>& parents) {
+	for (size_t i = 0; i < scene.entities.size(); ++i) {
+		if (parents[i]) {
+			scene.graph.attach(scene.entities[i].get(), parents[i]);
+		}
+		else {
+			scene.graph.addEntity(scene.entities[i].get());
+		}
+	}
+}
+}
+
+WV_TEST(TestRegistryAddRemove) {
+	TestSceneGraph scene;
+	std::vector<Entity*> parents;
+	CreateScene(scene, 200, true, parents);
+	LoadScene(scene, parents);
+	CHECK(scene.graph.m_entities.size() == 200);
+	CHECK(scene.graph.getHierarchy().size() == 200);
+	scene.update();
+
+	// Quitar una de cada tres: incluye raices de grupo, cuyos hijos pasan a ser raices
+	std::vector<Entity*> expected;
+	for (size_t i = 0; i < scene.entities.size(); ++i) {
+		Entity* entity = scene.entities[i].get();
+		if (i % 3 == 0) {
+			scene.graph.removeEntity(entity);
+			CHECK(entity->getSceneGraph() == nullptr);
+			CHECK(!scene.graph.getHierarchy().contains(entity));
+		}
+		else {
+			expected.push_back(entity);
+		}
+	}
+	// Quitar dos veces no toca el registro
+	scene.graph.removeEntity(scene.entities[0].get());
+	CHECK(scene.graph.m_entities.size() == expected.size());
+
+	std::vector<Entity*> registered = scene.graph.m_entities;
+	std::sort(registered.begin(), registered.end());
+	std::sort(expected.begin(), expected.end());
+	CHECK(registered == expected);
+	for (Entity* entity : expected) {
+		CHECK(entity->getSceneGraph() == &scene.graph);
+		HierarchyComponent* hierarchy = entity->getComponent<HierarchyComponent>();
+		// Los hijos de un padre quitado quedan como raices: todo padre restante sigue registrado
+		if (hierarchy->m_parent) {
+			CHECK(hierarchy->m_parent->getSceneGraph() == &scene.graph);
+			CHECK(scene.graph.isAncestor(hierarchy->m_parent, entity));
+		}
+	}
+	scene.update();
+}
+
+WV_BENCHMARK(BenchSceneLoadTeardown) {
+	for (size_t count : { size_t(10000), size_t(100000) }) {
+		char label[96];
+
+		// Registro anterior: busqueda lineal al agregar y al quitar
+		{
+			TestSceneGraph scene;
+			std::vector<Entity*> parents;
+			CreateScene(scene, count, false, parents);
+			std::vector<Entity*> registry;
+			TestHarness::BenchTimer timer;
+			for (const auto& entity : scene.entities) {
+				if (std::find(registry.begin(), registry.end(), entity.get()) == registry.end()) {
+					registry.push_back(entity.get());
+				}
+			}
+			std::snprintf(label, sizeof(label), "registro std::find: alta (%zu)", count);
+			TestHarness::report(label, timer.elapsedMs(), count);
+
+			timer.restart();
+			for (const auto& entity : scene.entities) {
+				registry.erase(std::remove(registry.begin(), registry.end(), entity.get()), registry.end());
+			}
+			std::snprintf(label, sizeof(label), "registro std::remove: baja (%zu)", count);
+			TestHarness::report(label, timer.elapsedMs(), count);
+			CHECK(registry.empty());
+		}
+
+		for (bool grouped : { false, true }) {
+			const char* shape = grouped ? "grupos de 10" : "plana";
+			TestSceneGraph scene;
+			std::vector<Entity*> parents;
+			CreateScene(scene, count, grouped, parents);
+
+			TestHarness::BenchTimer timer;
+			LoadScene(scene, parents);
+			std::snprintf(label, sizeof(label), "SceneGraph %s: carga (%zu)", shape, count);
+			TestHarness::report(label, timer.elapsedMs(), count);
+			CHECK(scene.graph.m_entities.size() == count);
+
+			// El primer update inserta todos los proxies en el indice espacial
+			timer.restart();
+			scene.update();
+			std::snprintf(label, sizeof(label), "SceneGraph %s: primer update (%zu)", shape, count);
+			TestHarness::report(label, timer.elapsedMs(), count);
+
+			timer.restart();
+			for (const auto& entity : scene.entities) {
+				scene.graph.removeEntity(entity.get());
+			}
+			std::snprintf(label, sizeof(label), "SceneGraph %s: desmontaje (%zu)", shape, count);
+			TestHarness::report(label, timer.elapsedMs(), count);
+			CHECK(scene.graph.m_entities.empty());
+			CHECK(scene.graph.getHierarchy().size() == 0);
+			CHECK(scene.graph.getStorage().getChunkCount() == 0);
+		}
+	}
+}
@@ -0,0 +1,135 @@
+/**
+ * @file ShadowCascadesTests.cpp
+ * @brief Implementa las pruebas de ShadowCascades dentro del subsistema Rendering.
+ * @ingroup rendering
+ *
+ * Cortes, volumenes de las cascadas, ajuste al texel y estabilidad al girar la
+ * camara. Sin GPU: solo se compila la matematica de las cascadas.
+ */
+#include "TestHarness.h"
+#include "Rendering/ShadowCascades.h"
+#include <cmath>
+
+namespace {
+constexpr float kNear = 0.1f;
+constexpr float kFar = 300.0f;
+constexpr float kFov = 1.0f;
+constexpr float kAspect = 16.0f / 9.0f;
+constexpr uint32_t kResolution = 1024;
+
+XMMATRIX
+CameraView(const XMFLOAT3& eye, float yaw, float pitch) {
+	const XMVECTOR eyePoint = XMLoadFloat3(&eye);
+	const XMVECTOR forward = XMVectorSet(std::sin(yaw) * std::cos(pitch), std::sin(pitch),
+	                                     std::cos(yaw) * std::cos(pitch), 0.0f);
+	return XMMatrixLookAtLH(eyePoint, XMVectorAdd(eyePoint, forward), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+}
+
+/// Ajusta las cascadas sin casters: el rango de profundidad depende solo de la rebanada.
+ShadowCascades
+FitCascades(const XMMATRIX& view, uint32_t cascadeCount) {
+	ShadowCascadeSettings settings;
+	settings.cascadeCount = cascadeCount;
+	settings.maxDistance = 120.0f;
+
+	ShadowCascades cascades;
+	cascades.setSettings(settings);
+	const XMFLOAT3 lightDirection(0.3f, -1.0f, 0.4f);
+	cascades.fit(view, XMMatrixPerspectiveFovLH(kFov, kAspect, kNear, kFar), kNear, kFar,
+	             lightDirection, BoundsBatch(), kResolution);
+	return cascades;
+}
+
+bool
+IsWhole(float value) {
+	return std::fabs(value - std::round(value)) < 1e-3f;
+}
+
+WV_TEST(TestSplits) {
+	float splits[ShadowCascades::kMaxCascades + 1];
+	for (float lambda : { 0.0f, 0.5f, 0.75f, 1.0f }) {
+		ShadowCascades::computeSplits(kNear, 120.0f, 4, lambda, splits);
+		CHECK(splits[0] == kNear);
+		CHECK(splits[4] == 120.0f);
+		for (uint32_t i = 0; i < 4; ++i) {
+			CHECK(splits[i] < splits[i + 1]);
+		}
+	}
+
+	// Extremos de la mezcla: reparto lineal y logaritmico exactos
+	ShadowCascades::computeSplits(10.0f, 1000.0f, 2, 0.0f, splits);
+	CHECK(std::fabs(splits[1] - 505.0f) < 1e-2f);
+	ShadowCascades::computeSplits(10.0f, 1000.0f, 2, 1.0f, splits);
+	CHECK(std::fabs(splits[1] - 100.0f) < 1e-2f);
+
+	// Con una cascada solo quedan los extremos
+	ShadowCascades::computeSplits(kNear, 120.0f, 1, 0.75f, splits);
+	CHECK(splits[0] == kNear);
+	CHECK(splits[1] == 120.0f);
+}
+
+WV_TEST(TestSliceInsideVolumes) {
+	XMFLOAT4X4 projection;
+	XMStoreFloat4x4(&projection, XMMatrixPerspectiveFovLH(kFov, kAspect, kNear, kFar));
+
+	for (uint32_t frame = 0; frame < 16; ++frame) {
+		const XMFLOAT3 eye(frame * 3.7f, 5.0f, frame * -2.1f);
+		const XMMATRIX view = CameraView(eye, frame * 0.4f, -0.3f + frame * 0.04f);
+		const ShadowCascades cascades = FitCascades(view, 4);
+		CHECK(cascades.getCascadeCount() == 4);
+		const XMMATRIX inverseView = XMMatrixInverse(nullptr, view);
+
+		for (uint32_t c = 0; c < cascades.getCascadeCount(); ++c) {
+			const ShadowCascade& cascade = cascades.getCascade(c);
+			// Esquinas de la rebanada [splitNear, splitFar] en espacio de vista -> NDC de la cascada
+			for (uint32_t corner = 0; corner < 8; ++corner) {
+				const float z = (corner & 4) ? cascade.splitFar : cascade.splitNear;
+				const float x = z / projection._11;
+				const float y = z / projection._22;
+				const XMVECTOR viewPoint = XMVectorSet((corner & 1) ? x : -x, (corner & 2) ? y : -y, z, 1.0f);
+				const XMVECTOR worldPoint = XMVector3TransformCoord(viewPoint, inverseView);
+				XMFLOAT3 ndc;
+				XMStoreFloat3(&ndc, XMVector3TransformCoord(worldPoint, cascade.viewProjection));
+				CHECK(std::fabs(ndc.x) <= 1.0001f);
+				CHECK(std::fabs(ndc.y) <= 1.0001f);
+				CHECK(ndc.z >= -1e-4f && ndc.z <= 1.0001f);
+			}
+		}
+	}
+}
+
+WV_TEST(TestSnappedCenters) {
+	for (uint32_t frame = 0; frame < 16; ++frame) {
+		const XMFLOAT3 eye(frame * 0.37f, 5.0f, frame * 0.21f);
+		const ShadowCascades cascades = FitCascades(CameraView(eye, frame * 0.13f, -0.2f), 4);
+		for (uint32_t c = 0; c < cascades.getCascadeCount(); ++c) {
+			const ShadowCascade& cascade = cascades.getCascade(c);
+			CHECK(std::fabs(cascade.texelSize - 2.0f * cascade.radius / kResolution) < 1e-5f);
+			CHECK(IsWhole(cascade.center.x / cascade.texelSize));
+			CHECK(IsWhole(cascade.center.y / cascade.texelSize));
+			CHECK(IsWhole(cascade.center.z / (cascade.radius * ShadowCascades::kDepthSnapFraction)));
+
+			// El origen world cae en un borde de texel del shadow map
+			XMFLOAT3 origin;
+			XMStoreFloat3(&origin, XMVector3TransformCoord(XMVectorZero(), cascade.viewProjection));
+			CHECK(IsWhole((origin.x * 0.5f + 0.5f) * kResolution));
+			CHECK(IsWhole((origin.y * 0.5f + 0.5f) * kResolution));
+		}
+	}
+}
+
+WV_TEST(TestRadiusStableUnderRotation) {
+	const XMFLOAT3 eye(12.0f, 4.0f, -8.0f);
+	const ShadowCascades reference = FitCascades(CameraView(eye, 0.0f, 0.0f), 4);
+	for (uint32_t step = 1; step < 32; ++step) {
+		const float yaw = step * 0.29f;
+		const float pitch = -0.6f + step * 0.035f;
+		const ShadowCascades rotated = FitCascades(CameraView(eye, yaw, pitch), 4);
+		CHECK(rotated.getCascadeCount() == reference.getCascadeCount());
+		for (uint32_t c = 0; c < rotated.getCascadeCount(); ++c) {
+			CHECK(rotated.getCascade(c).radius == reference.getCascade(c).radius);
+			CHECK(rotated.getCascade(c).texelSize == reference.getCascade(c).texelSize);
+		}
+	}
+}
+}
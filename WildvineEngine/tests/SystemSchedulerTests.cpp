@@ -0,0 +1,184 @@
+/**
+ * @file SystemSchedulerTests.cpp
+ * @brief Implementa las pruebas de SystemScheduler dentro del subsistema ECS.
+ * @ingroup ecs
+ *
+ * Orden determinista entre sistemas en conflicto, reparto de chunks entre workers
+ * y el benchmark de escalado: el mismo run() con 1..N nucleos (el hilo que llama
+ * mas N-1 workers de JobSystem::init).
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "ECS/SystemScheduler.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+struct SchedulerScene {
+	Mesh mesh;
+	std::vector<std::unique_ptr<TestEntity>> entities;
+	ArchetypeStorage storage;
+
+	~SchedulerScene() { storage.clear(); }
+};
+
+/// `count` entidades con Transform; una de cada dos tambien con MeshRenderer.
+void
+BuildScene(SchedulerScene& scene, size_t count) {
+	InitBoxMesh(scene.mesh, XMFLOAT3(0.5f, 0.5f, 0.5f));
+	TestRandom random;
+	for (size_t i = 0; i < count; ++i) {
+		auto entity = std::make_unique<TestEntity>();
+		EU::TSharedPointer<Transform> transform = EU::MakeShared<Transform>();
+		transform->setTransform(EU::Vector3(random.range(-100.0f, 100.0f), 0.0f, random.range(-100.0f, 100.0f)),
+		                        EU::Vector3(0.0f, random.range(0.0f, 6.0f), 0.0f), EU::Vector3(1.0f, 1.0f, 1.0f));
+		entity->addComponent(transform);
+		if (i % 2 == 0) {
+			EU::TSharedPointer<MeshRendererComponent> meshRenderer = EU::MakeShared<MeshRendererComponent>();
+			meshRenderer->setMesh(&scene.mesh);
+			entity->addComponent(meshRenderer);
+		}
+		scene.storage.add(entity.get());
+		scene.entities.push_back(std::move(entity));
+	}
+}
+
+/// Sistemas del update con trabajo por fila: matrices locales y cajas world.
+void
+AddFrameSystems(SystemScheduler& scheduler, ArchetypeStorage& storage, std::atomic<uint64_t>& visibleRows) {
+	const uint32_t transformBit = Entity::componentBit(ComponentType::TRANSFORM);
+	const uint32_t meshRendererBit = Entity::componentBit(ComponentType::MESH_RENDERER);
+	EntityQuery* transformQuery = &storage.query<Transform>();
+	EntityQuery* renderQuery = &storage.query<Transform, MeshRendererComponent>();
+
+	scheduler.addSystem("LocalTransforms", 0, transformBit, [transformQuery](const SystemContext& context) {
+		context.forEachChunkParallel(*transformQuery, [](const Archetype& archetype, const ArchetypeChunk& chunk) {
+			TransformData* transforms = archetype.transforms(chunk);
+			for (uint32_t row = 0; row < chunk.count; ++row) {
+				transforms[row].flags |= TransformData::kLocalDirty;
+				Transform::updateMatrices(transforms[row]);
+				transforms[row].worldMatrix = transforms[row].matrix;
+			}
+		});
+	});
+
+	scheduler.addSystem("WorldBounds", transformBit | meshRendererBit, 0,
+		[renderQuery, &visibleRows](const SystemContext& context) {
+			context.forEachChunkParallel(*renderQuery,
+				[&visibleRows](const Archetype& archetype, const ArchetypeChunk& chunk) {
+					const TransformData* transforms = archetype.transforms(chunk);
+					const MeshRendererData* meshRenderers = archetype.meshRenderers(chunk);
+					uint64_t visible = 0;
+					for (uint32_t row = 0; row < chunk.count; ++row) {
+						const Bounds bounds = meshRenderers[row].mesh->getBounds().transformed(transforms[row].worldMatrix);
+						visible += bounds.center.y > -1.0f ? 1 : 0;
+					}
+					visibleRows += visible;
+				});
+		});
+}
+}
+
+WV_TEST(TestConflictingSystemsKeepOrder) {
+	constexpr uint32_t kA = 1u << 1;
+	constexpr uint32_t kB = 1u << 2;
+
+	JobSystem jobs;
+	jobs.init(4);
+	SystemContext context;
+	context.jobs = &jobs;
+
+	for (int frame = 0; frame < 50; ++frame) {
+		std::mutex mutex;
+		std::vector<int> order;
+		auto record = [&mutex, &order](int id) {
+			return [&mutex, &order, id](const SystemContext&) {
+				std::lock_guard<std::mutex> lock(mutex);
+				order.push_back(id);
+			};
+		};
+
+		// 0 escribe A; 1 lee A; 2 escribe B (independiente); 3 escribe A y B
+		SystemScheduler scheduler;
+		scheduler.addSystem("WriteA", 0, kA, record(0));
+		scheduler.addSystem("ReadA", kA, 0, record(1));
+		scheduler.addSystem("WriteB", 0, kB, record(2));
+		scheduler.addSystem("WriteAB", 0, kA | kB, record(3));
+		scheduler.run(context);
+
+		CHECK(order.size() == 4);
+		auto position = [&order](int id) {
+			return std::find(order.begin(), order.end(), id) - order.begin();
+		};
+		CHECK(position(0) < position(1));
+		CHECK(position(1) < position(3));
+		CHECK(position(2) < position(3));
+	}
+	jobs.destroy();
+}
+
+WV_TEST(TestChunksVisitedOnce) {
+	SchedulerScene scene;
+	BuildScene(scene, 5000);
+	EntityQuery& query = scene.storage.query<Transform>();
+
+	JobSystem jobs;
+	jobs.init(3);
+	SystemContext context;
+	context.jobs = &jobs;
+
+	std::atomic<uint32_t> rows{ 0 };
+	std::atomic<uint32_t> chunks{ 0 };
+	context.forEachChunkParallel(query, [&rows, &chunks](const Archetype&, const ArchetypeChunk& chunk) {
+		rows += chunk.count;
+		++chunks;
+	});
+	CHECK(rows == 5000);
+	CHECK(chunks == scene.storage.getChunkCount());
+	jobs.destroy();
+}
+
+WV_BENCHMARK(BenchSchedulerScaling) {
+	constexpr size_t kEntities = 200000;
+	constexpr int kFrames = 20;
+
+	SchedulerScene scene;
+	BuildScene(scene, kEntities);
+	std::atomic<uint64_t> visibleRows{ 0 };
+	SystemScheduler scheduler;
+	AddFrameSystems(scheduler, scene.storage, visibleRows);
+
+	const uint32_t maxCores = (std::max)(1u, std::thread::hardware_concurrency());
+	double singleCoreMs = 0.0;
+	JobSystem jobs;
+	for (uint32_t cores = 1; cores <= maxCores; ++cores) {
+		// init(0) usaria todos los nucleos: con un nucleo no se arrancan workers
+		if (cores == 1) {
+			jobs.destroy();
+		}
+		else {
+			jobs.init(cores - 1);
+		}
+		SystemContext context;
+		context.jobs = &jobs;
+		context.storage = &scene.storage;
+		scheduler.run(context);
+
+		visibleRows = 0;
+		TestHarness::BenchTimer timer;
+		for (int frame = 0; frame < kFrames; ++frame) {
+			scheduler.run(context);
+		}
+		const double elapsedMs = timer.elapsedMs();
+		singleCoreMs = cores == 1 ? elapsedMs : singleCoreMs;
+
+		char label[96];
+		std::snprintf(label, sizeof(label), "%u nucleos (200k filas x %d frames, x%.2f)", cores, kFrames,
+		              singleCoreMs / elapsedMs);
+		TestHarness::report(label, elapsedMs, kEntities * kFrames);
+		CHECK(visibleRows == kEntities / 2 * kFrames);
+	}
+	jobs.destroy();
+}
@@ -0,0 +1,90 @@
+/**
+ * @file TestHarness.h
+ * @brief Declara el registro de pruebas y benchmarks del proyecto WildvineEngineTests.
+ * @ingroup tests
+ *
+ * Cada archivo registra sus funciones con WV_TEST o WV_BENCHMARK y TestMain las
+ * ejecuta en orden de registro. Las pruebas corren siempre (la compilacion las
+ * ejecuta); los benchmarks solo con `--bench`, porque usan escenas de 10k-1M
+ * objetos y tardan segundos.
+ */
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+namespace TestHarness {
+using TestFunction = void (*)();
+
+struct TestCase {
+	const char* name;
+	TestFunction function;
+	bool benchmark;
+};
+
+/// Pruebas registradas por los constructores estaticos de cada archivo.
+std::vector<TestCase>&
+registry();
+
+/// Comprobaciones fallidas en la ejecucion actual.
+int&
+failureCount();
+
+struct Registrar {
+	Registrar(const char* name, TestFunction function, bool benchmark) {
+		registry().push_back({ name, function, benchmark });
+	}
+};
+
+/// Cronometro de pared para los benchmarks.
+class BenchTimer {
+public:
+	BenchTimer() : m_start(std::chrono::high_resolution_clock::now()) {}
+
+	void
+	restart() { m_start = std::chrono::high_resolution_clock::now(); }
+
+	double
+	elapsedMs() const {
+		return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_start).count();
+	}
+
+private:
+	std::chrono::high_resolution_clock::time_point m_start;
+};
+
+/// Escribe una linea de resultado: tiempo total y coste por operacion.
+inline void
+report(const char* label, double milliseconds, size_t operations) {
+	const double nsPerOp = operations > 0 ? milliseconds * 1.0e6 / static_cast<double>(operations) : 0.0;
+	std::printf("  %-52s %10.3f ms %12.1f ns/op\n", label, milliseconds, nsPerOp);
+}
+
+/// Evita que el optimizador descarte un resultado que solo se mide.
+template<typename T>
+inline void
+keep(const T& value) {
+	static volatile T sink;
+	sink = value;
+}
+}
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::fprintf(stderr, "%s:%d: fallo: %s\n", __FILE__, __LINE__, #condition); \
+			++TestHarness::failureCount(); \
+		} \
+	} while (0)
+
+#define WV_REGISTER(name, benchmark) \
+	static void name(); \
+	static const TestHarness::Registrar name##Registrar(#name, &name, benchmark); \
+	static void name()
+
+/// Prueba de correccion: corre en cada compilacion.
+#define WV_TEST(name) WV_REGISTER(name, false)
+
+/// Benchmark: corre solo con `--bench`.
+#define WV_BENCHMARK(name) WV_REGISTER(name, true)
@@ -0,0 +1,66 @@
+/**
+ * @file TestMain.cpp
+ * @brief Implementa el punto de entrada de WildvineEngineTests.
+ * @ingroup tests
+ *
+ * Uso: `WildvineEngineTests [--bench] [filtro]`. Sin argumentos ejecuta todas las
+ * pruebas; `--bench` agrega los benchmarks y `filtro` limita la ejecucion a los
+ * nombres que lo contienen. Devuelve 0 si todas las comprobaciones pasan.
+ */
+#include "TestHarness.h"
+#include <cstring>
+
+namespace TestHarness {
+std::vector<TestCase>&
+registry() {
+	static std::vector<TestCase> cases;
+	return cases;
+}
+
+int&
+failureCount() {
+	static int failures = 0;
+	return failures;
+}
+}
+
+int
+main(int argc, char** argv) {
+	bool runBenchmarks = false;
+	const char* filter = nullptr;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--bench") == 0) {
+			runBenchmarks = true;
+		}
+		else {
+			filter = argv[i];
+		}
+	}
+
+	int executed = 0;
+	for (const TestHarness::TestCase& testCase : TestHarness::registry()) {
+		if (testCase.benchmark && !runBenchmarks) {
+			continue;
+		}
+		if (filter && !std::strstr(testCase.name, filter)) {
+			continue;
+		}
+		if (testCase.benchmark) {
+			std::printf("%s\n", testCase.name);
+		}
+		const int failuresBefore = TestHarness::failureCount();
+		testCase.function();
+		if (TestHarness::failureCount() != failuresBefore) {
+			std::fprintf(stderr, "%s: %d comprobaciones fallaron\n", testCase.name,
+			             TestHarness::failureCount() - failuresBefore);
+		}
+		++executed;
+	}
+
+	if (TestHarness::failureCount() > 0) {
+		std::fprintf(stderr, "WildvineEngineTests: %d comprobaciones fallaron\n", TestHarness::failureCount());
+		return 1;
+	}
+	std::printf("WildvineEngineTests: OK (%d ejecutadas)\n", executed);
+	return 0;
+}
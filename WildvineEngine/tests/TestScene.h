@@ -0,0 +1,113 @@
+/**
+ * @file TestScene.h
+ * @brief Declara las entidades y mallas sin GPU que usan las pruebas del ECS y del SceneGraph.
+ * @ingroup tests
+ *
+ * Actor crea buffers de D3D en su constructor; las pruebas usan TestEntity, que
+ * solo lleva los componentes que cada escena le agrega, y mallas que solo tienen
+ * la caja local de sus submallas. TestSceneGraph registra esas entidades en un
+ * SceneGraph real para medir update y gather sin dispositivo.
+ */
+#pragma once
+#include "ECS/Entity.h"
+#include "ECS/MeshRendererComponent.h"
+#include "ECS/Transform.h"
+#include "DeviceContext.h"
+#include "Rendering/Mesh.h"
+#include "SceneGraph/SceneGraph.h"
+#include <memory>
+
+/**
+ * @brief Entidad concreta sin logica propia ni recursos de GPU.
+ */
+class
+TestEntity : public Entity {
+public:
+	void awake() override {}
+	void init() override {}
+	void update(float, DeviceContext&) override {}
+	void render(DeviceContext&) override {}
+	void destroy() override {}
+
+	/// Componentes en orden de alta, para reproducir la busqueda lineal anterior.
+	const std::vector<EU::TSharedPointer<Component>>&
+	getComponents() const { return m_components; }
+};
+
+/**
+ * @brief Deja en `mesh` una submalla sin buffers con la caja local indicada.
+ */
+inline void
+InitBoxMesh(Mesh& mesh, const XMFLOAT3& halfExtents) {
+	Submesh submesh;
+	submesh.bounds.center = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	submesh.bounds.extents = halfExtents;
+	mesh.getSubmeshes().push_back(submesh);
+	mesh.updateBounds();
+}
+
+/**
+ * @brief Generador lineal congruente: escenas reproducibles sin <random>.
+ */
+struct TestRandom {
+	uint32_t state = 0x9E3779B9u;
+
+	uint32_t
+	next() {
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+
+	/// Valor uniforme en [minValue, maxValue).
+	float
+	range(float minValue, float maxValue) {
+		return minValue + (maxValue - minValue) * static_cast<float>(next() & 0xFFFF) / 65536.0f;
+	}
+};
+
+/**
+ * @brief SceneGraph inicializado con entidades propiedad de la prueba.
+ *
+ * El DeviceContext no tiene dispositivo: SceneGraph::update solo lo reenvia a
+ * Entity::update, que en TestEntity no hace nada.
+ */
+struct TestSceneGraph {
+	std::vector<std::unique_ptr<TestEntity>> entities;
+	Mesh boxMesh; ///< Caja de 1x1x1 compartida por los renderables.
+	DeviceContext deviceContext;
+	SceneGraph graph;
+
+	TestSceneGraph() {
+		InitBoxMesh(boxMesh, XMFLOAT3(0.5f, 0.5f, 0.5f));
+		graph.init();
+	}
+
+	~TestSceneGraph() { graph.destroy(); }
+
+	/// Crea una entidad en `position` sin registrarla; con `renderable` lleva un MeshRenderer con boxMesh.
+	TestEntity*
+	create(const EU::Vector3& position, bool renderable) {
+		entities.push_back(std::make_unique<TestEntity>());
+		TestEntity* entity = entities.back().get();
+		EU::TSharedPointer<Transform> transform = EU::MakeShared<Transform>();
+		transform->setTransform(position, EU::Vector3(0.0f, 0.0f, 0.0f), EU::Vector3(1.0f, 1.0f, 1.0f));
+		entity->addComponent(transform);
+		if (renderable) {
+			EU::TSharedPointer<MeshRendererComponent> meshRenderer = EU::MakeShared<MeshRendererComponent>();
+			meshRenderer->setMesh(&boxMesh);
+			entity->addComponent(meshRenderer);
+		}
+		return entity;
+	}
+
+	/// create() y registro en el grafo.
+	TestEntity*
+	spawn(const EU::Vector3& position, bool renderable) {
+		TestEntity* entity = create(position, renderable);
+		graph.addEntity(entity);
+		return entity;
+	}
+
+	void
+	update() { graph.update(1.0f / 60.0f, deviceContext); }
+};
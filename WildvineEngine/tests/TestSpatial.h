@@ -0,0 +1,138 @@
+/**
+ * @file TestSpatial.h
+ * @brief Declara las escenas de cajas y las pruebas de referencia que usan las pruebas de los indices espaciales.
+ * @ingroup tests
+ *
+ * Las consultas de un SpatialIndex devuelven candidatos segun cajas gordas o
+ * sueltas: deben incluir todo lo que la prueba exacta caja a caja acepta.
+ */
+#pragma once
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "Rendering/Frustum.h"
+#include "SceneGraph/SpatialIndex.h"
+#include <algorithm>
+
+/**
+ * @brief Caja de 1 a 4 unidades de lado con centro en [-halfSize, halfSize] sobre XZ.
+ */
+inline Bounds
+RandomBox(TestRandom& random, float halfSize) {
+	Bounds bounds;
+	bounds.center = XMFLOAT3(random.range(-halfSize, halfSize), random.range(0.0f, 20.0f),
+	                         random.range(-halfSize, halfSize));
+	bounds.extents = XMFLOAT3(random.range(0.5f, 2.0f), random.range(0.5f, 2.0f), random.range(0.5f, 2.0f));
+	return bounds;
+}
+
+/**
+ * @brief Frustum de una camara en `eye` con el giro `yaw` (radianes) sobre Y.
+ */
+inline Frustum
+CameraFrustum(const XMFLOAT3& eye, float yaw, float farPlane) {
+	const XMVECTOR position = XMLoadFloat3(&eye);
+	const XMVECTOR forward = XMVectorSet(std::sin(yaw), -0.1f, std::cos(yaw), 0.0f);
+	const XMMATRIX view = XMMatrixLookToLH(position, forward, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	Frustum frustum;
+	frustum.setFromMatrix(view * XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, farPlane));
+	return frustum;
+}
+
+/// Prueba exacta de solapamiento entre dos cajas validas.
+inline bool
+BoxesOverlap(const Bounds& a, const Bounds& b) {
+	return std::fabs(a.center.x - b.center.x) <= a.extents.x + b.extents.x &&
+	       std::fabs(a.center.y - b.center.y) <= a.extents.y + b.extents.y &&
+	       std::fabs(a.center.z - b.center.z) <= a.extents.z + b.extents.z;
+}
+
+/// `true` si todos los `expected` estan en `candidates` (ambos se ordenan).
+inline bool
+ContainsAll(std::vector<int32_t>& candidates, std::vector<int32_t>& expected) {
+	std::sort(candidates.begin(), candidates.end());
+	std::sort(expected.begin(), expected.end());
+	return std::includes(candidates.begin(), candidates.end(), expected.begin(), expected.end());
+}
+
+/// Distancia al cuadrado del punto a la caja (0 si esta dentro).
+inline float
+DistanceSqToBox(const Bounds& bounds, const XMFLOAT3& point) {
+	const XMFLOAT3 lower = bounds.getMin();
+	const XMFLOAT3 upper = bounds.getMax();
+	const float dx = (std::max)((std::max)(lower.x - point.x, 0.0f), point.x - upper.x);
+	const float dy = (std::max)((std::max)(lower.y - point.y, 0.0f), point.y - upper.y);
+	const float dz = (std::max)((std::max)(lower.z - point.z, 0.0f), point.z - upper.z);
+	return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief Comprueba que frustum, caja, esfera y rayo de `index` cubren la prueba exacta.
+ *
+ * `boxes[proxy]` es la caja actual de cada proxy de `live`. Las consultas estan
+ * pensadas para una escena de `RandomBox(random, 100)`.
+ */
+inline void
+CheckQueriesCoverExact(const SpatialIndex& index, const std::vector<Bounds>& boxes, const std::vector<int32_t>& live) {
+	std::vector<int32_t> candidates;
+	std::vector<int32_t> expected;
+
+	const Frustum frustum = CameraFrustum(XMFLOAT3(0.0f, 10.0f, -120.0f), 0.3f, 150.0f);
+	std::vector<SpatialHit> frustumHits;
+	index.collectFrustum(frustum, frustumHits);
+	for (const SpatialHit& hit : frustumHits) {
+		candidates.push_back(hit.proxy);
+	}
+	for (int32_t proxy : live) {
+		if (frustum.intersects(boxes[proxy])) {
+			expected.push_back(proxy);
+		}
+	}
+	CHECK(!expected.empty());
+	CHECK(ContainsAll(candidates, expected));
+
+	Bounds region;
+	region.center = XMFLOAT3(10.0f, 5.0f, -20.0f);
+	region.extents = XMFLOAT3(30.0f, 10.0f, 15.0f);
+	candidates.clear();
+	expected.clear();
+	index.collectAABB(region, candidates);
+	for (int32_t proxy : live) {
+		if (BoxesOverlap(boxes[proxy], region)) {
+			expected.push_back(proxy);
+		}
+	}
+	CHECK(!expected.empty());
+	CHECK(ContainsAll(candidates, expected));
+
+	const XMFLOAT3 center(-30.0f, 8.0f, 40.0f);
+	const float radius = 25.0f;
+	candidates.clear();
+	expected.clear();
+	index.collectSphere(center, radius, candidates);
+	for (int32_t proxy : live) {
+		if (DistanceSqToBox(boxes[proxy], center) <= radius * radius) {
+			expected.push_back(proxy);
+		}
+	}
+	CHECK(!expected.empty());
+	CHECK(ContainsAll(candidates, expected));
+
+	const XMFLOAT3 origin(-100.0f, 10.0f, -3.0f);
+	const XMFLOAT3 direction(1.0f, 0.0f, 0.05f);
+	const XMFLOAT3 inverse(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+	std::vector<SpatialRayHit> rayHits;
+	index.collectRay(origin, direction, 200.0f, rayHits);
+	candidates.clear();
+	expected.clear();
+	for (const SpatialRayHit& hit : rayHits) {
+		candidates.push_back(hit.proxy);
+	}
+	for (int32_t proxy : live) {
+		float tEnter = 0.0f;
+		if (Bounds::rayIntersects(boxes[proxy].getMin(), boxes[proxy].getMax(), origin, inverse, 200.0f, tEnter)) {
+			expected.push_back(proxy);
+		}
+	}
+	CHECK(!expected.empty());
+	CHECK(ContainsAll(candidates, expected));
+}
@@ -0,0 +1,204 @@
+/**
+ * @file TriangleBVHTests.cpp
+ * @brief Implementa las pruebas de TriangleBVH dentro del subsistema Rendering.
+ * @ingroup rendering
+ *
+ * Los rayos contra el BVH devuelven el mismo impacto que probar todos los
+ * triangulos de la malla, y los nodos cumplen lo que el cache de Model3D exige
+ * al leerlos (hijos despues del padre, hojas de hasta kLeafSize). El benchmark
+ * construye el arbol de un terreno procedural de 2M triangulos y mide el picking
+ * frente a la fuerza bruta.
+ */
+#include "TestHarness.h"
+#include "TestScene.h"
+#include "Rendering/TriangleBVH.h"
+#include <cmath>
+
+namespace {
+/// Terreno de `cells` x `cells` celdas de 1 unidad con colinas; dos triangulos por celda.
+struct TerrainMesh {
+	std::vector<SimpleVertex> vertices;
+	std::vector<unsigned int> indices;
+
+	explicit TerrainMesh(uint32_t cells) {
+		const uint32_t side = cells + 1;
+		const float half = 0.5f * static_cast<float>(cells);
+		vertices.resize(static_cast<size_t>(side) * side);
+		for (uint32_t z = 0; z < side; ++z) {
+			for (uint32_t x = 0; x < side; ++x) {
+				const float px = static_cast<float>(x) - half;
+				const float pz = static_cast<float>(z) - half;
+				const float height = 8.0f * std::sin(px * 0.05f) * std::cos(pz * 0.07f) + std::sin(px * 0.9f + pz * 1.3f);
+				vertices[static_cast<size_t>(z) * side + x].Position = EU::Vector3(px, height, pz);
+			}
+		}
+		indices.reserve(static_cast<size_t>(cells) * cells * 6);
+		for (uint32_t z = 0; z < cells; ++z) {
+			for (uint32_t x = 0; x < cells; ++x) {
+				const unsigned int corner = z * side + x;
+				indices.insert(indices.end(), { corner, corner + side, corner + 1,
+				                                corner + 1, corner + side, corner + side + 1 });
+			}
+		}
+	}
+
+	size_t
+	getTriangleCount() const { return indices.size() / 3; }
+};
+
+/// Rayo de picking: desde una camara sobre el terreno hacia un punto al azar de su superficie.
+struct PickRay {
+	XMFLOAT3 origin;
+	XMFLOAT3 direction;
+};
+
+std::vector<PickRay>
+MakePickRays(TestRandom& random, float half, size_t count) {
+	std::vector<PickRay> rays(count);
+	for (PickRay& ray : rays) {
+		ray.origin = XMFLOAT3(random.range(-half, half), 40.0f, random.range(-half, half));
+		const XMFLOAT3 target(random.range(-half, half), 0.0f, random.range(-half, half));
+		const XMVECTOR direction = XMVector3Normalize(XMVectorSubtract(XMLoadFloat3(&target), XMLoadFloat3(&ray.origin)));
+		XMStoreFloat3(&ray.direction, direction);
+	}
+	return rays;
+}
+
+/// Moller-Trumbore escalar contra todos los triangulos; ambas caras, `t` en (0, maxDistance).
+float
+BruteForceDistance(const TerrainMesh& mesh, const PickRay& ray, float maxDistance) {
+	float best = maxDistance;
+	for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+		const EU::Vector3& a = mesh.vertices[mesh.indices[i]].Position;
+		const EU::Vector3& b = mesh.vertices[mesh.indices[i + 1]].Position;
+		const EU::Vector3& c = mesh.vertices[mesh.indices[i + 2]].Position;
+		const XMFLOAT3 e1(b.x - a.x, b.y - a.y, b.z - a.z);
+		const XMFLOAT3 e2(c.x - a.x, c.y - a.y, c.z - a.z);
+		const XMFLOAT3& d = ray.direction;
+		const XMFLOAT3 p(d.y * e2.z - d.z * e2.y, d.z * e2.x - d.x * e2.z, d.x * e2.y - d.y * e2.x);
+		const float det = e1.x * p.x + e1.y * p.y + e1.z * p.z;
+		if (std::fabs(det) <= 1e-12f) {
+			continue;
+		}
+		const float invDet = 1.0f / det;
+		const XMFLOAT3 s(ray.origin.x - a.x, ray.origin.y - a.y, ray.origin.z - a.z);
+		const float u = (s.x * p.x + s.y * p.y + s.z * p.z) * invDet;
+		if (u < 0.0f || u > 1.0f) {
+			continue;
+		}
+		const XMFLOAT3 q(s.y * e1.z - s.z * e1.y, s.z * e1.x - s.x * e1.z, s.x * e1.y - s.y * e1.x);
+		const float v = (d.x * q.x + d.y * q.y + d.z * q.z) * invDet;
+		const float t = (e2.x * q.x + e2.y * q.y + e2.z * q.z) * invDet;
+		if (v >= 0.0f && u + v <= 1.0f && t > 1e-6f && t < best) {
+			best = t;
+		}
+	}
+	return best;
+}
+
+/// Compara cada rayo del BVH con la fuerza bruta; devuelve cuantos impactaron.
+size_t
+CheckAgainstBruteForce(const TriangleBVH& bvh, const TerrainMesh& mesh, const std::vector<PickRay>& rays) {
+	constexpr float kMaxDistance = 1000.0f;
+	size_t hits = 0;
+	for (const PickRay& ray : rays) {
+		TriangleHit hit;
+		const bool found = bvh.intersect(ray.origin, ray.direction, kMaxDistance, hit);
+		const float expected = BruteForceDistance(mesh, ray, kMaxDistance);
+		CHECK(found == (expected < kMaxDistance));
+		if (found) {
+			++hits;
+			CHECK(std::fabs(hit.distance - expected) <= 1e-3f * expected);
+			// El triangulo devuelto es el que esta a esa distancia
+			const unsigned int* triangle = &mesh.indices[static_cast<size_t>(hit.triangle) * 3];
+			const EU::Vector3& a = mesh.vertices[triangle[0]].Position;
+			const EU::Vector3& b = mesh.vertices[triangle[1]].Position;
+			const EU::Vector3& c = mesh.vertices[triangle[2]].Position;
+			const float y = a.y + hit.u * (b.y - a.y) + hit.v * (c.y - a.y);
+			CHECK(std::fabs(y - (ray.origin.y + hit.distance * ray.direction.y)) < 1e-2f);
+		}
+	}
+	return hits;
+}
+}
+
+WV_TEST(TestBVHMatchesBruteForce) {
+	const TerrainMesh mesh(96);
+	TriangleBVH bvh;
+	bvh.addSubmesh(mesh.vertices.data(), mesh.vertices.size(), mesh.indices.data(), mesh.indices.size());
+	bvh.build();
+	CHECK(bvh.getTriangleCount() == mesh.getTriangleCount());
+
+	// Lo que ParseBinaryCache exige para aceptar el arbol sin reconstruirlo
+	const std::vector<TriangleBVH::Node>& nodes = bvh.getNodes();
+	size_t leafTriangles = 0;
+	for (uint32_t i = 0; i < nodes.size(); ++i) {
+		if (nodes[i].count == 0) {
+			CHECK(nodes[i].first > i && nodes[i].first < nodes.size() - 1);
+		}
+		else {
+			CHECK(nodes[i].count <= TriangleBVH::kLeafSize && nodes[i].first < bvh.getPackets().size());
+			leafTriangles += nodes[i].count;
+		}
+	}
+	CHECK(leafTriangles == mesh.getTriangleCount());
+
+	TestRandom random;
+	const std::vector<PickRay> rays = MakePickRays(random, 60.0f, 2000);
+	const size_t hits = CheckAgainstBruteForce(bvh, mesh, rays);
+	// Los rayos que apuntan fuera del terreno fallan; la mayoria impacta
+	CHECK(hits > rays.size() / 2 && hits < rays.size());
+
+	// assign() con los mismos nodos responde igual
+	TriangleBVH copy;
+	std::vector<TriangleBVH::Node> copiedNodes = bvh.getNodes();
+	std::vector<TriangleBVH::TrianglePacket> copiedPackets = bvh.getPackets();
+	copy.assign(std::move(copiedNodes), std::move(copiedPackets));
+	for (size_t i = 0; i < 100; ++i) {
+		TriangleHit original;
+		TriangleHit assigned;
+		CHECK(bvh.intersect(rays[i].origin, rays[i].direction, 1000.0f, original) ==
+		      copy.intersect(rays[i].origin, rays[i].direction, 1000.0f, assigned));
+		CHECK(original.triangle == assigned.triangle && original.distance == assigned.distance);
+	}
+}
+
+WV_BENCHMARK(BenchTerrainBuildAndPick) {
+	constexpr uint32_t kCells = 1024;
+	constexpr size_t kPicks = 100000;
+	constexpr size_t kBruteForceRays = 20;
+	char label[96];
+
+	const TerrainMesh mesh(kCells);
+	const size_t triangles = mesh.getTriangleCount();
+	TriangleBVH bvh;
+	TestHarness::BenchTimer timer;
+	bvh.addSubmesh(mesh.vertices.data(), mesh.vertices.size(), mesh.indices.data(), mesh.indices.size());
+	bvh.build();
+	std::snprintf(label, sizeof(label), "construir BVH (%zu triangulos, %zu nodos)", triangles, bvh.getNodes().size());
+	TestHarness::report(label, timer.elapsedMs(), triangles);
+
+	TestRandom random;
+	const float half = 0.5f * static_cast<float>(kCells);
+	const std::vector<PickRay> rays = MakePickRays(random, half, kPicks);
+	size_t hits = 0;
+	timer.restart();
+	for (const PickRay& ray : rays) {
+		TriangleHit hit;
+		hits += bvh.intersect(ray.origin, ray.direction, 2000.0f, hit) ? 1 : 0;
+	}
+	std::snprintf(label, sizeof(label), "picking con BVH (%zu impactos)", hits);
+	TestHarness::report(label, timer.elapsedMs(), kPicks);
+	CHECK(hits > kPicks / 2);
+
+	// La fuerza bruta recorre los 2M triangulos por rayo: solo unos pocos rayos
+	const std::vector<PickRay> bruteRays(rays.begin(), rays.begin() + kBruteForceRays);
+	timer.restart();
+	float nearest = 0.0f;
+	for (const PickRay& ray : bruteRays) {
+		nearest += BruteForceDistance(mesh, ray, 2000.0f);
+	}
+	TestHarness::keep(nearest);
+	TestHarness::report("picking por fuerza bruta", timer.elapsedMs(), kBruteForceRays);
+	CheckAgainstBruteForce(bvh, mesh, bruteRays);
+}